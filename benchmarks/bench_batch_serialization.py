@@ -0,0 +1,73 @@
+"""
+Benchmarks the thread-count scaling of `FourByteSerializer.serialize_messages_and_timestamps`.
+"""
+
+import argparse
+import random
+import time
+from typing import List
+
+from clp_ffi_py.ir import FourByteSerializer
+
+
+def generate_messages(num_messages: int, seed: int) -> List[bytes]:
+    """
+    Generates log messages containing a mix of static text, integer, float, and dictionary
+    variables.
+
+    :param num_messages: The number of messages to generate.
+    :param seed: The seed of the random generator.
+    :return: The generated messages.
+    """
+    rng: random.Random = random.Random(seed)
+    return [
+        (
+            f"INFO [task-{rng.randint(0, 4096)}] Container container_{rng.randint(0, 1 << 40)}"
+            f" on host node-{rng.randint(0, 255)}.cluster finished in {rng.random() * 1000:.3f}"
+            f" ms with exit code {rng.randint(0, 3)}\n"
+        ).encode()
+        for _ in range(num_messages)
+    ]
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--num-messages", type=int, default=1_000_000)
+    parser.add_argument("--num-threads", type=int, nargs="+", default=[1, 2, 4, 8])
+    parser.add_argument("--num-repetitions", type=int, default=5)
+    parser.add_argument("--seed", type=int, default=3190)
+    args: argparse.Namespace = parser.parse_args()
+
+    messages: List[bytes] = generate_messages(args.num_messages, args.seed)
+    ref_timestamp: int = 1_700_000_000_000
+    timestamps: List[int] = [ref_timestamp + i for i in range(len(messages))]
+    num_input_bytes: int = sum(len(msg) for msg in messages)
+
+    ref_output: bytes = FourByteSerializer.serialize_messages_and_timestamps(
+        timestamps, messages, ref_timestamp
+    )
+    print(f"Messages: {len(messages)}, input size: {num_input_bytes / 1e6:.1f} MB")
+    # The speedup is relative to the first thread count.
+    print(f"{'threads':>8} {'best time (s)':>14} {'MB/s':>10} {'speedup':>8}")
+    baseline_duration: float = 0.0
+    for num_threads in args.num_threads:
+        best_duration: float = float("inf")
+        for _ in range(args.num_repetitions):
+            start: float = time.perf_counter()
+            output: bytes = FourByteSerializer.serialize_messages_and_timestamps(
+                timestamps, messages, ref_timestamp, num_threads
+            )
+            best_duration = min(best_duration, time.perf_counter() - start)
+            if output != ref_output:
+                raise RuntimeError(f"Output with {num_threads} threads differs from 1 thread.")
+        if 0.0 == baseline_duration:
+            baseline_duration = best_duration
+        print(
+            f"{num_threads:>8} {best_duration:>14.4f}"
+            f" {num_input_bytes / 1e6 / best_duration:>10.1f}"
+            f" {baseline_duration / best_duration:>8.2f}"
+        )
+
+
+if "__main__" == __name__:
+    main()
@@ -0,0 +1,105 @@
+"""
+Benchmarks the throughput and the memory of `DeserializerBuffer` on an unstructured IR stream whose
+log event sizes follow a heavy-tailed (Pareto) distribution.
+"""
+
+import argparse
+import os
+import random
+import resource
+import time
+from io import BytesIO
+from typing import List, Optional
+
+from clp_ffi_py.ir import DeserializerBuffer, FourByteDeserializer, FourByteSerializer
+
+
+def generate_ir_stream(
+    num_log_events: int, pareto_alpha: float, min_size: int, max_size: int, seed: int
+) -> bytes:
+    """
+    Generates an IR stream whose log message sizes follow a Pareto distribution.
+
+    :param num_log_events: The number of log events to generate.
+    :param pareto_alpha: The shape of the Pareto distribution. Smaller values give heavier tails.
+    :param min_size: The minimum size of a log message, which is the scale of the distribution.
+    :param max_size: The maximum size of a log message.
+    :param seed: The seed of the random generator.
+    :return: The IR stream.
+    """
+    rng: random.Random = random.Random(seed)
+    ref_timestamp: int = 1700000000000
+    chunks: List[bytes] = [
+        FourByteSerializer.serialize_preamble(ref_timestamp, "yyyy-MM-dd HH:mm:ss,SSS", "UTC")
+    ]
+    for i in range(num_log_events):
+        size: int = min(max_size, int(min_size * rng.paretovariate(pareto_alpha)))
+        prefix: bytes = f"Task {i} of job {rng.randint(0, 1 << 20)} dumped ".encode()
+        chunks.append(
+            FourByteSerializer.serialize_message_and_timestamp_delta(
+                1, prefix + b"x" * max(0, size - len(prefix))
+            )
+        )
+    chunks.append(FourByteSerializer.serialize_end_of_ir())
+    return b"".join(chunks)
+
+
+def get_current_rss_mb() -> float:
+    """
+    :return: The current RSS of the process, in MB. Only supported on Linux.
+    """
+    with open("/proc/self/statm") as statm:
+        return int(statm.read().split()[1]) * os.sysconf("SC_PAGE_SIZE") / 1e6
+
+
+def get_peak_rss_mb() -> float:
+    """
+    :return: The peak RSS of the process, in MB. On Linux, `ru_maxrss` is in KB.
+    """
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1e3
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--num-log-events", type=int, default=200_000)
+    parser.add_argument("--pareto-alpha", type=float, default=1.2)
+    parser.add_argument("--min-size", type=int, default=64)
+    parser.add_argument("--max-size", type=int, default=16 * 1024 * 1024)
+    parser.add_argument("--initial-buffer-capacity", type=int, default=65536)
+    parser.add_argument("--max-buffer-capacity", type=int, default=None)
+    parser.add_argument("--num-repetitions", type=int, default=5)
+    parser.add_argument("--seed", type=int, default=3190)
+    args: argparse.Namespace = parser.parse_args()
+
+    ir_stream: bytes = generate_ir_stream(
+        args.num_log_events, args.pareto_alpha, args.min_size, args.max_size, args.seed
+    )
+    print(f"Log events: {args.num_log_events}, stream size: {len(ir_stream) / 1e6:.1f} MB")
+    # The peak RSS is cumulative, so each buffer configuration should be run in its own process.
+    print(f"{'MB/s':>10} {'log events/s':>14} {'held RSS (MB)':>14} {'peak RSS (MB)':>14}")
+    max_buffer_capacity: Optional[int] = args.max_buffer_capacity
+    for _ in range(args.num_repetitions):
+        rss_before: float = get_current_rss_mb()
+        start: float = time.perf_counter()
+        # The stream is read through a file object so that it's copied into the read buffer, as
+        # it would be when read from a file.
+        deserializer_buffer: DeserializerBuffer = DeserializerBuffer(
+            BytesIO(ir_stream),
+            args.initial_buffer_capacity,
+            max_buffer_capacity=max_buffer_capacity,
+        )
+        FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+        num_log_events: int = FourByteDeserializer.count_matches(deserializer_buffer)
+        duration: float = time.perf_counter() - start
+        # The memory still held by the buffer once the whole stream, including any spike, is
+        # consumed.
+        held_rss: float = get_current_rss_mb() - rss_before
+        del deserializer_buffer
+        print(
+            f"{len(ir_stream) / 1e6 / duration:>10.1f} {num_log_events / duration:>14.0f}"
+            f" {held_rss:>14.1f} {get_peak_rss_mb():>14.1f}"
+        )
+
+
+if "__main__" == __name__:
+    main()
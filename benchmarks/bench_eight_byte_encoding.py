@@ -0,0 +1,182 @@
+"""
+Benchmarks the eight-byte encoding against the four-byte encoding on numeric-heavy log messages,
+comparing the serialized size, the serialization throughput, and the deserialization throughput.
+"""
+
+import argparse
+import random
+import time
+from io import BytesIO
+from typing import Callable, List, Optional, Tuple, TypeVar
+
+from clp_ffi_py.ir import (
+    ClpIrStreamReader,
+    Deserializer,
+    EightByteSerializer,
+    FourByteSerializer,
+    KeyValuePairLogEvent,
+    Serializer,
+)
+from clp_ffi_py.utils import serialize_dict_to_msgpack
+
+TIMESTAMP_FORMAT: str = "yyyy-MM-dd HH:mm:ss,SSS"
+TIMEZONE: str = "UTC"
+REF_TIMESTAMP: int = 1700000000000
+
+T = TypeVar("T")
+
+
+class _UnclosableBytesIO(BytesIO):
+    """
+    A `BytesIO` that stays readable after the serializer writing into it closes it.
+    """
+
+    # override
+    def close(self) -> None:
+        pass
+
+
+def generate_messages(num_messages: int, seed: int) -> List[bytes]:
+    """
+    Generates log messages dominated by 64-bit IDs and high-precision floats, which are encoded as
+    dictionary variables under the four-byte encoding.
+
+    :param num_messages: The number of messages to generate.
+    :param seed: The seed of the random generator.
+    :return: The generated messages.
+    """
+    rng: random.Random = random.Random(seed)
+    return [
+        (
+            f"Span {rng.getrandbits(63)} of trace {rng.getrandbits(63)} on shard"
+            f" {rng.randint(0, 1 << 40)} took {rng.random() * 1e4:.9f} ms at offset"
+            f" {rng.getrandbits(62)} with load {rng.random():.12f}"
+        ).encode()
+        for _ in range(num_messages)
+    ]
+
+
+def serialize_four_byte(messages: List[bytes]) -> bytes:
+    """
+    :param messages: The messages to serialize.
+    :return: An unstructured IR stream of the messages, using the four-byte encoding.
+    """
+    chunks: List[bytes] = [
+        FourByteSerializer.serialize_preamble(REF_TIMESTAMP, TIMESTAMP_FORMAT, TIMEZONE)
+    ]
+    for message in messages:
+        chunks.append(FourByteSerializer.serialize_message_and_timestamp_delta(1, message))
+    chunks.append(FourByteSerializer.serialize_end_of_ir())
+    return b"".join(chunks)
+
+
+def serialize_eight_byte(messages: List[bytes]) -> bytes:
+    """
+    :param messages: The messages to serialize.
+    :return: An unstructured IR stream of the messages, using the eight-byte encoding.
+    """
+    chunks: List[bytes] = [EightByteSerializer.serialize_preamble(TIMESTAMP_FORMAT, TIMEZONE)]
+    for idx, message in enumerate(messages):
+        chunks.append(
+            EightByteSerializer.serialize_message_and_timestamp(REF_TIMESTAMP + idx, message)
+        )
+    chunks.append(EightByteSerializer.serialize_end_of_ir())
+    return b"".join(chunks)
+
+
+def serialize_kv_pairs(messages: List[bytes], encoding: str) -> bytes:
+    """
+    :param messages: The messages to serialize, each as the value of a key-value pair.
+    :param encoding: The encoding of the key-value pair IR stream.
+    :return: A key-value pair IR stream of the messages.
+    """
+    auto_gen_msgpack_map: bytes = serialize_dict_to_msgpack({})
+    ir_stream: _UnclosableBytesIO = _UnclosableBytesIO()
+    with Serializer(ir_stream, encoding=encoding) as serializer:
+        for message in messages:
+            serializer.serialize_log_event_from_msgpack_map(
+                auto_gen_msgpack_map, serialize_dict_to_msgpack({"message": message.decode()})
+            )
+    return ir_stream.getvalue()
+
+
+def read_log_events(ir_stream: bytes) -> int:
+    """
+    :param ir_stream: An unstructured IR stream.
+    :return: The number of log events read.
+    """
+    with ClpIrStreamReader(BytesIO(ir_stream), enable_compression=False) as reader:
+        return sum(1 for _ in reader)
+
+
+def read_kv_pair_log_events(ir_stream: bytes) -> int:
+    """
+    :param ir_stream: A key-value pair IR stream.
+    :return: The number of log events read.
+    """
+    num_log_events: int = 0
+    deserializer: Deserializer = Deserializer(ir_stream)
+    while True:
+        log_event: Optional[KeyValuePairLogEvent] = deserializer.deserialize_log_event()
+        if log_event is None:
+            break
+        log_event.to_dict()
+        num_log_events += 1
+    return num_log_events
+
+
+def time_best(run: Callable[[], T], num_repetitions: int) -> Tuple[float, T]:
+    """
+    :param run: The callable to time.
+    :param num_repetitions: The number of times to run the callable, at least once.
+    :return: A tuple of the best duration and the result of the last run.
+    """
+    start: float = time.perf_counter()
+    result: T = run()
+    best_duration: float = time.perf_counter() - start
+    for _ in range(num_repetitions - 1):
+        start = time.perf_counter()
+        result = run()
+        best_duration = min(best_duration, time.perf_counter() - start)
+    return best_duration, result
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--num-messages", type=int, default=200_000)
+    parser.add_argument("--num-repetitions", type=int, default=5)
+    parser.add_argument("--seed", type=int, default=3190)
+    args: argparse.Namespace = parser.parse_args()
+
+    messages: List[bytes] = generate_messages(args.num_messages, args.seed)
+    num_input_bytes: int = sum(len(message) for message in messages)
+    print(f"Messages: {len(messages)}, input size: {num_input_bytes / 1e6:.1f} MB")
+    print(f"{'encoding':>20} {'size (MB)':>10} {'ser. msgs/s':>14} {'deser. msgs/s':>14}")
+    benchmarks: List[Tuple[str, Callable[[], bytes], Callable[[bytes], int]]] = [
+        ("four-byte", lambda: serialize_four_byte(messages), read_log_events),
+        ("eight-byte", lambda: serialize_eight_byte(messages), read_log_events),
+        (
+            "four-byte (kv)",
+            lambda: serialize_kv_pairs(messages, "four_byte"),
+            read_kv_pair_log_events,
+        ),
+        (
+            "eight-byte (kv)",
+            lambda: serialize_kv_pairs(messages, "eight_byte"),
+            read_kv_pair_log_events,
+        ),
+    ]
+    for name, serialize, deserialize in benchmarks:
+        serialization_duration, ir_stream = time_best(serialize, args.num_repetitions)
+        deserialization_duration, _ = time_best(
+            lambda: deserialize(ir_stream), args.num_repetitions
+        )
+        print(
+            f"{name:>20} {len(ir_stream) / 1e6:>10.2f}"
+            f" {len(messages) / serialization_duration:>14.0f}"
+            f" {len(messages) / deserialization_duration:>14.0f}"
+        )
+
+
+if "__main__" == __name__:
+    main()
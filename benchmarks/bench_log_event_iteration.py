@@ -0,0 +1,135 @@
+"""
+Benchmarks the throughput and the peak RSS of iterating deserialized `LogEvent`s and
+`KeyValuePairLogEvent`s.
+"""
+
+import argparse
+import json
+import resource
+import time
+from io import BytesIO
+from pathlib import Path
+from typing import Callable, List, Optional
+
+from clp_ffi_py.ir import (
+    ClpIrFileReader,
+    Deserializer,
+    KeyValuePairLogEvent,
+    Serializer,
+)
+from clp_ffi_py.utils import serialize_dict_to_msgpack
+
+TEST_DATA_DIR: Path = Path(__file__).resolve().parent.parent / "tests" / "test_ir" / "test_data"
+
+
+class _UnclosableBytesIO(BytesIO):
+    """
+    A `BytesIO` that stays readable after the serializer writing into it closes it.
+    """
+
+    # override
+    def close(self) -> None:
+        pass
+
+
+def iterate_log_events(ir_path: Path) -> int:
+    """
+    Iterates all log events in the given four-byte encoded IR stream.
+
+    :param ir_path: The path of the IR stream.
+    :return: The number of log events iterated.
+    """
+    num_log_events: int = 0
+    with ClpIrFileReader(ir_path, enable_compression=False) as reader:
+        for _ in reader:
+            num_log_events += 1
+    return num_log_events
+
+
+def serialize_jsonl(jsonl_path: Path, num_copies: int) -> bytes:
+    """
+    Serializes the JSON lines file into a key-value pair IR stream.
+
+    :param jsonl_path: The path of the JSON lines file.
+    :param num_copies: The number of times each JSON line is serialized.
+    :return: The serialized IR stream.
+    """
+    msgpack_maps: List[bytes] = [
+        serialize_dict_to_msgpack(json.loads(line))
+        for line in jsonl_path.read_text().splitlines()
+        if line
+    ]
+    auto_gen_msgpack_map: bytes = serialize_dict_to_msgpack({})
+    ir_stream: _UnclosableBytesIO = _UnclosableBytesIO()
+    with Serializer(ir_stream) as serializer:
+        for _ in range(num_copies):
+            for msgpack_map in msgpack_maps:
+                serializer.serialize_log_event_from_msgpack_map(auto_gen_msgpack_map, msgpack_map)
+    return ir_stream.getvalue()
+
+
+def iterate_kv_pair_log_events(ir_stream: bytes) -> int:
+    """
+    Iterates all log events in the given key-value pair IR stream.
+
+    :param ir_stream: The IR stream.
+    :return: The number of log events iterated.
+    """
+    num_log_events: int = 0
+    deserializer: Deserializer = Deserializer(ir_stream)
+    while True:
+        log_event: Optional[KeyValuePairLogEvent] = deserializer.deserialize_log_event()
+        if log_event is None:
+            break
+        num_log_events += 1
+    return num_log_events
+
+
+def get_peak_rss_mb() -> float:
+    """
+    :return: The peak RSS of the process, in MB. On Linux, `ru_maxrss` is in KB.
+    """
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1e3
+
+
+def run_benchmark(name: str, iterate: Callable[[], int], num_repetitions: int) -> None:
+    """
+    Runs the given iteration repeatedly, and prints the best throughput and the peak RSS.
+
+    :param name: The name of the benchmark.
+    :param iterate: A callable that iterates the log events and returns their number.
+    :param num_repetitions: The number of times to run the iteration.
+    """
+    best_throughput: float = 0.0
+    for _ in range(num_repetitions):
+        start: float = time.perf_counter()
+        num_log_events: int = iterate()
+        best_throughput = max(best_throughput, num_log_events / (time.perf_counter() - start))
+    print(f"{name:>28} {best_throughput:>16.0f} {get_peak_rss_mb():>16.1f}")
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--ir-path", type=Path, default=TEST_DATA_DIR / "unstructured_ir" / "benchmark.clp"
+    )
+    parser.add_argument(
+        "--jsonl-path", type=Path, default=TEST_DATA_DIR / "jsonl" / "elasticsearch.jsonl"
+    )
+    parser.add_argument("--num-jsonl-copies", type=int, default=1000)
+    parser.add_argument("--num-repetitions", type=int, default=20)
+    args: argparse.Namespace = parser.parse_args()
+
+    kv_pair_ir_stream: bytes = serialize_jsonl(args.jsonl_path, args.num_jsonl_copies)
+    # The peak RSS is cumulative, so the benchmarks are listed in the order they run.
+    print(f"{'benchmark':>28} {'log events/s':>16} {'peak RSS (MB)':>16}")
+    run_benchmark("LogEvent", lambda: iterate_log_events(args.ir_path), args.num_repetitions)
+    run_benchmark(
+        "KeyValuePairLogEvent",
+        lambda: iterate_kv_pair_log_events(kv_pair_ir_stream),
+        args.num_repetitions,
+    )
+
+
+if "__main__" == __name__:
+    main()
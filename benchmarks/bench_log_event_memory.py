@@ -0,0 +1,82 @@
+"""
+Benchmarks the memory held per deserialized `LogEvent`, depending on which representations of its
+log message have been accessed.
+"""
+
+import argparse
+import gc
+import os
+from pathlib import Path
+from typing import Callable, Dict, List
+
+from clp_ffi_py.ir import ClpIrFileReader, LogEvent
+
+TEST_DATA_DIR: Path = Path(__file__).resolve().parent.parent / "tests" / "test_ir" / "test_data"
+
+ACCESSES: Dict[str, Callable[[LogEvent], object]] = {
+    "none": lambda log_event: None,
+    "get_log_message": lambda log_event: log_event.get_log_message(),
+    "get_formatted_message": lambda log_event: log_event.get_formatted_message(),
+    "both": lambda log_event: (log_event.get_log_message(), log_event.get_formatted_message()),
+}
+
+
+def get_current_rss_bytes() -> int:
+    """
+    :return: The current RSS of the process, in bytes. Only supported on Linux.
+    """
+    with open("/proc/self/statm") as statm:
+        return int(statm.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+
+
+def read_log_events(ir_path: Path) -> List[LogEvent]:
+    """
+    Reads all log events in the given four-byte encoded IR stream.
+
+    :param ir_path: The path of the IR stream.
+    :return: The log events.
+    """
+    with ClpIrFileReader(ir_path, enable_compression=False) as reader:
+        return list(reader)
+
+
+def measure_bytes_per_log_event(
+    ir_path: Path, num_copies: int, access: Callable[[LogEvent], object]
+) -> float:
+    """
+    Reads the log events, accesses each of them, and measures the memory they hold.
+
+    :param ir_path: The path of the IR stream.
+    :param num_copies: The number of times the IR stream is read.
+    :param access: A callable applied to each log event after it's read.
+    :return: The average number of RSS bytes held per log event.
+    """
+    gc.collect()
+    rss_before: int = get_current_rss_bytes()
+    log_events: List[LogEvent] = []
+    for _ in range(num_copies):
+        log_events.extend(read_log_events(ir_path))
+    for log_event in log_events:
+        access(log_event)
+    gc.collect()
+    return (get_current_rss_bytes() - rss_before) / len(log_events)
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--ir-path", type=Path, default=TEST_DATA_DIR / "unstructured_ir" / "benchmark.clp"
+    )
+    parser.add_argument("--num-copies", type=int, default=10)
+    # Memory freed within the process is reused, so each access is measured in its own process.
+    parser.add_argument("--access", choices=ACCESSES.keys(), default="none")
+    args: argparse.Namespace = parser.parse_args()
+
+    bytes_per_log_event: float = measure_bytes_per_log_event(
+        args.ir_path, args.num_copies, ACCESSES[args.access]
+    )
+    print(f"{args.access}: {bytes_per_log_event:.1f} bytes/log event")
+
+
+if "__main__" == __name__:
+    main()
@@ -0,0 +1,168 @@
+"""
+Benchmarks the throughput of `Deserializer.scan_stats` against computing the same statistics from
+key-value pair log events decoded in Python.
+"""
+
+import argparse
+import json
+import time
+from io import BytesIO
+from pathlib import Path
+from typing import Any, Callable, Dict, FrozenSet, Iterator, List, Optional, Set, Tuple
+
+from clp_ffi_py.ir import Deserializer, KeyValuePairLogEvent, Serializer
+from clp_ffi_py.utils import serialize_dict_to_msgpack
+
+TEST_DATA_DIR: Path = Path(__file__).resolve().parent.parent / "tests" / "test_ir" / "test_data"
+
+KeyPath = Tuple[str, ...]
+
+
+class _UnclosableBytesIO(BytesIO):
+    """
+    A `BytesIO` that stays readable after the serializer writing into it closes it.
+    """
+
+    # override
+    def close(self) -> None:
+        pass
+
+
+def serialize_jsonl(jsonl_path: Path, num_copies: int) -> bytes:
+    """
+    Serializes the JSON lines file into a key-value pair IR stream.
+
+    :param jsonl_path: The path of the JSON lines file.
+    :param num_copies: The number of times each JSON line is serialized.
+    :return: The serialized IR stream.
+    """
+    msgpack_maps: List[bytes] = [
+        serialize_dict_to_msgpack(json.loads(line))
+        for line in jsonl_path.read_text().splitlines()
+        if line
+    ]
+    auto_gen_msgpack_map: bytes = serialize_dict_to_msgpack({})
+    ir_stream: _UnclosableBytesIO = _UnclosableBytesIO()
+    with Serializer(ir_stream) as serializer:
+        for _ in range(num_copies):
+            for msgpack_map in msgpack_maps:
+                serializer.serialize_log_event_from_msgpack_map(auto_gen_msgpack_map, msgpack_map)
+    return ir_stream.getvalue()
+
+
+def _get_leaf_kv_pairs(
+    kv_pairs: Dict[Any, Any], prefix: KeyPath = ()
+) -> Iterator[Tuple[KeyPath, Any]]:
+    """
+    :param kv_pairs: The key-value pairs.
+    :param prefix: The key path of `kv_pairs`.
+    :return: An iterator of the leaf key paths and their values, in the same way that
+        `Deserializer.scan_stats` counts keys.
+    """
+    for key, value in kv_pairs.items():
+        key_path: KeyPath = (*prefix, key)
+        if isinstance(value, dict) and 0 != len(value):
+            yield from _get_leaf_kv_pairs(value, key_path)
+        else:
+            yield key_path, value
+
+
+def scan_stats_in_python(ir_stream: bytes) -> int:
+    """
+    Computes the statistics of `Deserializer.scan_stats` by decoding each log event in Python.
+    Only the user-generated key-value pairs are considered.
+
+    :param ir_stream: The IR stream.
+    :return: The number of log events scanned.
+    """
+    num_log_events: int = 0
+    schemas: Set[FrozenSet[KeyPath]] = set()
+    key_frequencies: Dict[KeyPath, int] = {}
+    numeric_ranges: Dict[KeyPath, Tuple[Any, Any]] = {}
+    deserializer: Deserializer = Deserializer(ir_stream)
+    while True:
+        log_event: Optional[KeyValuePairLogEvent] = deserializer.deserialize_log_event()
+        if log_event is None:
+            break
+        num_log_events += 1
+        key_paths: List[KeyPath] = []
+        for key_path, value in _get_leaf_kv_pairs(log_event.to_dict()[1]):
+            key_paths.append(key_path)
+            key_frequencies[key_path] = key_frequencies.get(key_path, 0) + 1
+            if type(value) not in (int, float):
+                continue
+            min_value, max_value = numeric_ranges.get(key_path, (value, value))
+            numeric_ranges[key_path] = (min(min_value, value), max(max_value, value))
+        schemas.add(frozenset(key_paths))
+    return num_log_events
+
+
+def scan_stats_natively(ir_stream: bytes, in_place: bool) -> int:
+    """
+    :param ir_stream: The IR stream.
+    :param in_place: Whether to scan the IR stream in place, or to read it as a byte stream.
+    :return: The number of log events scanned by `Deserializer.scan_stats`.
+    """
+    stats: Dict[str, Any] = Deserializer.scan_stats(
+        ir_stream if in_place else BytesIO(ir_stream)
+    )
+    num_log_events: int = stats["num_log_events"]
+    return num_log_events
+
+
+def run_benchmark(
+    name: str, scan: Callable[[], int], num_encoded_bytes: int, num_repetitions: int
+) -> None:
+    """
+    Runs the given scan repeatedly, and prints the best throughput.
+
+    :param name: The name of the benchmark.
+    :param scan: A callable that scans the IR stream and returns the number of log events.
+    :param num_encoded_bytes: The size of the IR stream.
+    :param num_repetitions: The number of times to run the scan.
+    """
+    best_duration: float = float("inf")
+    num_log_events: int = 0
+    for _ in range(num_repetitions):
+        start: float = time.perf_counter()
+        num_log_events = scan()
+        best_duration = min(best_duration, time.perf_counter() - start)
+    print(
+        f"{name:>24} {num_log_events / best_duration:>16.0f}"
+        f" {num_encoded_bytes / best_duration / 1e6:>12.1f}"
+    )
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--jsonl-path", type=Path, default=TEST_DATA_DIR / "jsonl" / "elasticsearch.jsonl"
+    )
+    parser.add_argument("--num-jsonl-copies", type=int, default=1000)
+    parser.add_argument("--num-repetitions", type=int, default=10)
+    args: argparse.Namespace = parser.parse_args()
+
+    ir_stream: bytes = serialize_jsonl(args.jsonl_path, args.num_jsonl_copies)
+    print(f"{'benchmark':>24} {'log events/s':>16} {'MB/s':>12}")
+    run_benchmark(
+        "scan_stats (in place)",
+        lambda: scan_stats_natively(ir_stream, True),
+        len(ir_stream),
+        args.num_repetitions,
+    )
+    run_benchmark(
+        "scan_stats (stream)",
+        lambda: scan_stats_natively(ir_stream, False),
+        len(ir_stream),
+        args.num_repetitions,
+    )
+    run_benchmark(
+        "Python decode",
+        lambda: scan_stats_in_python(ir_stream),
+        len(ir_stream),
+        args.num_repetitions,
+    )
+
+
+if "__main__" == __name__:
+    main()
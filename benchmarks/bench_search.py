@@ -0,0 +1,86 @@
+"""
+Benchmarks searching an unstructured IR stream with wildcard queries, which are matched against
+the encoded logtypes before any log message is decoded, against decoding every log event and
+matching it in Python.
+"""
+
+import argparse
+import time
+from pathlib import Path
+from typing import Callable, Dict
+
+from clp_ffi_py.ir import ClpIrFileReader, Query
+from clp_ffi_py.wildcard_query import SubstringWildcardQuery
+
+TEST_DATA_DIR: Path = Path(__file__).resolve().parent.parent / "tests" / "test_ir" / "test_data"
+
+# Queries on static text, on variables, on both, and one that never matches.
+WILDCARD_QUERIES: Dict[str, str] = {
+    "static text": "reported UNHEALTHY",
+    "variable": "container_1427088391284_0067_01_*",
+    "static text and variable": "Rolling master-key*with id 75*",
+    "no match": "FATAL",
+}
+
+
+def search(ir_path: Path, query: Query) -> int:
+    """
+    :param ir_path: The path of the IR stream.
+    :param query: The query.
+    :return: The number of log events returned by `ClpIrStreamReader.search`.
+    """
+    with ClpIrFileReader(ir_path, enable_compression=False) as reader:
+        return sum(1 for _ in reader.search(query))
+
+
+def decode_and_match(ir_path: Path, query: Query) -> int:
+    """
+    :param ir_path: The path of the IR stream.
+    :param query: The query.
+    :return: The number of log events matched by `Query.match_log_event`, after every log event
+        is read without any query.
+    """
+    with ClpIrFileReader(ir_path, enable_compression=False) as reader:
+        return sum(1 for log_event in reader if query.match_log_event(log_event))
+
+
+def run_benchmark(name: str, count: Callable[[], int], num_repetitions: int) -> None:
+    """
+    Runs the given search repeatedly, and prints the best duration.
+
+    :param name: The name of the benchmark.
+    :param count: A callable that searches the IR stream and returns the number of matches.
+    :param num_repetitions: The number of times to run the search.
+    """
+    best_duration: float = float("inf")
+    num_matches: int = 0
+    for _ in range(num_repetitions):
+        start: float = time.perf_counter()
+        num_matches = count()
+        best_duration = min(best_duration, time.perf_counter() - start)
+    print(f"{name:>44} {num_matches:>10} {best_duration * 1e3:>10.1f}")
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--ir-path", type=Path, default=TEST_DATA_DIR / "unstructured_ir" / "rand_hadoop_log.clp"
+    )
+    parser.add_argument("--num-repetitions", type=int, default=20)
+    args: argparse.Namespace = parser.parse_args()
+
+    print(f"{'benchmark':>44} {'matches':>10} {'best (ms)':>10}")
+    for name, wildcard_query in WILDCARD_QUERIES.items():
+        query: Query = Query(wildcard_queries=[SubstringWildcardQuery(wildcard_query)])
+        run_benchmark(
+            f"{name} (search)", lambda: search(args.ir_path, query), args.num_repetitions
+        )
+        run_benchmark(
+            f"{name} (decode and match)",
+            lambda: decode_and_match(args.ir_path, query),
+            args.num_repetitions,
+        )
+
+
+if "__main__" == __name__:
+    main()
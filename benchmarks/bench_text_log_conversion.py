@@ -0,0 +1,88 @@
+"""
+Benchmarks the throughput of `FourByteSerializer.serialize_text_log`.
+"""
+
+import argparse
+import random
+import time
+from pathlib import Path
+from tempfile import TemporaryDirectory
+from typing import List
+
+from zstandard import ZstdCompressor
+
+from clp_ffi_py.ir import FourByteSerializer
+
+TIMESTAMP_FORMAT: str = "yyyy-MM-dd HH:mm:ss,SSS"
+
+
+def generate_text_log(path: Path, num_log_events: int, seed: int) -> None:
+    """
+    Generates a text log whose log events start with a timestamp in `TIMESTAMP_FORMAT`. Every
+    tenth log event spans multiple lines.
+
+    :param path: The path of the text log to generate.
+    :param num_log_events: The number of log events to generate.
+    :param seed: The seed of the random generator.
+    """
+    rng: random.Random = random.Random(seed)
+    lines: List[str] = []
+    for i in range(num_log_events):
+        second: int = i // 1000
+        lines.append(
+            f"2023-11-14 {second // 3600 % 24:02}:{second // 60 % 60:02}:{second % 60:02}"
+            f",{i % 1000:03} INFO [task-{rng.randint(0, 4096)}] Container"
+            f" container_{rng.randint(0, 1 << 40)} on host node-{rng.randint(0, 255)}.cluster"
+            f" finished in {rng.random() * 1000:.3f} ms\n"
+        )
+        if 0 == i % 10:
+            lines.append(f"\tat Foo.bar(Foo.java:{rng.randint(1, 1000)})\n")
+    path.write_text("".join(lines))
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--num-log-events", type=int, default=1_000_000)
+    parser.add_argument("--num-repetitions", type=int, default=5)
+    parser.add_argument("--seed", type=int, default=3190)
+    args: argparse.Namespace = parser.parse_args()
+
+    with TemporaryDirectory() as temp_dir:
+        input_path: Path = Path(temp_dir) / "input.log"
+        compressed_input_path: Path = Path(temp_dir) / "input.log.zst"
+        output_path: Path = Path(temp_dir) / "output.clp"
+        generate_text_log(input_path, args.num_log_events, args.seed)
+        compressed_input_path.write_bytes(
+            ZstdCompressor().compress(input_path.read_bytes())
+        )
+        num_input_bytes: int = input_path.stat().st_size
+
+        print(f"Log events: {args.num_log_events}, input size: {num_input_bytes / 1e6:.1f} MB")
+        # The conversion runs on a single core, so the CPU time gives the throughput per core.
+        print(f"{'input':>6} {'best time (s)':>14} {'MB/s':>10} {'MB/s per core':>14}")
+        for path, enable_zstd_decompression in [
+            (input_path, False),
+            (compressed_input_path, True),
+        ]:
+            best_duration: float = float("inf")
+            best_cpu_duration: float = float("inf")
+            for _ in range(args.num_repetitions):
+                start: float = time.perf_counter()
+                cpu_start: float = time.process_time()
+                FourByteSerializer.serialize_text_log(
+                    path,
+                    output_path,
+                    [TIMESTAMP_FORMAT],
+                    enable_zstd_decompression=enable_zstd_decompression,
+                )
+                best_cpu_duration = min(best_cpu_duration, time.process_time() - cpu_start)
+                best_duration = min(best_duration, time.perf_counter() - start)
+            print(
+                f"{'zstd' if enable_zstd_decompression else 'raw':>6} {best_duration:>14.4f}"
+                f" {num_input_bytes / 1e6 / best_duration:>10.1f}"
+                f" {num_input_bytes / 1e6 / best_cpu_duration:>14.1f}"
+            )
+
+
+if "__main__" == __name__:
+    main()
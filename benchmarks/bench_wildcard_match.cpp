@@ -0,0 +1,155 @@
+// Benchmarks matching log messages against wildcard queries with `WildcardQuery::matches`, which
+// searches for the query's longest literal first, against calling `wildcard_match_unsafe` directly.
+//
+// Usage: bench_wildcard_match [num_messages] [num_repetitions]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/string_utils/string_utils.hpp>
+
+#include <clp_ffi_py/ir/native/Query.hpp>
+
+namespace {
+using clp_ffi_py::ir::native::WildcardQuery;
+
+constexpr size_t cDefaultNumMessages{1'000'000};
+constexpr size_t cDefaultNumRepetitions{5};
+constexpr unsigned cSeed{3190};
+
+// Patterns commonly used to search Hadoop logs: a rare literal, a frequent literal, literals
+// separated by wildcards, a variable prefix, and a pattern without any literal to prefilter with.
+constexpr std::string_view cPatterns[]{
+        "*UNHEALTHY*",
+        "*INFO*",
+        "*container_*_01_000012*finished*",
+        "*node-1?.cluster*",
+        "*task-4095]*exit code 3*",
+        "*?*",
+};
+
+/**
+ * @param num_messages
+ * @return Generated log messages in the style of Hadoop's YARN logs.
+ */
+[[nodiscard]] auto generate_messages(size_t num_messages) -> std::vector<std::string>;
+
+/**
+ * Matches all the messages against the pattern repeatedly, and prints the best throughput.
+ * @tparam Matcher A callable that takes a message and returns whether it matches.
+ * @param name
+ * @param messages
+ * @param num_repetitions
+ * @param matcher
+ */
+template <typename Matcher>
+auto run_benchmark(
+        std::string_view name,
+        std::vector<std::string> const& messages,
+        size_t num_repetitions,
+        Matcher matcher
+) -> void;
+
+auto generate_messages(size_t num_messages) -> std::vector<std::string> {
+    std::mt19937_64 rng{cSeed};
+    std::vector<std::string> messages;
+    messages.reserve(num_messages);
+    for (size_t i{0}; i < num_messages; ++i) {
+        auto const task_id{rng() % 4096};
+        auto const container_id{rng() % 100'000};
+        auto const node_id{rng() % 256};
+        auto const duration_ms{rng() % 100'000};
+        auto const exit_code{rng() % 4};
+        std::string message{0 == rng() % 10 ? "WARN" : "INFO"};
+        message += " [task-" + std::to_string(task_id) + "] Container container_1427088391284_";
+        message += std::to_string(container_id) + "_01_000012 on host node-";
+        message += std::to_string(node_id) + ".cluster ";
+        message += 0 == rng() % 1000 ? "UNHEALTHY" : "finished";
+        message += " in " + std::to_string(duration_ms) + " ms with exit code ";
+        message += std::to_string(exit_code);
+        messages.emplace_back(std::move(message));
+    }
+    return messages;
+}
+
+template <typename Matcher>
+auto run_benchmark(
+        std::string_view name,
+        std::vector<std::string> const& messages,
+        size_t num_repetitions,
+        Matcher matcher
+) -> void {
+    auto best_duration{std::numeric_limits<double>::max()};
+    size_t num_matches{0};
+    for (size_t repetition{0}; repetition < num_repetitions; ++repetition) {
+        num_matches = 0;
+        auto const start{std::chrono::steady_clock::now()};
+        for (auto const& message : messages) {
+            if (matcher(std::string_view{message})) {
+                ++num_matches;
+            }
+        }
+        std::chrono::duration<double> const duration{std::chrono::steady_clock::now() - start};
+        best_duration = std::min(best_duration, duration.count());
+    }
+    std::printf(
+            "%-56.*s %10zu %14.0f\n",
+            static_cast<int>(name.size()),
+            name.data(),
+            num_matches,
+            static_cast<double>(messages.size()) / best_duration
+    );
+}
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+    size_t num_messages{cDefaultNumMessages};
+    size_t num_repetitions{cDefaultNumRepetitions};
+    if (argc > 1) {
+        num_messages = std::strtoull(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        num_repetitions = std::strtoull(argv[2], nullptr, 10);
+    }
+
+    auto const messages{generate_messages(num_messages)};
+    std::printf("%-56s %10s %14s\n", "benchmark", "matches", "messages/s");
+    for (auto const pattern : cPatterns) {
+        for (auto const case_sensitive : {true, false}) {
+            WildcardQuery const wildcard_query{std::string{pattern}, case_sensitive};
+            std::string const name_prefix{
+                    std::string{pattern} + (case_sensitive ? " (cs" : " (ci")
+            };
+            run_benchmark(
+                    name_prefix + ", prefiltered)",
+                    messages,
+                    num_repetitions,
+                    [&](std::string_view message) -> bool {
+                        return wildcard_query.matches(message);
+                    }
+            );
+            run_benchmark(
+                    name_prefix + ", plain)",
+                    messages,
+                    num_repetitions,
+                    [&](std::string_view message) -> bool {
+                        return clp::string_utils::wildcard_match_unsafe(
+                                message,
+                                pattern,
+                                case_sensitive
+                        );
+                    }
+            );
+        }
+    }
+    return 0;
+}
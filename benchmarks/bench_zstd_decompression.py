@@ -0,0 +1,59 @@
+"""
+Benchmarks reading a zstd-compressed unstructured IR stream with the native zstd decompression
+against decompressing it in Python with `zstandard`.
+"""
+
+import argparse
+import time
+from pathlib import Path
+
+from clp_ffi_py.ir import ClpIrFileReader
+
+TEST_DATA_DIR: Path = Path(__file__).resolve().parent.parent / "tests" / "test_ir" / "test_data"
+
+
+def read_log_events(ir_path: Path, enable_native_decompression: bool) -> int:
+    """
+    Reads all log events in the given zstd-compressed IR stream.
+
+    :param ir_path: The path of the compressed IR stream.
+    :param enable_native_decompression: Whether to decompress the IR stream natively.
+    :return: The number of log events read.
+    """
+    num_log_events: int = 0
+    with ClpIrFileReader(
+        ir_path, enable_native_decompression=enable_native_decompression
+    ) as reader:
+        for _ in reader:
+            num_log_events += 1
+    return num_log_events
+
+
+def main() -> None:
+    parser: argparse.ArgumentParser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--ir-path",
+        type=Path,
+        default=TEST_DATA_DIR / "unstructured_ir" / "compressed_benchmark.clp.zst",
+    )
+    parser.add_argument("--num-repetitions", type=int, default=10)
+    args: argparse.Namespace = parser.parse_args()
+
+    num_compressed_bytes: int = args.ir_path.stat().st_size
+    print(f"Compressed size: {num_compressed_bytes / 1e6:.1f} MB")
+    print(f"{'decompression':>16} {'log events/s':>16} {'compressed MB/s':>16}")
+    for name, enable_native_decompression in (("zstandard", False), ("native", True)):
+        best_duration: float = float("inf")
+        num_log_events: int = 0
+        for _ in range(args.num_repetitions):
+            start: float = time.perf_counter()
+            num_log_events = read_log_events(args.ir_path, enable_native_decompression)
+            best_duration = min(best_duration, time.perf_counter() - start)
+        print(
+            f"{name:>16} {num_log_events / best_duration:>16.0f}"
+            f" {num_compressed_bytes / best_duration / 1e6:>16.1f}"
+        )
+
+
+if "__main__" == __name__:
+    main()
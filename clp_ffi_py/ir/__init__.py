@@ -10,9 +10,12 @@ __all__: List[str] = [
     "DecoderBuffer",  # native_deprecated
     "Deserializer",  # native
     "DeserializerBuffer",  # native
+    "EightByteDeserializer",  # native
+    "EightByteSerializer",  # native
     "FourByteDeserializer",  # native
     "FourByteEncoder",  # native_deprecated
     "FourByteSerializer",  # native
+    "FourByteStreamSerializer",  # native
     "IncompleteStreamError",  # native
     "KeyValuePairLogEvent",  # native
     "LogEvent",  # native
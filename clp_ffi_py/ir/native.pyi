@@ -1,13 +1,25 @@
 from __future__ import annotations
 
+from array import array
 from datetime import tzinfo
+from mmap import mmap
+from os import PathLike
 from types import TracebackType
-from typing import Any, Dict, IO, List, Optional, Tuple, Type
+from typing import Any, Dict, IO, List, Optional, Sequence, Tuple, Type, Union
 
 from clp_ffi_py.wildcard_query import WildcardQuery
 
+_IrInput = Union[IO[bytes], str, PathLike[str], bytes, bytearray, memoryview, mmap]
+
 class DeserializerBuffer:
-    def __init__(self, input_stream: IO[bytes], initial_buffer_capacity: int = 4096): ...
+    def __init__(
+        self,
+        input_stream: _IrInput,
+        initial_buffer_capacity: int = 4096,
+        enable_zstd_decompression: bool = False,
+        num_readahead_buffers: int = 0,
+        max_buffer_capacity: Optional[int] = None,
+    ): ...
     def get_num_deserialized_log_messages(self) -> int: ...
     def _test_streaming(self, seed: int) -> bytearray: ...
 
@@ -60,6 +72,7 @@ class Query:
     def get_search_time_termination_margin(self) -> int: ...
     def get_wildcard_queries(self) -> Optional[List[WildcardQuery]]: ...
     def match_log_event(self, log_event: LogEvent) -> bool: ...
+    def get_matching_wildcard_query_indices(self, log_event: LogEvent) -> List[int]: ...
 
 class FourByteSerializer:
     @staticmethod
@@ -69,11 +82,80 @@ class FourByteSerializer:
     @staticmethod
     def serialize_message_and_timestamp_delta(timestamp_delta: int, msg: bytes) -> bytearray: ...
     @staticmethod
+    def serialize_messages_and_timestamps(
+        timestamps: Sequence[int],
+        messages: Sequence[bytes],
+        ref_timestamp: int,
+        num_threads: int = 1,
+    ) -> bytes: ...
+    @staticmethod
     def serialize_message(msg: bytes) -> bytearray: ...
     @staticmethod
     def serialize_timestamp_delta(timestamp_delta: int) -> bytearray: ...
     @staticmethod
     def serialize_end_of_ir() -> bytearray: ...
+    @staticmethod
+    def serialize_text_log(
+        input_path: Union[str, PathLike[str]],
+        output_path: Union[str, PathLike[str]],
+        timestamp_formats: Sequence[str],
+        timezone: str = "UTC",
+        enable_zstd_decompression: bool = False,
+    ) -> int: ...
+
+class FourByteStreamSerializer:
+    def __init__(
+        self,
+        output_stream: IO[bytes],
+        ref_timestamp: int,
+        timestamp_format: str,
+        timezone: str,
+        buffer_size_limit: int = 65536,
+    ): ...
+    def __enter__(self) -> FourByteStreamSerializer: ...
+    def __exit__(
+        self,
+        exc_type: Optional[Type[BaseException]],
+        exc_value: Optional[BaseException],
+        traceback: Optional[TracebackType],
+    ) -> None: ...
+    def serialize_log_event(self, timestamp: int, msg: bytes) -> int: ...
+    def get_num_bytes_serialized(self) -> int: ...
+    def flush(self) -> None: ...
+    def close(self) -> None: ...
+
+class EightByteSerializer:
+    @staticmethod
+    def serialize_preamble(timestamp_format: str, timezone: str) -> bytearray: ...
+    @staticmethod
+    def serialize_message_and_timestamp(timestamp: int, msg: bytes) -> bytearray: ...
+    @staticmethod
+    def serialize_end_of_ir() -> bytearray: ...
+
+class EightByteDeserializer:
+    @staticmethod
+    def deserialize_preamble(decoder_buffer: DeserializerBuffer) -> Metadata: ...
+    @staticmethod
+    def deserialize_next_log_event(
+        deserializer_buffer: DeserializerBuffer,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> Optional[LogEvent]: ...
+    @staticmethod
+    def deserialize_next_log_events(
+        deserializer_buffer: DeserializerBuffer,
+        max_events: int,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> List[LogEvent]: ...
+    @staticmethod
+    def dump(
+        deserializer_buffer: DeserializerBuffer,
+        output: Union[IO[bytes], int],
+        timezone: Optional[tzinfo] = None,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> int: ...
 
 class FourByteDeserializer:
     @staticmethod
@@ -84,6 +166,58 @@ class FourByteDeserializer:
         query: Optional[Query] = None,
         allow_incomplete_stream: bool = False,
     ) -> Optional[LogEvent]: ...
+    @staticmethod
+    def deserialize_next_log_events(
+        deserializer_buffer: DeserializerBuffer,
+        max_events: int,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> List[LogEvent]: ...
+    @staticmethod
+    def count_matches(
+        deserializer_buffer: DeserializerBuffer,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> int: ...
+    @staticmethod
+    def find_match_indices(
+        deserializer_buffer: DeserializerBuffer,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> array[int]: ...
+    @staticmethod
+    def histogram(
+        deserializer_buffer: DeserializerBuffer,
+        bucket_ms: int,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> Tuple[array[int], array[int]]: ...
+    @staticmethod
+    def scan_timestamps(
+        deserializer_buffer: DeserializerBuffer,
+        index_interval: int = 0,
+        allow_incomplete_stream: bool = False,
+    ) -> Tuple[
+        Optional[int],
+        Optional[int],
+        int,
+        Optional[Tuple[array[int], array[int], array[int]]],
+    ]: ...
+    @staticmethod
+    def dump(
+        deserializer_buffer: DeserializerBuffer,
+        output: Union[IO[bytes], int],
+        timezone: Optional[tzinfo] = None,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> int: ...
+    @staticmethod
+    def filter_ir_stream(
+        deserializer_buffer: DeserializerBuffer,
+        output_stream: IO[bytes],
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> int: ...
 
 class KeyValuePairLogEvent:
     def __init__(self, auto_gen_kv_pairs: Dict[Any, Any], user_gen_kv_pairs: Dict[Any, Any]): ...
@@ -97,6 +231,7 @@ class Serializer:
         output_stream: IO[bytes],
         buffer_size_limit: int = 65536,
         user_defined_metadata: Optional[Dict[str, Any]] = None,
+        encoding: str = "four_byte",
     ): ...
     def __enter__(self) -> Serializer: ...
     def __exit__(
@@ -115,11 +250,31 @@ class Serializer:
 class Deserializer:
     def __init__(
         self,
-        input_stream: IO[bytes],
+        input_stream: _IrInput,
         buffer_capacity: int = 65536,
         allow_incomplete_stream: bool = False,
+        enable_zstd_decompression: bool = False,
+        num_readahead_buffers: int = 0,
     ): ...
     def deserialize_log_event(self) -> Optional[KeyValuePairLogEvent]: ...
     def get_user_defined_metadata(self) -> Optional[Dict[str, Any]]: ...
+    @staticmethod
+    def scan_stats(
+        input_stream: _IrInput,
+        buffer_capacity: int = 65536,
+        allow_incomplete_stream: bool = False,
+        enable_zstd_decompression: bool = False,
+        num_readahead_buffers: int = 0,
+    ) -> Dict[str, Any]: ...
+    @staticmethod
+    def filter_ir_stream(
+        input_stream: _IrInput,
+        output_stream: IO[bytes],
+        query: Optional[Query] = None,
+        buffer_capacity: int = 65536,
+        allow_incomplete_stream: bool = False,
+        enable_zstd_decompression: bool = False,
+        num_readahead_buffers: int = 0,
+    ) -> int: ...
 
 class IncompleteStreamError(Exception): ...
@@ -1,14 +1,58 @@
 from __future__ import annotations
 
+import codecs
+import os
+from datetime import tzinfo
+from io import RawIOBase, TextIOBase
 from pathlib import Path
 from sys import stderr
 from types import TracebackType
-from typing import Generator, IO, Iterator, Optional, Type, Union
+from typing import cast, Generator, IO, Iterator, List, Optional, Type, Union
 from warnings import warn
 
 from zstandard import ZstdDecompressionReader, ZstdDecompressor
 
-from clp_ffi_py.ir.native import DeserializerBuffer, FourByteDeserializer, LogEvent, Metadata, Query
+from clp_ffi_py.ir.native import (
+    DeserializerBuffer,
+    EightByteDeserializer,
+    FourByteDeserializer,
+    LogEvent,
+    Metadata,
+    Query,
+)
+
+
+class _TextStreamByteWriter(RawIOBase):
+    """
+    A byte stream that decodes the UTF-8 bytes written into it and forwards the decoded text to a
+    text stream, so that the text is written in chunks as large as each write.
+
+    :param text_stream: The text stream to forward the decoded text to.
+    """
+
+    def __init__(self, text_stream: IO[str]):
+        super().__init__()
+        self._text_stream: IO[str] = text_stream
+        # A chunk may end in the middle of a multi-byte character, which is kept until the next
+        # chunk is written.
+        self._decoder: codecs.IncrementalDecoder = codecs.getincrementaldecoder("utf-8")(
+            errors="replace"
+        )
+
+    # override
+    def writable(self) -> bool:
+        return True
+
+    # override
+    def write(self, data: Union[bytes, memoryview]) -> int:  # type: ignore[override]
+        self._text_stream.write(self._decoder.decode(data))
+        return len(data)
+
+    # override
+    def flush(self) -> None:
+        remaining_text: str = self._decoder.decode(b"", final=True)
+        if "" != remaining_text:
+            self._text_stream.write(remaining_text)
 
 
 class ClpIrStreamReader(Iterator[LogEvent]):
@@ -25,10 +69,18 @@ class ClpIrStreamReader(Iterator[LogEvent]):
     :param decoder_buffer_size: Deprecated since 0.0.13. Use `deserializer_buffer_size` instead.
         This argument is provided for backward compatibility and if set, will overwrite
         `deserializer_buffer_size`'s value.
+    :param enable_native_decompression: If set to `True` and `enable_compression` is set, the
+        istream is decompressed natively with the GIL released, instead of using
+        `zstandard.ZstdDecompressor`.
+    :param max_deserializer_buffer_size: The maximum size that the deserializer buffer can grow to
+        when buffering a large log event. If `None`, the size is unbounded.
+    :param log_event_batch_size: The maximum number of log events deserialized per native call
+        when iterating the stream.
     """
 
     DEFAULT_DESERIALIZER_BUFFER_SIZE: int = 65536
     DEFAULT_DECODER_BUFFER_SIZE: int = DEFAULT_DESERIALIZER_BUFFER_SIZE
+    DEFAULT_LOG_EVENT_BATCH_SIZE: int = 256
 
     def __init__(
         self,
@@ -37,6 +89,9 @@ class ClpIrStreamReader(Iterator[LogEvent]):
         enable_compression: bool = True,
         allow_incomplete_stream: bool = False,
         decoder_buffer_size: Optional[int] = None,
+        enable_native_decompression: bool = False,
+        max_deserializer_buffer_size: Optional[int] = None,
+        log_event_batch_size: int = DEFAULT_LOG_EVENT_BATCH_SIZE,
     ):
         if decoder_buffer_size is not None:
             deserializer_buffer_size = decoder_buffer_size
@@ -48,16 +103,28 @@ class ClpIrStreamReader(Iterator[LogEvent]):
             )
 
         self.__istream: Union[IO[bytes], ZstdDecompressionReader]
-        if enable_compression:
+        enable_zstd_decompression: bool = enable_compression and enable_native_decompression
+        if enable_compression and not enable_native_decompression:
             dctx: ZstdDecompressor = ZstdDecompressor()
             self.__istream = dctx.stream_reader(istream, read_across_frames=True)
         else:
             self.__istream = istream
         self._deserializer_buffer: DeserializerBuffer = DeserializerBuffer(
-            self.__istream, deserializer_buffer_size
+            self.__istream,
+            deserializer_buffer_size,
+            enable_zstd_decompression=enable_zstd_decompression,
+            max_buffer_capacity=max_deserializer_buffer_size,
         )
         self._metadata: Optional[Metadata] = None
+        # The deserializer matching the encoding of the stream, which is known once the preamble is
+        # deserialized.
+        self._deserializer: Union[Type[FourByteDeserializer], Type[EightByteDeserializer]] = (
+            FourByteDeserializer
+        )
         self._allow_incomplete_stream: bool = allow_incomplete_stream
+        self._log_event_batch_size: int = log_event_batch_size
+        # Log events deserialized in the current batch but not yet returned.
+        self._log_event_batch: Iterator[LogEvent] = iter([])
 
     def read_next_log_event(self) -> Optional[LogEvent]:
         """
@@ -67,11 +134,19 @@ class ClpIrStreamReader(Iterator[LogEvent]):
             - Next unread log event represented as an instance of LogEvent.
             - None if the end of IR stream is reached.
         :raise Exception:
-            If :meth:`~clp_ffi_py.ir.native.FourByteDeserializer.deserialize_next_log_event` fails.
+            If :meth:`~clp_ffi_py.ir.native.FourByteDeserializer.deserialize_next_log_events` fails.
         """
-        return FourByteDeserializer.deserialize_next_log_event(
-            self._deserializer_buffer, allow_incomplete_stream=self._allow_incomplete_stream
+        log_event: Optional[LogEvent] = next(self._log_event_batch, None)
+        if None is not log_event:
+            return log_event
+        self._log_event_batch = iter(
+            self._deserializer.deserialize_next_log_events(
+                self._deserializer_buffer,
+                self._log_event_batch_size,
+                allow_incomplete_stream=self._allow_incomplete_stream,
+            )
         )
+        return next(self._log_event_batch, None)
 
     def read_preamble(self) -> None:
         """
@@ -85,6 +160,8 @@ class ClpIrStreamReader(Iterator[LogEvent]):
         if self.has_metadata():
             return
         self._metadata = FourByteDeserializer.deserialize_preamble(self._deserializer_buffer)
+        if not self._metadata.is_using_four_byte_encoding():
+            self._deserializer = EightByteDeserializer
 
     def get_metadata(self) -> Metadata:
         if None is self._metadata:
@@ -104,8 +181,13 @@ class ClpIrStreamReader(Iterator[LogEvent]):
         """
         if False is self.has_metadata():
             self.read_preamble()
+        # Log events left in the current batch have already been consumed from the stream.
+        for pending_log_event in self._log_event_batch:
+            if query.match_log_event(pending_log_event):
+                yield pending_log_event
+        # A search is not batched, since a short batch can't tell whether the search has terminated.
         while True:
-            log_event: Optional[LogEvent] = FourByteDeserializer.deserialize_next_log_event(
+            log_event: Optional[LogEvent] = self._deserializer.deserialize_next_log_event(
                 self._deserializer_buffer,
                 query=query,
                 allow_incomplete_stream=self._allow_incomplete_stream,
@@ -114,6 +196,74 @@ class ClpIrStreamReader(Iterator[LogEvent]):
                 break
             yield log_event
 
+    def dump(
+        self,
+        ostream: Union[IO[str], IO[bytes], int] = stderr,
+        timezone: Optional[tzinfo] = None,
+        query: Optional[Query] = None,
+    ) -> int:
+        """
+        Writes the remaining log events into the given output as text, in the same format as
+        `str(log_event)`. The log events are deserialized, formatted, and written natively in large
+        chunks with the GIL released, without creating any LogEvent instance.
+
+        :param ostream: A text output stream, a byte output stream, or a file descriptor. Text is
+            written into byte output streams and file descriptors encoded in UTF-8.
+        :param timezone: Timezone of the formatted timestamps. If None is given, the timezone of
+            the IR stream is used.
+        :param query: If given, only the log events that match this query are written. Check the
+            document of :class:`~clp_ffi_py.ir.Query` for more details.
+        :return: The number of log events written.
+        """
+        if False is self.has_metadata():
+            self.read_preamble()
+        # Log events left in the current batch have already been consumed from the stream.
+        pending_log_events: List[LogEvent] = [
+            log_event
+            for log_event in self._log_event_batch
+            if query is None or query.match_log_event(log_event)
+        ]
+        pending_text: str = "".join(
+            log_event.get_formatted_message(timezone) for log_event in pending_log_events
+        )
+
+        output: Union[IO[bytes], int]
+        text_stream_writer: Optional[_TextStreamByteWriter] = None
+        if isinstance(ostream, int):
+            output = ostream
+            pending_bytes: memoryview = memoryview(pending_text.encode())
+            while len(pending_bytes) > 0:
+                pending_bytes = pending_bytes[os.write(ostream, pending_bytes) :]
+        elif isinstance(ostream, TextIOBase):
+            ostream.write(pending_text)
+            buffer: Optional[IO[bytes]] = getattr(ostream, "buffer", None)
+            encoding: Optional[str] = getattr(ostream, "encoding", None)
+            if (
+                buffer is not None
+                and encoding is not None
+                and "utf-8" == codecs.lookup(encoding).name
+            ):
+                # Write into the underlying byte stream directly, after the text written so far.
+                ostream.flush()
+                output = buffer
+            else:
+                text_stream_writer = _TextStreamByteWriter(ostream)
+                output = cast(IO[bytes], text_stream_writer)
+        else:
+            output = ostream
+            output.write(pending_text.encode())
+
+        num_log_events_written: int = len(pending_log_events) + self._deserializer.dump(
+            self._deserializer_buffer,
+            output,
+            timezone,
+            query,
+            allow_incomplete_stream=self._allow_incomplete_stream,
+        )
+        if text_stream_writer is not None:
+            text_stream_writer.flush()
+        return num_log_events_written
+
     def close(self) -> None:
         self.__istream.close()
 
@@ -154,6 +304,9 @@ class ClpIrFileReader(ClpIrStreamReader):
         enable_compression: bool = True,
         allow_incomplete_stream: bool = False,
         decoder_buffer_size: Optional[int] = None,
+        enable_native_decompression: bool = False,
+        max_deserializer_buffer_size: Optional[int] = None,
+        log_event_batch_size: int = ClpIrStreamReader.DEFAULT_LOG_EVENT_BATCH_SIZE,
     ):
         if decoder_buffer_size is not None:
             deserializer_buffer_size = decoder_buffer_size
@@ -169,8 +322,7 @@ class ClpIrFileReader(ClpIrStreamReader):
             deserializer_buffer_size=deserializer_buffer_size,
             enable_compression=enable_compression,
             allow_incomplete_stream=allow_incomplete_stream,
+            enable_native_decompression=enable_native_decompression,
+            max_deserializer_buffer_size=max_deserializer_buffer_size,
+            log_event_batch_size=log_event_batch_size,
         )
-
-    def dump(self, ostream: IO[str] = stderr) -> None:
-        for log_event in self:
-            ostream.write(str(log_event))
@@ -1,6 +1,8 @@
 import json
-from datetime import datetime, tzinfo
-from typing import Any, Dict, Optional
+import mmap
+import os
+from datetime import datetime, timedelta, tzinfo
+from typing import Any, Dict, Optional, Union
 
 import dateutil.tz
 import msgpack
@@ -21,6 +23,23 @@ def get_formatted_timestamp(timestamp: int, timezone: Optional[tzinfo]) -> str:
     return dt.isoformat(sep=" ", timespec="milliseconds")
 
 
+def get_utc_offset(timestamp: int, timezone: Optional[tzinfo]) -> int:
+    """
+    Gets the UTC offset of the provided timezone at the provided timestamp.
+
+    :param timestamp: Timestamp to get the UTC offset at.
+    :param timezone: Timezone to get the UTC offset of. If None is given, UTC is used by default.
+    :return: The UTC offset in seconds.
+    """
+    if timezone is None:
+        timezone = dateutil.tz.UTC
+    dt: datetime = datetime.fromtimestamp(timestamp / 1000, timezone)
+    utc_offset: Optional[timedelta] = dt.utcoffset()
+    if utc_offset is None:
+        return 0
+    return int(utc_offset.total_seconds())
+
+
 def get_timezone_from_timezone_id(timezone_id: str) -> tzinfo:
     """
     Gets the Python timezone object of the provided timezone id.
@@ -69,3 +88,17 @@ def parse_json_str(json_str: str) -> Any:
     :return: The parsed JSON object.
     """
     return json.loads(json_str)
+
+
+def mmap_file(path: Union[str, "os.PathLike[str]"]) -> Union[mmap.mmap, bytes]:
+    """
+    Memory-maps the given file as read-only.
+
+    :param path: Path of the file to map.
+    :return: The read-only memory map of the file, or an empty `bytes` object if the file is empty,
+        since an empty file cannot be memory-mapped.
+    """
+    with open(path, "rb") as f:
+        if 0 == os.fstat(f.fileno()).st_size:
+            return b""
+        return mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
@@ -75,6 +75,31 @@ private:
     // Variables
     PyExceptionContext m_exception_context;
 };
+
+/**
+ * A guard class that releases the GIL upon initialization and reacquires it upon destruction, so
+ * that other Python threads can run while the guarded scope executes pure native code.
+ * NOTE: The GIL must be held when the guard is created, and no Python object or CPython API may be
+ * accessed within the guarded scope.
+ */
+class PyGilReleaseGuard {
+public:
+    // Constructor
+    PyGilReleaseGuard() : m_thread_state{PyEval_SaveThread()} {}
+
+    // Destructor
+    ~PyGilReleaseGuard() { PyEval_RestoreThread(m_thread_state); }
+
+    // Delete copy/move constructor and assignment
+    PyGilReleaseGuard(PyGilReleaseGuard const&) = delete;
+    PyGilReleaseGuard(PyGilReleaseGuard&&) = delete;
+    auto operator=(PyGilReleaseGuard const&) -> PyGilReleaseGuard& = delete;
+    auto operator=(PyGilReleaseGuard&&) -> PyGilReleaseGuard& = delete;
+
+private:
+    // Variables
+    PyThreadState* m_thread_state;
+};
 }  // namespace clp_ffi_py
 
 #endif  // CLP_FFI_PY_PY_OBJECT_UTILS_HPP
@@ -13,18 +13,20 @@
 
 namespace clp_ffi_py {
 namespace {
-constexpr std::string_view cPyFuncNameGetFormattedTimestamp{"get_formatted_timestamp"};
+constexpr std::string_view cPyFuncNameGetUtcOffset{"get_utc_offset"};
 constexpr std::string_view cPyFuncNameGetTimezoneFromTimezoneId{"get_timezone_from_timezone_id"};
 constexpr std::string_view cPyFuncNameSerializeDictToMsgpack{"serialize_dict_to_msgpack"};
 constexpr std::string_view cPyFuncNameSerializeDictToJsonStr{"serialize_dict_to_json_str"};
 constexpr std::string_view cPyFuncNameParseJsonStr{"parse_json_str"};
+constexpr std::string_view cPyFuncNameMmapFile{"mmap_file"};
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
-PyObjectStaticPtr<PyObject> Py_func_get_formatted_timestamp{nullptr};
+PyObjectStaticPtr<PyObject> Py_func_get_utc_offset{nullptr};
 PyObjectStaticPtr<PyObject> Py_func_get_timezone_from_timezone_id{nullptr};
 PyObjectStaticPtr<PyObject> Py_func_serialize_dict_to_msgpack{nullptr};
 PyObjectStaticPtr<PyObject> Py_func_serialize_dict_to_json_str{nullptr};
 PyObjectStaticPtr<PyObject> Py_func_parse_json_str{nullptr};
+PyObjectStaticPtr<PyObject> Py_func_mmap_file{nullptr};
 
 // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
 
@@ -54,11 +56,11 @@ auto py_utils_init() -> bool {
         return false;
     }
 
-    Py_func_get_formatted_timestamp.reset(PyObject_GetAttrString(
+    Py_func_get_utc_offset.reset(PyObject_GetAttrString(
             py_utils,
-            get_c_str_from_constexpr_string_view(cPyFuncNameGetFormattedTimestamp)
+            get_c_str_from_constexpr_string_view(cPyFuncNameGetUtcOffset)
     ));
-    if (nullptr == Py_func_get_formatted_timestamp.get()) {
+    if (nullptr == Py_func_get_utc_offset.get()) {
         return false;
     }
 
@@ -86,17 +88,25 @@ auto py_utils_init() -> bool {
         return false;
     }
 
+    Py_func_mmap_file.reset(PyObject_GetAttrString(
+            py_utils,
+            get_c_str_from_constexpr_string_view(cPyFuncNameMmapFile)
+    ));
+    if (nullptr == Py_func_mmap_file.get()) {
+        return false;
+    }
+
     return true;
 }
 
-auto py_utils_get_formatted_timestamp(clp::ir::epoch_time_ms_t timestamp, PyObject* timezone)
+auto py_utils_get_utc_offset(clp::ir::epoch_time_ms_t timestamp, PyObject* timezone)
         -> PyObject* {
     PyObjectPtr<PyObject> const func_args_ptr{Py_BuildValue("LO", timestamp, timezone)};
     auto* func_args{func_args_ptr.get()};
     if (nullptr == func_args) {
         return nullptr;
     }
-    return py_utils_function_call_wrapper(Py_func_get_formatted_timestamp.get(), func_args);
+    return py_utils_function_call_wrapper(Py_func_get_utc_offset.get(), func_args);
 }
 
 auto py_utils_get_timezone_from_timezone_id(std::string const& timezone_id) -> PyObject* {
@@ -167,4 +177,13 @@ auto py_utils_parse_json_str(std::string_view json_str) -> PyObject* {
     }
     return py_utils_function_call_wrapper(Py_func_parse_json_str.get(), func_args);
 }
+
+auto py_utils_mmap_file(PyObject* path) -> PyObject* {
+    PyObjectPtr<PyObject> const func_args_ptr{Py_BuildValue("(O)", path)};
+    auto* func_args{func_args_ptr.get()};
+    if (nullptr == func_args) {
+        return nullptr;
+    }
+    return py_utils_function_call_wrapper(Py_func_mmap_file.get(), func_args);
+}
 }  // namespace clp_ffi_py
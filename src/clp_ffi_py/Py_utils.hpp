@@ -18,14 +18,13 @@ namespace clp_ffi_py {
 [[nodiscard]] auto py_utils_init() -> bool;
 
 /**
- * CPython wrapper of `clp_ffi_py.utils.get_formatted_timestamp`.
+ * CPython wrapper of `clp_ffi_py.utils.get_utc_offset`.
  * @param timestamp
  * @param tzinfo Python tzinfo object that specifies timezone information.
- * @return a new reference of a PyObject string that stores the formatted timestamp.
+ * @return a new reference of a PyObject int that stores the UTC offset in seconds.
  * @return nullptr on failure with the relevant Python exception and error set.
  */
-[[nodiscard]] auto
-py_utils_get_formatted_timestamp(clp::ir::epoch_time_ms_t timestamp, PyObject* timezone)
+[[nodiscard]] auto py_utils_get_utc_offset(clp::ir::epoch_time_ms_t timestamp, PyObject* timezone)
         -> PyObject*;
 
 /**
@@ -61,6 +60,15 @@ py_utils_get_formatted_timestamp(clp::ir::epoch_time_ms_t timestamp, PyObject* t
  * @return nullptr on failure with the relevant Python exception and error set.
  */
 [[nodiscard]] auto py_utils_parse_json_str(std::string_view json_str) -> PyObject*;
+
+/**
+ * CPython wrapper of `clp_ffi_py.utils.mmap_file`.
+ * @param path A Python `str` or path-like object.
+ * @return a new reference of a Python object that exposes the file content through the buffer
+ * protocol.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto py_utils_mmap_file(PyObject* path) -> PyObject*;
 }  // namespace clp_ffi_py
 
 #endif  // CLP_FFI_PY_PY_UTILS_HPP
@@ -10,9 +10,6 @@ constexpr std::string_view cSetstateInputError{
         "Python dictionary is expected to be the input of __setstate__ method."
 };
 constexpr std::string_view cSetstateKeyErrorTemplate{"\"%s\" not found in the state dictionary."};
-constexpr std::string_view cTimezoneObjectNotInitialized{
-        "Timezone (tzinfo) object is not yet initialized."
-};
 }  // namespace clp_ffi_py
 
 #endif  // CLP_FFI_PY_ERROR_MESSAGES
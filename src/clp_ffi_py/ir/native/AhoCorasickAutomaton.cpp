@@ -0,0 +1,94 @@
+#include "AhoCorasickAutomaton.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <queue>
+#include <string_view>
+#include <vector>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * @param c
+ * @return The given character converted to lowercase.
+ */
+[[nodiscard]] auto to_lower(char c) -> char;
+
+auto to_lower(char c) -> char {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+}  // namespace
+
+auto AhoCorasickAutomaton::add_literal(std::string_view literal, size_t literal_id) -> void {
+    node_id_t node_id{cRootId};
+    for (auto const c : literal) {
+        auto const lowercase_c{to_lower(c)};
+        auto child_id{get_child(node_id, lowercase_c)};
+        if (cRootId == child_id) {
+            child_id = static_cast<node_id_t>(m_nodes.size());
+            m_nodes[node_id].children.emplace_back(lowercase_c, child_id);
+            m_nodes.emplace_back();
+        }
+        node_id = child_id;
+    }
+    m_nodes[node_id].literal_ids.push_back(literal_id);
+}
+
+auto AhoCorasickAutomaton::build() -> void {
+    // Nodes are visited in breadth-first order, so that the failure link of each node, which points
+    // to a shallower node, is already complete when the node is visited.
+    std::queue<node_id_t> node_ids;
+    for (auto const& [c, child_id] : m_nodes[cRootId].children) {
+        m_nodes[child_id].failure_link = cRootId;
+        node_ids.push(child_id);
+    }
+    while (false == node_ids.empty()) {
+        auto const node_id{node_ids.front()};
+        node_ids.pop();
+        for (auto const& [c, child_id] : m_nodes[node_id].children) {
+            auto const failure_link{get_next(m_nodes[node_id].failure_link, c)};
+            auto& child{m_nodes[child_id]};
+            child.failure_link = failure_link;
+            auto const& inherited_literal_ids{m_nodes[failure_link].literal_ids};
+            child.literal_ids.insert(
+                    child.literal_ids.end(),
+                    inherited_literal_ids.begin(),
+                    inherited_literal_ids.end()
+            );
+            node_ids.push(child_id);
+        }
+    }
+}
+
+auto AhoCorasickAutomaton::find(std::string_view str, std::vector<bool>& is_literal_found) const
+        -> void {
+    node_id_t node_id{cRootId};
+    for (auto const c : str) {
+        node_id = get_next(node_id, to_lower(c));
+        for (auto const literal_id : m_nodes[node_id].literal_ids) {
+            is_literal_found[literal_id] = true;
+        }
+    }
+}
+
+auto AhoCorasickAutomaton::get_child(node_id_t node_id, char c) const -> node_id_t {
+    for (auto const& [child_c, child_id] : m_nodes[node_id].children) {
+        if (child_c == c) {
+            return child_id;
+        }
+    }
+    return cRootId;
+}
+
+auto AhoCorasickAutomaton::get_next(node_id_t node_id, char c) const -> node_id_t {
+    while (true) {
+        if (auto const child_id{get_child(node_id, c)}; cRootId != child_id) {
+            return child_id;
+        }
+        if (cRootId == node_id) {
+            return cRootId;
+        }
+        node_id = m_nodes[node_id].failure_link;
+    }
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,84 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_AHOCORASICKAUTOMATON_HPP
+#define CLP_FFI_PY_IR_NATIVE_AHOCORASICKAUTOMATON_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class implements an Aho-Corasick automaton that finds all the occurrences of a set of
+ * literals in a string in a single pass, regardless of the number of literals. Literals are matched
+ * case-insensitively: they're converted to lowercase when added, and so is every character of the
+ * searched string.
+ */
+class AhoCorasickAutomaton {
+public:
+    // Constructor
+    AhoCorasickAutomaton() : m_nodes(1) {}
+
+    // Default copy & move constructors and assignment operators
+    AhoCorasickAutomaton(AhoCorasickAutomaton const&) = default;
+    AhoCorasickAutomaton(AhoCorasickAutomaton&&) = default;
+    auto operator=(AhoCorasickAutomaton const&) -> AhoCorasickAutomaton& = default;
+    auto operator=(AhoCorasickAutomaton&&) -> AhoCorasickAutomaton& = default;
+
+    // Destructor
+    ~AhoCorasickAutomaton() = default;
+
+    // Methods
+    /**
+     * Adds a literal to find. Must be called before `build`.
+     * @param literal A non-empty literal.
+     * @param literal_id The ID reported when the literal is found.
+     */
+    auto add_literal(std::string_view literal, size_t literal_id) -> void;
+
+    /**
+     * Builds the failure links and the outputs of the automaton after all the literals are added.
+     */
+    auto build() -> void;
+
+    /**
+     * Finds all the literals that occur in the given string.
+     * @param str
+     * @param is_literal_found Returns whether each literal occurs, indexed by literal ID. Must be
+     * large enough to hold every added literal ID, and is only set for the literals found.
+     */
+    auto find(std::string_view str, std::vector<bool>& is_literal_found) const -> void;
+
+private:
+    // Types
+    using node_id_t = uint32_t;
+
+    struct Node {
+        std::vector<std::pair<char, node_id_t>> children;
+        node_id_t failure_link{0};
+        // IDs of the literals that end at this node, including the ones of its failure links.
+        std::vector<size_t> literal_ids;
+    };
+
+    static constexpr node_id_t cRootId{0};
+
+    /**
+     * @param node_id
+     * @param c
+     * @return The ID of the child of the given node along the given character, if any.
+     * @return cRootId otherwise.
+     */
+    [[nodiscard]] auto get_child(node_id_t node_id, char c) const -> node_id_t;
+
+    /**
+     * @param node_id
+     * @param c
+     * @return The ID of the node reached from the given node when reading the given character.
+     */
+    [[nodiscard]] auto get_next(node_id_t node_id, char c) const -> node_id_t;
+
+    std::vector<Node> m_nodes;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_AHOCORASICKAUTOMATON_HPP
@@ -0,0 +1,83 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "BufferViewReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/type_utils.hpp>
+#include <gsl/gsl>
+
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/Py_utils.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto BufferViewReader::create(PyObject* input) -> gsl::owner<BufferViewReader*> {
+    PyObjectPtr<PyObject> mapped_file;
+    if (false == static_cast<bool>(PyObject_CheckBuffer(input))) {
+        // The input is a path: memory-map the file so that it can be accessed in place.
+        PyObjectPtr<PyObject> const path{PyOS_FSPath(input)};
+        if (nullptr == path) {
+            return nullptr;
+        }
+        mapped_file.reset(py_utils_mmap_file(path.get()));
+        if (nullptr == mapped_file) {
+            return nullptr;
+        }
+        input = mapped_file.get();
+    }
+
+    // `PyObject_GetBuffer` holds a reference of the exporting object, which keeps the memory region
+    // valid until the buffer is released.
+    Py_buffer py_buffer{};
+    if (0 != PyObject_GetBuffer(input, &py_buffer, PyBUF_SIMPLE)) {
+        return nullptr;
+    }
+    gsl::owner<BufferViewReader*> reader{new (std::nothrow) BufferViewReader{py_buffer}};
+    if (nullptr == reader) {
+        PyBuffer_Release(&py_buffer);
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cOutOfMemoryError)
+        );
+        return nullptr;
+    }
+    return reader;
+}
+
+auto BufferViewReader::is_supported_input(PyObject* input) -> bool {
+    return static_cast<bool>(PyObject_CheckBuffer(input))
+           || static_cast<bool>(PyUnicode_Check(input))
+           || static_cast<bool>(PyObject_HasAttrString(input, "__fspath__"));
+}
+
+auto BufferViewReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    auto const remaining_bytes{m_view.subspan(m_pos)};
+    if (remaining_bytes.empty()) {
+        num_bytes_read = 0;
+        return clp::ErrorCode_EndOfFile;
+    }
+    num_bytes_read = std::min(remaining_bytes.size(), num_bytes_to_read);
+    std::copy_n(
+            remaining_bytes.begin(),
+            num_bytes_read,
+            clp::size_checked_pointer_cast<int8_t>(buf)
+    );
+    m_pos += num_bytes_read;
+    return clp::ErrorCode_Success;
+}
+
+auto BufferViewReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    if (pos > m_view.size()) {
+        return clp::ErrorCode_OutOfBounds;
+    }
+    m_pos = pos;
+    return clp::ErrorCode_Success;
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,107 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_BUFFERVIEWREADER_HPP
+#define CLP_FFI_PY_IR_NATIVE_BUFFERVIEWREADER_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <gsl/gsl>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class implements `clp::ReaderInterface` to consume data from a contiguous memory region
+ * exposed by a Python object through the buffer protocol, such as `bytes` or `mmap.mmap`.
+ * The memory region is accessed in place: reading from it requires neither buffering nor any
+ * interaction with the Python interpreter. Therefore, the read methods can be called without
+ * holding the GIL.
+ */
+class BufferViewReader : public clp::ReaderInterface {
+public:
+    // Factory function
+    /**
+     * Creates a reader with the given input object.
+     * @param input An object supported by `is_supported_input`. If it's a path, the file will be
+     * memory-mapped as read-only.
+     * @return The transferred ownership of a created object on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto create(PyObject* input) -> gsl::owner<BufferViewReader*>;
+
+    /**
+     * @param input
+     * @return Whether the given input can be read by this class, i.e., whether it's a `str` or a
+     * path-like object, or an object that supports the buffer protocol.
+     */
+    [[nodiscard]] static auto is_supported_input(PyObject* input) -> bool;
+
+    // Delete copy & move constructors and assignment operators
+    BufferViewReader(BufferViewReader const&) = delete;
+    BufferViewReader(BufferViewReader&&) = delete;
+    auto operator=(BufferViewReader const&) -> BufferViewReader& = delete;
+    auto operator=(BufferViewReader&&) -> BufferViewReader& = delete;
+
+    // Destructor
+    /**
+     * Releases the underlying Python buffer. Must be called with the GIL held.
+     */
+    ~BufferViewReader() override { PyBuffer_Release(&m_py_buffer); }
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of bytes from the memory region.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_EndOfFile if there is no more data to read.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the memory region.
+     * @param pos
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_OutOfBounds if the given position is beyond the end of the memory region.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the read head in the memory region.
+     * @return ErrorCode_Success always.
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode_Success;
+    }
+
+    // Methods
+    /**
+     * @return A view of the entire memory region.
+     */
+    [[nodiscard]] auto get_view() const -> std::span<int8_t const> { return m_view; }
+
+private:
+    // Constructor
+    /**
+     * Constructs a `BufferViewReader` by taking the ownership of the given Python buffer. Must be
+     * called from the factory function.
+     * @param py_buffer
+     */
+    explicit BufferViewReader(Py_buffer const& py_buffer)
+            : m_py_buffer{py_buffer},
+              m_view{static_cast<int8_t const*>(py_buffer.buf),
+                     static_cast<size_t>(py_buffer.len)} {}
+
+    // Variables
+    Py_buffer m_py_buffer;
+    std::span<int8_t const> m_view;
+    size_t m_pos{0};
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_BUFFERVIEWREADER_HPP
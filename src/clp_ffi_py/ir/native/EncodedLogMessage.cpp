@@ -0,0 +1,34 @@
+#include "EncodedLogMessage.hpp"
+
+#include <string>
+
+#include <clp/BufferReader.hpp>
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/type_utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto EncodedLogMessage::decode(std::string& log_message) const
+        -> clp::ffi::ir_stream::IRErrorCode {
+    clp::BufferReader reader{
+            clp::size_checked_pointer_cast<char const>(m_encoded_log_event.data()),
+            m_encoded_log_event.size()
+    };
+    // The timestamp has been deserialized along with the log event already.
+    clp::ir::epoch_time_ms_t timestamp_or_timestamp_delta{0};
+    if (m_is_four_byte_encoded) {
+        return clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event(
+                reader,
+                m_tag,
+                log_message,
+                timestamp_or_timestamp_delta
+        );
+    }
+    return clp::ffi::ir_stream::eight_byte_encoding::deserialize_log_event(
+            reader,
+            m_tag,
+            log_message,
+            timestamp_or_timestamp_delta
+    );
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,51 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_ENCODEDLOGMESSAGE_HPP
+#define CLP_FFI_PY_IR_NATIVE_ENCODEDLOGMESSAGE_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A class that holds the log message of a deserialized IR log event in its encoded form, i.e., the
+ * bytes of the encoded variables and the logtype as they appear in the IR stream, so that the log
+ * message is only decoded once it's requested.
+ */
+class EncodedLogMessage {
+public:
+    // Constructor
+    /**
+     * @param tag The first tag of the encoded log event.
+     * @param encoded_log_event The encoded log event, starting right after its first tag.
+     * @param is_four_byte_encoded Whether the log event is four-byte encoded instead of eight-byte
+     * encoded.
+     */
+    EncodedLogMessage(
+            clp::ffi::ir_stream::encoded_tag_t tag,
+            std::span<int8_t const> encoded_log_event,
+            bool is_four_byte_encoded
+    )
+            : m_tag{tag},
+              m_encoded_log_event{encoded_log_event.begin(), encoded_log_event.end()},
+              m_is_four_byte_encoded{is_four_byte_encoded} {}
+
+    // Methods
+    /**
+     * Decodes the log message.
+     * @param log_message Returns the decoded log message.
+     * @return Same as `clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event` or
+     * `clp::ffi::ir_stream::eight_byte_encoding::deserialize_log_event`.
+     */
+    [[nodiscard]] auto decode(std::string& log_message) const -> clp::ffi::ir_stream::IRErrorCode;
+
+private:
+    clp::ffi::ir_stream::encoded_tag_t m_tag;
+    std::vector<int8_t> m_encoded_log_event;
+    bool m_is_four_byte_encoded;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_ENCODEDLOGMESSAGE_HPP
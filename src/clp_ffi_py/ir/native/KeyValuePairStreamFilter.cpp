@@ -0,0 +1,500 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "KeyValuePairStreamFilter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stack>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <clp/ffi/ir_stream/Deserializer.hpp>
+#include <clp/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/time_types.hpp>
+#include <clp/TraceableException.hpp>
+#include <clp/type_utils.hpp>
+#include <json/single_include/nlohmann/json.hpp>
+#include <wrapped_facade_headers/msgpack.hpp>
+
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/PyDeserializerBuffer.hpp>
+#include <clp_ffi_py/ir/native/PyKeyValuePairLogEvent.hpp>
+#include <clp_ffi_py/ir/native/Query.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+using clp::ffi::ir_stream::IRErrorCode;
+using clp::ffi::KeyValuePairLogEvent;
+using clp::ffi::SchemaTree;
+
+namespace {
+/**
+ * Class that implements `clp::ffi::ir_stream::IrUnitHandlerInterface` for holding the last
+ * deserialized log event until it's processed by the filter.
+ */
+class FilterIrUnitHandler {
+public:
+    // Methods that implement the `clp::ffi::ir_stream::IrUnitHandlerInterface` interface
+    [[nodiscard]] auto handle_log_event(KeyValuePairLogEvent&& deserialized_log_event)
+            -> IRErrorCode {
+        log_event.emplace(std::move(deserialized_log_event));
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    [[nodiscard]] auto handle_utc_offset_change(
+            [[maybe_unused]] clp::UtcOffset utc_offset_old,
+            clp::UtcOffset utc_offset_new
+    ) -> IRErrorCode {
+        utc_offset = utc_offset_new;
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    [[nodiscard]] static auto handle_schema_tree_node_insertion(
+            [[maybe_unused]] bool is_auto_generated,
+            [[maybe_unused]] SchemaTree::NodeLocator schema_tree_node_locator
+    ) -> IRErrorCode {
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    [[nodiscard]] auto handle_end_of_stream() -> IRErrorCode {
+        is_end_of_stream_reached = true;
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    // TODO: We should enable linting when clang-tidy config is up-to-date to allow simple classes.
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes,readability-identifier-naming)
+    std::optional<KeyValuePairLogEvent> log_event;
+    clp::UtcOffset utc_offset{0};
+    bool is_end_of_stream_reached{false};
+    // NOLINTEND(misc-non-private-member-variables-in-classes,readability-identifier-naming)
+};
+
+/**
+ * Converts the given key-value pairs of a log event into a msgpack map directly from their schema
+ * tree nodes, so that they can be re-serialized without being converted into JSON first.
+ * @param schema_tree The schema tree of the keys.
+ * @param schema_subtree_bitmap A bitmap indicating the schema tree nodes in the subtree of the
+ * key-value pairs.
+ * @param node_id_value_pairs
+ * @param zone The zone to allocate the msgpack maps and the decoded strings in.
+ * @param array_handles Returns the handles that own the msgpack arrays converted from unstructured
+ * arrays.
+ * @return The msgpack map on success.
+ * @return std::nullopt on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto convert_kv_pairs_to_msgpack_map(
+        SchemaTree const& schema_tree,
+        std::vector<bool> const& schema_subtree_bitmap,
+        KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+        msgpack::zone& zone,
+        std::vector<msgpack::object_handle>& array_handles
+) -> std::optional<msgpack::object_map>;
+
+/**
+ * Converts the value of the given schema tree node into a msgpack object.
+ * @param node
+ * @param optional_val The value, or std::nullopt if the node is an empty object.
+ * @param zone The zone to allocate the decoded strings in.
+ * @param array_handles Returns the handle that owns the msgpack array if the value is an
+ * unstructured array.
+ * @param msgpack_obj Returns the converted msgpack object.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto convert_value_to_msgpack_object(
+        SchemaTree::Node const& node,
+        std::optional<clp::ffi::Value> const& optional_val,
+        msgpack::zone& zone,
+        std::vector<msgpack::object_handle>& array_handles,
+        msgpack::object& msgpack_obj
+) -> bool;
+
+/**
+ * @param str
+ * @return A msgpack string object that references the given string without copying it.
+ */
+[[nodiscard]] auto create_msgpack_str(std::string_view str) -> msgpack::object;
+
+auto convert_kv_pairs_to_msgpack_map(
+        SchemaTree const& schema_tree,
+        std::vector<bool> const& schema_subtree_bitmap,
+        KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+        msgpack::zone& zone,
+        std::vector<msgpack::object_handle>& array_handles
+) -> std::optional<msgpack::object_map> {
+    // Each map in the DFS stack holds the IDs of the schema tree nodes of its keys, and the number
+    // of its key-value pairs that have been populated so far.
+    struct DfsMap {
+        std::vector<SchemaTree::Node::id_t> child_ids;
+        msgpack::object_map map;
+        size_t num_populated_kv_pairs;
+    };
+    auto const create_dfs_map = [&](SchemaTree::Node const& node) -> DfsMap {
+        DfsMap dfs_map{{}, {}, 0};
+        for (auto const child_id : node.get_children_ids()) {
+            if (schema_subtree_bitmap[child_id]) {
+                dfs_map.child_ids.push_back(child_id);
+            }
+        }
+        dfs_map.map.size = static_cast<uint32_t>(dfs_map.child_ids.size());
+        dfs_map.map.ptr = static_cast<msgpack::object_kv*>(zone.allocate_align(
+                sizeof(msgpack::object_kv) * dfs_map.child_ids.size(),
+                MSGPACK_ZONE_ALIGNOF(msgpack::object_kv)
+        ));
+        return dfs_map;
+    };
+
+    std::stack<DfsMap> dfs_stack;
+    dfs_stack.emplace(create_dfs_map(schema_tree.get_root()));
+    auto const root_map{dfs_stack.top().map};
+    while (false == dfs_stack.empty()) {
+        auto& dfs_stack_top{dfs_stack.top()};
+        if (dfs_stack_top.child_ids.size() == dfs_stack_top.num_populated_kv_pairs) {
+            dfs_stack.pop();
+            continue;
+        }
+        auto const child_id{dfs_stack_top.child_ids[dfs_stack_top.num_populated_kv_pairs]};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto& kv_pair{dfs_stack_top.map.ptr[dfs_stack_top.num_populated_kv_pairs]};
+        ++dfs_stack_top.num_populated_kv_pairs;
+
+        auto const& child_node{schema_tree.get_node(child_id)};
+        kv_pair.key = create_msgpack_str(child_node.get_key_name());
+        if (false == node_id_value_pairs.contains(child_id)) {
+            // The node is an object that has descendants in the subtree, so its map is populated
+            // through the DFS stack.
+            auto child_dfs_map{create_dfs_map(child_node)};
+            kv_pair.val.type = msgpack::type::MAP;
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+            kv_pair.val.via.map = child_dfs_map.map;
+            dfs_stack.emplace(std::move(child_dfs_map));
+            continue;
+        }
+        if (false
+            == convert_value_to_msgpack_object(
+                    child_node,
+                    node_id_value_pairs.at(child_id),
+                    zone,
+                    array_handles,
+                    kv_pair.val
+            ))
+        {
+            return std::nullopt;
+        }
+    }
+    return root_map;
+}
+
+auto convert_value_to_msgpack_object(
+        SchemaTree::Node const& node,
+        std::optional<clp::ffi::Value> const& optional_val,
+        msgpack::zone& zone,
+        std::vector<msgpack::object_handle>& array_handles,
+        msgpack::object& msgpack_obj
+) -> bool {
+    if (false == optional_val.has_value()) {
+        msgpack_obj.type = msgpack::type::MAP;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        msgpack_obj.via.map = {0, nullptr};
+        return true;
+    }
+
+    auto const type{node.get_type()};
+    auto const& val{optional_val.value()};
+    switch (type) {
+        case SchemaTree::Node::Type::Int:
+            msgpack_obj = msgpack::object{val.get_immutable_view<clp::ffi::value_int_t>()};
+            return true;
+        case SchemaTree::Node::Type::Float:
+            msgpack_obj = msgpack::object{val.get_immutable_view<clp::ffi::value_float_t>()};
+            return true;
+        case SchemaTree::Node::Type::Bool:
+            msgpack_obj = msgpack::object{val.get_immutable_view<clp::ffi::value_bool_t>()};
+            return true;
+        case SchemaTree::Node::Type::Str: {
+            if (val.is<std::string>()) {
+                msgpack_obj = create_msgpack_str(val.get_immutable_view<std::string>());
+                return true;
+            }
+            auto const decoded_result{
+                    PyKeyValuePairLogEvent_internal::decode_as_encoded_text_ast(val)
+            };
+            if (false == decoded_result.has_value()) {
+                return false;
+            }
+            auto const& decoded_str{decoded_result.value()};
+            auto* decoded_str_buf{static_cast<char*>(zone.allocate_no_align(decoded_str.size()))};
+            std::ranges::copy(decoded_str, decoded_str_buf);
+            msgpack_obj = create_msgpack_str({decoded_str_buf, decoded_str.size()});
+            return true;
+        }
+        case SchemaTree::Node::Type::UnstructuredArray: {
+            auto const decoded_result{
+                    PyKeyValuePairLogEvent_internal::decode_as_encoded_text_ast(val)
+            };
+            if (false == decoded_result.has_value()) {
+                return false;
+            }
+            auto const json_array{nlohmann::json::parse(decoded_result.value(), nullptr, false)};
+            if (json_array.is_discarded()) {
+                PyErr_SetString(PyExc_RuntimeError, "Failed to parse the unstructured array");
+                return false;
+            }
+            auto const msgpack_bytes{nlohmann::json::to_msgpack(json_array)};
+            auto unpack_result{unpack_msgpack(
+                    {clp::size_checked_pointer_cast<char const>(msgpack_bytes.data()),
+                     msgpack_bytes.size()}
+            )};
+            if (unpack_result.has_error()) {
+                PyErr_SetString(PyExc_RuntimeError, unpack_result.error().c_str());
+                return false;
+            }
+            msgpack_obj = unpack_result.value().get();
+            array_handles.emplace_back(std::move(unpack_result.value()));
+            return true;
+        }
+        case SchemaTree::Node::Type::Obj:
+            // A null value.
+            msgpack_obj = msgpack::object{};
+            return true;
+        default:
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    "Unknown schema tree node type: %d",
+                    static_cast<uint32_t>(type)
+            );
+            return false;
+    }
+}
+
+auto create_msgpack_str(std::string_view str) -> msgpack::object {
+    msgpack::object msgpack_obj;
+    msgpack_obj.type = msgpack::type::STR;
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+    msgpack_obj.via.str.size = static_cast<uint32_t>(str.size());
+    msgpack_obj.via.str.ptr = str.data();
+    // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+    return msgpack_obj;
+}
+}  // namespace
+
+auto KeyValuePairStreamFilter::filter(
+        clp::ReaderInterface& reader,
+        PyObject* output_stream,
+        Query const* query,
+        bool allow_incomplete_stream
+) -> PyObject* {
+    try {
+        auto deserializer_result{clp::ffi::ir_stream::Deserializer<FilterIrUnitHandler>::create(
+                reader,
+                FilterIrUnitHandler{}
+        )};
+        if (deserializer_result.has_error()) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cDeserializerCreateErrorFormatStr),
+                    deserializer_result.error().message().c_str()
+            );
+            return nullptr;
+        }
+        auto& deserializer{deserializer_result.value()};
+        auto& ir_unit_handler{deserializer.get_ir_unit_handler()};
+
+        std::optional<nlohmann::json> optional_user_defined_metadata;
+        auto const& metadata{deserializer.get_metadata()};
+        std::string const user_defined_metadata_key{
+                clp::ffi::ir_stream::cProtocol::Metadata::UserDefinedMetadataKey
+        };
+        if (metadata.contains(user_defined_metadata_key)) {
+            optional_user_defined_metadata.emplace(metadata.at(user_defined_metadata_key));
+        }
+        auto serializer_result{ClpIrSerializer::create(optional_user_defined_metadata)};
+        if (serializer_result.has_error()) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cSerializerCreateErrorFormatStr),
+                    serializer_result.error().message().c_str()
+            );
+            return nullptr;
+        }
+        KeyValuePairStreamFilter stream_filter{
+                std::move(serializer_result.value()),
+                output_stream,
+                query
+        };
+
+        while (false == ir_unit_handler.is_end_of_stream_reached) {
+            auto const ir_unit_type_result{deserializer.deserialize_next_ir_unit(reader)};
+            if (ir_unit_type_result.has_error()) {
+                auto const err{ir_unit_type_result.error()};
+                if (std::errc::result_out_of_range != err) {
+                    PyErr_Format(
+                            PyExc_RuntimeError,
+                            get_c_str_from_constexpr_string_view(
+                                    cDeserializerDeserializeNextIrUnitErrorFormatStr
+                            ),
+                            err.message().c_str()
+                    );
+                    return nullptr;
+                }
+                if (false == allow_incomplete_stream) {
+                    PyErr_SetString(
+                            PyDeserializerBuffer::get_py_incomplete_stream_error(),
+                            get_c_str_from_constexpr_string_view(cDeserializerIncompleteIRError)
+                    );
+                    return nullptr;
+                }
+                break;
+            }
+            if (ir_unit_handler.log_event.has_value()) {
+                if (false
+                    == stream_filter.process(
+                            ir_unit_handler.log_event.value(),
+                            ir_unit_handler.utc_offset
+                    ))
+                {
+                    return nullptr;
+                }
+                ir_unit_handler.log_event.reset();
+            }
+        }
+
+        if (false == stream_filter.finish()) {
+            return nullptr;
+        }
+        return PyLong_FromSize_t(stream_filter.get_num_matched_log_events());
+    } catch (clp::TraceableException& exception) {
+        handle_traceable_exception(exception);
+        return nullptr;
+    } catch (std::bad_alloc const&) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
+        );
+        return nullptr;
+    }
+}
+
+auto KeyValuePairStreamFilter::process(
+        KeyValuePairLogEvent const& log_event,
+        clp::UtcOffset utc_offset
+) -> bool {
+    if (nullptr != m_query && false == m_query->get_wildcard_queries().empty()) {
+        auto const serialized_result{log_event.serialize_to_json()};
+        if (serialized_result.has_error()) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    "Failed to serialize the log event into JSON: %s",
+                    serialized_result.error().message().c_str()
+            );
+            return false;
+        }
+        auto const& user_gen_kv_pairs{serialized_result.value().second};
+        if (false
+            == m_query->matches_wildcard_queries(user_gen_kv_pairs.dump(
+                    -1,
+                    ' ',
+                    false,
+                    nlohmann::json::error_handler_t::replace
+            )))
+        {
+            return true;
+        }
+    }
+
+    auto const auto_gen_keys_schema_subtree_bitmap_result{
+            log_event.get_auto_gen_keys_schema_subtree_bitmap()
+    };
+    if (auto_gen_keys_schema_subtree_bitmap_result.has_error()) {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                "Failed to get auto-generated keys schema subtree bitmap: %s",
+                auto_gen_keys_schema_subtree_bitmap_result.error().message().c_str()
+        );
+        return false;
+    }
+    auto const user_gen_keys_schema_subtree_bitmap_result{
+            log_event.get_user_gen_keys_schema_subtree_bitmap()
+    };
+    if (user_gen_keys_schema_subtree_bitmap_result.has_error()) {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                "Failed to get user-generated keys schema subtree bitmap: %s",
+                user_gen_keys_schema_subtree_bitmap_result.error().message().c_str()
+        );
+        return false;
+    }
+    msgpack::zone zone;
+    std::vector<msgpack::object_handle> array_handles;
+    auto const optional_auto_gen_msgpack_map{convert_kv_pairs_to_msgpack_map(
+            log_event.get_auto_gen_keys_schema_tree(),
+            auto_gen_keys_schema_subtree_bitmap_result.value(),
+            log_event.get_auto_gen_node_id_value_pairs(),
+            zone,
+            array_handles
+    )};
+    if (false == optional_auto_gen_msgpack_map.has_value()) {
+        return false;
+    }
+    auto const optional_user_gen_msgpack_map{convert_kv_pairs_to_msgpack_map(
+            log_event.get_user_gen_keys_schema_tree(),
+            user_gen_keys_schema_subtree_bitmap_result.value(),
+            log_event.get_user_gen_node_id_value_pairs(),
+            zone,
+            array_handles
+    )};
+    if (false == optional_user_gen_msgpack_map.has_value()) {
+        return false;
+    }
+
+    // The serializer only writes a UTC offset change if the offset differs from the last one.
+    m_serializer.change_utc_offset(utc_offset);
+    if (false
+        == m_serializer.serialize_msgpack_map(
+                optional_auto_gen_msgpack_map.value(),
+                optional_user_gen_msgpack_map.value()
+        ))
+    {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cSerializerSerializeMsgpackMapError)
+        );
+        return false;
+    }
+    ++m_num_matched_log_events;
+
+    if (m_serializer.get_ir_buf_view().size() > cOutputBufferSizeLimit) {
+        return write_ir_buf();
+    }
+    return true;
+}
+
+auto KeyValuePairStreamFilter::finish() -> bool {
+    if (false == write_ir_buf()) {
+        return false;
+    }
+    constexpr std::array<int8_t, 1> cEndOfStreamBuf{clp::ffi::ir_stream::cProtocol::Eof};
+    return write_to_py_output_stream(m_output_stream, cEndOfStreamBuf);
+}
+
+auto KeyValuePairStreamFilter::write_ir_buf() -> bool {
+    if (false == write_to_py_output_stream(m_output_stream, m_serializer.get_ir_buf_view())) {
+        return false;
+    }
+    m_serializer.clear_ir_buf();
+    return true;
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,116 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_KEYVALUEPAIRSTREAMFILTER_HPP
+#define CLP_FFI_PY_IR_NATIVE_KEYVALUEPAIRSTREAMFILTER_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <cstddef>
+#include <utility>
+
+#include <clp/ffi/ir_stream/Serializer.hpp>
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/time_types.hpp>
+
+#include <clp_ffi_py/ir/native/Query.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * Class that filters a CLP key-value pair IR stream into a new key-value pair IR stream, one log
+ * event at a time. Each matched log event is re-serialized through a fresh four-byte encoded
+ * `clp::ffi::ir_stream::Serializer`, so the output stream only contains the schema tree nodes
+ * required by the matched log events. The user-defined stream-level metadata and the UTC offset of
+ * each matched log event are carried over.
+ * No Python object is created for the deserialized log events, and their key-value pairs are
+ * converted into the serializer's input directly from their schema tree nodes.
+ */
+class KeyValuePairStreamFilter {
+public:
+    using ClpIrSerializer = clp::ffi::ir_stream::Serializer<clp::ir::four_byte_encoded_variable_t>;
+
+    /**
+     * The size of the serialized log events accumulated before being written into the output
+     * stream.
+     */
+    static constexpr size_t cOutputBufferSizeLimit{65'536};
+
+    /**
+     * Filters the key-value pair IR stream read from the given reader in a single pass, and writes
+     * the matched log events into the given output stream as a complete IR stream.
+     * The wildcard queries of the given query are matched against the JSON string of the
+     * user-generated key-value pairs of each log event. The search time range of the query is
+     * ignored since key-value pair log events have no designated timestamp.
+     * @param reader
+     * @param output_stream A Python `IO[bytes]` object. It's not flushed nor closed.
+     * @param query The query to match the log events against, or nullptr to match all log events.
+     * @param allow_incomplete_stream Whether to treat an incomplete stream as the end of the stream
+     * instead of an error.
+     * @return A new reference to a Python int of the number of matched log events on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto filter(
+            clp::ReaderInterface& reader,
+            PyObject* output_stream,
+            Query const* query,
+            bool allow_incomplete_stream
+    ) -> PyObject*;
+
+    // Constructor
+    KeyValuePairStreamFilter(
+            ClpIrSerializer serializer,
+            PyObject* output_stream,
+            Query const* query
+    )
+            : m_serializer{std::move(serializer)},
+              m_output_stream{output_stream},
+              m_query{query} {}
+
+    // Delete copy & move constructors and assignment operators
+    KeyValuePairStreamFilter(KeyValuePairStreamFilter const&) = delete;
+    KeyValuePairStreamFilter(KeyValuePairStreamFilter&&) = delete;
+    auto operator=(KeyValuePairStreamFilter const&) -> KeyValuePairStreamFilter& = delete;
+    auto operator=(KeyValuePairStreamFilter&&) -> KeyValuePairStreamFilter& = delete;
+
+    // Destructor
+    ~KeyValuePairStreamFilter() = default;
+
+    // Methods
+    /**
+     * Re-serializes the given log event if it matches the query, and writes the serialized log
+     * events into the output stream once they exceed `cOutputBufferSizeLimit`.
+     * @param log_event
+     * @param utc_offset The UTC offset of the input stream at the log event.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto
+    process(clp::ffi::KeyValuePairLogEvent const& log_event, clp::UtcOffset utc_offset) -> bool;
+
+    /**
+     * Writes the remaining serialized log events and the end-of-stream IR unit into the output
+     * stream.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto finish() -> bool;
+
+    [[nodiscard]] auto get_num_matched_log_events() const -> size_t {
+        return m_num_matched_log_events;
+    }
+
+private:
+    /**
+     * Writes the serialized IR buffer into the output stream and clears it.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto write_ir_buf() -> bool;
+
+    ClpIrSerializer m_serializer;
+    PyObject* m_output_stream;
+    Query const* m_query;
+    size_t m_num_matched_log_events{0};
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_KEYVALUEPAIRSTREAMFILTER_HPP
@@ -0,0 +1,486 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "KeyValuePairStreamStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <clp/ffi/ir_stream/Deserializer.hpp>
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/time_types.hpp>
+#include <clp/TraceableException.hpp>
+
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/PyDeserializerBuffer.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+using clp::ffi::ir_stream::IRErrorCode;
+using clp::ffi::KeyValuePairLogEvent;
+using clp::ffi::SchemaTree;
+
+namespace {
+/**
+ * Class that implements `clp::ffi::ir_stream::IrUnitHandlerInterface` for collecting the statistics
+ * of the deserialized log events.
+ */
+class StatsIrUnitHandler {
+public:
+    // Methods that implement the `clp::ffi::ir_stream::IrUnitHandlerInterface` interface
+    [[nodiscard]] auto handle_log_event(KeyValuePairLogEvent&& deserialized_log_event)
+            -> IRErrorCode {
+        stats.update(deserialized_log_event);
+        // Keep the last log event so that the keys can be resolved from its schema trees, which
+        // contain all the keys seen in the stream so far.
+        last_log_event.emplace(std::move(deserialized_log_event));
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    [[nodiscard]] static auto handle_utc_offset_change(
+            [[maybe_unused]] clp::UtcOffset utc_offset_old,
+            [[maybe_unused]] clp::UtcOffset utc_offset_new
+    ) -> IRErrorCode {
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    [[nodiscard]] static auto handle_schema_tree_node_insertion(
+            [[maybe_unused]] bool is_auto_generated,
+            [[maybe_unused]] SchemaTree::NodeLocator schema_tree_node_locator
+    ) -> IRErrorCode {
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    [[nodiscard]] auto handle_end_of_stream() -> IRErrorCode {
+        is_end_of_stream_reached = true;
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    // TODO: We should enable linting when clang-tidy config is up-to-date to allow simple classes.
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes,readability-identifier-naming)
+    KeyValuePairStreamStats stats;
+    std::optional<KeyValuePairLogEvent> last_log_event;
+    bool is_end_of_stream_reached{false};
+    // NOLINTEND(misc-non-private-member-variables-in-classes,readability-identifier-naming)
+};
+
+/**
+ * Extends the given range to include the given value.
+ * @tparam ValueType
+ * @param range
+ * @param val
+ */
+template <typename ValueType>
+auto extend_range(std::optional<std::pair<ValueType, ValueType>>& range, ValueType val) -> void {
+    if (false == range.has_value()) {
+        range.emplace(val, val);
+        return;
+    }
+    auto& [min, max]{range.value()};
+    min = std::min(min, val);
+    max = std::max(max, val);
+}
+
+/**
+ * Inserts the given item into the given Python dictionary, and releases the reference of the item.
+ * @param py_dict
+ * @param key
+ * @param py_value A new reference to the value to insert.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto
+set_py_dict_item_and_steal_value(PyObject* py_dict, char const* key, PyObject* py_value) -> bool {
+    PyObjectPtr<PyObject> const value{py_value};
+    if (nullptr == value) {
+        return false;
+    }
+    return 0 == PyDict_SetItemString(py_dict, key, value.get());
+}
+
+/**
+ * Gets the lower or upper bound of a numeric value range, which may consist of both integer and
+ * float values, as a Python number.
+ * @param int_range The range of integer values, if any.
+ * @param float_range The range of float values, if any.
+ * @param get_lower_bound Whether to get the lower bound or the upper bound.
+ * @return A new reference to a Python int or float on success.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto get_range_bound_as_py_number(
+        std::optional<std::pair<clp::ffi::value_int_t, clp::ffi::value_int_t>> const& int_range,
+        std::optional<std::pair<clp::ffi::value_float_t, clp::ffi::value_float_t>> const&
+                float_range,
+        bool get_lower_bound
+) -> PyObject* {
+    if (false == float_range.has_value()) {
+        auto const& [min, max]{int_range.value()};
+        return PyLong_FromLongLong(static_cast<long long>(get_lower_bound ? min : max));
+    }
+    auto const& [float_min, float_max]{float_range.value()};
+    auto const float_bound{get_lower_bound ? float_min : float_max};
+    if (false == int_range.has_value()) {
+        return PyFloat_FromDouble(float_bound);
+    }
+    auto const& [int_min, int_max]{int_range.value()};
+    auto const int_bound{get_lower_bound ? int_min : int_max};
+    auto const int_bound_as_float{static_cast<clp::ffi::value_float_t>(int_bound)};
+    bool const use_int_bound{
+            get_lower_bound ? int_bound_as_float <= float_bound : int_bound_as_float >= float_bound
+    };
+    if (use_int_bound) {
+        return PyLong_FromLongLong(static_cast<long long>(int_bound));
+    }
+    return PyFloat_FromDouble(float_bound);
+}
+}  // namespace
+
+auto KeyValuePairStreamStats::scan(
+        clp::ReaderInterface& reader,
+        bool allow_incomplete_stream,
+        bool release_gil
+) -> PyObject* {
+    try {
+        auto deserializer_result{clp::ffi::ir_stream::Deserializer<StatsIrUnitHandler>::create(
+                reader,
+                StatsIrUnitHandler{}
+        )};
+        if (deserializer_result.has_error()) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cDeserializerCreateErrorFormatStr),
+                    deserializer_result.error().message().c_str()
+            );
+            return nullptr;
+        }
+
+        auto& deserializer{deserializer_result.value()};
+        auto& ir_unit_handler{deserializer.get_ir_unit_handler()};
+        std::error_code deserialization_err;
+        {
+            std::optional<PyGilReleaseGuard> gil_release_guard;
+            if (release_gil) {
+                gil_release_guard.emplace();
+            }
+            while (false == ir_unit_handler.is_end_of_stream_reached) {
+                auto const ir_unit_type_result{deserializer.deserialize_next_ir_unit(reader)};
+                if (ir_unit_type_result.has_error()) {
+                    deserialization_err = ir_unit_type_result.error();
+                    break;
+                }
+            }
+        }
+
+        if (deserialization_err) {
+            if (std::errc::result_out_of_range != deserialization_err) {
+                PyErr_Format(
+                        PyExc_RuntimeError,
+                        get_c_str_from_constexpr_string_view(
+                                cDeserializerDeserializeNextIrUnitErrorFormatStr
+                        ),
+                        deserialization_err.message().c_str()
+                );
+                return nullptr;
+            }
+            if (false == allow_incomplete_stream) {
+                PyErr_SetString(
+                        PyDeserializerBuffer::get_py_incomplete_stream_error(),
+                        get_c_str_from_constexpr_string_view(cDeserializerIncompleteIRError)
+                );
+                return nullptr;
+            }
+        }
+
+        size_t num_encoded_bytes{0};
+        if (clp::ErrorCode_Success != reader.try_get_pos(num_encoded_bytes)) {
+            PyErr_SetString(PyExc_RuntimeError, "Failed to get the position of the IR stream.");
+            return nullptr;
+        }
+
+        auto const& last_log_event{ir_unit_handler.last_log_event};
+        return ir_unit_handler.stats.to_py_dict(
+                last_log_event.has_value() ? &last_log_event.value() : nullptr,
+                num_encoded_bytes
+        );
+    } catch (clp::TraceableException& exception) {
+        handle_traceable_exception(exception);
+        return nullptr;
+    } catch (std::bad_alloc const&) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
+        );
+        return nullptr;
+    }
+}
+
+auto KeyValuePairStreamStats::update(KeyValuePairLogEvent const& log_event) -> void {
+    update_key_stats(
+            log_event.get_auto_gen_keys_schema_tree(),
+            log_event.get_auto_gen_node_id_value_pairs(),
+            m_auto_gen_key_stats,
+            m_current_schema.first
+    );
+    update_key_stats(
+            log_event.get_user_gen_keys_schema_tree(),
+            log_event.get_user_gen_node_id_value_pairs(),
+            m_user_gen_key_stats,
+            m_current_schema.second
+    );
+    if (false == m_schemas.contains(m_current_schema)) {
+        m_schemas.insert(m_current_schema);
+    }
+    ++m_num_log_events;
+}
+
+auto KeyValuePairStreamStats::to_py_dict(
+        KeyValuePairLogEvent const* last_log_event,
+        size_t num_encoded_bytes
+) const -> PyObject* {
+    PyObjectPtr<PyObject> py_stats{PyDict_New()};
+    if (nullptr == py_stats) {
+        return nullptr;
+    }
+
+    PyObjectPtr<PyObject> const py_auto_gen_key_frequencies{PyDict_New()};
+    PyObjectPtr<PyObject> const py_auto_gen_numeric_ranges{PyDict_New()};
+    PyObjectPtr<PyObject> const py_user_gen_key_frequencies{PyDict_New()};
+    PyObjectPtr<PyObject> const py_user_gen_numeric_ranges{PyDict_New()};
+    if (nullptr == py_auto_gen_key_frequencies || nullptr == py_auto_gen_numeric_ranges
+        || nullptr == py_user_gen_key_frequencies || nullptr == py_user_gen_numeric_ranges)
+    {
+        return nullptr;
+    }
+
+    if (nullptr != last_log_event) {
+        if (false
+            == add_key_stats_to_py_dicts(
+                    last_log_event->get_auto_gen_keys_schema_tree(),
+                    m_auto_gen_key_stats,
+                    py_auto_gen_key_frequencies.get(),
+                    py_auto_gen_numeric_ranges.get()
+            ))
+        {
+            return nullptr;
+        }
+        if (false
+            == add_key_stats_to_py_dicts(
+                    last_log_event->get_user_gen_keys_schema_tree(),
+                    m_user_gen_key_stats,
+                    py_user_gen_key_frequencies.get(),
+                    py_user_gen_numeric_ranges.get()
+            ))
+        {
+            return nullptr;
+        }
+    }
+
+    auto* stats{py_stats.get()};
+    if (false
+        == set_py_dict_item_and_steal_value(
+                stats,
+                "num_log_events",
+                PyLong_FromSize_t(m_num_log_events)
+        ))
+    {
+        return nullptr;
+    }
+    if (false
+        == set_py_dict_item_and_steal_value(
+                stats,
+                "num_distinct_schemas",
+                PyLong_FromSize_t(m_schemas.size())
+        ))
+    {
+        return nullptr;
+    }
+    if (false
+        == set_py_dict_item_and_steal_value(
+                stats,
+                "num_encoded_bytes",
+                PyLong_FromSize_t(num_encoded_bytes)
+        ))
+    {
+        return nullptr;
+    }
+    if (0
+                != PyDict_SetItemString(
+                        stats,
+                        "auto_gen_key_frequencies",
+                        py_auto_gen_key_frequencies.get()
+                )
+        || 0
+                   != PyDict_SetItemString(
+                           stats,
+                           "auto_gen_numeric_ranges",
+                           py_auto_gen_numeric_ranges.get()
+                   )
+        || 0
+                   != PyDict_SetItemString(
+                           stats,
+                           "user_gen_key_frequencies",
+                           py_user_gen_key_frequencies.get()
+                   )
+        || 0
+                   != PyDict_SetItemString(
+                           stats,
+                           "user_gen_numeric_ranges",
+                           py_user_gen_numeric_ranges.get()
+                   ))
+    {
+        return nullptr;
+    }
+
+    return py_stats.release();
+}
+
+auto KeyValuePairStreamStats::KeyStats::update(
+        SchemaTree::Node::Type type,
+        std::optional<clp::ffi::Value> const& optional_val
+) -> void {
+    ++m_num_occurrences;
+    if (false == optional_val.has_value()) {
+        return;
+    }
+    auto const& val{optional_val.value()};
+    switch (type) {
+        case SchemaTree::Node::Type::Int:
+            extend_range(m_int_range, val.get_immutable_view<clp::ffi::value_int_t>());
+            break;
+        case SchemaTree::Node::Type::Float: {
+            auto const float_val{val.get_immutable_view<clp::ffi::value_float_t>()};
+            if (std::isnan(float_val)) {
+                // NaN is unordered, so it can't be part of a value range.
+                break;
+            }
+            extend_range(m_float_range, float_val);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+auto KeyValuePairStreamStats::KeyStats::merge(KeyStats const& other) -> void {
+    m_num_occurrences += other.m_num_occurrences;
+    if (other.m_int_range.has_value()) {
+        extend_range(m_int_range, other.m_int_range.value().first);
+        extend_range(m_int_range, other.m_int_range.value().second);
+    }
+    if (other.m_float_range.has_value()) {
+        extend_range(m_float_range, other.m_float_range.value().first);
+        extend_range(m_float_range, other.m_float_range.value().second);
+    }
+}
+
+auto KeyValuePairStreamStats::update_key_stats(
+        SchemaTree const& schema_tree,
+        KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+        std::vector<KeyStats>& key_stats,
+        Schema& schema
+) -> void {
+    schema.clear();
+    for (auto const& [node_id, optional_val] : node_id_value_pairs) {
+        if (key_stats.size() <= node_id) {
+            key_stats.resize(static_cast<size_t>(node_id) + 1);
+        }
+        key_stats[node_id].update(schema_tree.get_node(node_id).get_type(), optional_val);
+        schema.push_back(node_id);
+    }
+    std::ranges::sort(schema);
+}
+
+auto KeyValuePairStreamStats::add_key_stats_to_py_dicts(
+        SchemaTree const& schema_tree,
+        std::vector<KeyStats> const& key_stats,
+        PyObject* py_key_frequencies,
+        PyObject* py_numeric_ranges
+) -> bool {
+    // Sibling nodes may share the same key name if their types are different, so the statistics
+    // are merged by the full key path before being converted into Python objects.
+    std::map<std::vector<std::string_view>, KeyStats> key_path_stats;
+
+    // Traverse the schema tree in DFS order to construct the full key path of each node. Each stack
+    // element is a node ID and the depth of the node (excluding the root).
+    std::vector<std::pair<SchemaTree::Node::id_t, size_t>> dfs_stack;
+    for (auto const child_id : schema_tree.get_root().get_children_ids()) {
+        dfs_stack.emplace_back(child_id, 0);
+    }
+    std::vector<std::string_view> key_path;
+    while (false == dfs_stack.empty()) {
+        auto const [node_id, depth]{dfs_stack.back()};
+        dfs_stack.pop_back();
+        auto const& node{schema_tree.get_node(node_id)};
+        key_path.resize(depth);
+        key_path.push_back(node.get_key_name());
+        for (auto const child_id : node.get_children_ids()) {
+            dfs_stack.emplace_back(child_id, depth + 1);
+        }
+        if (key_stats.size() <= node_id || 0 == key_stats[node_id].get_num_occurrences()) {
+            continue;
+        }
+        key_path_stats[key_path].merge(key_stats[node_id]);
+    }
+
+    for (auto const& [path, stats] : key_path_stats) {
+        PyObjectPtr<PyObject> const py_key{PyTuple_New(static_cast<Py_ssize_t>(path.size()))};
+        if (nullptr == py_key) {
+            return false;
+        }
+        for (size_t idx{0}; idx < path.size(); ++idx) {
+            auto* py_key_name{construct_py_str_from_string_view(path[idx])};
+            if (nullptr == py_key_name) {
+                return false;
+            }
+            PyTuple_SET_ITEM(py_key.get(), static_cast<Py_ssize_t>(idx), py_key_name);
+        }
+
+        PyObjectPtr<PyObject> const py_num_occurrences{
+                PyLong_FromSize_t(stats.get_num_occurrences())
+        };
+        if (nullptr == py_num_occurrences
+            || 0 != PyDict_SetItem(py_key_frequencies, py_key.get(), py_num_occurrences.get()))
+        {
+            return false;
+        }
+
+        auto const& int_range{stats.get_int_range()};
+        auto const& float_range{stats.get_float_range()};
+        if (false == int_range.has_value() && false == float_range.has_value()) {
+            continue;
+        }
+        PyObjectPtr<PyObject> const py_range{PyTuple_New(2)};
+        if (nullptr == py_range) {
+            return false;
+        }
+        auto* py_min{get_range_bound_as_py_number(int_range, float_range, true)};
+        if (nullptr == py_min) {
+            return false;
+        }
+        PyTuple_SET_ITEM(py_range.get(), 0, py_min);
+        auto* py_max{get_range_bound_as_py_number(int_range, float_range, false)};
+        if (nullptr == py_max) {
+            return false;
+        }
+        PyTuple_SET_ITEM(py_range.get(), 1, py_max);
+        if (0 != PyDict_SetItem(py_numeric_ranges, py_key.get(), py_range.get())) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace clp_ffi_py::ir::native
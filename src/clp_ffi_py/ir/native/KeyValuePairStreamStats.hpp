@@ -0,0 +1,168 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_KEYVALUEPAIRSTREAMSTATS_HPP
+#define CLP_FFI_PY_IR_NATIVE_KEYVALUEPAIRSTREAMSTATS_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <cstddef>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/ReaderInterface.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * Class that accumulates the statistics of a CLP key-value pair IR stream, one log event at a time:
+ * - The number of log events.
+ * - The number of distinct schemas, where a schema is the set of (leaf) keys in a log event.
+ * - The number of occurrences of each key.
+ * - The value range of each numeric (integer or float) key.
+ * The accumulated statistics only consist of native data, so they can be updated without any
+ * interaction with the Python interpreter.
+ */
+class KeyValuePairStreamStats {
+public:
+    /**
+     * Scans the key-value pair IR stream read from the given reader in a single pass, and collects
+     * the statistics of all the deserialized log events.
+     * @param reader
+     * @param allow_incomplete_stream Whether to treat an incomplete stream as the end of the stream
+     * instead of an error.
+     * @param release_gil Whether to release the GIL while scanning the stream. Must only be set if
+     * the reader doesn't interact with the Python interpreter.
+     * @return A new reference to a Python dictionary containing the collected statistics on
+     * success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto
+    scan(clp::ReaderInterface& reader, bool allow_incomplete_stream, bool release_gil) -> PyObject*;
+
+    // Constructor
+    KeyValuePairStreamStats() = default;
+
+    // Default copy & move constructors and assignment operators
+    KeyValuePairStreamStats(KeyValuePairStreamStats const&) = default;
+    KeyValuePairStreamStats(KeyValuePairStreamStats&&) = default;
+    auto operator=(KeyValuePairStreamStats const&) -> KeyValuePairStreamStats& = default;
+    auto operator=(KeyValuePairStreamStats&&) -> KeyValuePairStreamStats& = default;
+
+    // Destructor
+    ~KeyValuePairStreamStats() = default;
+
+    // Methods
+    /**
+     * Updates the statistics with the given log event.
+     * @param log_event
+     * @throw std::bad_alloc if memory allocation fails.
+     */
+    auto update(clp::ffi::KeyValuePairLogEvent const& log_event) -> void;
+
+    /**
+     * Converts the collected statistics into a Python dictionary. Keys are represented as tuples of
+     * key names, from the outermost to the innermost.
+     * @param last_log_event The last log event used to update the statistics, whose schema trees
+     * contain all the keys seen so far. `nullptr` if no log event has been seen.
+     * @param num_encoded_bytes The total number of encoded bytes consumed from the stream.
+     * @return A new reference to the Python dictionary on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto to_py_dict(
+            clp::ffi::KeyValuePairLogEvent const* last_log_event,
+            size_t num_encoded_bytes
+    ) const -> PyObject*;
+
+    [[nodiscard]] auto get_num_log_events() const -> size_t { return m_num_log_events; }
+
+    [[nodiscard]] auto get_num_distinct_schemas() const -> size_t { return m_schemas.size(); }
+
+private:
+    /**
+     * Statistics of a single key, identified by its schema tree node ID.
+     */
+    class KeyStats {
+    public:
+        // Types
+        using IntRange = std::pair<clp::ffi::value_int_t, clp::ffi::value_int_t>;
+        using FloatRange = std::pair<clp::ffi::value_float_t, clp::ffi::value_float_t>;
+
+        // Methods
+        /**
+         * Updates the statistics with a value of the key.
+         * @param type The type of the key.
+         * @param optional_val
+         */
+        auto update(
+                clp::ffi::SchemaTree::Node::Type type,
+                std::optional<clp::ffi::Value> const& optional_val
+        ) -> void;
+
+        /**
+         * Merges the statistics of another key into this one.
+         * @param other
+         */
+        auto merge(KeyStats const& other) -> void;
+
+        [[nodiscard]] auto get_num_occurrences() const -> size_t { return m_num_occurrences; }
+
+        [[nodiscard]] auto get_int_range() const -> std::optional<IntRange> const& {
+            return m_int_range;
+        }
+
+        [[nodiscard]] auto get_float_range() const -> std::optional<FloatRange> const& {
+            return m_float_range;
+        }
+
+    private:
+        size_t m_num_occurrences{0};
+        std::optional<IntRange> m_int_range;
+        std::optional<FloatRange> m_float_range;
+    };
+
+    using Schema = std::vector<clp::ffi::SchemaTree::Node::id_t>;
+
+    /**
+     * Updates the key statistics with the given node-ID-value pairs.
+     * @param schema_tree The schema tree that the node IDs refer to.
+     * @param node_id_value_pairs
+     * @param key_stats The key statistics to update, indexed by node ID.
+     * @param schema Returns the sorted node IDs of the given pairs.
+     */
+    static auto update_key_stats(
+            clp::ffi::SchemaTree const& schema_tree,
+            clp::ffi::KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+            std::vector<KeyStats>& key_stats,
+            Schema& schema
+    ) -> void;
+
+    /**
+     * Adds the given key statistics into Python dictionaries.
+     * @param schema_tree
+     * @param key_stats
+     * @param py_key_frequencies Python dictionary that maps each key to its number of occurrences.
+     * @param py_numeric_ranges Python dictionary that maps each numeric key to its (min, max)
+     * value.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto add_key_stats_to_py_dicts(
+            clp::ffi::SchemaTree const& schema_tree,
+            std::vector<KeyStats> const& key_stats,
+            PyObject* py_key_frequencies,
+            PyObject* py_numeric_ranges
+    ) -> bool;
+
+    size_t m_num_log_events{0};
+    std::vector<KeyStats> m_auto_gen_key_stats;
+    std::vector<KeyStats> m_user_gen_key_stats;
+    std::set<std::pair<Schema, Schema>> m_schemas;
+    // Scratch buffer for the (auto-generated, user-generated) schema of the log event being
+    // processed, reused across updates to avoid allocations.
+    std::pair<Schema, Schema> m_current_schema;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_KEYVALUEPAIRSTREAMSTATS_HPP
@@ -0,0 +1,81 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "LocalFileReader.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <new>
+#include <string_view>
+#include <utility>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/type_utils.hpp>
+#include <gsl/gsl>
+
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto LocalFileReader::create(PyObject* path) -> gsl::owner<LocalFileReader*> {
+    PyObjectPtr<PyObject> const fs_path{PyOS_FSPath(path)};
+    if (nullptr == fs_path) {
+        return nullptr;
+    }
+    if (false == static_cast<bool>(PyUnicode_Check(fs_path.get()))) {
+        PyErr_SetString(PyExc_TypeError, "The path of the file to read must be a `str`.");
+        return nullptr;
+    }
+    Py_ssize_t path_size{0};
+    auto const* path_data{PyUnicode_AsUTF8AndSize(fs_path.get(), &path_size)};
+    if (nullptr == path_data) {
+        return nullptr;
+    }
+    std::u8string_view const utf8_path{
+            clp::size_checked_pointer_cast<char8_t const>(path_data),
+            static_cast<size_t>(path_size)
+    };
+
+    std::ifstream file{std::filesystem::path{utf8_path}, std::ios::in | std::ios::binary};
+    if (false == file.is_open()) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, fs_path.get());
+        return nullptr;
+    }
+    gsl::owner<LocalFileReader*> reader{new (std::nothrow) LocalFileReader{std::move(file)}};
+    if (nullptr == reader) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cOutOfMemoryError)
+        );
+        return nullptr;
+    }
+    return reader;
+}
+
+auto LocalFileReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    m_file.read(buf, static_cast<std::streamsize>(num_bytes_to_read));
+    num_bytes_read = static_cast<size_t>(m_file.gcount());
+    m_pos += num_bytes_read;
+    if (m_file.bad()) {
+        return clp::ErrorCode_Failure;
+    }
+    if (0 == num_bytes_read && 0 != num_bytes_to_read) {
+        return clp::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto LocalFileReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    // Clears the EOF state so that the file can be read again after seeking.
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(pos));
+    if (m_file.fail()) {
+        return clp::ErrorCode_Failure;
+    }
+    m_pos = pos;
+    return clp::ErrorCode_Success;
+}
+}  // namespace clp_ffi_py::ir::native
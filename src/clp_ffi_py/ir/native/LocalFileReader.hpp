@@ -0,0 +1,80 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_LOCALFILEREADER_HPP
+#define CLP_FFI_PY_IR_NATIVE_LOCALFILEREADER_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <cstddef>
+#include <fstream>
+#include <utility>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <gsl/gsl>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class implements `clp::ReaderInterface` to read a local file using a native file stream.
+ * Reading from it doesn't require any interaction with the Python interpreter. Therefore, the read
+ * methods can be called without holding the GIL, e.g., from a native thread.
+ */
+class LocalFileReader : public clp::ReaderInterface {
+public:
+    // Factory function
+    /**
+     * Opens the file at the given path.
+     * @param path A Python `str` or path-like object.
+     * @return The transferred ownership of a created object on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto create(PyObject* path) -> gsl::owner<LocalFileReader*>;
+
+    // Delete copy & move constructors and assignment operators
+    LocalFileReader(LocalFileReader const&) = delete;
+    LocalFileReader(LocalFileReader&&) = delete;
+    auto operator=(LocalFileReader const&) -> LocalFileReader& = delete;
+    auto operator=(LocalFileReader&&) -> LocalFileReader& = delete;
+
+    // Destructor
+    ~LocalFileReader() override = default;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of bytes from the file.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_EndOfFile if there is no more data to read.
+     * @return ErrorCode_Failure if the underlying file stream fails.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the file.
+     * @param pos
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_Failure if the underlying file stream fails to seek.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the read head in the file.
+     * @return ErrorCode_Success always.
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode_Success;
+    }
+
+private:
+    // Constructor
+    explicit LocalFileReader(std::ifstream file) : m_file{std::move(file)} {}
+
+    // Variables
+    std::ifstream m_file;
+    size_t m_pos{0};
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_LOCALFILEREADER_HPP
@@ -5,13 +5,19 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ir/types.hpp>
 
+#include <clp_ffi_py/ir/native/EncodedLogMessage.hpp>
+
 namespace clp_ffi_py::ir::native {
 /**
  * A class that represents a deserialized IR log event. Contains ways to access (get or set) the log
  * message, the timestamp, and the log event index.
+ * The log message may be left encoded when the log event is deserialized, in which case it must be
+ * decoded through `decode_log_message` before being accessed.
  */
 class LogEvent {
 public:
@@ -38,7 +44,23 @@ public:
         }
     }
 
-    [[nodiscard]] auto get_log_message() const -> std::string { return m_log_message; }
+    /**
+     * Constructs a new log event whose log message is left encoded until `decode_log_message` is
+     * called.
+     * @param encoded_log_message
+     * @param timestamp
+     * @param index
+     */
+    explicit LogEvent(
+            EncodedLogMessage encoded_log_message,
+            clp::ir::epoch_time_ms_t timestamp,
+            size_t index
+    )
+            : m_encoded_log_message{std::move(encoded_log_message)},
+              m_timestamp{timestamp},
+              m_index{index} {}
+
+    [[nodiscard]] auto get_log_message() const -> std::string const& { return m_log_message; }
 
     [[nodiscard]] auto get_log_message_view() const -> std::string_view {
         return std::string_view{m_log_message};
@@ -46,12 +68,37 @@ public:
 
     [[nodiscard]] auto get_timestamp() const -> clp::ir::epoch_time_ms_t { return m_timestamp; }
 
-    [[nodiscard]] auto get_formatted_timestamp() const -> std::string {
+    [[nodiscard]] auto get_formatted_timestamp() const -> std::string const& {
         return m_formatted_timestamp;
     }
 
     [[nodiscard]] auto get_index() const -> size_t { return m_index; }
 
+    /**
+     * @return Whether the log message has been decoded.
+     */
+    [[nodiscard]] auto is_log_message_decoded() const -> bool {
+        return false == m_encoded_log_message.has_value();
+    }
+
+    /**
+     * Decodes the log message if it's still encoded, and discards the encoded log message.
+     * @return IRErrorCode_Success on success, or if the log message has been decoded already.
+     * @return Forwards `EncodedLogMessage::decode`'s return values on failure.
+     */
+    [[nodiscard]] auto decode_log_message() -> clp::ffi::ir_stream::IRErrorCode {
+        if (false == m_encoded_log_message.has_value()) {
+            return clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success;
+        }
+        if (auto const err{m_encoded_log_message->decode(m_log_message)};
+            clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success != err)
+        {
+            return err;
+        }
+        m_encoded_log_message.reset();
+        return clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success;
+    }
+
     /**
      * @return Whether the log event has the formatted timestamp buffered.
      */
@@ -59,17 +106,27 @@ public:
         return (false == m_formatted_timestamp.empty());
     }
 
-    auto set_log_message(std::string_view log_message) -> void { m_log_message = log_message; }
+    /**
+     * Releases the memory of the decoded log message, once it's kept elsewhere. The log message
+     * must not be accessed through this log event afterwards, until it's set again.
+     */
+    auto release_log_message() -> void { std::string{}.swap(m_log_message); }
+
+    auto set_log_message(std::string_view log_message) -> void {
+        m_encoded_log_message.reset();
+        m_log_message = log_message;
+    }
 
     auto set_timestamp(clp::ir::epoch_time_ms_t timestamp) -> void { m_timestamp = timestamp; }
 
-    auto set_formatted_timestamp(std::string const& formatted_timestamp) -> void {
+    auto set_formatted_timestamp(std::string_view formatted_timestamp) -> void {
         m_formatted_timestamp = formatted_timestamp;
     }
 
     auto set_index(size_t index) -> void { m_index = index; }
 
 private:
+    std::optional<EncodedLogMessage> m_encoded_log_message;
     std::string m_log_message;
     clp::ir::epoch_time_ms_t m_timestamp;
     size_t m_index;
@@ -0,0 +1,195 @@
+#include "LogtypeMatcher.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <clp/ir/types.hpp>
+#include <clp/type_utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * @param c
+ * @return Whether the given logtype character is a variable placeholder.
+ */
+[[nodiscard]] auto is_variable_placeholder(char c) -> bool;
+
+/**
+ * @param pattern_char
+ * @param logtype_char
+ * @param case_sensitive
+ * @return Whether the given characters are equal.
+ */
+[[nodiscard]] auto is_char_matched(char pattern_char, char logtype_char, bool case_sensitive)
+        -> bool;
+
+auto is_variable_placeholder(char c) -> bool {
+    return clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Integer) == c
+           || clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Dictionary) == c
+           || clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Float) == c;
+}
+
+auto is_char_matched(char pattern_char, char logtype_char, bool case_sensitive) -> bool {
+    if (case_sensitive) {
+        return pattern_char == logtype_char;
+    }
+    return std::tolower(static_cast<unsigned char>(pattern_char))
+           == std::tolower(static_cast<unsigned char>(logtype_char));
+}
+}  // namespace
+
+auto LogtypeMatcher::add_wildcard_query(std::string_view wildcard_query, bool case_sensitive)
+        -> void {
+    Pattern pattern{.tokens{}, .case_sensitive = case_sensitive};
+    bool is_escaped{false};
+    for (auto const c : wildcard_query) {
+        if (is_escaped) {
+            pattern.tokens.push_back({PatternTokenType::Literal, c});
+            is_escaped = false;
+            continue;
+        }
+        switch (c) {
+            case '\\':
+                is_escaped = true;
+                break;
+            case '?':
+                pattern.tokens.push_back({PatternTokenType::AnyChar, c});
+                break;
+            case '*':
+                // Consecutive `*` are equivalent to a single one.
+                if (pattern.tokens.empty()
+                    || PatternTokenType::AnyString != pattern.tokens.back().type)
+                {
+                    pattern.tokens.push_back({PatternTokenType::AnyString, c});
+                }
+                break;
+            default:
+                pattern.tokens.push_back({PatternTokenType::Literal, c});
+                break;
+        }
+    }
+    m_patterns.emplace_back(std::move(pattern));
+}
+
+auto LogtypeMatcher::match(std::string_view logtype, MatchState& state) const -> Result {
+    auto& result_cache_entries{state.m_result_cache_entries};
+    auto& result_cache{state.m_result_cache};
+    if (auto const it{result_cache.find(logtype)}; result_cache.end() != it) {
+        auto const entry_it{it->second};
+        result_cache_entries.splice(result_cache_entries.begin(), result_cache_entries, entry_it);
+        return entry_it->second;
+    }
+
+    auto& logtype_tokens{state.m_logtype_tokens};
+    logtype_tokens.clear();
+    bool is_escaped{false};
+    for (auto const c : logtype) {
+        if (is_escaped) {
+            logtype_tokens.push_back({false, c});
+            is_escaped = false;
+        } else if (clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Escape) == c) {
+            is_escaped = true;
+        } else {
+            logtype_tokens.push_back({is_variable_placeholder(c), c});
+        }
+    }
+
+    auto const result{evaluate(state)};
+    if (result_cache_entries.size() >= cResultCacheCapacity) {
+        // Reuse the least recently used entry to avoid reallocating it.
+        auto& [evicted_logtype, evicted_result]{result_cache_entries.back()};
+        result_cache.erase(evicted_logtype);
+        evicted_logtype = logtype;
+        evicted_result = result;
+        result_cache_entries.splice(
+                result_cache_entries.begin(),
+                result_cache_entries,
+                std::prev(result_cache_entries.end())
+        );
+    } else {
+        result_cache_entries.emplace_front(std::string{logtype}, result);
+    }
+    auto const entry_it{result_cache_entries.begin()};
+    result_cache.emplace(entry_it->first, entry_it);
+    return result;
+}
+
+auto LogtypeMatcher::evaluate(MatchState& state) const -> Result {
+    if (m_patterns.empty()) {
+        return Result::AlwaysMatches;
+    }
+    bool may_match{false};
+    for (auto const& pattern : m_patterns) {
+        if (match_pattern(pattern, false, state)) {
+            return Result::AlwaysMatches;
+        }
+        if (false == may_match && match_pattern(pattern, true, state)) {
+            may_match = true;
+        }
+    }
+    return may_match ? Result::DependsOnVariables : Result::NeverMatches;
+}
+
+auto LogtypeMatcher::match_pattern(
+        Pattern const& pattern,
+        bool variables_match_any_string,
+        MatchState& state
+) -> bool {
+    auto const& pattern_tokens{pattern.tokens};
+    auto const& logtype_tokens{state.m_logtype_tokens};
+    auto& match_table{state.m_match_table};
+    auto const num_pattern_tokens{pattern_tokens.size()};
+    auto const num_logtype_tokens{logtype_tokens.size()};
+
+    // `match_table[i * row_size + j]` indicates whether the pattern suffix starting at token `i`
+    // matches the logtype suffix starting at token `j`. The table is filled backwards since each
+    // entry only depends on the entries of shorter suffixes.
+    auto const row_size{num_logtype_tokens + 1};
+    match_table.assign((num_pattern_tokens + 1) * row_size, false);
+    auto const is_suffix_matched = [&](size_t pattern_idx, size_t logtype_idx) -> bool {
+        return match_table[pattern_idx * row_size + logtype_idx];
+    };
+
+    for (auto pattern_idx{num_pattern_tokens + 1}; pattern_idx-- > 0;) {
+        bool const is_pattern_end{num_pattern_tokens == pattern_idx};
+        for (auto logtype_idx{num_logtype_tokens + 1}; logtype_idx-- > 0;) {
+            bool const is_logtype_end{num_logtype_tokens == logtype_idx};
+            bool is_matched{false};
+            if (is_pattern_end && is_logtype_end) {
+                is_matched = true;
+            } else if (false == is_pattern_end
+                       && PatternTokenType::AnyString == pattern_tokens[pattern_idx].type)
+            {
+                // `*` either ends, or consumes the next logtype token (including an entire
+                // variable).
+                is_matched = is_suffix_matched(pattern_idx + 1, logtype_idx)
+                             || (false == is_logtype_end
+                                 && is_suffix_matched(pattern_idx, logtype_idx + 1));
+            } else if (false == is_logtype_end && logtype_tokens[logtype_idx].is_variable) {
+                // A variable can only be matched by a non-`*` token if it can be any string. In
+                // that case, the variable either ends, or produces a character that matches the
+                // next pattern token.
+                is_matched = variables_match_any_string
+                             && (is_suffix_matched(pattern_idx, logtype_idx + 1)
+                                 || (false == is_pattern_end
+                                     && is_suffix_matched(pattern_idx + 1, logtype_idx)));
+            } else if (false == is_pattern_end && false == is_logtype_end) {
+                auto const& pattern_token{pattern_tokens[pattern_idx]};
+                is_matched = (PatternTokenType::AnyChar == pattern_token.type
+                              || is_char_matched(
+                                      pattern_token.literal,
+                                      logtype_tokens[logtype_idx].literal,
+                                      pattern.case_sensitive
+                              ))
+                             && is_suffix_matched(pattern_idx + 1, logtype_idx + 1);
+            }
+            match_table[pattern_idx * row_size + logtype_idx] = is_matched;
+        }
+    }
+    return is_suffix_matched(0, 0);
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,148 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_LOGTYPEMATCHER_HPP
+#define CLP_FFI_PY_IR_NATIVE_LOGTYPEMATCHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class evaluates a list of wildcard queries against the logtype of an encoded log event,
+ * without decoding its variables. A logtype is the static text of a log message in which every
+ * variable is replaced by a placeholder. Since a variable can be any string, the logtype alone
+ * decides whether:
+ * - the log message matches at least one wildcard query regardless of its variables;
+ * - the log message can't match any wildcard query regardless of its variables;
+ * - otherwise, the result depends on the variables, and the log message must be decoded to match
+ *   the wildcard queries.
+ * Logtypes repeat heavily in a log stream, so the result of each logtype is cached in a
+ * `MatchState`. The cache is bounded to `cResultCacheCapacity` logtypes, evicting the least
+ * recently used one when full, so streams with many distinct logtypes don't grow it without bound.
+ * <p>
+ * NOTE: Matching doesn't modify the matcher, so a matcher can be shared by concurrent matches as
+ * long as each of them uses its own `MatchState`.
+ */
+class LogtypeMatcher {
+public:
+    // Types
+    enum class Result : uint8_t {
+        AlwaysMatches,
+        NeverMatches,
+        DependsOnVariables
+    };
+
+    class MatchState;
+
+    // Constants
+    static constexpr size_t cResultCacheCapacity{4096};
+
+    // Methods
+    /**
+     * Compiles and adds a wildcard query to match against. Must not be called once the matcher is
+     * used to match, since the results cached in the match states would be stale.
+     * @param wildcard_query Wildcard query. Must be valid (see `wildcard_match_unsafe`).
+     * @param case_sensitive
+     */
+    auto add_wildcard_query(std::string_view wildcard_query, bool case_sensitive) -> void;
+
+    /**
+     * Matches the added wildcard queries against the given logtype. If no wildcard query is added,
+     * any logtype always matches.
+     * @param logtype An encoded logtype of the four-byte or eight-byte IR encoding.
+     * @param state The state to look up and cache the result in.
+     * @return The (cached) result of the given logtype.
+     */
+    [[nodiscard]] auto match(std::string_view logtype, MatchState& state) const -> Result;
+
+private:
+    // Types
+    enum class PatternTokenType : uint8_t {
+        Literal,
+        AnyChar,
+        AnyString
+    };
+
+    struct PatternToken {
+        PatternTokenType type;
+        char literal;
+    };
+
+    struct Pattern {
+        std::vector<PatternToken> tokens;
+        bool case_sensitive;
+    };
+
+    /**
+     * A token of a logtype: either a static character, or a placeholder of a variable.
+     */
+    struct LogtypeToken {
+        bool is_variable;
+        char literal;
+    };
+
+    /**
+     * Evaluates all the added wildcard queries against the logtype stored in the given state.
+     * @param state
+     * @return The result of the logtype.
+     */
+    [[nodiscard]] auto evaluate(MatchState& state) const -> Result;
+
+    /**
+     * Matches the given pattern against the logtype stored in the given state.
+     * @param pattern
+     * @param variables_match_any_string If true, each variable can be replaced by any string to
+     * match the pattern. Otherwise, each variable must be entirely matched by a `*` in the pattern.
+     * @param state
+     * @return Whether the pattern matches.
+     */
+    [[nodiscard]] static auto
+    match_pattern(Pattern const& pattern, bool variables_match_any_string, MatchState& state)
+            -> bool;
+
+    std::vector<Pattern> m_patterns;
+};
+
+/**
+ * The mutable state of matching logtypes against one logtype matcher: the cached results and the
+ * scratch buffers reused across evaluations to avoid allocations. A state must only be used with
+ * one logtype matcher, and by one thread at a time.
+ */
+class LogtypeMatcher::MatchState {
+public:
+    // Constructor
+    MatchState() = default;
+
+    // Delete copy constructor and assignment operator since the cache index refers to the cache
+    // entries by address.
+    MatchState(MatchState const&) = delete;
+    auto operator=(MatchState const&) -> MatchState& = delete;
+
+    // Default move constructor and assignment operator
+    MatchState(MatchState&&) = default;
+    auto operator=(MatchState&&) -> MatchState& = default;
+
+    // Destructor
+    ~MatchState() = default;
+
+private:
+    friend class LogtypeMatcher;
+
+    using ResultCacheEntries = std::list<std::pair<std::string, Result>>;
+
+    // The cached results ordered from the most recently used to the least recently used, and an
+    // index of them keyed by views of the logtypes they own.
+    ResultCacheEntries m_result_cache_entries;
+    std::unordered_map<std::string_view, ResultCacheEntries::iterator> m_result_cache;
+
+    // Scratch buffers of the evaluation.
+    std::vector<LogtypeToken> m_logtype_tokens;
+    std::vector<bool> m_match_table;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_LOGTYPEMATCHER_HPP
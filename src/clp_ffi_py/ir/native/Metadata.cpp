@@ -27,33 +27,28 @@ auto is_valid_json_string_data(nlohmann::json const& json_data, char const* key)
 }
 }  // namespace
 
-Metadata::Metadata(nlohmann::json const& metadata, bool is_four_byte_encoding) {
-    if (false == is_four_byte_encoding) {
-        throw ExceptionFFI(
-                clp::ErrorCode_Unsupported,
-                __FILE__,
-                __LINE__,
-                "Eight Byte Preamble is not yet supported."
-        );
-    }
-    m_is_four_byte_encoding = is_four_byte_encoding;
-
-    auto const* ref_timestamp_key{static_cast<char const*>(
-            clp::ffi::ir_stream::cProtocol::Metadata::ReferenceTimestampKey
-    )};
-    if (false == is_valid_json_string_data(metadata, ref_timestamp_key)) {
-        throw ExceptionFFI(
-                clp::ErrorCode_MetadataCorrupted,
-                __FILE__,
-                __LINE__,
-                "Valid Reference Timestamp cannot be found in the metadata."
-        );
-    }
-    try {
-        std::string const ref_timestamp_str{metadata.at(ref_timestamp_key)};
-        m_ref_timestamp = static_cast<clp::ir::epoch_time_ms_t>(std::stoull(ref_timestamp_str));
-    } catch (std::exception const& ex) {
-        throw ExceptionFFI(clp::ErrorCode_Unsupported, __FILE__, __LINE__, ex.what());
+Metadata::Metadata(nlohmann::json const& metadata, bool is_four_byte_encoding)
+        : m_is_four_byte_encoding{is_four_byte_encoding},
+          m_ref_timestamp{0} {
+    // Only the four-byte encoding serializes timestamps as deltas from the reference timestamp.
+    if (m_is_four_byte_encoding) {
+        auto const* ref_timestamp_key{static_cast<char const*>(
+                clp::ffi::ir_stream::cProtocol::Metadata::ReferenceTimestampKey
+        )};
+        if (false == is_valid_json_string_data(metadata, ref_timestamp_key)) {
+            throw ExceptionFFI(
+                    clp::ErrorCode_MetadataCorrupted,
+                    __FILE__,
+                    __LINE__,
+                    "Valid Reference Timestamp cannot be found in the metadata."
+            );
+        }
+        try {
+            std::string const ref_timestamp_str{metadata.at(ref_timestamp_key)};
+            m_ref_timestamp = static_cast<clp::ir::epoch_time_ms_t>(std::stoull(ref_timestamp_str));
+        } catch (std::exception const& ex) {
+            throw ExceptionFFI(clp::ErrorCode_Unsupported, __FILE__, __LINE__, ex.what());
+        }
     }
 
     auto const* timestamp_format_key{
@@ -17,15 +17,16 @@ public:
     /**
      * Constructs a new Metadata object by reading values from a JSON object deserialized from the
      * preamble. This constructor will validate the JSON data and throw exceptions when failing to
-     * extract required values.
+     * extract required values. The reference timestamp is only required by the four-byte encoding,
+     * and is set to 0 for the eight-byte encoding.
      * @param metadata JSON data that contains the metadata.
      * @param is_four_byte_encoding
      */
     explicit Metadata(nlohmann::json const& metadata, bool is_four_byte_encoding);
 
     /**
-     * Constructs a new Metadata object from the provided fields. Currently,
-     * `m_is_four_byte_encoding` is set to true by default since it is the only format supported.
+     * Constructs a new Metadata object from the provided fields. `m_is_four_byte_encoding` is set
+     * to true since the reference timestamp is only used by the four-byte encoding.
      * @param ref_timestamp The reference timestamp used to calculate the timestamp of the first log
      * message in the IR stream.
      * @param timestamp_format Timestamp format to use when generating the logs with a reader.
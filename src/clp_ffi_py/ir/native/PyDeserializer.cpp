@@ -2,7 +2,9 @@
 
 #include "PyDeserializer.hpp"
 
+#include <memory>
 #include <new>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -14,15 +16,24 @@
 #include <clp/ffi/ir_stream/protocol_constants.hpp>
 #include <clp/ffi/KeyValuePairLogEvent.hpp>
 #include <clp/ffi/SchemaTree.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <clp/time_types.hpp>
 #include <clp/TraceableException.hpp>
+#include <gsl/gsl>
 #include <json/single_include/nlohmann/json.hpp>
 
 #include <clp_ffi_py/api_decoration.hpp>
 #include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/BufferViewReader.hpp>
 #include <clp_ffi_py/ir/native/DeserializerBufferReader.hpp>
 #include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/KeyValuePairStreamFilter.hpp>
+#include <clp_ffi_py/ir/native/KeyValuePairStreamStats.hpp>
 #include <clp_ffi_py/ir/native/PyKeyValuePairLogEvent.hpp>
+#include <clp_ffi_py/ir/native/PyQuery.hpp>
+#include <clp_ffi_py/ir/native/Query.hpp>
+#include <clp_ffi_py/ir/native/ReadaheadReader.hpp>
+#include <clp_ffi_py/ir/native/ZstdDecompressionReader.hpp>
 #include <clp_ffi_py/Py_utils.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
@@ -33,6 +44,26 @@ using clp::ffi::ir_stream::IRErrorCode;
 using clp::ffi::ir_stream::IrUnitType;
 
 namespace {
+/**
+ * Creates a reader to read the IR stream from the given input.
+ * @param input_stream
+ * @param buffer_capacity
+ * @param enable_zstd_decompression Whether the input is zstd-compressed and should be decompressed
+ * natively.
+ * @param num_readahead_buffers The number of buffers filled by a native readahead thread, or 0 to
+ * disable readahead.
+ * @param is_gil_free Returns whether the created reader can be used without holding the GIL.
+ * @return The transferred ownership of the created reader on success.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto create_reader(
+        PyObject* input_stream,
+        Py_ssize_t buffer_capacity,
+        bool enable_zstd_decompression,
+        Py_ssize_t num_readahead_buffers,
+        bool& is_gil_free
+) -> gsl::owner<clp::ReaderInterface*>;
+
 /**
  * Callback of `PyDeserializer`'s `__init__` method:
  */
@@ -41,17 +72,31 @@ PyDoc_STRVAR(
         cPyDeserializerDoc,
         "Deserializer for deserializing CLP key-value pair IR streams.\n"
         "This class deserializes a CLP key-value pair IR stream into log events.\n\n"
-        "__init__(self, input_stream, buffer_capacity=65536, allow_incomplete_stream=False)\n\n"
+        "__init__(self, input_stream, buffer_capacity=65536, allow_incomplete_stream=False,"
+        " enable_zstd_decompression=False, num_readahead_buffers=0)\n\n"
         "Initializes a :class:`Deserializer` instance with the given inputs. Note that each"
         " object should only be initialized once. Double initialization will result in a memory"
         " leak.\n\n"
-        ":param input_stream: Serialized CLP IR stream.\n"
-        ":type input_stream: IO[bytes]\n"
-        ":param buffer_capacity: The capacity of the underlying read buffer.\n"
+        ":param input_stream: Serialized CLP IR stream. It can be a readable byte stream, the path"
+        " of a file, or an object supporting the buffer protocol (e.g., `bytes` or `mmap.mmap`)."
+        " A file is memory-mapped, and a buffer is read in place; in both cases, the GIL is"
+        " released during deserialization.\n"
+        ":type input_stream: IO[bytes] | str | os.PathLike[str] | bytes | mmap.mmap\n"
+        ":param buffer_capacity: The capacity of the underlying read buffer. Only used when the"
+        " input is a byte stream.\n"
         ":type buffer_capacity: int\n"
         ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not"
         " treated as an error.\n"
         ":type allow_incomplete_stream: bool\n"
+        ":param enable_zstd_decompression: If set to `True`, the input is a zstd-compressed CLP IR"
+        " stream, which is decompressed natively with the GIL released.\n"
+        ":type enable_zstd_decompression: bool\n"
+        ":param num_readahead_buffers: If non-zero, the input, which must be a path or an object"
+        " supporting the buffer protocol, is read by a native readahead thread into the given"
+        " number (at least 2) of buffers, each of `buffer_capacity` bytes. The I/O latency of"
+        " the input is then overlapped with deserialization, which benefits inputs on slow"
+        " storage.\n"
+        ":type num_readahead_buffers: int\n"
 );
 CLP_FFI_PY_METHOD auto PyDeserializer_init(PyDeserializer* self, PyObject* args, PyObject* keywords)
         -> int;
@@ -89,6 +134,98 @@ PyDoc_STRVAR(
 );
 CLP_FFI_PY_METHOD auto PyDeserializer_get_user_defined_metadata(PyDeserializer* self) -> PyObject*;
 
+/**
+ * Callback of `PyDeserializer`'s `scan_stats` static method.
+ */
+PyDoc_STRVAR(
+        cPyDeserializerScanStatsDoc,
+        "scan_stats(input_stream, buffer_capacity=65536, allow_incomplete_stream=False,"
+        " enable_zstd_decompression=False, num_readahead_buffers=0)\n"
+        "--\n\n"
+        "Scans the given CLP key-value pair IR stream in a single pass and collects its statistics"
+        " natively, without creating any Python log event objects.\n\n"
+        "Keys are represented as tuples of key names, from the outermost to the innermost. Only"
+        " leaf keys (keys with a primitive value, or an empty dictionary as the value) are"
+        " counted.\n\n"
+        ":param input_stream: Serialized CLP key-value pair IR stream. It accepts the same types of"
+        " input as :meth:`__init__`.\n"
+        ":type input_stream: IO[bytes] | str | os.PathLike[str] | bytes | mmap.mmap\n"
+        ":param buffer_capacity: The capacity of the underlying read buffer. Only used when the"
+        " input is a byte stream.\n"
+        ":type buffer_capacity: int\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not"
+        " treated as an error.\n"
+        ":type allow_incomplete_stream: bool\n"
+        ":param enable_zstd_decompression: If set to `True`, the input is a zstd-compressed CLP IR"
+        " stream, which is decompressed natively.\n"
+        ":type enable_zstd_decompression: bool\n"
+        ":param num_readahead_buffers: The number of buffers filled by a native readahead thread."
+        " See :meth:`__init__`.\n"
+        ":type num_readahead_buffers: int\n"
+        ":return: A dictionary with the following items:\n\n"
+        "    - \"num_log_events\": The number of log events.\n"
+        "    - \"num_distinct_schemas\": The number of distinct sets of keys among all log"
+        " events.\n"
+        "    - \"num_encoded_bytes\": The total number of encoded bytes read from the stream.\n"
+        "    - \"auto_gen_key_frequencies\": The number of occurrences of each auto-generated"
+        " key.\n"
+        "    - \"auto_gen_numeric_ranges\": The (min, max) value of each auto-generated integer or"
+        " float key.\n"
+        "    - \"user_gen_key_frequencies\": The number of occurrences of each user-generated"
+        " key.\n"
+        "    - \"user_gen_numeric_ranges\": The (min, max) value of each user-generated integer or"
+        " float key.\n"
+        ":rtype: dict[str, Any]\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+);
+CLP_FFI_PY_METHOD auto
+PyDeserializer_scan_stats(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject*;
+
+/**
+ * Callback of `PyDeserializer`'s `filter_ir_stream` static method.
+ */
+PyDoc_STRVAR(
+        cPyDeserializerFilterIrStreamDoc,
+        "filter_ir_stream(input_stream, output_stream, query=None, buffer_capacity=65536,"
+        " allow_incomplete_stream=False, enable_zstd_decompression=False, num_readahead_buffers=0)"
+        "\n"
+        "--\n\n"
+        "Filters the given CLP key-value pair IR stream natively in a single pass, and writes the"
+        " matched log events into `output_stream` as a new, complete key-value pair IR stream,"
+        " without creating any Python log event objects.\n\n"
+        "The wildcard queries of the given query are matched against the JSON string of the"
+        " user-generated key-value pairs of each log event. The search time range of the query is"
+        " ignored. The user-defined stream-level metadata of the input stream is carried over."
+        " `output_stream` is not flushed nor closed.\n\n"
+        ":param input_stream: Serialized CLP key-value pair IR stream. It accepts the same types of"
+        " input as :meth:`__init__`.\n"
+        ":type input_stream: IO[bytes] | str | os.PathLike[str] | bytes | mmap.mmap\n"
+        ":param output_stream: A writable byte output stream.\n"
+        ":type output_stream: IO[bytes]\n"
+        ":param query: A Query object that filters log events. If not given, all log events are"
+        " written.\n"
+        ":type query: Query | None\n"
+        ":param buffer_capacity: The capacity of the underlying read buffer. Only used when the"
+        " input is a byte stream.\n"
+        ":type buffer_capacity: int\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not"
+        " treated as an error.\n"
+        ":type allow_incomplete_stream: bool\n"
+        ":param enable_zstd_decompression: If set to `True`, the input is a zstd-compressed CLP IR"
+        " stream, which is decompressed natively.\n"
+        ":type enable_zstd_decompression: bool\n"
+        ":param num_readahead_buffers: The number of buffers filled by a native readahead thread."
+        " See :meth:`__init__`.\n"
+        ":type num_readahead_buffers: int\n"
+        ":return: The number of log events written.\n"
+        ":rtype: int\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+);
+CLP_FFI_PY_METHOD auto
+PyDeserializer_filter_ir_stream(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject*;
+
 /**
  * Callback of `PyDeserializer`'s deallocator.
  */
@@ -106,6 +243,16 @@ PyMethodDef PyDeserializer_method_table[]{
          METH_NOARGS,
          static_cast<char const*>(cPyDeserializerGetUserDefinedMetadataDoc)},
 
+        {"scan_stats",
+         py_c_function_cast(PyDeserializer_scan_stats),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cPyDeserializerScanStatsDoc)},
+
+        {"filter_ir_stream",
+         py_c_function_cast(PyDeserializer_filter_ir_stream),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cPyDeserializerFilterIrStreamDoc)},
+
         {nullptr}
 };
 
@@ -134,15 +281,50 @@ PyType_Spec PyDeserializer_type_spec{
         static_cast<PyType_Slot*>(PyDeserializer_slots)
 };
 
+auto create_reader(
+        PyObject* input_stream,
+        Py_ssize_t buffer_capacity,
+        bool enable_zstd_decompression,
+        Py_ssize_t num_readahead_buffers,
+        bool& is_gil_free
+) -> gsl::owner<clp::ReaderInterface*> {
+    if (0 != num_readahead_buffers) {
+        // The readahead thread never calls into the Python interpreter, so the reader can be used
+        // without the GIL, with or without decompression.
+        is_gil_free = true;
+        std::unique_ptr<clp::ReaderInterface> readahead_reader{
+                ReadaheadReader::create(input_stream, num_readahead_buffers, buffer_capacity)
+        };
+        if (nullptr == readahead_reader || false == enable_zstd_decompression) {
+            return readahead_reader.release();
+        }
+        return ZstdDecompressionReader::create(std::move(readahead_reader), false);
+    }
+    if (enable_zstd_decompression) {
+        return ZstdDecompressionReader::create(input_stream, buffer_capacity, is_gil_free);
+    }
+    // `BufferViewReader` never calls into the Python interpreter, so it can be used without the
+    // GIL.
+    is_gil_free = BufferViewReader::is_supported_input(input_stream);
+    if (is_gil_free) {
+        return BufferViewReader::create(input_stream);
+    }
+    return DeserializerBufferReader::create(input_stream, buffer_capacity);
+}
+
 CLP_FFI_PY_METHOD auto PyDeserializer_init(PyDeserializer* self, PyObject* args, PyObject* keywords)
         -> int {
     static char keyword_input_stream[]{"input_stream"};
     static char keyword_buffer_capacity[]{"buffer_capacity"};
     static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char keyword_enable_zstd_decompression[]{"enable_zstd_decompression"};
+    static char keyword_num_readahead_buffers[]{"num_readahead_buffers"};
     static char* keyword_table[]{
             static_cast<char*>(keyword_input_stream),
             static_cast<char*>(keyword_buffer_capacity),
             static_cast<char*>(keyword_allow_incomplete_stream),
+            static_cast<char*>(keyword_enable_zstd_decompression),
+            static_cast<char*>(keyword_num_readahead_buffers),
             nullptr
     };
 
@@ -153,22 +335,32 @@ CLP_FFI_PY_METHOD auto PyDeserializer_init(PyDeserializer* self, PyObject* args,
     PyObject* input_stream{};
     Py_ssize_t buffer_capacity{PyDeserializer::cDefaultBufferCapacity};
     int allow_incomplete_stream{0};
+    int enable_zstd_decompression{0};
+    Py_ssize_t num_readahead_buffers{0};
     if (false
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
                 keywords,
-                "O|np",
+                "O|nppn",
                 static_cast<char**>(keyword_table),
                 &input_stream,
                 &buffer_capacity,
-                &allow_incomplete_stream
+                &allow_incomplete_stream,
+                &enable_zstd_decompression,
+                &num_readahead_buffers
         )))
     {
         return -1;
     }
 
     if (false
-        == self->init(input_stream, buffer_capacity, static_cast<bool>(allow_incomplete_stream)))
+        == self->init(
+                input_stream,
+                buffer_capacity,
+                static_cast<bool>(allow_incomplete_stream),
+                static_cast<bool>(enable_zstd_decompression),
+                num_readahead_buffers
+        ))
     {
         return -1;
     }
@@ -177,6 +369,10 @@ CLP_FFI_PY_METHOD auto PyDeserializer_init(PyDeserializer* self, PyObject* args,
 }
 
 CLP_FFI_PY_METHOD auto PyDeserializer_deserialize_log_event(PyDeserializer* self) -> PyObject* {
+    PyDeserializerGuard const deserializer_guard{self};
+    if (false == deserializer_guard.is_acquired()) {
+        return nullptr;
+    }
     return self->deserialize_log_event();
 }
 
@@ -214,6 +410,138 @@ CLP_FFI_PY_METHOD auto PyDeserializer_get_user_defined_metadata(PyDeserializer*
     return py_metadata_dict.release();
 }
 
+CLP_FFI_PY_METHOD auto
+PyDeserializer_scan_stats(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject* {
+    static char keyword_input_stream[]{"input_stream"};
+    static char keyword_buffer_capacity[]{"buffer_capacity"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char keyword_enable_zstd_decompression[]{"enable_zstd_decompression"};
+    static char keyword_num_readahead_buffers[]{"num_readahead_buffers"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_input_stream),
+            static_cast<char*>(keyword_buffer_capacity),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            static_cast<char*>(keyword_enable_zstd_decompression),
+            static_cast<char*>(keyword_num_readahead_buffers),
+            nullptr
+    };
+
+    PyObject* input_stream{};
+    Py_ssize_t buffer_capacity{PyDeserializer::cDefaultBufferCapacity};
+    int allow_incomplete_stream{0};
+    int enable_zstd_decompression{0};
+    Py_ssize_t num_readahead_buffers{0};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O|nppn",
+                static_cast<char**>(keyword_table),
+                &input_stream,
+                &buffer_capacity,
+                &allow_incomplete_stream,
+                &enable_zstd_decompression,
+                &num_readahead_buffers
+        )))
+    {
+        return nullptr;
+    }
+
+    bool is_gil_free{false};
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    std::unique_ptr<clp::ReaderInterface> const reader{create_reader(
+            input_stream,
+            buffer_capacity,
+            static_cast<bool>(enable_zstd_decompression),
+            num_readahead_buffers,
+            is_gil_free
+    )};
+    if (nullptr == reader) {
+        return nullptr;
+    }
+    return KeyValuePairStreamStats::scan(
+            *reader,
+            static_cast<bool>(allow_incomplete_stream),
+            is_gil_free
+    );
+}
+
+CLP_FFI_PY_METHOD auto
+PyDeserializer_filter_ir_stream(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject* {
+    static char keyword_input_stream[]{"input_stream"};
+    static char keyword_output_stream[]{"output_stream"};
+    static char keyword_query[]{"query"};
+    static char keyword_buffer_capacity[]{"buffer_capacity"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char keyword_enable_zstd_decompression[]{"enable_zstd_decompression"};
+    static char keyword_num_readahead_buffers[]{"num_readahead_buffers"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_input_stream),
+            static_cast<char*>(keyword_output_stream),
+            static_cast<char*>(keyword_query),
+            static_cast<char*>(keyword_buffer_capacity),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            static_cast<char*>(keyword_enable_zstd_decompression),
+            static_cast<char*>(keyword_num_readahead_buffers),
+            nullptr
+    };
+
+    PyObject* input_stream{};
+    PyObject* output_stream{};
+    PyObject* py_query{Py_None};
+    Py_ssize_t buffer_capacity{PyDeserializer::cDefaultBufferCapacity};
+    int allow_incomplete_stream{0};
+    int enable_zstd_decompression{0};
+    Py_ssize_t num_readahead_buffers{0};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "OO|Onppn",
+                static_cast<char**>(keyword_table),
+                &input_stream,
+                &output_stream,
+                &py_query,
+                &buffer_capacity,
+                &allow_incomplete_stream,
+                &enable_zstd_decompression,
+                &num_readahead_buffers
+        )))
+    {
+        return nullptr;
+    }
+
+    Query const* query{nullptr};
+    if (Py_None != py_query) {
+        if (false == static_cast<bool>(PyObject_TypeCheck(py_query, PyQuery::get_py_type()))) {
+            PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
+            return nullptr;
+        }
+        query = py_reinterpret_cast<PyQuery>(py_query)->get_query();
+    }
+
+    bool is_gil_free{false};
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    std::unique_ptr<clp::ReaderInterface> const reader{create_reader(
+            input_stream,
+            buffer_capacity,
+            static_cast<bool>(enable_zstd_decompression),
+            num_readahead_buffers,
+            is_gil_free
+    )};
+    if (nullptr == reader) {
+        return nullptr;
+    }
+    return KeyValuePairStreamFilter::filter(
+            *reader,
+            output_stream,
+            query,
+            static_cast<bool>(allow_incomplete_stream)
+    );
+}
+
 CLP_FFI_PY_METHOD auto PyDeserializer_dealloc(PyDeserializer* self) -> void {
     self->clean();
     Py_TYPE(self)->tp_free(py_reinterpret_cast<PyObject>(self));
@@ -233,11 +561,19 @@ auto PyDeserializer::module_level_init(PyObject* py_module) -> bool {
 auto PyDeserializer::init(
         PyObject* input_stream,
         Py_ssize_t buffer_capacity,
-        bool allow_incomplete_stream
+        bool allow_incomplete_stream,
+        bool enable_zstd_decompression,
+        Py_ssize_t num_readahead_buffers
 ) -> bool {
     m_allow_incomplete_stream = allow_incomplete_stream;
-    m_deserializer_buffer_reader = DeserializerBufferReader::create(input_stream, buffer_capacity);
-    if (nullptr == m_deserializer_buffer_reader) {
+    m_reader = create_reader(
+            input_stream,
+            buffer_capacity,
+            enable_zstd_decompression,
+            num_readahead_buffers,
+            m_release_gil_during_deserialization
+    );
+    if (nullptr == m_reader) {
         return false;
     }
 
@@ -260,7 +596,7 @@ auto PyDeserializer::init(
                 = [this]() -> IRErrorCode { return this->handle_end_of_stream(); };
 
         auto deserializer_result{Deserializer::create(
-                *m_deserializer_buffer_reader,
+                *m_reader,
                 {std::move(log_event_handle),
                  std::move(trivial_utc_offset_handle),
                  std::move(trivial_schema_tree_node_insertion_handle),
@@ -296,9 +632,13 @@ auto PyDeserializer::init(
 auto PyDeserializer::deserialize_log_event() -> PyObject* {
     try {
         while (false == is_stream_completed()) {
-            auto const ir_unit_type_result{
-                    m_deserializer->deserialize_next_ir_unit(*m_deserializer_buffer_reader)
-            };
+            auto const ir_unit_type_result{[&]() {
+                std::optional<PyGilReleaseGuard> gil_release_guard;
+                if (m_release_gil_during_deserialization) {
+                    gil_release_guard.emplace();
+                }
+                return m_deserializer->deserialize_next_ir_unit(*m_reader);
+            }()};
             if (ir_unit_type_result.has_error()) {
                 auto const err{ir_unit_type_result.error()};
                 if (std::errc::result_out_of_range != err) {
@@ -343,6 +683,18 @@ auto PyDeserializer::deserialize_log_event() -> PyObject* {
     Py_RETURN_NONE;
 }
 
+auto PyDeserializer::acquire() -> bool {
+    if (m_is_in_use) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cDeserializerInUseError)
+        );
+        return false;
+    }
+    m_is_in_use = true;
+    return true;
+}
+
 auto PyDeserializer::get_user_defined_metadata() const -> nlohmann::json const* {
     auto const& metadata{m_deserializer->get_metadata()};
     std::string const user_defined_metadata_key{
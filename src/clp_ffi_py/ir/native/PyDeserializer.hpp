@@ -10,18 +10,22 @@
 #include <clp/ffi/ir_stream/Deserializer.hpp>
 #include <clp/ffi/KeyValuePairLogEvent.hpp>
 #include <clp/ffi/SchemaTree.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <clp/time_types.hpp>
 #include <gsl/gsl>
 #include <json/single_include/nlohmann/json.hpp>
 
-#include <clp_ffi_py/ir/native/DeserializerBufferReader.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
 /**
  * A PyObject structure for deserializing CLP key-value pair IR stream. The underlying deserializer
- * is pointed by `m_deserializer`, which reads the IR stream from a Python `IO[byte]` object via
- * `DeserializerBufferReader`.
+ * is pointed by `m_deserializer`, which reads the IR stream through `m_reader`:
+ * - `BufferViewReader` if the input is a path or an object supporting the buffer protocol. The
+ *   stream is then read in place, and the GIL is released during deserialization.
+ * - `DeserializerBufferReader` if the input is a Python `IO[byte]` object.
+ * - `ZstdDecompressionReader` on top of one of the above if the input is zstd-compressed. The GIL
+ *   is released during decompression in either case.
  */
 class PyDeserializer {
 public:
@@ -68,17 +72,27 @@ public:
      * to initialize the underlying deserializer and deserializer buffer reader. Other data members
      * are assumed to be zero-initialized by `default-init` method. It has to be manually called
      * whenever creating a new `PyDeserializer` object through CPython APIs.
-     * @param input_stream The input IR stream. Must be a Python `IO[byte]` object.
+     * @param input_stream The input IR stream. Must be a Python `IO[byte]` object, a path, or an
+     * object supporting the buffer protocol.
      * @param buffer_capacity The buffer capacity used to initialize the underlying
-     * `PyDeserializerBufferReader`.
+     * `PyDeserializerBufferReader`. Unused if the input isn't a Python `IO[byte]` object.
      * @param allow_incomplete_stream Whether to treat an incomplete CLP IR stream as an error. When
      * set to `true`, an incomplete stream is interpreted as the end of the stream without raising
      * an exception.
+     * @param enable_zstd_decompression Whether the input IR stream is zstd-compressed and should be
+     * decompressed natively.
+     * @param num_readahead_buffers The number of buffers filled by a native readahead thread, each
+     * of `buffer_capacity` bytes, or 0 to disable readahead.
      * @return true on success.
      * @return false on failure with the relevant Python exception and error set.
      */
-    [[nodiscard]] auto
-    init(PyObject* input_stream, Py_ssize_t buffer_capacity, bool allow_incomplete_stream) -> bool;
+    [[nodiscard]] auto init(
+            PyObject* input_stream,
+            Py_ssize_t buffer_capacity,
+            bool allow_incomplete_stream,
+            bool enable_zstd_decompression,
+            Py_ssize_t num_readahead_buffers
+    ) -> bool;
 
     /**
      * Zero-initializes all the data members in `PyDeserializer`. Should be called once the
@@ -87,7 +101,9 @@ public:
     auto default_init() -> void {
         m_end_of_stream_reached = false;
         m_allow_incomplete_stream = false;
-        m_deserializer_buffer_reader = nullptr;
+        m_release_gil_during_deserialization = false;
+        m_is_in_use = false;
+        m_reader = nullptr;
         m_deserializer = nullptr;
         m_deserialized_log_event = nullptr;
     }
@@ -97,7 +113,7 @@ public:
      */
     auto clean() -> void {
         delete m_deserializer;
-        delete m_deserializer_buffer_reader;
+        delete m_reader;
         clear_deserialized_log_event();
     }
 
@@ -117,6 +133,22 @@ public:
      */
     [[nodiscard]] auto get_user_defined_metadata() const -> nlohmann::json const*;
 
+    /**
+     * Marks the deserializer as in use until `release` is called. A method must acquire the
+     * deserializer before deserializing, since the GIL may be released during deserialization,
+     * which would otherwise allow another Python thread to run the same underlying deserializer and
+     * reader concurrently.
+     * @return true on success.
+     * @return false if the deserializer is already in use, with the relevant Python exception and
+     * error set.
+     */
+    [[nodiscard]] auto acquire() -> bool;
+
+    /**
+     * Releases the deserializer acquired by `acquire`.
+     */
+    auto release() -> void { m_is_in_use = false; }
+
 private:
     /**
      * Class that implements `clp::ffi::ir_stream::IrUnitHandlerInterface` for deserializing
@@ -251,12 +283,51 @@ private:
     PyObject_HEAD;
     bool m_end_of_stream_reached;
     bool m_allow_incomplete_stream;
+    bool m_release_gil_during_deserialization;
+    bool m_is_in_use;
     // NOLINTBEGIN(cppcoreguidelines-owning-memory)
-    gsl::owner<DeserializerBufferReader*> m_deserializer_buffer_reader;
+    gsl::owner<clp::ReaderInterface*> m_reader;
     gsl::owner<Deserializer*> m_deserializer;
     gsl::owner<clp::ffi::KeyValuePairLogEvent*> m_deserialized_log_event;
     // NOLINTEND(cppcoreguidelines-owning-memory)
 };
+
+/**
+ * A guard class that acquires a `PyDeserializer` upon initialization and releases it upon
+ * destruction (see `PyDeserializer::acquire`).
+ */
+class PyDeserializerGuard {
+public:
+    // Constructor
+    explicit PyDeserializerGuard(PyDeserializer* deserializer)
+            : m_deserializer{deserializer},
+              m_is_acquired{deserializer->acquire()} {}
+
+    // Destructor
+    ~PyDeserializerGuard() {
+        if (m_is_acquired) {
+            m_deserializer->release();
+        }
+    }
+
+    // Delete copy/move constructor and assignment
+    PyDeserializerGuard(PyDeserializerGuard const&) = delete;
+    PyDeserializerGuard(PyDeserializerGuard&&) = delete;
+    auto operator=(PyDeserializerGuard const&) -> PyDeserializerGuard& = delete;
+    auto operator=(PyDeserializerGuard&&) -> PyDeserializerGuard& = delete;
+
+    // Methods
+    /**
+     * @return Whether the deserializer has been acquired. If not, the relevant Python exception and
+     * error are set.
+     */
+    [[nodiscard]] auto is_acquired() const -> bool { return m_is_acquired; }
+
+private:
+    // Variables
+    PyDeserializer* m_deserializer;
+    bool m_is_acquired;
+};
 }  // namespace clp_ffi_py::ir::native
 
 #endif  // CLP_FFI_PY_IR_NATIVE_PYDESERIALIZER_HPP
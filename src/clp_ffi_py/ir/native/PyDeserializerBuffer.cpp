@@ -5,16 +5,27 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
 #include <random>
 #include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/TraceableException.hpp>
 #include <clp/type_utils.hpp>
 
 #include <clp_ffi_py/api_decoration.hpp>
 #include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/BufferViewReader.hpp>
 #include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/Query.hpp>
+#include <clp_ffi_py/ir/native/ReadaheadReader.hpp>
+#include <clp_ffi_py/ir/native/ZstdDecompressionReader.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 #include <clp_ffi_py/utils.hpp>
@@ -23,7 +34,9 @@ namespace clp_ffi_py::ir::native {
 namespace {
 /**
  * Callback of PyDeserializerBuffer `__init__` method:
- * __init__(self, input_stream: IO[bytes], initial_buffer_capacity: int = 4096)
+ * __init__(self, input_stream: IO[bytes] | str | os.PathLike[str] | bytes | mmap.mmap,
+ *          initial_buffer_capacity: int = 4096, enable_zstd_decompression: bool = False,
+ *          num_readahead_buffers: int = 0, max_buffer_capacity: Optional[int] = None)
  * Keyword argument parsing is supported.
  * Assumes `self` is uninitialized and will allocate the underlying memory. If `self` is already
  * initialized this will result in memory leaks.
@@ -123,11 +136,25 @@ PyDoc_STRVAR(
         "class is expected to be passed across different calls of CLP IR deserialization methods "
         "when deserializing from the same IR stream.\n\n"
         "The signature of `__init__` method is shown as following:\n\n"
-        "__init__(self, input_stream, initial_buffer_capacity=4096)\n\n"
+        "__init__(self, input_stream, initial_buffer_capacity=4096,"
+        " enable_zstd_decompression=False, num_readahead_buffers=0, max_buffer_capacity=None)\n\n"
         "Initializes a DeserializerBuffer object for the given input IR stream.\n\n"
         ":param input_stream: Input stream that contains serialized CLP IR. It should be an "
-        "instance of type `IO[bytes]` with the method `readinto` supported.\n"
-        ":param initial_buffer_capacity: The initial capacity of the underlying byte buffer.\n"
+        "instance of type `IO[bytes]` with the method `readinto` supported, the path of a file, "
+        "or an object supporting the buffer protocol (e.g., `bytes` or `mmap.mmap`). A file is "
+        "memory-mapped, and a buffer is read in place without being copied.\n"
+        ":param initial_buffer_capacity: The initial capacity of the underlying byte buffer. Only "
+        "used when the input is an `IO[bytes]` object, is decompressed, or is read ahead.\n"
+        ":param enable_zstd_decompression: If set to `True`, the input is zstd-compressed, and "
+        "it's decompressed natively with the GIL released.\n"
+        ":param num_readahead_buffers: If non-zero, the input, which must be a path or an object "
+        "supporting the buffer protocol, is read by a native readahead thread into the given "
+        "number (at least 2) of buffers, each of `initial_buffer_capacity` bytes, while the "
+        "buffered bytes are being deserialized.\n"
+        ":param max_buffer_capacity: The maximum capacity that the underlying byte buffer can grow "
+        "to when buffering a large IR unit. If the buffer is full at its maximum capacity, reading "
+        "fails with `RuntimeError`. If `None`, the capacity is unbounded. Once the large IR unit "
+        "is consumed, the buffer shrinks back towards `initial_buffer_capacity`.\n"
 );
 
 // NOLINTBEGIN(cppcoreguidelines-pro-type-*-cast)
@@ -167,9 +194,15 @@ CLP_FFI_PY_METHOD auto
 PyDeserializerBuffer_init(PyDeserializerBuffer* self, PyObject* args, PyObject* keywords) -> int {
     static char keyword_input_stream[]{"input_stream"};
     static char keyword_initial_buffer_capacity[]{"initial_buffer_capacity"};
+    static char keyword_enable_zstd_decompression[]{"enable_zstd_decompression"};
+    static char keyword_num_readahead_buffers[]{"num_readahead_buffers"};
+    static char keyword_max_buffer_capacity[]{"max_buffer_capacity"};
     static char* keyword_table[]{
             static_cast<char*>(keyword_input_stream),
             static_cast<char*>(keyword_initial_buffer_capacity),
+            static_cast<char*>(keyword_enable_zstd_decompression),
+            static_cast<char*>(keyword_num_readahead_buffers),
+            static_cast<char*>(keyword_max_buffer_capacity),
             nullptr
     };
 
@@ -179,35 +212,59 @@ PyDeserializerBuffer_init(PyDeserializerBuffer* self, PyObject* args, PyObject*
 
     PyObject* input_stream{nullptr};
     Py_ssize_t initial_buffer_capacity{PyDeserializerBuffer::cDefaultInitialCapacity};
+    int enable_zstd_decompression{0};
+    Py_ssize_t num_readahead_buffers{0};
+    PyObject* py_max_buffer_capacity{Py_None};
     if (false
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
                 keywords,
-                "O|L",
+                "O|LpnO",
                 static_cast<char**>(keyword_table),
                 &input_stream,
-                &initial_buffer_capacity
+                &initial_buffer_capacity,
+                &enable_zstd_decompression,
+                &num_readahead_buffers,
+                &py_max_buffer_capacity
         )))
     {
         return -1;
     }
 
-    PyObjectPtr<PyObject> const readinto_method_obj{PyObject_GetAttrString(input_stream, "readinto")
-    };
-    auto* readinto_method{readinto_method_obj.get()};
-    if (nullptr == readinto_method) {
+    Py_ssize_t max_buffer_capacity{PyDeserializerBuffer::cUnboundedMaxCapacity};
+    if (Py_None != py_max_buffer_capacity
+        && false == parse_py_int<Py_ssize_t>(py_max_buffer_capacity, max_buffer_capacity))
+    {
         return -1;
     }
 
-    if (false == static_cast<bool>(PyCallable_Check(readinto_method))) {
-        PyErr_SetString(
-                PyExc_TypeError,
-                "The attribute `readinto` of the given input stream object is not callable."
-        );
-        return -1;
+    if (false == BufferViewReader::is_supported_input(input_stream)) {
+        PyObjectPtr<PyObject> const readinto_method_obj{
+                PyObject_GetAttrString(input_stream, "readinto")
+        };
+        auto* readinto_method{readinto_method_obj.get()};
+        if (nullptr == readinto_method) {
+            return -1;
+        }
+
+        if (false == static_cast<bool>(PyCallable_Check(readinto_method))) {
+            PyErr_SetString(
+                    PyExc_TypeError,
+                    "The attribute `readinto` of the given input stream object is not callable."
+            );
+            return -1;
+        }
     }
 
-    if (false == self->init(input_stream, initial_buffer_capacity)) {
+    if (false
+        == self->init(
+                input_stream,
+                initial_buffer_capacity,
+                static_cast<bool>(enable_zstd_decompression),
+                num_readahead_buffers,
+                max_buffer_capacity
+        ))
+    {
         return -1;
     }
 
@@ -241,12 +298,21 @@ PyDeserializerBuffer_test_streaming(PyDeserializerBuffer* self, PyObject* seed_o
     if (false == parse_py_int<uint32_t>(seed_obj, seed)) {
         return nullptr;
     }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{self};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
     return self->test_streaming(seed);
 }
 }  // namespace
 
-auto PyDeserializerBuffer::create(PyObject* input_stream, Py_ssize_t buf_capacity)
-        -> PyDeserializerBuffer* {
+auto PyDeserializerBuffer::create(
+        PyObject* input_stream,
+        Py_ssize_t buf_capacity,
+        bool enable_zstd_decompression,
+        Py_ssize_t num_readahead_buffers,
+        Py_ssize_t max_buf_capacity
+) -> PyDeserializerBuffer* {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
     PyDeserializerBuffer* self{PyObject_New(PyDeserializerBuffer, get_py_type())};
     if (nullptr == self) {
@@ -257,7 +323,15 @@ auto PyDeserializerBuffer::create(PyObject* input_stream, Py_ssize_t buf_capacit
         return nullptr;
     }
     self->default_init();
-    if (false == self->init(input_stream, buf_capacity)) {
+    if (false
+        == self->init(
+                input_stream,
+                buf_capacity,
+                enable_zstd_decompression,
+                num_readahead_buffers,
+                max_buf_capacity
+        ))
+    {
         return nullptr;
     }
     return self;
@@ -296,55 +370,128 @@ auto PyDeserializerBuffer::module_level_init(PyObject* py_module) -> bool {
     return add_python_type(get_py_type(), "DeserializerBuffer", py_module);
 }
 
-auto PyDeserializerBuffer::init(PyObject* input_stream, Py_ssize_t buf_capacity) -> bool {
+auto PyDeserializerBuffer::init(
+        PyObject* input_stream,
+        Py_ssize_t buf_capacity,
+        bool enable_zstd_decompression,
+        Py_ssize_t num_readahead_buffers,
+        Py_ssize_t max_buf_capacity
+) -> bool {
     if (0 >= buf_capacity) {
         PyErr_SetString(PyExc_ValueError, "Buffer capacity must be a positive integer (> 0).");
         return false;
     }
+    if (buf_capacity > max_buf_capacity) {
+        PyErr_SetString(
+                PyExc_ValueError,
+                "The maximum buffer capacity must not be less than the initial buffer capacity."
+        );
+        return false;
+    }
+    m_initial_buffer_capacity = buf_capacity;
+    m_max_buffer_capacity = max_buf_capacity;
+    if (0 != num_readahead_buffers) {
+        m_native_reader
+                = ReadaheadReader::create(input_stream, num_readahead_buffers, buf_capacity);
+        if (nullptr == m_native_reader) {
+            return false;
+        }
+        m_is_native_reader_gil_free = true;
+        if (enable_zstd_decompression) {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            std::unique_ptr<clp::ReaderInterface> readahead_reader{m_native_reader};
+            m_native_reader = ZstdDecompressionReader::create(std::move(readahead_reader), false);
+            if (nullptr == m_native_reader) {
+                return false;
+            }
+        }
+    } else if (enable_zstd_decompression) {
+        m_native_reader = ZstdDecompressionReader::create(
+                input_stream,
+                buf_capacity,
+                m_is_native_reader_gil_free
+        );
+        if (nullptr == m_native_reader) {
+            return false;
+        }
+    } else if (BufferViewReader::is_supported_input(input_stream)) {
+        m_buffer_view_reader = BufferViewReader::create(input_stream);
+        if (nullptr == m_buffer_view_reader) {
+            return false;
+        }
+        m_read_buffer = m_buffer_view_reader->get_view();
+        m_buffer_size = static_cast<Py_ssize_t>(m_read_buffer.size());
+        return true;
+    }
     m_read_buffer_mem_owner = static_cast<int8_t*>(PyMem_Malloc(buf_capacity));
     if (nullptr == m_read_buffer_mem_owner) {
         PyErr_NoMemory();
         return false;
     }
     m_read_buffer = std::span<int8_t>{m_read_buffer_mem_owner, static_cast<size_t>(buf_capacity)};
-    m_input_ir_stream = input_stream;
-    Py_INCREF(m_input_ir_stream);
+    if (nullptr == m_native_reader) {
+        m_input_ir_stream = input_stream;
+        Py_INCREF(m_input_ir_stream);
+    }
     return true;
 }
 
 auto PyDeserializerBuffer::populate_read_buffer(Py_ssize_t& num_bytes_read) -> bool {
-    auto const unconsumed_bytes_in_curr_read_buffer{get_unconsumed_bytes()};
-    auto const num_unconsumed_bytes{
-            static_cast<Py_ssize_t>(unconsumed_bytes_in_curr_read_buffer.size())
-    };
+    if (is_reading_from_buffer_view()) {
+        num_bytes_read = 0;
+        return true;
+    }
+
+    auto const num_unconsumed_bytes{get_num_unconsumed_bytes()};
     auto const buffer_capacity{static_cast<Py_ssize_t>(m_read_buffer.size())};
 
-    if (num_unconsumed_bytes > (buffer_capacity / 2)) {
-        // PyMem_Realloc is not used to avoid redundant memory copy
-        auto const new_capacity{buffer_capacity * 2};
-        auto* new_buf{static_cast<int8_t*>(PyMem_Malloc(new_capacity))};
-        if (nullptr == new_buf) {
-            PyErr_NoMemory();
+    if (num_unconsumed_bytes > (buffer_capacity / 2) && buffer_capacity < m_max_buffer_capacity) {
+        // Grows the buffer so that at least half of it is free for reading.
+        auto const new_capacity{
+                buffer_capacity > m_max_buffer_capacity - buffer_capacity
+                        ? m_max_buffer_capacity
+                        : buffer_capacity * 2
+        };
+        if (false == resize_read_buffer(new_capacity)) {
+            return false;
+        }
+    } else if (buffer_capacity > m_initial_buffer_capacity
+               && num_unconsumed_bytes <= (buffer_capacity / 4))
+    {
+        // The large IR unit that grew the buffer has been consumed, so shrink the buffer back. The
+        // buffer is halved at a time so that a stream of similarly-sized large IR units doesn't
+        // cause a reallocation on every refill.
+        if (false
+            == resize_read_buffer(std::max(m_initial_buffer_capacity, buffer_capacity / 2)))
+        {
             return false;
         }
-        std::span<int8_t> const new_read_buffer{new_buf, static_cast<size_t>(new_capacity)};
+    } else if (m_buffer_size > (buffer_capacity / 2)) {
+        // Only compacts when the free tail is less than half of the buffer. Otherwise, the tail is
+        // large enough for reading, and the unconsumed bytes are left in place to avoid a memmove
+        // on every refill.
+        auto const unconsumed_bytes_in_curr_read_buffer{get_unconsumed_bytes()};
         std::ranges::copy(
                 unconsumed_bytes_in_curr_read_buffer.begin(),
                 unconsumed_bytes_in_curr_read_buffer.end(),
-                new_read_buffer.begin()
+                get_writable_read_buffer().begin()
         );
-        PyMem_Free(m_read_buffer_mem_owner);
-        m_read_buffer_mem_owner = new_buf;
-        m_read_buffer = new_read_buffer;
-    } else if (0 < num_unconsumed_bytes) {
-        std::ranges::copy(
-                unconsumed_bytes_in_curr_read_buffer.begin(),
-                unconsumed_bytes_in_curr_read_buffer.end(),
-                m_read_buffer.begin()
+        m_num_current_bytes_consumed = 0;
+        m_buffer_size = num_unconsumed_bytes;
+    }
+
+    if (static_cast<Py_ssize_t>(m_read_buffer.size()) == m_buffer_size) {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cDeserializerBufferMaxCapacityErrorFormatStr),
+                m_max_buffer_capacity
         );
+        return false;
+    }
+
+    if (nullptr != m_native_reader) {
+        return read_from_native_reader(num_bytes_read);
     }
-    m_num_current_bytes_consumed = 0;
-    m_buffer_size = num_unconsumed_bytes;
 
     enable_py_buffer_protocol();
     PyObjectPtr<PyObject> const num_read_byte_obj{PyObject_CallMethod(
@@ -366,6 +513,59 @@ auto PyDeserializerBuffer::populate_read_buffer(Py_ssize_t& num_bytes_read) -> b
     return true;
 }
 
+auto PyDeserializerBuffer::resize_read_buffer(Py_ssize_t new_capacity) -> bool {
+    auto const unconsumed_bytes_in_curr_read_buffer{get_unconsumed_bytes()};
+    // PyMem_Realloc is not used to avoid redundant memory copy
+    auto* new_buf{static_cast<int8_t*>(PyMem_Malloc(new_capacity))};
+    if (nullptr == new_buf) {
+        PyErr_NoMemory();
+        return false;
+    }
+    std::span<int8_t> const new_read_buffer{new_buf, static_cast<size_t>(new_capacity)};
+    std::ranges::copy(
+            unconsumed_bytes_in_curr_read_buffer.begin(),
+            unconsumed_bytes_in_curr_read_buffer.end(),
+            new_read_buffer.begin()
+    );
+    PyMem_Free(m_read_buffer_mem_owner);
+    m_read_buffer_mem_owner = new_buf;
+    m_read_buffer = new_read_buffer;
+    m_buffer_size = static_cast<Py_ssize_t>(unconsumed_bytes_in_curr_read_buffer.size());
+    m_num_current_bytes_consumed = 0;
+    return true;
+}
+
+auto PyDeserializerBuffer::read_from_native_reader(Py_ssize_t& num_bytes_read) -> bool {
+    auto const buffer{get_writable_read_buffer().subspan(static_cast<size_t>(m_buffer_size))};
+    size_t num_bytes_read_from_reader{0};
+    auto err{clp::ErrorCode_Success};
+    try {
+        std::optional<PyGilReleaseGuard> gil_release_guard;
+        if (m_is_native_reader_gil_free) {
+            gil_release_guard.emplace();
+        }
+        err = m_native_reader->try_read(
+                clp::size_checked_pointer_cast<char>(buffer.data()),
+                buffer.size(),
+                num_bytes_read_from_reader
+        );
+    } catch (clp::TraceableException& exception) {
+        handle_traceable_exception(exception);
+        return false;
+    }
+    if (clp::ErrorCode_Success != err && clp::ErrorCode_EndOfFile != err) {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                "Failed to read from the native reader. Error code: %d",
+                static_cast<int>(err)
+        );
+        return false;
+    }
+    num_bytes_read = static_cast<Py_ssize_t>(num_bytes_read_from_reader);
+    m_buffer_size += num_bytes_read;
+    return true;
+}
+
 auto PyDeserializerBuffer::metadata_init(PyMetadata* metadata) -> bool {
     if (has_metadata()) {
         PyErr_SetString(PyExc_RuntimeError, "Metadata has already been initialized.");
@@ -392,7 +592,7 @@ auto PyDeserializerBuffer::py_getbuffer(Py_buffer* view, int flags) -> int {
         );
         return -1;
     }
-    auto const buffer{m_read_buffer.subspan(m_buffer_size, m_read_buffer.size() - m_buffer_size)};
+    auto const buffer{get_writable_read_buffer().subspan(static_cast<size_t>(m_buffer_size))};
     return PyBuffer_FillInfo(
             view,
             py_reinterpret_cast<PyObject>(this),
@@ -412,6 +612,7 @@ auto PyDeserializerBuffer::commit_read_buffer_consumption(Py_ssize_t num_bytes_c
         return false;
     }
     m_num_current_bytes_consumed += num_bytes_consumed;
+    m_num_total_bytes_consumed += static_cast<size_t>(num_bytes_consumed);
     return true;
 }
 
@@ -430,6 +631,34 @@ auto PyDeserializerBuffer::try_read() -> bool {
     return true;
 }
 
+auto PyDeserializerBuffer::acquire() -> bool {
+    if (m_is_in_use) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cDeserializerBufferInUseError)
+        );
+        return false;
+    }
+    m_is_in_use = true;
+    return true;
+}
+
+auto PyDeserializerBuffer::get_query_match_state(Query const& query) -> Query::MatchState* {
+    if (nullptr != m_query_match_state && m_query_match_state->is_created_for(query)) {
+        return m_query_match_state;
+    }
+    delete m_query_match_state;
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    m_query_match_state = new (std::nothrow) Query::MatchState{query};
+    if (nullptr == m_query_match_state) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
+        );
+    }
+    return m_query_match_state;
+}
+
 auto PyDeserializerBuffer::test_streaming(uint32_t seed) -> PyObject* {
     std::default_random_engine rand_generator(seed);
     std::vector<uint8_t> read_bytes;
@@ -437,7 +666,7 @@ auto PyDeserializerBuffer::test_streaming(uint32_t seed) -> PyObject* {
     while (false == reach_istream_end) {
         std::uniform_int_distribution<Py_ssize_t> distribution(
                 1,
-                static_cast<Py_ssize_t>(m_read_buffer.size())
+                std::max<Py_ssize_t>(static_cast<Py_ssize_t>(m_read_buffer.size()), 1)
         );
         auto num_bytes_to_read{distribution(rand_generator)};
         if (get_num_unconsumed_bytes() < num_bytes_to_read) {
@@ -448,7 +677,7 @@ auto PyDeserializerBuffer::test_streaming(uint32_t seed) -> PyObject* {
             if (0 == num_bytes_read_from_istream) {
                 reach_istream_end = true;
             }
-            num_bytes_to_read = std::min<Py_ssize_t>(num_bytes_to_read, m_buffer_size);
+            num_bytes_to_read = std::min<Py_ssize_t>(num_bytes_to_read, get_num_unconsumed_bytes());
         }
         auto const unconsumed_bytes{get_unconsumed_bytes()};
         auto const bytes_to_consume{unconsumed_bytes.subspan(0, num_bytes_to_read)};
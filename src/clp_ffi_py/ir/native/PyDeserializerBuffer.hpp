@@ -8,8 +8,12 @@
 #include <span>
 
 #include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <gsl/gsl>
 
+#include <clp_ffi_py/ir/native/BufferViewReader.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
+#include <clp_ffi_py/ir/native/Query.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
@@ -23,23 +27,36 @@ namespace clp_ffi_py::ir::native {
  * This class encompasses all essential attributes to hold the buffered bytes and monitor the state
  * of the buffer. It's meant to be utilized across various CLP IR deserialization method calls when
  * deserializing from the same IR stream.
+ * If the input is a path or an object supporting the buffer protocol, the input is accessed in
+ * place through a `BufferViewReader` instead: the read buffer is the entire input, so it never
+ * needs to be refilled, and no bytes are copied.
+ * If the input is zstd-compressed and native decompression is enabled, the read buffer is refilled
+ * from a native `ZstdDecompressionReader` instead of the `readinto` method of the input stream.
+ * Similarly, if readahead is enabled, the read buffer is refilled from a native `ReadaheadReader`.
  */
 class PyDeserializerBuffer {
 public:
     static constexpr Py_ssize_t cDefaultInitialCapacity{4096};
+    static constexpr Py_ssize_t cUnboundedMaxCapacity{PY_SSIZE_T_MAX};
 
     // Static methods
     /**
      * CPython-level factory function.
      * @param input_stream
      * @param buf_capacity
+     * @param enable_zstd_decompression
+     * @param num_readahead_buffers
+     * @param max_buf_capacity
      * @return a new reference of a `PyDeserializerBuffer` object that is initialized with the given
      * inputs.
      * @return nullptr on failure with the relevant Python exception and error set.
      */
     [[nodiscard]] static auto create(
             PyObject* input_stream,
-            Py_ssize_t buf_capacity = PyDeserializerBuffer::cDefaultInitialCapacity
+            Py_ssize_t buf_capacity = PyDeserializerBuffer::cDefaultInitialCapacity,
+            bool enable_zstd_decompression = false,
+            Py_ssize_t num_readahead_buffers = 0,
+            Py_ssize_t max_buf_capacity = PyDeserializerBuffer::cUnboundedMaxCapacity
     ) -> PyDeserializerBuffer*;
 
     /**
@@ -84,12 +101,25 @@ public:
      * to initialize the underlying input IR stream and read buffer. Other data members are assumed
      * to be zero-initialized by `default-init` method. It has to be manually called whenever
      * creating a new PyDeserializerBuffer object through CPython APIs.
+     * @param input_stream A Python `IO[bytes]` object, a path, or an object supporting the buffer
+     * protocol.
+     * @param buf_capacity The initial capacity of the read buffer. Unused if the input is read in
+     * place without decompression.
+     * @param enable_zstd_decompression Whether the input is zstd-compressed and should be
+     * decompressed natively.
+     * @param num_readahead_buffers The number of buffers filled by a native `ReadaheadReader`, each
+     * of `buf_capacity` bytes, or 0 to disable readahead.
+     * @param max_buf_capacity The maximum capacity that the read buffer can grow to. Must not be
+     * less than `buf_capacity`.
      * @return true on success.
      * @return false on failure with the relevant Python exception and error set.
      */
     [[nodiscard]] auto init(
             PyObject* input_stream,
-            Py_ssize_t buf_capacity = PyDeserializerBuffer::cDefaultInitialCapacity
+            Py_ssize_t buf_capacity = PyDeserializerBuffer::cDefaultInitialCapacity,
+            bool enable_zstd_decompression = false,
+            Py_ssize_t num_readahead_buffers = 0,
+            Py_ssize_t max_buf_capacity = PyDeserializerBuffer::cUnboundedMaxCapacity
     ) -> bool;
 
     /**
@@ -99,12 +129,20 @@ public:
     auto default_init() -> void {
         m_read_buffer_mem_owner = nullptr;
         m_buffer_size = 0;
+        m_initial_buffer_capacity = 0;
+        m_max_buffer_capacity = 0;
         m_num_current_bytes_consumed = 0;
+        m_num_total_bytes_consumed = 0;
         m_ref_timestamp = 0;
         m_num_deserialized_message = 0;
         m_py_buffer_protocol_enabled = false;
         m_input_ir_stream = nullptr;
         m_metadata = nullptr;
+        m_buffer_view_reader = nullptr;
+        m_native_reader = nullptr;
+        m_query_match_state = nullptr;
+        m_is_native_reader_gil_free = false;
+        m_is_in_use = false;
     }
 
     /**
@@ -115,6 +153,9 @@ public:
         Py_XDECREF(m_input_ir_stream);
         Py_XDECREF(m_metadata);
         PyMem_Free(m_read_buffer_mem_owner);
+        delete m_buffer_view_reader;
+        delete m_native_reader;
+        delete m_query_match_state;
     }
 
     /**
@@ -125,6 +166,13 @@ public:
      */
     auto commit_read_buffer_consumption(Py_ssize_t num_bytes_consumed) -> bool;
 
+    /**
+     * @return Total number of bytes consumed since the beginning of the input IR stream.
+     */
+    [[nodiscard]] auto get_num_total_bytes_consumed() const -> size_t {
+        return m_num_total_bytes_consumed;
+    }
+
     [[nodiscard]] auto get_num_deserialized_message() const -> size_t {
         return m_num_deserialized_message;
     }
@@ -157,7 +205,7 @@ public:
     /**
      * @return A span containing unconsumed bytes.
      */
-    [[nodiscard]] auto get_unconsumed_bytes() const -> std::span<int8_t> {
+    [[nodiscard]] auto get_unconsumed_bytes() const -> std::span<int8_t const> {
         return m_read_buffer.subspan(m_num_current_bytes_consumed, get_num_unconsumed_bytes());
     }
 
@@ -213,21 +261,92 @@ public:
      */
     [[nodiscard]] auto test_streaming(uint32_t seed) -> PyObject*;
 
+    /**
+     * Marks the deserializer buffer as in use until `release` is called. A deserialization method
+     * must acquire the buffer before accessing it, since the GIL may be released while the buffer
+     * is accessed, which would otherwise allow another Python thread to refill or consume the same
+     * buffer concurrently.
+     * @return true on success.
+     * @return false if the buffer is already in use, with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto acquire() -> bool;
+
+    /**
+     * Releases the deserializer buffer acquired by `acquire`.
+     */
+    auto release() -> void { m_is_in_use = false; }
+
+    /**
+     * Gets the state of matching the given query against the log events of this buffer. The state
+     * is kept across the deserialization method calls on this buffer, so that the results cached
+     * while searching the stream with the same query are reused. It's replaced whenever a different
+     * query is given. Must only be called while the buffer is acquired (see `acquire`).
+     * @param query
+     * @return A pointer to the state on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto get_query_match_state(Query const& query) -> Query::MatchState*;
+
 private:
     static inline PyObjectStaticPtr<PyTypeObject> m_py_type{nullptr};
     static inline PyObjectStaticPtr<PyObject> m_py_incomplete_stream_error{nullptr};
 
     /**
-     * Cleans the consumed bytes by shifting the unconsumed bytes to the beginning of the buffer,
-     * and fills the read buffer by reading from the input IR stream. If more than half of the bytes
-     * are unconsumed in the read buffer, the buffer will be doubled before reading.
+     * Fills the free tail of the read buffer by reading from the input IR stream. Before reading:
+     * - If more than half of the bytes are unconsumed in the read buffer, the buffer is doubled, up
+     *   to the maximum capacity.
+     * - If the buffer has grown beyond its initial capacity and at most a quarter of it is
+     *   unconsumed, the buffer is halved, down to the initial capacity.
+     * - Otherwise, the unconsumed bytes are shifted to the beginning of the buffer only if the free
+     *   tail is less than half of the buffer.
+     * If the input is read from a buffer view, there is nothing to read since the read buffer
+     * already holds the entire input. If a native reader is set, the read buffer is filled from the
+     * native reader instead of the input IR stream.
      * @param num_bytes_read Number of bytes read from the input IR stream to populate the read
      * buffer.
      * @return true on success.
-     * @return false on failure with the relevant Python exception and error set.
+     * @return false on failure with the relevant Python exception and error set, including when the
+     * read buffer is full at its maximum capacity.
      */
     [[nodiscard]] auto populate_read_buffer(Py_ssize_t& num_bytes_read) -> bool;
 
+    /**
+     * Reallocates the read buffer with the given capacity, and moves the unconsumed bytes to the
+     * beginning of the new buffer.
+     * @param new_capacity Must be no less than the number of unconsumed bytes.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto resize_read_buffer(Py_ssize_t new_capacity) -> bool;
+
+    /**
+     * Reads from the native reader into the unused tail of the read buffer.
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto read_from_native_reader(Py_ssize_t& num_bytes_read) -> bool;
+
+    /**
+     * @return Whether the input is accessed in place through `m_buffer_view_reader`.
+     */
+    [[nodiscard]] auto is_reading_from_buffer_view() const -> bool {
+        return nullptr != m_buffer_view_reader;
+    }
+
+    /**
+     * @return A writable span of the owned read buffer, or an empty span if the input is accessed
+     * in place through `m_buffer_view_reader`, so that the caller's read-only buffer is never
+     * written.
+     */
+    [[nodiscard]] auto get_writable_read_buffer() -> std::span<int8_t> {
+        if (nullptr == m_read_buffer_mem_owner) {
+            return {};
+        }
+        return {m_read_buffer_mem_owner, m_read_buffer.size()};
+    }
+
     /**
      * Enable the buffer protocol.
      */
@@ -242,12 +361,60 @@ private:
     PyObject* m_input_ir_stream;
     PyMetadata* m_metadata;
     int8_t* m_read_buffer_mem_owner;
-    std::span<int8_t> m_read_buffer;
+    // A read-only view of either the owned read buffer or the caller's buffer.
+    std::span<int8_t const> m_read_buffer;
     clp::ir::epoch_time_ms_t m_ref_timestamp;
     Py_ssize_t m_buffer_size;
+    Py_ssize_t m_initial_buffer_capacity;
+    Py_ssize_t m_max_buffer_capacity;
     Py_ssize_t m_num_current_bytes_consumed;
+    size_t m_num_total_bytes_consumed;
     size_t m_num_deserialized_message;
     bool m_py_buffer_protocol_enabled;
+    // NOLINTBEGIN(cppcoreguidelines-owning-memory)
+    gsl::owner<BufferViewReader*> m_buffer_view_reader;
+    gsl::owner<clp::ReaderInterface*> m_native_reader;
+    gsl::owner<Query::MatchState*> m_query_match_state;
+    // NOLINTEND(cppcoreguidelines-owning-memory)
+    bool m_is_native_reader_gil_free;
+    bool m_is_in_use;
+};
+
+/**
+ * A guard class that acquires a `PyDeserializerBuffer` upon initialization and releases it upon
+ * destruction (see `PyDeserializerBuffer::acquire`).
+ */
+class PyDeserializerBufferGuard {
+public:
+    // Constructor
+    explicit PyDeserializerBufferGuard(PyDeserializerBuffer* deserializer_buffer)
+            : m_deserializer_buffer{deserializer_buffer},
+              m_is_acquired{deserializer_buffer->acquire()} {}
+
+    // Destructor
+    ~PyDeserializerBufferGuard() {
+        if (m_is_acquired) {
+            m_deserializer_buffer->release();
+        }
+    }
+
+    // Delete copy/move constructor and assignment
+    PyDeserializerBufferGuard(PyDeserializerBufferGuard const&) = delete;
+    PyDeserializerBufferGuard(PyDeserializerBufferGuard&&) = delete;
+    auto operator=(PyDeserializerBufferGuard const&) -> PyDeserializerBufferGuard& = delete;
+    auto operator=(PyDeserializerBufferGuard&&) -> PyDeserializerBufferGuard& = delete;
+
+    // Methods
+    /**
+     * @return Whether the buffer has been acquired. If not, the relevant Python exception and error
+     * are set.
+     */
+    [[nodiscard]] auto is_acquired() const -> bool { return m_is_acquired; }
+
+private:
+    // Variables
+    PyDeserializerBuffer* m_deserializer_buffer;
+    bool m_is_acquired;
 };
 }  // namespace clp_ffi_py::ir::native
 
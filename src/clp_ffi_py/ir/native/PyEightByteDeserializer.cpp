@@ -0,0 +1,168 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "PyEightByteDeserializer.hpp"
+
+#include <type_traits>
+
+#include <clp_ffi_py/ir/native/deserialization_methods.hpp>
+#include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyEightByteDeserializerDoc,
+        "Namespace for all CLP eight-byte encoded IR deserialization methods.\n\n"
+        "Methods deserialize log events from serialized CLP IR streams. This class should never be "
+        "instantiated since it only contains static methods.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cDeserializePreambleDoc,
+        "deserialize_preamble(deserializer_buffer)\n"
+        "--\n\n"
+        "Deserializes the preamble from the IR stream buffered in the given deserializer "
+        "buffer.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: The deserialized preamble presented as a new instance of Metadata.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cDeserializeNextLogEventDoc,
+        "deserialize_next_log_event(deserializer_buffer, query=None, allow_incomplete_stream=False)"
+        "\n--\n\n"
+        "Deserializes the next serialized log event from the eight-byte encoded IR stream buffered "
+        "in the given deserializer buffer. `deserializer_buffer` must have been returned by a "
+        "successfully invocation of `deserialize_preamble`. If `query` is provided, only the next "
+        "log event matching the query will be returned.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param query: A Query object that filters log events. See `Query` documents for more "
+        "details.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end, and "
+        "the function will return None without raising any exceptions.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return:\n"
+        "     - A newly created LogEvent instance representing the next deserialized log event "
+        "       from the IR stream (if the query is `None`).\n"
+        "     - A newly created LogEvent instance representing the next deserialized log event "
+        "       matched with the given query in the IR stream (if the query is given).\n"
+        "     - None when the end of IR stream is reached or the query search terminates.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cDeserializeNextLogEventsDoc,
+        "deserialize_next_log_events(deserializer_buffer, max_events, query=None,"
+        " allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Deserializes up to `max_events` serialized log events from the eight-byte encoded IR "
+        "stream buffered in the given deserializer buffer. This is the batched version of "
+        "`deserialize_next_log_event`, which amortizes the per-call overhead across the log events "
+        "in a batch.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param max_events: The maximum number of log events to deserialize.\n"
+        ":param query: A Query object that filters log events. See `Query` documents for more "
+        "details.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: A list of newly created LogEvent instances representing the next deserialized "
+        "log events (matched with the given query, if the query is given). The list contains "
+        "fewer than `max_events` log events if the end of the IR stream is reached, the query "
+        "search terminates, or an error occurs after at least one log event is deserialized. In "
+        "the last case, the error is raised by the next call.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cDumpDoc,
+        "dump(deserializer_buffer, output, timezone=None, query=None,"
+        " allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Deserializes all the remaining log events from the eight-byte encoded IR stream buffered "
+        "in the given deserializer buffer, and writes them into `output` as text, without creating "
+        "any LogEvent instance. Each log event is written in the same format as `str(log_event)`, "
+        "i.e., its formatted timestamp followed by its log message. The log events are "
+        "deserialized, formatted, and buffered into large chunks natively with the GIL released. "
+        "The UTC offsets of `timezone` are only resolved through Python once per 15 minutes of log "
+        "time.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param output: A file descriptor, or a writable byte output stream. Writes into a file "
+        "descriptor are done with the GIL released. `output` is not flushed nor closed.\n"
+        ":param timezone: Python tzinfo object that specifies the timezone of the formatted "
+        "timestamps. If not given, the timezone of the IR stream is used, whose UTC offsets are "
+        "resolved natively from the system's timezone database.\n"
+        ":param query: A Query object that filters log events. If not given, all the remaining "
+        "log events are written.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: The number of log events written.\n"
+);
+
+// NOLINTNEXTLINE(*-avoid-c-arrays, cppcoreguidelines-avoid-non-const-global-variables)
+PyMethodDef PyEightByteDeserializer_method_table[]{
+        {"deserialize_preamble",
+         deserialize_preamble,
+         METH_O | METH_STATIC,
+         static_cast<char const*>(cDeserializePreambleDoc)},
+
+        {"deserialize_next_log_event",
+         py_c_function_cast(deserialize_next_eight_byte_log_event),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cDeserializeNextLogEventDoc)},
+
+        {"deserialize_next_log_events",
+         py_c_function_cast(deserialize_next_eight_byte_log_events),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cDeserializeNextLogEventsDoc)},
+
+        {"dump",
+         py_c_function_cast(dump_eight_byte),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cDumpDoc)},
+
+        {nullptr, nullptr, 0, nullptr}
+};
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-*-cast)
+// NOLINTNEXTLINE(*-avoid-c-arrays, cppcoreguidelines-avoid-non-const-global-variables)
+PyType_Slot PyEightByteDeserializer_slots[]{
+        {Py_tp_methods, static_cast<void*>(PyEightByteDeserializer_method_table)},
+        {Py_tp_doc, const_cast<void*>(static_cast<void const*>(cPyEightByteDeserializerDoc))},
+        {0, nullptr}
+};
+// NOLINTEND(cppcoreguidelines-pro-type-*-cast)
+
+/**
+ * `PyEightByteDeserializer`'s Python type specifications.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+PyType_Spec PyEightByteDeserializer_type_spec{
+        "clp_ffi_py.ir.native.EightByteDeserializer",
+        sizeof(PyEightByteDeserializer),
+        0,
+        Py_TPFLAGS_DEFAULT,
+        static_cast<PyType_Slot*>(PyEightByteDeserializer_slots)
+};
+}  // namespace
+
+auto PyEightByteDeserializer::module_level_init(PyObject* py_module) -> bool {
+    static_assert(std::is_trivially_destructible<PyEightByteDeserializer>());
+    auto* type{
+            py_reinterpret_cast<PyTypeObject>(PyType_FromSpec(&PyEightByteDeserializer_type_spec))
+    };
+    m_py_type.reset(type);
+    if (nullptr == type) {
+        return false;
+    }
+    // Explicitly set the tp_new to nullptr to mark this type non-instantiable.
+    type->tp_new = nullptr;
+    return add_python_type(type, "EightByteDeserializer", py_module);
+}
+}  // namespace clp_ffi_py::ir::native
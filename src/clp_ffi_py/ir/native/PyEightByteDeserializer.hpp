@@ -0,0 +1,44 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_PYEIGHTBYTEDESERIALIZER_HPP
+#define CLP_FFI_PY_IR_NATIVE_PYEIGHTBYTEDESERIALIZER_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class provides a Python-level namespace for eight-byte encoded IR deserialization methods.
+ */
+class PyEightByteDeserializer {
+public:
+    // Static methods
+    /**
+     * Creates and initializes PyEightByteDeserializer as a Python type, and then incorporates this
+     * type as a Python object into py_module.
+     * @param py_module This is the Python module where the initialized PyEightByteDeserializer will
+     * be incorporated.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto module_level_init(PyObject* py_module) -> bool;
+
+    // Delete default constructor to disable direct instantiation.
+    PyEightByteDeserializer() = delete;
+
+    // Delete copy & move constructors and assignment operators
+    PyEightByteDeserializer(PyEightByteDeserializer const&) = delete;
+    PyEightByteDeserializer(PyEightByteDeserializer&&) = delete;
+    auto operator=(PyEightByteDeserializer const&) -> PyEightByteDeserializer& = delete;
+    auto operator=(PyEightByteDeserializer&&) -> PyEightByteDeserializer& = delete;
+
+    // Destructor
+    ~PyEightByteDeserializer() = default;
+
+private:
+    static inline PyObjectStaticPtr<PyTypeObject> m_py_type{nullptr};
+
+    PyObject_HEAD;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_PYEIGHTBYTEDESERIALIZER_HPP
@@ -0,0 +1,114 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "PyEightByteSerializer.hpp"
+
+#include <type_traits>
+
+#include <clp_ffi_py/ir/native/serialization_methods.hpp>
+#include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyEightByteSerializerDoc,
+        "Namespace for all CLP eight byte IR serialization methods.\n\n"
+        "Methods serialize bytes from the log record to create a CLP log message. Unlike the "
+        "four byte encoding, variables are encoded in 8 bytes, so 64-bit integers and "
+        "high-precision floats can be encoded instead of being stored as dictionary variables, "
+        "and each log event stores its full timestamp instead of a delta. This class should never "
+        "be instantiated since it only contains static methods.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cSerializePreambleDoc,
+        "serialize_preamble(timestamp_format, timezone)\n"
+        "--\n\n"
+        "Serializes the preamble for an 8-byte encoded CLP IR stream.\n\n"
+        ":param timestamp_format: Timestamp format to be use when generating the logs with a "
+        "reader.\n"
+        ":param timezone: Timezone in TZID format to be use when generating the timestamp "
+        "from Unix epoch time.\n"
+        ":raises NotImplementedError: If metadata length too large.\n"
+        ":return: The serialized preamble.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cSerializeMessageAndTimestampDoc,
+        "serialize_message_and_timestamp(timestamp, msg)\n"
+        "--\n\n"
+        "Serializes the log `msg` along with the timestamp using the 8-byte encoding.\n\n"
+        ":param timestamp: Unix epoch timestamp in milliseconds of the log message.\n"
+        ":param msg: Log message to serialize.\n"
+        ":raises NotImplementedError: If the log message failed to serialize.\n"
+        ":return: The serialized message and timestamp.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cSerializeEndOfIrDoc,
+        "serialize_end_of_ir()\n"
+        "--\n\n"
+        "Serializes the byte sequence that indicates the end of a CLP IR stream. A stream that "
+        "does not contain this will be considered as an incomplete IR stream.\n"
+);
+
+// NOLINTNEXTLINE(*-avoid-c-arrays, cppcoreguidelines-avoid-non-const-global-variables)
+PyMethodDef PyEightByteSerializer_method_table[]{
+        {"serialize_preamble",
+         clp_ffi_py::ir::native::serialize_eight_byte_preamble,
+         METH_VARARGS | METH_STATIC,
+         static_cast<char const*>(cSerializePreambleDoc)},
+
+        {"serialize_message_and_timestamp",
+         clp_ffi_py::ir::native::serialize_eight_byte_message_and_timestamp,
+         METH_VARARGS | METH_STATIC,
+         static_cast<char const*>(cSerializeMessageAndTimestampDoc)},
+
+        {"serialize_end_of_ir",
+         py_c_function_cast(clp_ffi_py::ir::native::serialize_end_of_ir),
+         METH_NOARGS | METH_STATIC,
+         static_cast<char const*>(cSerializeEndOfIrDoc)},
+
+        {nullptr, nullptr, 0, nullptr}
+};
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-*-cast)
+// NOLINTNEXTLINE(*-avoid-c-arrays, cppcoreguidelines-avoid-non-const-global-variables)
+PyType_Slot PyEightByteSerializer_slots[]{
+        {Py_tp_methods, static_cast<void*>(PyEightByteSerializer_method_table)},
+        {Py_tp_doc, const_cast<void*>(static_cast<void const*>(cPyEightByteSerializerDoc))},
+        {0, nullptr}
+};
+// NOLINTEND(cppcoreguidelines-pro-type-*-cast)
+
+/**
+ * `PyEightByteSerializer`'s Python type specifications.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+PyType_Spec PyEightByteSerializer_type_spec{
+        "clp_ffi_py.ir.native.EightByteSerializer",
+        sizeof(PyEightByteSerializer),
+        0,
+        Py_TPFLAGS_DEFAULT,
+        static_cast<PyType_Slot*>(PyEightByteSerializer_slots)
+};
+}  // namespace
+
+auto PyEightByteSerializer::module_level_init(PyObject* py_module) -> bool {
+    static_assert(std::is_trivially_destructible<PyEightByteSerializer>());
+    auto* type{
+            py_reinterpret_cast<PyTypeObject>(PyType_FromSpec(&PyEightByteSerializer_type_spec))
+    };
+    m_py_type.reset(type);
+    if (nullptr == type) {
+        return false;
+    }
+    // Explicitly set the tp_new to nullptr to mark this type non-instantiable.
+    type->tp_new = nullptr;
+    return add_python_type(type, "EightByteSerializer", py_module);
+}
+}  // namespace clp_ffi_py::ir::native
@@ -54,6 +54,170 @@ PyDoc_STRVAR(
         "     - None when the end of IR stream is reached or the query search terminates.\n"
 );
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cDeserializeNextLogEventsDoc,
+        "deserialize_next_log_events(deserializer_buffer, max_events, query=None,"
+        " allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Deserializes up to `max_events` serialized log events from the IR stream buffered "
+        "in the given deserializer buffer. This is the batched version of "
+        "`deserialize_next_log_event`, which amortizes the per-call overhead across the log events "
+        "in a batch.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param max_events: The maximum number of log events to deserialize.\n"
+        ":param query: A Query object that filters log events. See `Query` documents for more "
+        "details.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: A list of newly created LogEvent instances representing the next deserialized "
+        "log events (matched with the given query, if the query is given). The list contains "
+        "fewer than `max_events` log events if the end of the IR stream is reached, the query "
+        "search terminates, or an error occurs after at least one log event is deserialized. In "
+        "the last case, the error is raised by the next call.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cDumpDoc,
+        "dump(deserializer_buffer, output, timezone=None, query=None,"
+        " allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Deserializes all the remaining log events from the IR stream buffered in the given "
+        "deserializer buffer, and writes them into `output` as text, without creating any LogEvent "
+        "instance. Each log event is written in the same format as `str(log_event)`, i.e., its "
+        "formatted timestamp followed by its log message. The log events are deserialized, "
+        "formatted, and buffered into large chunks natively with the GIL released. The UTC offsets "
+        "of `timezone` are only resolved through Python once per 15 minutes of log time.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param output: A file descriptor, or a writable byte output stream. Writes into a file "
+        "descriptor are done with the GIL released. `output` is not flushed nor closed.\n"
+        ":param timezone: Python tzinfo object that specifies the timezone of the formatted "
+        "timestamps. If not given, the timezone of the IR stream is used, whose UTC offsets are "
+        "resolved natively from the system's timezone database.\n"
+        ":param query: A Query object that filters log events. If not given, all the remaining "
+        "log events are written.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: The number of log events written.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cCountMatchesDoc,
+        "count_matches(deserializer_buffer, query=None, allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Counts the remaining log events in the IR stream buffered in the given deserializer "
+        "buffer that match the given query. The search runs natively without creating any "
+        "LogEvent instance, and stops at the end of the IR stream or once the search time range of "
+        "the query is safely exceeded.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param query: A Query object that filters log events. If not given, all the remaining "
+        "log events are counted.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: The number of matched log events.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cFindMatchIndicesDoc,
+        "find_match_indices(deserializer_buffer, query=None, allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Finds the indices of the remaining log events in the IR stream buffered in the given "
+        "deserializer buffer that match the given query. The search runs natively without "
+        "creating any LogEvent instance, and stops at the end of the IR stream or once the search "
+        "time range of the query is safely exceeded.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param query: A Query object that filters log events. If not given, the indices of all "
+        "the remaining log events are returned.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: An `array.array` of type code 'Q' containing the indices of the matched log "
+        "events (see `LogEvent.get_index`), in ascending order.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cHistogramDoc,
+        "histogram(deserializer_buffer, bucket_ms, query=None, allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Counts the remaining log events in the IR stream buffered in the given deserializer "
+        "buffer that match the given query, grouped into time buckets of `bucket_ms` "
+        "milliseconds. The search runs natively without creating any LogEvent instance, and "
+        "log messages are only decoded if required by the wildcard queries.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param bucket_ms: The size of each time bucket in milliseconds. A log event with "
+        "timestamp `ts` is counted in the bucket starting at `ts - ts % bucket_ms`.\n"
+        ":param query: A Query object that filters log events. If not given, all the remaining "
+        "log events are counted.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: A tuple of two arrays of the same length:\n"
+        "    - An `array.array` of type code 'q' containing the start timestamps of the non-empty "
+        "buckets, in ascending order.\n"
+        "    - An `array.array` of type code 'Q' containing the number of matched log events in "
+        "each bucket.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cScanTimestampsDoc,
+        "scan_timestamps(deserializer_buffer, index_interval=0, allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Scans the timestamps of the remaining log events in the IR stream buffered in the given "
+        "deserializer buffer. Only the tags and the timestamp deltas are parsed: the logtypes and "
+        "the variables are skipped over without being decoded, which is much faster than "
+        "deserializing the log events.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param index_interval: If non-zero, a sparse index is built with an entry for every log "
+        "event whose index is a multiple of `index_interval`.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: A tuple of:\n"
+        "    - The minimum timestamp of the scanned log events, or None if there's none.\n"
+        "    - The maximum timestamp of the scanned log events, or None if there's none.\n"
+        "    - The number of scanned log events.\n"
+        "    - None if `index_interval` is 0. Otherwise, the sparse index as a tuple of three "
+        "`array.array` of the same length: the timestamps of the indexed log events (type code "
+        "'q'), the byte offsets in the IR stream right after them (type code 'Q'), and their "
+        "indices (type code 'Q'). Deserialization can resume from each offset using the "
+        "corresponding timestamp as the reference timestamp.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cFilterIrStreamDoc,
+        "filter_ir_stream(deserializer_buffer, output_stream, query=None, "
+        "allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Writes the remaining log events in the IR stream buffered in the given deserializer "
+        "buffer that match the given query into `output_stream` as a new, complete four-byte "
+        "encoded IR stream. The filtering runs natively without creating any LogEvent instance: "
+        "the encoded bytes of each matched log message are copied as is, and only its timestamp "
+        "delta is re-serialized relative to the previous matched log event. The filtering stops at "
+        "the end of the IR stream or once the search time range of the query is safely "
+        "exceeded.\n\n"
+        "The preamble of the output stream has the same timestamp format and timezone as the input "
+        "stream, and the timestamp of the last deserialized log event (or the reference timestamp "
+        "if none has been deserialized) as its reference timestamp. `output_stream` is not "
+        "flushed nor closed.\n\n"
+        ":param deserializer_buffer: The deserializer buffer of the serialized CLP IR stream.\n"
+        ":param output_stream: A writable byte output stream.\n"
+        ":param query: A Query object that filters log events. If not given, all the remaining "
+        "log events are written.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: The number of log events written.\n"
+);
+
 // NOLINTNEXTLINE(*-avoid-c-arrays, cppcoreguidelines-avoid-non-const-global-variables)
 PyMethodDef PyFourByteDeserializer_method_table[]{
         {"deserialize_preamble",
@@ -66,6 +230,41 @@ PyMethodDef PyFourByteDeserializer_method_table[]{
          METH_VARARGS | METH_KEYWORDS | METH_STATIC,
          static_cast<char const*>(cDeserializeNextLogEventDoc)},
 
+        {"deserialize_next_log_events",
+         py_c_function_cast(deserialize_next_log_events),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cDeserializeNextLogEventsDoc)},
+
+        {"dump",
+         py_c_function_cast(dump),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cDumpDoc)},
+
+        {"count_matches",
+         py_c_function_cast(count_matches),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cCountMatchesDoc)},
+
+        {"find_match_indices",
+         py_c_function_cast(find_match_indices),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cFindMatchIndicesDoc)},
+
+        {"histogram",
+         py_c_function_cast(histogram),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cHistogramDoc)},
+
+        {"scan_timestamps",
+         py_c_function_cast(scan_timestamps),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cScanTimestampsDoc)},
+
+        {"filter_ir_stream",
+         py_c_function_cast(filter_ir_stream),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cFilterIrStreamDoc)},
+
         {nullptr, nullptr, 0, nullptr}
 };
 
@@ -47,6 +47,31 @@ PyDoc_STRVAR(
         ":return: The serialized message and timestamp.\n"
 );
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cSerializeMessagesAndTimestampsDoc,
+        "serialize_messages_and_timestamps(timestamps, messages, ref_timestamp, num_threads=1)\n"
+        "--\n\n"
+        "Serializes a batch of log messages along with their timestamps using the 4-byte encoding "
+        "into one contiguous byte sequence. The timestamp delta of each log message is computed "
+        "from the timestamp of the previous log message, or from `ref_timestamp` for the first "
+        "one. The GIL is released while serializing. Large batches can be split into chunks "
+        "serialized by multiple native threads in parallel; the result is identical to the "
+        "sequential serialization.\n\n"
+        ":param timestamps: Unix epoch timestamps in milliseconds of the log messages.\n"
+        ":param messages: Log messages to serialize.\n"
+        ":param ref_timestamp: Timestamp in milliseconds of the log message serialized before the "
+        "batch, or the reference timestamp of the preamble if the batch starts the stream.\n"
+        ":param num_threads: The maximum number of threads to serialize the batch with, or 0 to "
+        "use one thread per CPU core. Each thread serializes at least 4096 log messages, so small "
+        "batches are serialized by fewer threads.\n"
+        ":raises ValueError: If the number of timestamps doesn't match the number of messages, or "
+        "`num_threads` is negative.\n"
+        ":raises TypeError: If any message is not bytes.\n"
+        ":raises NotImplementedError: If any log message failed to serialize.\n"
+        ":return: The serialized messages and timestamps.\n"
+);
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cSerializeMessageDoc,
@@ -70,6 +95,37 @@ PyDoc_STRVAR(
         ":return: The serialized timestamp.\n"
 );
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cSerializeTextLogDoc,
+        "serialize_text_log(input_path, output_path, timestamp_formats, timezone=\"UTC\", "
+        "enable_zstd_decompression=False)\n"
+        "--\n\n"
+        "Converts a plain-text log file into a complete 4-byte encoded CLP IR stream file, "
+        "including the preamble and the end-of-stream byte. The conversion runs natively without "
+        "holding the GIL.\n\n"
+        "A line starting with a timestamp that matches any of `timestamp_formats` starts a new log "
+        "message; any other line is appended to the current log message, so multi-line messages "
+        "such as stack traces are kept together. The timestamp is removed from the message since "
+        "it's stored separately. Lines before the first timestamp form a log message with "
+        "timestamp 0.\n\n"
+        "Supported format specifiers are `yyyy`, `MM`, `MMM`, `dd`, `HH`, `mm`, `ss`, `S` "
+        "(repeated 1 to 9 times for fractional seconds), `Z` (`+hhmm`), and `XXX` (`Z` or "
+        "`+hh:mm`). Text in single quotes and non-letter characters are matched literally. "
+        "Timestamps without a UTC offset are interpreted in `timezone`.\n\n"
+        ":param input_path: Path of the text log file.\n"
+        ":param output_path: Path of the IR stream file to write.\n"
+        ":param timestamp_formats: Formats of the timestamps that start log messages, tried in "
+        "order.\n"
+        ":param timezone: Timezone ID recorded in the preamble.\n"
+        ":param enable_zstd_decompression: Whether the text log file is zstd-compressed.\n"
+        ":raises ValueError: If any timestamp format is invalid, or if `timezone` cannot be loaded "
+        "from the system's timezone database while a timestamp format has no UTC offset.\n"
+        ":raises OSError: If either file cannot be opened.\n"
+        ":raises RuntimeError: If the conversion fails.\n"
+        ":return: The number of log messages converted.\n"
+);
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cSerializeEndOfIrDoc,
@@ -91,6 +147,11 @@ PyMethodDef PyFourByteSerializer_method_table[]{
          METH_VARARGS | METH_STATIC,
          static_cast<char const*>(cSerializeMessageAndTimestampDeltaDoc)},
 
+        {"serialize_messages_and_timestamps",
+         clp_ffi_py::ir::native::serialize_four_byte_messages_and_timestamps,
+         METH_VARARGS | METH_STATIC,
+         static_cast<char const*>(cSerializeMessagesAndTimestampsDoc)},
+
         {"serialize_message",
          clp_ffi_py::ir::native::serialize_four_byte_message,
          METH_VARARGS | METH_STATIC,
@@ -101,6 +162,11 @@ PyMethodDef PyFourByteSerializer_method_table[]{
          METH_VARARGS | METH_STATIC,
          static_cast<char const*>(cSerializeTimestampDeltaDoc)},
 
+        {"serialize_text_log",
+         py_c_function_cast(clp_ffi_py::ir::native::serialize_four_byte_text_log),
+         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cSerializeTextLogDoc)},
+
         {"serialize_end_of_ir",
          py_c_function_cast(clp_ffi_py::ir::native::serialize_end_of_ir),
          METH_NOARGS | METH_STATIC,
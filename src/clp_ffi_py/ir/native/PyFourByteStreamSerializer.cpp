@@ -0,0 +1,636 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "PyFourByteStreamSerializer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include <clp/ffi/ir_stream/encoding_methods.hpp>
+#include <clp/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_py/api_decoration.hpp>
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/Py_utils.hpp>
+#include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * Callback of `PyFourByteStreamSerializer`'s `__init__` method:
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyFourByteStreamSerializerDoc,
+        "Serializer for serializing CLP four-byte encoded IR streams of unstructured log events.\n"
+        "This class serializes log events into the CLP four-byte encoded IR format and writes the"
+        " serialized data to a specified byte stream object. It keeps track of the timestamp of"
+        " the last serialized log event to compute timestamp deltas, and reuses its internal"
+        " buffers across log events.\n\n"
+        "__init__(self, output_stream, ref_timestamp, timestamp_format, timezone,"
+        " buffer_size_limit=65536)\n\n"
+        "Initializes a :class:`FourByteStreamSerializer` instance with the given output stream and"
+        " serializes the preamble. Note that each object should only be initialized once. Double"
+        " initialization will result in a memory leak.\n\n"
+        ":param output_stream: A writable byte output stream to which the serializer will write the"
+        " serialized IR byte sequences.\n"
+        ":type output_stream: IO[bytes]\n"
+        ":param ref_timestamp: The reference Unix epoch timestamp in milliseconds used to compute"
+        " the timestamp delta of the first log event.\n"
+        ":type ref_timestamp: int\n"
+        ":param timestamp_format: The timestamp format to be use when generating the logs with a"
+        " reader.\n"
+        ":type timestamp_format: str\n"
+        ":param timezone: The timezone in TZID format to be used when generating the timestamp from"
+        " Unix epoch time.\n"
+        ":type timezone: str\n"
+        ":param buffer_size_limit: The maximum amount of serialized data to buffer before flushing"
+        " it to `output_stream`. Defaults to 64 KiB.\n"
+        ":type buffer_size_limit: int\n"
+);
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_init(
+        PyFourByteStreamSerializer* self,
+        PyObject* args,
+        PyObject* keywords
+) -> int;
+
+/**
+ * Callback of `PyFourByteStreamSerializer`'s `serialize_log_event` method.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyFourByteStreamSerializerSerializeLogEventDoc,
+        "serialize_log_event(self, timestamp, msg)\n"
+        "--\n\n"
+        "Serializes the given log event. Its timestamp is serialized as the delta from the"
+        " timestamp of the last serialized log event, or from the reference timestamp if it's the"
+        " first log event.\n\n"
+        ":param timestamp: The Unix epoch timestamp of the log event in milliseconds.\n"
+        ":type timestamp: int\n"
+        ":param msg: The log message to serialize.\n"
+        ":type msg: bytes\n"
+        ":return: The number of bytes serialized.\n"
+        ":rtype: int\n"
+        ":raise IOError: If the serializer has already been closed.\n"
+        ":raise NotImplementedError: If the log message failed to serialize.\n"
+);
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_serialize_log_event(
+        PyFourByteStreamSerializer* self,
+        PyObject* args,
+        PyObject* keywords
+) -> PyObject*;
+
+/**
+ * Callback of `PyFourByteStreamSerializer`'s `get_num_bytes_serialized` method.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyFourByteStreamSerializerGetNumBytesSerializedDoc,
+        "get_num_bytes_serialized(self)\n"
+        "--\n\n"
+        ":return: The total number of bytes serialized.\n"
+        ":rtype: int\n"
+);
+CLP_FFI_PY_METHOD auto
+PyFourByteStreamSerializer_get_num_bytes_serialized(PyFourByteStreamSerializer* self)
+        -> PyObject*;
+
+/**
+ * Callback of `PyFourByteStreamSerializer`'s `flush` method.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyFourByteStreamSerializerFlushDoc,
+        "flush(self)\n"
+        "--\n\n"
+        "Flushes any buffered data and the output stream.\n\n"
+        ":raise IOError: If the serializer has already been closed.\n"
+);
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_flush(PyFourByteStreamSerializer* self)
+        -> PyObject*;
+
+/**
+ * Callback of `PyFourByteStreamSerializer`'s `close` method.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyFourByteStreamSerializerCloseDoc,
+        "close(self)\n"
+        "--\n\n"
+        "Closes the serializer, writing any buffered data to the output stream and appending a byte"
+        " sequence to mark the end of the CLP IR stream. The output stream is then flushed and"
+        " closed.\n"
+        "NOTE: This method must be called to properly terminate an IR stream. If it isn't called,"
+        " the stream will be incomplete, and any buffered data may be lost.\n\n"
+        ":raise IOError: If the serializer has already been closed.\n"
+);
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_close(PyFourByteStreamSerializer* self)
+        -> PyObject*;
+
+/**
+ * Callback of `PyFourByteStreamSerializer`'s `__enter__` method.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyFourByteStreamSerializerEnterDoc,
+        "__enter__(self)\n"
+        "--\n\n"
+        "Enters the runtime context.\n\n"
+        ":return: self.\n"
+        ":rtype: :class:`FourByteStreamSerializer`\n"
+);
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_enter(PyFourByteStreamSerializer* self)
+        -> PyObject*;
+
+/**
+ * Callback of `PyFourByteStreamSerializer`'s `__exit__` method.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyFourByteStreamSerializerExitDoc,
+        "__exit__(self, exc_type, exc_value, traceback)\n"
+        "--\n\n"
+        "Exits the runtime context, automatically calling :meth:`close` to flush all buffered data"
+        " into the output stream.\n\n"
+        ":param exc_type: The type of the exception that caused the exit. Unused.\n"
+        ":param exc_value: The value of the exception that caused the exit. Unused.\n"
+        ":param exc_traceable: The traceback. Unused.\n"
+);
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_exit(
+        PyFourByteStreamSerializer* self,
+        PyObject* args,
+        PyObject* keywords
+) -> PyObject*;
+
+/**
+ * Callback of `PyFourByteStreamSerializer`'s deallocator.
+ */
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_dealloc(PyFourByteStreamSerializer* self)
+        -> void;
+
+// NOLINTNEXTLINE(*-avoid-c-arrays, cppcoreguidelines-avoid-non-const-global-variables)
+PyMethodDef PyFourByteStreamSerializer_method_table[]{
+        {"serialize_log_event",
+         py_c_function_cast(PyFourByteStreamSerializer_serialize_log_event),
+         METH_VARARGS | METH_KEYWORDS,
+         static_cast<char const*>(cPyFourByteStreamSerializerSerializeLogEventDoc)},
+
+        {"get_num_bytes_serialized",
+         py_c_function_cast(PyFourByteStreamSerializer_get_num_bytes_serialized),
+         METH_NOARGS,
+         static_cast<char const*>(cPyFourByteStreamSerializerGetNumBytesSerializedDoc)},
+
+        {"flush",
+         py_c_function_cast(PyFourByteStreamSerializer_flush),
+         METH_NOARGS,
+         static_cast<char const*>(cPyFourByteStreamSerializerFlushDoc)},
+
+        {"close",
+         py_c_function_cast(PyFourByteStreamSerializer_close),
+         METH_NOARGS,
+         static_cast<char const*>(cPyFourByteStreamSerializerCloseDoc)},
+
+        {"__enter__",
+         py_c_function_cast(PyFourByteStreamSerializer_enter),
+         METH_NOARGS,
+         static_cast<char const*>(cPyFourByteStreamSerializerEnterDoc)},
+
+        {"__exit__",
+         py_c_function_cast(PyFourByteStreamSerializer_exit),
+         METH_VARARGS | METH_KEYWORDS,
+         static_cast<char const*>(cPyFourByteStreamSerializerExitDoc)},
+
+        {nullptr}
+};
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-*-cast)
+// NOLINTNEXTLINE(*-avoid-c-arrays, cppcoreguidelines-avoid-non-const-global-variables)
+PyType_Slot PyFourByteStreamSerializer_slots[]{
+        {Py_tp_alloc, reinterpret_cast<void*>(PyType_GenericAlloc)},
+        {Py_tp_dealloc, reinterpret_cast<void*>(PyFourByteStreamSerializer_dealloc)},
+        {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+        {Py_tp_init, reinterpret_cast<void*>(PyFourByteStreamSerializer_init)},
+        {Py_tp_methods, static_cast<void*>(PyFourByteStreamSerializer_method_table)},
+        {Py_tp_doc, const_cast<void*>(static_cast<void const*>(cPyFourByteStreamSerializerDoc))},
+        {0, nullptr}
+};
+// NOLINTEND(cppcoreguidelines-pro-type-*-cast)
+
+/**
+ * `PyFourByteStreamSerializer`'s Python type specifications.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+PyType_Spec PyFourByteStreamSerializer_type_spec{
+        "clp_ffi_py.ir.native.FourByteStreamSerializer",
+        sizeof(PyFourByteStreamSerializer),
+        0,
+        Py_TPFLAGS_DEFAULT,
+        static_cast<PyType_Slot*>(PyFourByteStreamSerializer_slots)
+};
+
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_init(
+        PyFourByteStreamSerializer* self,
+        PyObject* args,
+        PyObject* keywords
+) -> int {
+    static char keyword_output_stream[]{"output_stream"};
+    static char keyword_ref_timestamp[]{"ref_timestamp"};
+    static char keyword_timestamp_format[]{"timestamp_format"};
+    static char keyword_timezone[]{"timezone"};
+    static char keyword_buffer_size_limit[]{"buffer_size_limit"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_output_stream),
+            static_cast<char*>(keyword_ref_timestamp),
+            static_cast<char*>(keyword_timestamp_format),
+            static_cast<char*>(keyword_timezone),
+            static_cast<char*>(keyword_buffer_size_limit),
+            nullptr
+    };
+
+    // If the argument parsing fails, `self` will be deallocated. We must reset all pointers to
+    // nullptr in advance, otherwise the deallocator might trigger segmentation fault.
+    self->default_init();
+
+    PyObject* output_stream{Py_None};
+    clp::ir::epoch_time_ms_t ref_timestamp{};
+    char const* input_timestamp_format{};
+    Py_ssize_t input_timestamp_format_size{};
+    char const* input_timezone{};
+    Py_ssize_t input_timezone_size{};
+    Py_ssize_t buffer_size_limit{PyFourByteStreamSerializer::cDefaultBufferSizeLimit};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "OLs#s#|n",
+                static_cast<char**>(keyword_table),
+                &output_stream,
+                &ref_timestamp,
+                &input_timestamp_format,
+                &input_timestamp_format_size,
+                &input_timezone,
+                &input_timezone_size,
+                &buffer_size_limit
+        )))
+    {
+        return -1;
+    }
+
+    // Ensure the `output_stream` has `write`, `flush`, and `close` methods
+    auto output_stream_has_method = [&](char const* method_name) -> bool {
+        PyObjectPtr<PyObject> const method{PyObject_GetAttrString(output_stream, method_name)};
+        if (nullptr == method) {
+            return false;
+        }
+        if (false == static_cast<bool>(PyCallable_Check(method.get()))) {
+            PyErr_Format(
+                    PyExc_TypeError,
+                    "The attribute `%s` of the given output stream object is not callable.",
+                    method_name
+            );
+            return false;
+        }
+        return true;
+    };
+
+    if (false == output_stream_has_method("write")) {
+        return -1;
+    }
+    if (false == output_stream_has_method("flush")) {
+        return -1;
+    }
+    if (false == output_stream_has_method("close")) {
+        return -1;
+    }
+
+    if (0 > buffer_size_limit) {
+        PyErr_SetString(PyExc_ValueError, "The buffer size limit cannot be negative");
+        return -1;
+    }
+
+    if (false
+        == self->init(
+                output_stream,
+                ref_timestamp,
+                {input_timestamp_format, static_cast<size_t>(input_timestamp_format_size)},
+                {input_timezone, static_cast<size_t>(input_timezone_size)},
+                buffer_size_limit
+        ))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_serialize_log_event(
+        PyFourByteStreamSerializer* self,
+        PyObject* args,
+        PyObject* keywords
+) -> PyObject* {
+    static char keyword_timestamp[]{"timestamp"};
+    static char keyword_msg[]{"msg"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_timestamp),
+            static_cast<char*>(keyword_msg),
+            nullptr
+    };
+
+    clp::ir::epoch_time_ms_t timestamp{};
+    char const* input_buffer{};
+    Py_ssize_t input_buffer_size{};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "Ly#",
+                static_cast<char**>(keyword_table),
+                &timestamp,
+                &input_buffer,
+                &input_buffer_size
+        )))
+    {
+        return nullptr;
+    }
+
+    auto const num_bytes_serialized{self->serialize_log_event(
+            timestamp,
+            {input_buffer, static_cast<size_t>(input_buffer_size)}
+    )};
+    if (false == num_bytes_serialized.has_value()) {
+        return nullptr;
+    }
+    return PyLong_FromSsize_t(num_bytes_serialized.value());
+}
+
+CLP_FFI_PY_METHOD auto
+PyFourByteStreamSerializer_get_num_bytes_serialized(PyFourByteStreamSerializer* self)
+        -> PyObject* {
+    return PyLong_FromSsize_t(self->get_num_bytes_serialized());
+}
+
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_flush(PyFourByteStreamSerializer* self)
+        -> PyObject* {
+    if (false == self->flush()) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_close(PyFourByteStreamSerializer* self)
+        -> PyObject* {
+    if (false == self->close()) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_enter(PyFourByteStreamSerializer* self)
+        -> PyObject* {
+    Py_INCREF(self);
+    return py_reinterpret_cast<PyObject>(self);
+}
+
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_exit(
+        PyFourByteStreamSerializer* self,
+        PyObject* args,
+        PyObject* keywords
+) -> PyObject* {
+    static char keyword_exc_type[]{"exc_type"};
+    static char keyword_exc_value[]{"exc_value"};
+    static char keyword_traceback[]{"traceback"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_exc_type),
+            static_cast<char*>(keyword_exc_value),
+            static_cast<char*>(keyword_traceback),
+            nullptr
+    };
+
+    PyObject* py_exc_type{};
+    PyObject* py_exc_value{};
+    PyObject* py_traceback{};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "|OOO",
+                static_cast<char**>(keyword_table),
+                &py_exc_type,
+                &py_exc_value,
+                &py_traceback
+        )))
+    {
+        return nullptr;
+    }
+
+    // We don't do anything with the given exception. It is the caller's responsibility to raise
+    // the exceptions: https://docs.python.org/3/reference/datamodel.html#object.__exit__
+    if (false == self->close()) {
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+CLP_FFI_PY_METHOD auto PyFourByteStreamSerializer_dealloc(PyFourByteStreamSerializer* self)
+        -> void {
+    PyErrGuard const err_guard;
+
+    if (false == self->is_closed()) {
+        if (0
+            != PyErr_WarnEx(
+                    PyExc_ResourceWarning,
+                    "`FourByteStreamSerializer.close()` is not called before object destruction,"
+                    " which will leave the stream incomplete, and potentially resulting in data"
+                    " loss due to data buffering",
+                    1
+            ))
+        {
+            PyErr_Clear();
+        }
+    }
+
+    self->clean();
+    Py_TYPE(self)->tp_free(py_reinterpret_cast<PyObject>(self));
+}
+}  // namespace
+
+auto PyFourByteStreamSerializer::module_level_init(PyObject* py_module) -> bool {
+    static_assert(std::is_trivially_destructible<PyFourByteStreamSerializer>());
+    auto* type{
+            py_reinterpret_cast<PyTypeObject>(PyType_FromSpec(&PyFourByteStreamSerializer_type_spec)
+            )
+    };
+    m_py_type.reset(type);
+    if (nullptr == type) {
+        return false;
+    }
+    return add_python_type(get_py_type(), "FourByteStreamSerializer", py_module);
+}
+
+auto PyFourByteStreamSerializer::init(
+        PyObject* output_stream,
+        clp::ir::epoch_time_ms_t ref_timestamp,
+        std::string_view timestamp_format,
+        std::string_view timezone,
+        Py_ssize_t buffer_size_limit
+) -> bool {
+    m_output_stream = output_stream;
+    Py_INCREF(output_stream);
+    m_prev_timestamp = ref_timestamp;
+    m_buffer_size_limit = buffer_size_limit;
+    m_buffers = new (std::nothrow) Buffers{};
+    if (nullptr == m_buffers) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
+        );
+        return false;
+    }
+
+    auto& ir_buf{m_buffers->ir_buf};
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_preamble(
+                timestamp_format,
+                {},
+                timezone,
+                ref_timestamp,
+                ir_buf
+        ))
+    {
+        PyErr_SetString(
+                PyExc_NotImplementedError,
+                get_c_str_from_constexpr_string_view(cSerializePreambleError)
+        );
+        return false;
+    }
+    auto const preamble_size{static_cast<Py_ssize_t>(ir_buf.size())};
+    if (preamble_size > m_buffer_size_limit && false == write_ir_buf_to_output_stream()) {
+        return false;
+    }
+    m_num_total_bytes_serialized += preamble_size;
+    return true;
+}
+
+auto PyFourByteStreamSerializer::assert_is_not_closed() const -> bool {
+    if (is_closed()) {
+        PyErr_SetString(PyExc_IOError, "FourByteStreamSerializer has already been closed.");
+        return false;
+    }
+    return true;
+}
+
+auto PyFourByteStreamSerializer::serialize_log_event(
+        clp::ir::epoch_time_ms_t timestamp,
+        std::string_view message
+) -> std::optional<Py_ssize_t> {
+    if (false == assert_is_not_closed()) {
+        return std::nullopt;
+    }
+
+    auto& [ir_buf, logtype]{*m_buffers};
+    auto const buffer_size_before_serialization{ir_buf.size()};
+    logtype.clear();
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_message(message, logtype, ir_buf))
+    {
+        // Drop the partially serialized log event so that the buffered IR stream stays valid.
+        ir_buf.resize(buffer_size_before_serialization);
+        PyErr_SetString(
+                PyExc_NotImplementedError,
+                get_c_str_from_constexpr_string_view(cSerializeMessageError)
+        );
+        return std::nullopt;
+    }
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_timestamp(
+                timestamp - m_prev_timestamp,
+                ir_buf
+        ))
+    {
+        ir_buf.resize(buffer_size_before_serialization);
+        PyErr_SetString(
+                PyExc_NotImplementedError,
+                get_c_str_from_constexpr_string_view(cSerializeTimestampError)
+        );
+        return std::nullopt;
+    }
+    m_prev_timestamp = timestamp;
+
+    auto const buffer_size_after_serialization{static_cast<Py_ssize_t>(ir_buf.size())};
+    auto const num_bytes_serialized{
+            buffer_size_after_serialization
+            - static_cast<Py_ssize_t>(buffer_size_before_serialization)
+    };
+    m_num_total_bytes_serialized += num_bytes_serialized;
+
+    if (buffer_size_after_serialization > m_buffer_size_limit
+        && false == write_ir_buf_to_output_stream())
+    {
+        return std::nullopt;
+    }
+    return num_bytes_serialized;
+}
+
+auto PyFourByteStreamSerializer::flush() -> bool {
+    if (false == assert_is_not_closed()) {
+        return false;
+    }
+    if (false == write_ir_buf_to_output_stream()) {
+        return false;
+    }
+    return flush_output_stream();
+}
+
+auto PyFourByteStreamSerializer::close() -> bool {
+    if (false == assert_is_not_closed()) {
+        return false;
+    }
+
+    // Append end-of-stream to the buffered IR stream so that they're written together
+    m_buffers->ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+    m_num_total_bytes_serialized += 1;
+    if (false == write_ir_buf_to_output_stream()) {
+        return false;
+    }
+
+    if (false == (flush_output_stream() && close_output_stream())) {
+        return false;
+    }
+
+    release_buffers();
+    return true;
+}
+
+auto PyFourByteStreamSerializer::write_ir_buf_to_output_stream() -> bool {
+    if (false == assert_is_not_closed()) {
+        return false;
+    }
+
+    auto& ir_buf{m_buffers->ir_buf};
+    if (false == write_to_py_output_stream(m_output_stream, ir_buf)) {
+        return false;
+    }
+
+    // `clear` keeps the allocated capacity, so the buffer is reused by the following log events.
+    ir_buf.clear();
+    return true;
+}
+
+auto PyFourByteStreamSerializer::flush_output_stream() -> bool {
+    PyObjectPtr<PyObject> const ret_val{PyObject_CallMethod(m_output_stream, "flush", "")};
+    return nullptr != ret_val;
+}
+
+auto PyFourByteStreamSerializer::close_output_stream() -> bool {
+    PyObjectPtr<PyObject> const ret_val{PyObject_CallMethod(m_output_stream, "close", "")};
+    return nullptr != ret_val;
+}
+}  // namespace clp_ffi_py::ir::native
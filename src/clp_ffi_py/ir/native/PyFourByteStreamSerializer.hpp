@@ -0,0 +1,197 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_PYFOURBYTESTREAMSERIALIZER_HPP
+#define CLP_FFI_PY_IR_NATIVE_PYFOURBYTESTREAMSERIALIZER_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+#include <gsl/gsl>
+
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A PyObject structure for serializing a CLP four-byte encoded IR stream of unstructured log
+ * events. Unlike the static methods of `PyFourByteSerializer`, it tracks the timestamp of the last
+ * serialized log event to compute timestamp deltas, and accumulates the serialized log events in a
+ * buffer that is reused across log events. The buffered IR stream is written into an `IO[byte]`
+ * stream pointed by `m_output_stream` whenever its size exceeds the buffer size limit.
+ */
+class PyFourByteStreamSerializer {
+public:
+    /**
+     * The default buffer size limit. Any change to the value should also be applied to `__init__`'s
+     * doc string and Python stub file.
+     */
+    static constexpr size_t cDefaultBufferSizeLimit{65'536};
+
+    /**
+     * Gets the `PyTypeObject` that represents `PyFourByteStreamSerializer`'s Python type. This type
+     * is dynamically created and initialized during the execution of `module_level_init`.
+     * @return Python type object associated with `PyFourByteStreamSerializer`.
+     */
+    [[nodiscard]] static auto get_py_type() -> PyTypeObject* { return m_py_type.get(); }
+
+    /**
+     * Creates and initializes `PyFourByteStreamSerializer` as a Python type, and then incorporates
+     * this type as a Python object into the py_module module.
+     * @param py_module The Python module where the initialized `PyFourByteStreamSerializer` will be
+     * incorporated.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto module_level_init(PyObject* py_module) -> bool;
+
+    // Delete default constructor to disable direct instantiation.
+    PyFourByteStreamSerializer() = delete;
+
+    // Delete copy & move constructors and assignment operators
+    PyFourByteStreamSerializer(PyFourByteStreamSerializer const&) = delete;
+    PyFourByteStreamSerializer(PyFourByteStreamSerializer&&) = delete;
+    auto operator=(PyFourByteStreamSerializer const&) -> PyFourByteStreamSerializer& = delete;
+    auto operator=(PyFourByteStreamSerializer&&) -> PyFourByteStreamSerializer& = delete;
+
+    // Destructor
+    ~PyFourByteStreamSerializer() = default;
+
+    /**
+     * Initializes the underlying data with the given inputs, and serializes the preamble into the
+     * IR buffer. Since the memory allocation of `PyFourByteStreamSerializer` is handled by
+     * CPython's allocator, cpp constructors will not be explicitly called. This function serves as
+     * the default constructor to initialize the underlying data. It has to be called manually to
+     * create a `PyFourByteStreamSerializer` object through CPython APIs.
+     * @param output_stream
+     * @param ref_timestamp
+     * @param timestamp_format
+     * @param timezone
+     * @param buffer_size_limit
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto init(
+            PyObject* output_stream,
+            clp::ir::epoch_time_ms_t ref_timestamp,
+            std::string_view timestamp_format,
+            std::string_view timezone,
+            Py_ssize_t buffer_size_limit
+    ) -> bool;
+
+    /**
+     * Initializes the pointers to nullptr by default. Should be called once the object is
+     * allocated.
+     */
+    auto default_init() -> void {
+        m_output_stream = nullptr;
+        m_buffers = nullptr;
+        m_prev_timestamp = 0;
+        m_num_total_bytes_serialized = 0;
+        m_buffer_size_limit = 0;
+    }
+
+    /**
+     * Releases the memory allocated for underlying data fields.
+     */
+    auto clean() -> void {
+        release_buffers();
+        Py_XDECREF(m_output_stream);
+    }
+
+    [[nodiscard]] auto is_closed() const -> bool { return nullptr == m_buffers; }
+
+    /**
+     * Serializes the given log event into the IR buffer, with its timestamp serialized as the delta
+     * from the timestamp of the last serialized log event (or the reference timestamp).
+     * @param timestamp
+     * @param message
+     * @return the number of bytes serialized on success.
+     * @return std::nullopt on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto
+    serialize_log_event(clp::ir::epoch_time_ms_t timestamp, std::string_view message)
+            -> std::optional<Py_ssize_t>;
+
+    [[nodiscard]] auto get_num_bytes_serialized() const -> Py_ssize_t {
+        return m_num_total_bytes_serialized;
+    }
+
+    /**
+     * Flushes the underlying IR buffer and `m_output_stream`.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto flush() -> bool;
+
+    /**
+     * Closes the serializer by writing the buffered results into the output stream with the
+     * end-of-stream byte appended in the end.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto close() -> bool;
+
+private:
+    /**
+     * The buffers reused across log events.
+     */
+    struct Buffers {
+        std::vector<int8_t> ir_buf;
+        std::string logtype;
+    };
+
+    static inline PyObjectStaticPtr<PyTypeObject> m_py_type{nullptr};
+
+    /**
+     * Asserts the serializer has not been closed.
+     * @return true on success, false if it's already been closed with `IOError` set.
+     */
+    [[nodiscard]] auto assert_is_not_closed() const -> bool;
+
+    /**
+     * Writes the underlying IR buffer into `m_output_stream`.
+     * NOTE: the serializer must not be closed to call this method.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto write_ir_buf_to_output_stream() -> bool;
+
+    /**
+     * Releases `m_buffers`.
+     * NOTE: it is safe to call this method more than once as it resets `m_buffers` to nullptr.
+     */
+    auto release_buffers() -> void {
+        delete m_buffers;
+        m_buffers = nullptr;
+    }
+
+    /**
+     * Wrapper of `output_stream`'s `flush` method.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto flush_output_stream() -> bool;
+
+    /**
+     * Wrapper of `output_stream`'s `close` method.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto close_output_stream() -> bool;
+
+    // Variables
+    PyObject_HEAD;
+    PyObject* m_output_stream;
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    gsl::owner<Buffers*> m_buffers;
+    clp::ir::epoch_time_ms_t m_prev_timestamp;
+    Py_ssize_t m_num_total_bytes_serialized;
+    Py_ssize_t m_buffer_size_limit;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_PYFOURBYTESTREAMSERIALIZER_HPP
@@ -442,6 +442,7 @@ auto PyKeyValuePairLogEvent::create(clp::ffi::KeyValuePairLogEvent kv_log_event)
     }
     self->default_init();
     if (false == self->init(std::move(kv_log_event))) {
+        Py_DECREF(self);
         return nullptr;
     }
     return self;
@@ -463,9 +464,11 @@ auto PyKeyValuePairLogEvent::module_level_init(PyObject* py_module) -> bool {
 }
 
 auto PyKeyValuePairLogEvent::init(clp::ffi::KeyValuePairLogEvent kv_pair_log_event) -> bool {
-    m_kv_pair_log_event
-            = new (std::nothrow) clp::ffi::KeyValuePairLogEvent{std::move(kv_pair_log_event)};
-    if (nullptr == m_kv_pair_log_event) {
+    clean();
+    try {
+        m_kv_pair_log_event = new (m_kv_pair_log_event_storage.data())
+                clp::ffi::KeyValuePairLogEvent{std::move(kv_pair_log_event)};
+    } catch (std::bad_alloc const&) {
         PyErr_SetString(
                 PyExc_RuntimeError,
                 get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
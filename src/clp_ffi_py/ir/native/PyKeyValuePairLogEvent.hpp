@@ -3,8 +3,11 @@
 
 #include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
 
+#include <array>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <stack>
 #include <string>
@@ -16,7 +19,6 @@
 #include <clp/ffi/SchemaTree.hpp>
 #include <clp/ffi/Value.hpp>
 #include <clp/TraceableException.hpp>
-#include <gsl/gsl>
 
 #include <clp_ffi_py/Py_utils.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
@@ -43,7 +45,8 @@ concept StringViewToPyUnicodeMethodReq
 
 /**
  * A PyObject structure functioning as a Python-compatible interface to retrieve a key-value pair
- * log event. The underlying data is pointed to by `m_kv_pair_log_event`.
+ * log event. The underlying data is pointed to by `m_kv_pair_log_event`, which is constructed in
+ * place within the Python object's own allocation to avoid another heap allocation for it.
  */
 class PyKeyValuePairLogEvent {
 public:
@@ -105,11 +108,13 @@ public:
     auto default_init() -> void { m_kv_pair_log_event = nullptr; }
 
     /**
-     * Releases the memory allocated for underlying data fields.
+     * Destroys the underlying data fields.
      */
     auto clean() -> void {
-        delete m_kv_pair_log_event;
-        m_kv_pair_log_event = nullptr;
+        if (nullptr != m_kv_pair_log_event) {
+            std::destroy_at(m_kv_pair_log_event);
+            m_kv_pair_log_event = nullptr;
+        }
     }
 
     [[nodiscard]] auto get_kv_pair_log_event() const -> clp::ffi::KeyValuePairLogEvent const* {
@@ -133,10 +138,14 @@ public:
 private:
     static inline PyObjectStaticPtr<PyTypeObject> m_py_type{nullptr};
 
+    using KeyValuePairLogEventStorage
+            = std::array<std::byte, sizeof(clp::ffi::KeyValuePairLogEvent)>;
+
     // Variables
     PyObject_HEAD;
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-    gsl::owner<clp::ffi::KeyValuePairLogEvent*> m_kv_pair_log_event;
+    // Points to `m_kv_pair_log_event_storage` once the log event is constructed.
+    clp::ffi::KeyValuePairLogEvent* m_kv_pair_log_event;
+    alignas(clp::ffi::KeyValuePairLogEvent) KeyValuePairLogEventStorage m_kv_pair_log_event_storage;
 };
 
 // NOLINTNEXTLINE(readability-identifier-naming)
@@ -9,13 +9,18 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 
 #include <clp/ir/types.hpp>
 
 #include <clp_ffi_py/api_decoration.hpp>
 #include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/EncodedLogMessage.hpp>
+#include <clp_ffi_py/ir/native/error_messages.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyQuery.hpp>
+#include <clp_ffi_py/ir/native/Query.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormatter.hpp>
 #include <clp_ffi_py/Py_utils.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
@@ -240,7 +245,7 @@ CLP_FFI_PY_METHOD auto PyLogEvent_init(PyLogEvent* self, PyObject* args, PyObjec
     // nullptr in advance, otherwise the deallocator might trigger segmentation fault.
     self->default_init();
 
-    char const* log_message{nullptr};
+    PyObject* py_log_message{nullptr};
     clp::ir::epoch_time_ms_t timestamp{0};
     size_t index{0};
     PyObject* metadata{Py_None};
@@ -248,9 +253,9 @@ CLP_FFI_PY_METHOD auto PyLogEvent_init(PyLogEvent* self, PyObject* args, PyObjec
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
                 keywords,
-                "sL|KO",
+                "UL|KO",
                 static_cast<char**>(keyword_table),
-                &log_message,
+                &py_log_message,
                 &timestamp,
                 &index,
                 &metadata
@@ -258,6 +263,10 @@ CLP_FFI_PY_METHOD auto PyLogEvent_init(PyLogEvent* self, PyObject* args, PyObjec
     {
         return -1;
     }
+    std::string_view log_message;
+    if (false == parse_py_string_as_string_view(py_log_message, log_message)) {
+        return -1;
+    }
 
     auto const has_metadata{Py_None != metadata};
     if (has_metadata
@@ -291,27 +300,21 @@ CLP_FFI_PY_METHOD auto PyLogEvent_dealloc(PyLogEvent* self) -> void {
 CLP_FFI_PY_METHOD auto PyLogEvent_getstate(PyLogEvent* self) -> PyObject* {
     auto* log_event{self->get_log_event()};
     if (false == log_event->has_formatted_timestamp()) {
-        PyObjectPtr<PyObject> const formatted_timestamp_object{
-                clp_ffi_py::py_utils_get_formatted_timestamp(
-                        log_event->get_timestamp(),
-                        self->has_metadata() ? self->get_py_metadata()->get_py_timezone() : Py_None
-                )
-        };
-        auto* formatted_timestamp_ptr{formatted_timestamp_object.get()};
-        if (nullptr == formatted_timestamp_ptr) {
-            return nullptr;
-        }
         std::string formatted_timestamp;
-        if (false == clp_ffi_py::parse_py_string(formatted_timestamp_ptr, formatted_timestamp)) {
+        if (false == self->format_timestamp(Py_None, formatted_timestamp)) {
             return nullptr;
         }
         log_event->set_formatted_timestamp(formatted_timestamp);
     }
 
+    auto* py_log_message{self->get_py_log_message()};
+    if (nullptr == py_log_message) {
+        return nullptr;
+    }
     return Py_BuildValue(
-            "{sssssLsK}",
+            "{sOsssLsK}",
             get_c_str_from_constexpr_string_view(cStateLogMessage),
-            log_event->get_log_message().c_str(),
+            py_log_message,
             get_c_str_from_constexpr_string_view(cStateFormattedTimestamp),
             log_event->get_formatted_timestamp().c_str(),
             get_c_str_from_constexpr_string_view(cStateTimestamp),
@@ -343,8 +346,8 @@ CLP_FFI_PY_METHOD auto PyLogEvent_setstate(PyLogEvent* self, PyObject* state) ->
         );
         return nullptr;
     }
-    std::string log_message;
-    if (false == clp_ffi_py::parse_py_string(log_message_obj, log_message)) {
+    std::string_view log_message;
+    if (false == clp_ffi_py::parse_py_string_as_string_view(log_message_obj, log_message)) {
         return nullptr;
     }
 
@@ -411,7 +414,9 @@ CLP_FFI_PY_METHOD auto PyLogEvent_repr(PyLogEvent* self) -> PyObject* {
 }
 
 CLP_FFI_PY_METHOD auto PyLogEvent_get_log_message(PyLogEvent* self) -> PyObject* {
-    return PyUnicode_FromString(self->get_log_event()->get_log_message().c_str());
+    auto* py_log_message{self->get_py_log_message()};
+    Py_XINCREF(py_log_message);
+    return py_log_message;
 }
 
 CLP_FFI_PY_METHOD auto PyLogEvent_get_timestamp(PyLogEvent* self) -> PyObject* {
@@ -427,8 +432,7 @@ CLP_FFI_PY_METHOD auto PyLogEvent_match_query(PyLogEvent* self, PyObject* query)
         PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
         return nullptr;
     }
-    auto* py_query{py_reinterpret_cast<PyQuery>(query)};
-    return get_py_bool(py_query->get_query()->matches(*self->get_log_event()));
+    return self->match_query(*py_reinterpret_cast<PyQuery>(query)->get_query());
 }
 
 CLP_FFI_PY_METHOD auto
@@ -468,6 +472,21 @@ auto PyLogEvent::module_level_init(PyObject* py_module) -> bool {
     return add_python_type(get_py_type(), "LogEvent", py_module);
 }
 
+template <typename... Args>
+auto PyLogEvent::emplace_log_event(Args&&... args) -> bool {
+    destroy_log_event();
+    try {
+        m_log_event = new (m_log_event_storage.data()) LogEvent(std::forward<Args>(args)...);
+    } catch (std::bad_alloc const&) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
+        );
+        return false;
+    }
+    return true;
+}
+
 auto PyLogEvent::create_new_log_event(
         std::string_view log_message,
         clp::ir::epoch_time_ms_t timestamp,
@@ -481,8 +500,29 @@ auto PyLogEvent::create_new_log_event(
     }
     self->default_init();
     if (false == self->init(log_message, timestamp, index, metadata)) {
+        Py_DECREF(self);
+        return nullptr;
+    }
+    return self;
+}
+
+auto PyLogEvent::create_new_log_event(
+        EncodedLogMessage encoded_log_message,
+        clp::ir::epoch_time_ms_t timestamp,
+        size_t index,
+        PyMetadata* metadata
+) -> PyLogEvent* {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    PyLogEvent* self{PyObject_New(PyLogEvent, get_py_type())};
+    if (nullptr == self) {
         return nullptr;
     }
+    self->default_init();
+    if (false == self->emplace_log_event(std::move(encoded_log_message), timestamp, index)) {
+        Py_DECREF(self);
+        return nullptr;
+    }
+    self->set_metadata(metadata);
     return self;
 }
 
@@ -493,13 +533,8 @@ auto PyLogEvent::init(
         PyMetadata* metadata,
         std::optional<std::string_view> formatted_timestamp
 ) -> bool {
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-    m_log_event = new (std::nothrow) LogEvent(log_message, timestamp, index, formatted_timestamp);
-    if (nullptr == m_log_event) {
-        PyErr_SetString(
-                PyExc_RuntimeError,
-                get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
-        );
+    Py_CLEAR(m_py_log_message);
+    if (false == emplace_log_event(log_message, timestamp, index, formatted_timestamp)) {
         return false;
     }
     set_metadata(metadata);
@@ -507,42 +542,133 @@ auto PyLogEvent::init(
 }
 
 auto PyLogEvent::get_formatted_message(PyObject* timezone) -> PyObject* {
-    auto cache_formatted_timestamp{false};
-    if (Py_None == timezone) {
-        if (m_log_event->has_formatted_timestamp()) {
-            // If the formatted timestamp exists, it constructs the raw message
-            // without calling python level format function
-            return PyUnicode_FromFormat(
-                    "%s%s",
-                    m_log_event->get_formatted_timestamp().c_str(),
-                    m_log_event->get_log_message().c_str()
-            );
+    auto const use_default_timezone{Py_None == timezone};
+    if (use_default_timezone && nullptr != m_py_formatted_message) {
+        Py_INCREF(m_py_formatted_message);
+        return m_py_formatted_message;
+    }
+
+    std::string_view log_message;
+    if (false == get_log_message_view(log_message)) {
+        return nullptr;
+    }
+    std::string formatted_message;
+    if (use_default_timezone && m_log_event->has_formatted_timestamp()) {
+        // If the formatted timestamp exists, it constructs the raw message without formatting the
+        // timestamp again
+        formatted_message = m_log_event->get_formatted_timestamp();
+    } else {
+        if (false == format_timestamp(timezone, formatted_message)) {
+            return nullptr;
         }
-        if (has_metadata()) {
-            timezone = m_py_metadata->get_py_timezone();
-            cache_formatted_timestamp = true;
+        if (use_default_timezone && has_metadata()) {
+            m_log_event->set_formatted_timestamp(formatted_message);
         }
     }
+    formatted_message.append(log_message);
 
-    PyObjectPtr<PyObject> const formatted_timestamp_object{
-            py_utils_get_formatted_timestamp(m_log_event->get_timestamp(), timezone)
-    };
-    auto* formatted_timestamp_ptr{formatted_timestamp_object.get()};
-    if (nullptr == formatted_timestamp_ptr) {
-        return nullptr;
+    auto* py_formatted_message{PyUnicode_DecodeUTF8(
+            formatted_message.data(),
+            static_cast<Py_ssize_t>(formatted_message.size()),
+            "replace"
+    )};
+    if (use_default_timezone && nullptr != py_formatted_message) {
+        Py_INCREF(py_formatted_message);
+        m_py_formatted_message = py_formatted_message;
     }
-    std::string formatted_timestamp;
-    if (false == parse_py_string(formatted_timestamp_ptr, formatted_timestamp)) {
+    return py_formatted_message;
+}
+
+auto PyLogEvent::decode_log_message() -> bool {
+    if (auto const err{m_log_event->decode_log_message()};
+        clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success != err)
+    {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
+                err
+        );
+        return false;
+    }
+    return true;
+}
+
+auto PyLogEvent::match_query(Query const& query) -> PyObject* {
+    if (false == query.matches_time_range(m_log_event->get_timestamp())) {
+        Py_RETURN_FALSE;
+    }
+    if (query.get_wildcard_queries().empty()) {
+        Py_RETURN_TRUE;
+    }
+    std::string_view log_message;
+    if (false == get_log_message_view(log_message)) {
         return nullptr;
     }
+    return get_py_bool(query.matches_wildcard_queries(log_message));
+}
 
-    if (cache_formatted_timestamp) {
-        m_log_event->set_formatted_timestamp(formatted_timestamp);
+auto PyLogEvent::get_log_message_view(std::string_view& log_message) -> bool {
+    if (nullptr != m_py_log_message) {
+        // For ASCII strings, this is a view of the string's own data, without any copy.
+        Py_ssize_t size{0};
+        char const* data{PyUnicode_AsUTF8AndSize(m_py_log_message, &size)};
+        if (nullptr == data) {
+            return false;
+        }
+        log_message = std::string_view{data, static_cast<size_t>(size)};
+        return true;
     }
-    return PyUnicode_FromFormat(
-            "%s%s",
-            formatted_timestamp.c_str(),
-            m_log_event->get_log_message().c_str()
-    );
+    if (false == decode_log_message()) {
+        return false;
+    }
+    log_message = m_log_event->get_log_message_view();
+    return true;
+}
+
+auto PyLogEvent::get_py_log_message() -> PyObject* {
+    if (nullptr == m_py_log_message) {
+        if (false == decode_log_message()) {
+            return nullptr;
+        }
+        auto const log_message{m_log_event->get_log_message_view()};
+        m_py_log_message = PyUnicode_FromStringAndSize(
+                log_message.data(),
+                static_cast<Py_ssize_t>(log_message.size())
+        );
+        if (nullptr == m_py_log_message) {
+            return nullptr;
+        }
+        m_log_event->release_log_message();
+    }
+    return m_py_log_message;
+}
+
+auto PyLogEvent::format_timestamp(PyObject* timezone, std::string& formatted_timestamp) -> bool {
+    auto const timestamp{m_log_event->get_timestamp()};
+    if (Py_None == timezone && has_metadata()) {
+        return m_py_metadata->format_timestamp(timestamp, formatted_timestamp);
+    }
+
+    int32_t utc_offset{0};
+    if (Py_None != timezone) {
+        PyObjectPtr<PyObject> const py_utc_offset{py_utils_get_utc_offset(timestamp, timezone)};
+        if (nullptr == py_utc_offset || false == parse_py_int(py_utc_offset.get(), utc_offset)) {
+            return false;
+        }
+    }
+    // The UTC offset of an explicit timezone is resolved through `datetime`, which already raises
+    // if the timestamp is out of range in the timezone, so only the UTC date can be out of range.
+    TimestampFormatter timestamp_formatter;
+    if (TimestampFormatter::Result::Success
+        != timestamp_formatter.format(timestamp, utc_offset, formatted_timestamp))
+    {
+        PyErr_Format(
+                PyExc_ValueError,
+                get_c_str_from_constexpr_string_view(cTimestampOutOfRangeErrorFormatStr),
+                static_cast<long long>(timestamp)
+        );
+        return false;
+    }
+    return true;
 }
 }  // namespace clp_ffi_py::ir::native
@@ -3,22 +3,32 @@
 
 #include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
 
+#include <array>
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 
 #include <clp/ir/types.hpp>
 
+#include <clp_ffi_py/ir/native/EncodedLogMessage.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
+#include <clp_ffi_py/ir/native/Query.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
 /**
  * A PyObject structure functioning as a Python-compatible interface to retrieve a log event. The
- * underlying data is pointed to by `m_log_event`. The object may reference a PyMetadata object
- * pointed to by `m_py_metadata` that specifies the event's metadata, such as timestamp format, from
- * the preamble.
+ * underlying data is pointed to by `m_log_event`, which is constructed in place within the Python
+ * object's own allocation, so that creating a log event doesn't require another heap allocation.
+ * The object may reference a PyMetadata object pointed to by `m_py_metadata` that specifies the
+ * event's metadata, such as timestamp format, from the preamble. The Python strings of the log
+ * message and the default formatted message are created on the first request and cached, so that
+ * repeated calls return the same objects. Log events created by the deserializer may hold their log
+ * messages encoded; a log message is decoded on the first request, so that accessing only
+ * timestamps or indices skips the decoding.
  */
 class PyLogEvent {
 public:
@@ -56,6 +66,23 @@ public:
             PyMetadata* metadata
     ) -> PyLogEvent*;
 
+    /**
+     * Creates and initializes a new PyLogEvent whose log message is left encoded until it's
+     * requested.
+     * @param encoded_log_message
+     * @param timestamp
+     * @param index
+     * @param metadata A PyMetadata instance to bind with the log event (can be nullptr).
+     * @return a new reference of a PyLogEvent object that is initialized with the given inputs.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto create_new_log_event(
+            EncodedLogMessage encoded_log_message,
+            clp::ir::epoch_time_ms_t timestamp,
+            size_t index,
+            PyMetadata* metadata
+    ) -> PyLogEvent*;
+
     // Delete default constructor to disable direct instantiation.
     PyLogEvent() = delete;
 
@@ -104,23 +131,27 @@ public:
     auto default_init() -> void {
         m_log_event = nullptr;
         m_py_metadata = nullptr;
+        m_py_log_message = nullptr;
+        m_py_formatted_message = nullptr;
     }
 
     /**
-     * Releases the memory allocated for underlying metadata field and the reference hold for the
-     * Python object(s).
+     * Destroys the underlying log event and releases the reference hold for the Python object(s).
      */
     auto clean() -> void {
         Py_XDECREF(m_py_metadata);
-        delete m_log_event;
+        Py_XDECREF(m_py_log_message);
+        Py_XDECREF(m_py_formatted_message);
+        destroy_log_event();
     }
 
     /**
      * Binds the given PyMetadata and holds a reference. If `Py_metadata` has been set already,
-     * decrement the reference to discard the old value.
+     * decrement the reference to discard the old value, along with the cached formatted message.
      * @param metadata
      */
     auto set_metadata(PyMetadata* metadata) -> void {
+        Py_CLEAR(m_py_formatted_message);
         Py_XDECREF(m_py_metadata);
         m_py_metadata = metadata;
         if (nullptr != metadata) {
@@ -133,23 +164,96 @@ public:
      * timezone is provided, this timezone is used to format the timestamp. If the timezone is not
      * provided (Py_None), the default formatted timestamp from the log event is used. In the case
      * where the log event does not have a cached formatted timestamp, it obtains one using the
-     * default timezone from the metadata (if metadata is present), or defaults to UTC.
+     * default timezone from the metadata (if metadata is present), or defaults to UTC. The
+     * formatted message without a specific timezone is cached.
      * @param timezone Python tzinfo object that specifies a timezone.
-     * @return Python string of the formatted log message.
+     * @return A new reference of the Python string of the formatted log message.
      * @return nullptr on failure with the relevant Python exception and error set.
      */
     [[nodiscard]] auto get_formatted_message(PyObject* timezone = Py_None) -> PyObject*;
 
+    /**
+     * Formats the timestamp of the underlying log event natively. If a specific timezone is
+     * provided, its UTC offset at the timestamp is resolved through Python. Otherwise, the
+     * timestamp is formatted using the timezone from the metadata (if metadata is present), or
+     * defaults to UTC.
+     * @param timezone Python tzinfo object that specifies a timezone.
+     * @param formatted_timestamp Returns the formatted timestamp.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto format_timestamp(PyObject* timezone, std::string& formatted_timestamp)
+            -> bool;
+
+    /**
+     * Decodes the log message of the underlying log event if it's still encoded.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto decode_log_message() -> bool;
+
+    /**
+     * Gets the log message, decoding it if it's still encoded. Once the Python string of the log
+     * message is created, the log message is read from that string instead, since the underlying
+     * log event no longer keeps its own copy.
+     * @param log_message Returns a view of the log message, valid until the log event is modified
+     * or destroyed.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto get_log_message_view(std::string_view& log_message) -> bool;
+
+    /**
+     * Matches the log event against the given query. The log message is only decoded if the
+     * timestamp is within the search time range and the query has wildcard queries.
+     * @param query
+     * @return A new reference to `True` if the log event matches the query, or `False` otherwise.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto match_query(Query const& query) -> PyObject*;
+
+    /**
+     * Gets the Python string of the log message, creating it on the first call. Once created, the
+     * underlying log event's copy of the log message is released, so that only one copy is kept.
+     * @return A borrowed reference of the Python string on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto get_py_log_message() -> PyObject*;
+
     [[nodiscard]] auto get_log_event() -> LogEvent* { return m_log_event; }
 
     [[nodiscard]] auto get_py_metadata() -> PyMetadata* { return m_py_metadata; }
 
 private:
+    /**
+     * Constructs the underlying log event in `m_log_event_storage` with the given arguments,
+     * destroying the existing one if any.
+     * @tparam Args
+     * @param args The arguments forwarded to `LogEvent`'s constructor.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    template <typename... Args>
+    [[nodiscard]] auto emplace_log_event(Args&&... args) -> bool;
+
+    /**
+     * Destroys the underlying log event if it has been constructed.
+     */
+    auto destroy_log_event() -> void {
+        if (nullptr != m_log_event) {
+            std::destroy_at(m_log_event);
+            m_log_event = nullptr;
+        }
+    }
+
     static inline PyObjectStaticPtr<PyTypeObject> m_py_type{nullptr};
 
     PyObject_HEAD;
     LogEvent* m_log_event;
     PyMetadata* m_py_metadata;
+    PyObject* m_py_log_message;
+    PyObject* m_py_formatted_message;
+    alignas(LogEvent) std::array<std::byte, sizeof(LogEvent)> m_log_event_storage;
 };
 }  // namespace clp_ffi_py::ir::native
 
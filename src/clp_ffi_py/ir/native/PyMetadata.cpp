@@ -2,7 +2,9 @@
 
 #include "PyMetadata.hpp"
 
+#include <cstdint>
 #include <new>
+#include <string>
 #include <type_traits>
 
 #include <clp/ir/types.hpp>
@@ -11,7 +13,11 @@
 #include <clp_ffi_py/api_decoration.hpp>
 #include <clp_ffi_py/error_messages.hpp>
 #include <clp_ffi_py/ExceptionFFI.hpp>
+#include <clp_ffi_py/ir/native/error_messages.hpp>
 #include <clp_ffi_py/ir/native/Metadata.hpp>
+#include <clp_ffi_py/ir/native/PyTimezoneUtcOffsetCache.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormatter.hpp>
+#include <clp_ffi_py/ir/native/Timezone.hpp>
 #include <clp_ffi_py/Py_utils.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/utils.hpp>
@@ -93,7 +99,8 @@ PyDoc_STRVAR(
         "get_timezone(self)\n"
         "--\n\n"
         "Gets the timezone represented as tzinfo to be use when generating the timestamp from Unix "
-        "epoch time.\n\n"
+        "epoch time. Timestamps are formatted natively from the system's timezone database, so "
+        "the tzinfo object is only created on the first call.\n\n"
         ":return: A new reference to the timezone as tzinfo.\n"
 );
 CLP_FFI_PY_METHOD auto PyMetadata_get_timezone(PyMetadata* self) -> PyObject*;
@@ -215,10 +222,6 @@ CLP_FFI_PY_METHOD auto PyMetadata_get_timezone_id(PyMetadata* self) -> PyObject*
 CLP_FFI_PY_METHOD auto PyMetadata_get_timezone(PyMetadata* self) -> PyObject* {
     auto* timezone{self->get_py_timezone()};
     if (nullptr == timezone) {
-        PyErr_SetString(
-                PyExc_RuntimeError,
-                get_c_str_from_constexpr_string_view(clp_ffi_py::cTimezoneObjectNotInitialized)
-        );
         return nullptr;
     }
     Py_INCREF(timezone);
@@ -268,7 +271,7 @@ auto PyMetadata::init(
         );
         return false;
     }
-    return init_py_timezone();
+    return init_timezone();
 }
 
 auto PyMetadata::init(nlohmann::json const& metadata, bool is_four_byte_encoding) -> bool {
@@ -287,15 +290,84 @@ auto PyMetadata::init(nlohmann::json const& metadata, bool is_four_byte_encoding
         m_metadata = nullptr;
         return false;
     }
-    return init_py_timezone();
+    return init_timezone();
 }
 
-auto PyMetadata::init_py_timezone() -> bool {
-    m_py_timezone = py_utils_get_timezone_from_timezone_id(m_metadata->get_timezone_id());
+auto PyMetadata::get_py_timezone() -> PyObject* {
     if (nullptr == m_py_timezone) {
+        m_py_timezone = py_utils_get_timezone_from_timezone_id(m_metadata->get_timezone_id());
+    }
+    return m_py_timezone;
+}
+
+auto PyMetadata::init_timezone() -> bool {
+    m_timezone = Timezone::get(m_metadata->get_timezone_id());
+    if (nullptr == m_timezone) {
+        // Fall back to the Python tzinfo object, which also validates the timezone id.
+        if (nullptr == get_py_timezone()) {
+            return false;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        m_utc_offset_cache = new (std::nothrow) PyTimezoneUtcOffsetCache(m_py_timezone);
+        if (nullptr == m_utc_offset_cache) {
+            PyErr_SetString(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
+            );
+            return false;
+        }
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    m_timestamp_formatter = new (std::nothrow) TimestampFormatter();
+    if (nullptr == m_timestamp_formatter) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::cOutOfMemoryError)
+        );
         return false;
     }
-    Py_INCREF(m_py_timezone);
     return true;
 }
+
+auto PyMetadata::format_timestamp(clp::ir::epoch_time_ms_t timestamp, std::string& output)
+        -> bool {
+    if (nullptr != m_timezone) {
+        return format_timestamp(timestamp, m_timezone->get_utc_offset(timestamp), output);
+    }
+    auto const utc_offset{m_utc_offset_cache->resolve_utc_offset(timestamp)};
+    if (false == utc_offset.has_value()) {
+        return false;
+    }
+    return format_timestamp(timestamp, utc_offset.value(), output);
+}
+
+auto PyMetadata::format_timestamp(
+        clp::ir::epoch_time_ms_t timestamp,
+        int32_t utc_offset,
+        std::string& output
+) -> bool {
+    // Raises the same types of exceptions as `datetime.fromtimestamp`.
+    switch (m_timestamp_formatter->format(timestamp, utc_offset, output)) {
+        case TimestampFormatter::Result::Success:
+            return true;
+        case TimestampFormatter::Result::UtcDateOutOfRange:
+            PyErr_Format(
+                    PyExc_ValueError,
+                    get_c_str_from_constexpr_string_view(cTimestampOutOfRangeErrorFormatStr),
+                    static_cast<long long>(timestamp)
+            );
+            return false;
+        case TimestampFormatter::Result::LocalDateOutOfRange:
+            PyErr_Format(
+                    PyExc_OverflowError,
+                    get_c_str_from_constexpr_string_view(
+                            cTimestampLocalDateOutOfRangeErrorFormatStr
+                    ),
+                    static_cast<long long>(timestamp)
+            );
+            return false;
+    }
+    return false;
+}
 }  // namespace clp_ffi_py::ir::native
@@ -3,17 +3,26 @@
 
 #include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
 
+#include <cstdint>
+#include <string>
+
 #include <clp/ir/types.hpp>
 #include <json/single_include/nlohmann/json.hpp>
 
 #include <clp_ffi_py/ir/native/Metadata.hpp>
+#include <clp_ffi_py/ir/native/PyTimezoneUtcOffsetCache.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormatter.hpp>
+#include <clp_ffi_py/ir/native/Timezone.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
 /**
  * A PyObject structure functioning as a Python-compatible interface to retrieve CLP IR metadata.
- * The underlying data is pointed to by `m_metadata`. Additionally, it retains a tzinfo object at
- * the Python level that signifies the corresponding timezone.
+ * The underlying data is pointed to by `m_metadata`. The timezone is resolved natively from the
+ * system's timezone database, and the timestamp formatter used to format the timestamps of the log
+ * events in this timezone is retained. A tzinfo object at the Python level that signifies the
+ * corresponding timezone is only created on request, or as a fallback if the timezone isn't
+ * available in the system's timezone database.
  */
 class PyMetadata {
 public:
@@ -93,6 +102,8 @@ public:
      */
     auto clean() -> void {
         delete m_metadata;
+        delete m_utc_offset_cache;
+        delete m_timestamp_formatter;
         Py_XDECREF(m_py_timezone);
     }
 
@@ -102,27 +113,69 @@ public:
      */
     auto default_init() -> void {
         m_metadata = nullptr;
+        m_timezone = nullptr;
         m_py_timezone = nullptr;
+        m_utc_offset_cache = nullptr;
+        m_timestamp_formatter = nullptr;
     }
 
+    /**
+     * Formats the given timestamp in the timezone of the metadata, and appends it to the given
+     * output.
+     * @param timestamp
+     * @param output
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto format_timestamp(clp::ir::epoch_time_ms_t timestamp, std::string& output)
+            -> bool;
+
     [[nodiscard]] auto get_metadata() -> Metadata* { return m_metadata; }
 
-    [[nodiscard]] auto get_py_timezone() -> PyObject* { return m_py_timezone; }
+    /**
+     * Gets the Python tzinfo object of the timezone, creating it on the first request.
+     * @return A borrowed reference of the tzinfo object on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto get_py_timezone() -> PyObject*;
+
+    /**
+     * @return The native timezone, or nullptr if the timezone isn't available in the system's
+     * timezone database, in which case the Python tzinfo object is used instead.
+     */
+    [[nodiscard]] auto get_timezone() -> Timezone const* { return m_timezone; }
 
 private:
     static inline PyObjectStaticPtr<PyTypeObject> m_py_type{nullptr};
 
     /**
-     * Initializes py_timezone by setting the corresponded tzinfo object from the timezone id.
+     * Initializes the timezone from the timezone id and the timestamp formatter of the timezone. If
+     * the timezone isn't available in the system's timezone database, the corresponded tzinfo
+     * object and its UTC offset cache are initialized instead.
      * Should be called by `init` methods.
      * @return true on success.
      * @return false on failure with the relevant Python exception and error set.
      */
-    [[nodiscard]] auto init_py_timezone() -> bool;
+    [[nodiscard]] auto init_timezone() -> bool;
+
+    /**
+     * Formats the given timestamp with the given UTC offset using the timestamp formatter.
+     * @param timestamp
+     * @param utc_offset
+     * @param output
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto
+    format_timestamp(clp::ir::epoch_time_ms_t timestamp, int32_t utc_offset, std::string& output)
+            -> bool;
 
     PyObject_HEAD;
     Metadata* m_metadata;
+    Timezone const* m_timezone;
     PyObject* m_py_timezone;
+    PyTimezoneUtcOffsetCache* m_utc_offset_cache;
+    TimestampFormatter* m_timestamp_formatter;
 };
 }  // namespace clp_ffi_py::ir::native
 
@@ -112,6 +112,23 @@ PyDoc_STRVAR(
 );
 CLP_FFI_PY_METHOD auto PyQuery_match_log_event(PyQuery* self, PyObject* log_event) -> PyObject*;
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyQueryGetMatchingWildcardQueryIndicesDoc,
+        "get_matching_wildcard_query_indices(self, log_event)\n"
+        "--\n\n"
+        "Finds all the wildcard queries that match the input log message. The search time range "
+        "is not considered.\n\n"
+        "With many wildcard queries, the literals of all the wildcard queries are searched in a "
+        "single pass over the log message, and only the wildcard queries whose literals are found "
+        "are fully matched.\n\n"
+        ":param log_event: Input log event.\n"
+        ":return: A list of the indices of the matching wildcard queries in the list returned by "
+        "`get_wildcard_queries`, in ascending order.\n"
+);
+CLP_FFI_PY_METHOD auto
+PyQuery_get_matching_wildcard_query_indices(PyQuery* self, PyObject* log_event) -> PyObject*;
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cPyQueryGetSearchTimeLowerBoundDoc,
@@ -201,6 +218,11 @@ PyMethodDef PyQuery_method_table[]{
          METH_O,
          static_cast<char const*>(cPyQueryMatchLogEventDoc)},
 
+        {"get_matching_wildcard_query_indices",
+         py_c_function_cast(PyQuery_get_matching_wildcard_query_indices),
+         METH_O,
+         static_cast<char const*>(cPyQueryGetMatchingWildcardQueryIndicesDoc)},
+
         {"__getstate__",
          py_c_function_cast(PyQuery_getstate),
          METH_NOARGS,
@@ -488,12 +510,44 @@ CLP_FFI_PY_METHOD auto PyQuery_setstate(PyQuery* self, PyObject* state) -> PyObj
 }
 
 CLP_FFI_PY_METHOD auto PyQuery_match_log_event(PyQuery* self, PyObject* log_event) -> PyObject* {
+    if (false == static_cast<bool>(PyObject_TypeCheck(log_event, PyLogEvent::get_py_type()))) {
+        PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
+        return nullptr;
+    }
+    return py_reinterpret_cast<PyLogEvent>(log_event)->match_query(*self->get_query());
+}
+
+CLP_FFI_PY_METHOD auto
+PyQuery_get_matching_wildcard_query_indices(PyQuery* self, PyObject* log_event) -> PyObject* {
     if (false == static_cast<bool>(PyObject_TypeCheck(log_event, PyLogEvent::get_py_type()))) {
         PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
         return nullptr;
     }
     auto* py_log_event{py_reinterpret_cast<PyLogEvent>(log_event)};
-    return get_py_bool(self->get_query()->matches(*py_log_event->get_log_event()));
+    std::string_view log_message;
+    if (false == py_log_event->get_log_message_view(log_message)) {
+        return nullptr;
+    }
+    auto const matching_indices{
+            self->get_query()->get_matching_wildcard_query_indices(log_message)
+    };
+
+    PyObjectPtr<PyObject> py_matching_indices{
+            PyList_New(static_cast<Py_ssize_t>(matching_indices.size()))
+    };
+    if (nullptr == py_matching_indices) {
+        return nullptr;
+    }
+    Py_ssize_t list_idx{0};
+    for (auto const matching_idx : matching_indices) {
+        auto* py_matching_idx{PyLong_FromSize_t(matching_idx)};
+        if (nullptr == py_matching_idx) {
+            return nullptr;
+        }
+        PyList_SET_ITEM(py_matching_indices.get(), list_idx, py_matching_idx);
+        ++list_idx;
+    }
+    return py_matching_indices.release();
 }
 
 CLP_FFI_PY_METHOD auto PyQuery_get_search_time_lower_bound(PyQuery* self) -> PyObject* {
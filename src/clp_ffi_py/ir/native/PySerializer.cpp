@@ -8,8 +8,10 @@
 #include <new>
 #include <optional>
 #include <span>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 
 #include <clp/ffi/ir_stream/protocol_constants.hpp>
 #include <json/single_include/nlohmann/json.hpp>
@@ -34,7 +36,8 @@ PyDoc_STRVAR(
         "Serializer for serializing CLP key-value pair IR streams.\n"
         "This class serializes log events into the CLP key-value pair IR format and writes the"
         " serialized data to a specified byte stream object.\n\n"
-        "__init__(self, output_stream, buffer_size_limit=65536, user_defined_metadata=None)\n\n"
+        "__init__(self, output_stream, buffer_size_limit=65536, user_defined_metadata=None,"
+        " encoding=\"four_byte\")\n\n"
         "Initializes a :class:`Serializer` instance with the given output stream. Note that each"
         " object should only be initialized once. Double initialization will result in a memory"
         " leak.\n\n"
@@ -49,6 +52,11 @@ PyDoc_STRVAR(
         " it must be valid for serialization as a string using the `Python Standard JSON library"
         " <https://docs.python.org/3/library/json.html>`_\.\n"
         ":type user_defined_metadata: dict | None\n"
+        ":param encoding: The encoding of the variables in the serialized IR stream, either"
+        " \"four_byte\" or \"eight_byte\". The eight-byte encoding can encode 64-bit integers and"
+        " high-precision floats that would be stored as dictionary variables with the four-byte"
+        " encoding, at the cost of larger encoded variables.\n"
+        ":type encoding: str\n"
 );
 CLP_FFI_PY_METHOD auto PySerializer_init(PySerializer* self, PyObject* args, PyObject* keywords)
         -> int;
@@ -221,15 +229,29 @@ PyType_Spec PySerializer_type_spec{
         static_cast<PyType_Slot*>(PySerializer_slots)
 };
 
+/**
+ * Creates a CLP IR serializer of the given type.
+ * @tparam ClpIrSerializerType One of the alternatives of `PySerializer::ClpIrSerializer`.
+ * @param optional_user_defined_metadata
+ * @return The created serializer on success.
+ * @return std::nullopt on failure with the relevant Python exception and error set.
+ */
+template <typename ClpIrSerializerType>
+[[nodiscard]] auto
+create_clp_ir_serializer(std::optional<nlohmann::json> const& optional_user_defined_metadata)
+        -> std::optional<PySerializer::ClpIrSerializer>;
+
 CLP_FFI_PY_METHOD auto PySerializer_init(PySerializer* self, PyObject* args, PyObject* keywords)
         -> int {
     static char keyword_output_stream[]{"output_stream"};
     static char keyword_buffer_size_limit[]{"buffer_size_limit"};
     static char keyword_user_defined_metadata[]{"user_defined_metadata"};
+    static char keyword_encoding[]{"encoding"};
     static char* keyword_table[]{
             static_cast<char*>(keyword_output_stream),
             static_cast<char*>(keyword_buffer_size_limit),
             static_cast<char*>(keyword_user_defined_metadata),
+            static_cast<char*>(keyword_encoding),
             nullptr
     };
 
@@ -240,15 +262,17 @@ CLP_FFI_PY_METHOD auto PySerializer_init(PySerializer* self, PyObject* args, PyO
     PyObject* output_stream{Py_None};
     PyObject* py_user_defined_metadata{Py_None};
     Py_ssize_t buffer_size_limit{PySerializer::cDefaultBufferSizeLimit};
+    char const* encoding_c_str{PySerializer::cFourByteEncoding.data()};
     if (false
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
                 keywords,
-                "O|nO",
+                "O|nOs",
                 static_cast<char**>(keyword_table),
                 &output_stream,
                 &buffer_size_limit,
-                &py_user_defined_metadata
+                &py_user_defined_metadata,
+                &encoding_c_str
         )))
     {
         return -1;
@@ -287,6 +311,19 @@ CLP_FFI_PY_METHOD auto PySerializer_init(PySerializer* self, PyObject* args, PyO
         return -1;
     }
 
+    std::string_view const encoding{encoding_c_str};
+    if (PySerializer::cFourByteEncoding != encoding && PySerializer::cEightByteEncoding != encoding)
+    {
+        PyErr_Format(
+                PyExc_ValueError,
+                "Unsupported encoding: %s. Expected \"%s\" or \"%s\".",
+                encoding_c_str,
+                PySerializer::cFourByteEncoding.data(),
+                PySerializer::cEightByteEncoding.data()
+        );
+        return -1;
+    }
+
     std::optional<nlohmann::json> optional_user_defined_metadata;
     if (Py_None != py_user_defined_metadata) {
         if (false == static_cast<bool>(PyDict_Check(py_user_defined_metadata))) {
@@ -328,17 +365,21 @@ CLP_FFI_PY_METHOD auto PySerializer_init(PySerializer* self, PyObject* args, PyO
         optional_user_defined_metadata = std::move(parsed_user_defined_metadata);
     }
 
-    auto serializer_result{PySerializer::ClpIrSerializer::create(optional_user_defined_metadata)};
-    if (serializer_result.has_error()) {
-        PyErr_Format(
-                PyExc_RuntimeError,
-                get_c_str_from_constexpr_string_view(cSerializerCreateErrorFormatStr),
-                serializer_result.error().message().c_str()
-        );
+    auto optional_serializer{
+            PySerializer::cFourByteEncoding == encoding
+                    ? create_clp_ir_serializer<PySerializer::FourByteClpIrSerializer>(
+                              optional_user_defined_metadata
+                      )
+                    : create_clp_ir_serializer<PySerializer::EightByteClpIrSerializer>(
+                              optional_user_defined_metadata
+                      )
+    };
+    if (false == optional_serializer.has_value()) {
         return -1;
     }
 
-    if (false == self->init(output_stream, std::move(serializer_result.value()), buffer_size_limit))
+    if (false
+        == self->init(output_stream, std::move(optional_serializer.value()), buffer_size_limit))
     {
         return -1;
     }
@@ -470,6 +511,21 @@ CLP_FFI_PY_METHOD auto PySerializer_dealloc(PySerializer* self) -> void {
     self->clean();
     Py_TYPE(self)->tp_free(py_reinterpret_cast<PyObject>(self));
 }
+
+template <typename ClpIrSerializerType>
+auto create_clp_ir_serializer(std::optional<nlohmann::json> const& optional_user_defined_metadata)
+        -> std::optional<PySerializer::ClpIrSerializer> {
+    auto serializer_result{ClpIrSerializerType::create(optional_user_defined_metadata)};
+    if (serializer_result.has_error()) {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cSerializerCreateErrorFormatStr),
+                serializer_result.error().message().c_str()
+        );
+        return std::nullopt;
+    }
+    return PySerializer::ClpIrSerializer{std::move(serializer_result.value())};
+}
 }  // namespace
 
 auto PySerializer::module_level_init(PyObject* py_module) -> bool {
@@ -534,12 +590,19 @@ auto PySerializer::serialize_log_event_from_msgpack_map(
 
     auto const buffer_size_before_serialization{get_ir_buf_size()};
     // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+    auto const& auto_gen_msgpack_map{optional_auto_gen_msgpack_map_handle.value().get().via.map};
+    auto const& user_gen_msgpack_map{optional_user_gen_msgpack_map_handle.value().get().via.map};
+    // NOLINTEND(cppcoreguidelines-pro-type-union-access)
     if (false
-        == m_serializer->serialize_msgpack_map(
-                optional_auto_gen_msgpack_map_handle.value().get().via.map,
-                optional_user_gen_msgpack_map_handle.value().get().via.map
+        == std::visit(
+                [&](auto& serializer) -> bool {
+                    return serializer.serialize_msgpack_map(
+                            auto_gen_msgpack_map,
+                            user_gen_msgpack_map
+                    );
+                },
+                *m_serializer
         ))
-    // NOLINTEND(cppcoreguidelines-pro-type-union-access)
     {
         PyErr_SetString(
                 PyExc_RuntimeError,
@@ -582,7 +645,7 @@ auto PySerializer::close() -> bool {
 
     // Write end-of-stream
     constexpr std::array<int8_t, 1> cEndOfStreamBuf{clp::ffi::ir_stream::cProtocol::Eof};
-    if (false == write_to_output_stream({cEndOfStreamBuf.cbegin(), cEndOfStreamBuf.cend()})) {
+    if (false == write_to_py_output_stream(m_output_stream, cEndOfStreamBuf)) {
         return false;
     }
     m_num_total_bytes_serialized += cEndOfStreamBuf.size();
@@ -600,55 +663,14 @@ auto PySerializer::write_ir_buf_to_output_stream() -> bool {
         return false;
     }
 
-    auto const optional_num_bytes_written{write_to_output_stream(m_serializer->get_ir_buf_view())};
-    if (false == optional_num_bytes_written.has_value()) {
-        return false;
-    }
-    if (optional_num_bytes_written.value() != get_ir_buf_size()) {
-        PyErr_SetString(
-                PyExc_RuntimeError,
-                "The number of bytes written to the output stream doesn't match the size of the "
-                "internal buffer"
-        );
+    if (false == write_to_py_output_stream(m_output_stream, get_ir_buf_view())) {
         return false;
     }
 
-    m_serializer->clear_ir_buf();
+    std::visit([](auto& serializer) -> void { serializer.clear_ir_buf(); }, *m_serializer);
     return true;
 }
 
-auto PySerializer::write_to_output_stream(PySerializer::BufferView buf)
-        -> std::optional<Py_ssize_t> {
-    if (buf.empty()) {
-        return 0;
-    }
-
-    // `PyBUF_READ` ensures the buffer is read-only, so it should be safe to cast `char const*` to
-    // `char*`
-    PyObjectPtr<PyObject> const ir_buf_mem_view{PyMemoryView_FromMemory(
-            // NOLINTNEXTLINE(bugprone-casting-through-void, cppcoreguidelines-pro-type-*-cast)
-            static_cast<char*>(const_cast<void*>(static_cast<void const*>(buf.data()))),
-            static_cast<Py_ssize_t>(buf.size()),
-            PyBUF_READ
-    )};
-    if (nullptr == ir_buf_mem_view) {
-        return std::nullopt;
-    }
-
-    PyObjectPtr<PyObject> const py_num_bytes_written{
-            PyObject_CallMethod(m_output_stream, "write", "O", ir_buf_mem_view.get())
-    };
-    if (nullptr == py_num_bytes_written) {
-        return std::nullopt;
-    }
-
-    Py_ssize_t num_bytes_written{};
-    if (false == parse_py_int(py_num_bytes_written.get(), num_bytes_written)) {
-        return std::nullopt;
-    }
-    return num_bytes_written;
-}
-
 auto PySerializer::flush_output_stream() -> bool {
     PyObjectPtr<PyObject> const ret_val{PyObject_CallMethod(m_output_stream, "flush", "")};
     if (nullptr == ret_val) {
@@ -6,6 +6,9 @@
 #include <cstddef>
 #include <optional>
 #include <span>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
 #include <clp/ffi/ir_stream/Serializer.hpp>
 #include <clp/ir/types.hpp>
@@ -15,14 +18,26 @@
 
 namespace clp_ffi_py::ir::native {
 /**
- * A PyObject structure for CLP key-value pair IR format serialization (using four-byte encoding).
- * The underlying serializer is pointed by `m_serializer`, and the serialized IR stream is written
- * into an `IO[byte]` stream pointed by `m_output_stream`.
+ * A PyObject structure for CLP key-value pair IR format serialization (using either four-byte or
+ * eight-byte encoding). The underlying serializer is pointed by `m_serializer`, and the serialized
+ * IR stream is written into an `IO[byte]` stream pointed by `m_output_stream`.
  */
 class PySerializer {
 public:
-    using ClpIrSerializer = clp::ffi::ir_stream::Serializer<clp::ir::four_byte_encoded_variable_t>;
-    using BufferView = ClpIrSerializer::BufferView;
+    using FourByteClpIrSerializer
+            = clp::ffi::ir_stream::Serializer<clp::ir::four_byte_encoded_variable_t>;
+    using EightByteClpIrSerializer
+            = clp::ffi::ir_stream::Serializer<clp::ir::eight_byte_encoded_variable_t>;
+    using ClpIrSerializer = std::variant<FourByteClpIrSerializer, EightByteClpIrSerializer>;
+    using BufferView = FourByteClpIrSerializer::BufferView;
+    static_assert(std::is_same_v<BufferView, EightByteClpIrSerializer::BufferView>);
+
+    /**
+     * The names of the supported encodings. Any change to the values should also be applied to
+     * `__init__`'s doc string and Python stub file.
+     */
+    static constexpr std::string_view cFourByteEncoding{"four_byte"};
+    static constexpr std::string_view cEightByteEncoding{"eight_byte"};
 
     /**
      * The default buffer size limit. Any change to the value should also be applied to `__init__`'s
@@ -133,8 +148,15 @@ private:
      */
     [[nodiscard]] auto assert_is_not_closed() const -> bool;
 
+    [[nodiscard]] auto get_ir_buf_view() const -> BufferView {
+        return std::visit(
+                [](auto const& serializer) -> BufferView { return serializer.get_ir_buf_view(); },
+                *m_serializer
+        );
+    }
+
     [[nodiscard]] auto get_ir_buf_size() const -> Py_ssize_t {
-        return static_cast<Py_ssize_t>(m_serializer->get_ir_buf_view().size());
+        return static_cast<Py_ssize_t>(get_ir_buf_view().size());
     }
 
     /**
@@ -154,14 +176,6 @@ private:
         m_serializer = nullptr;
     }
 
-    /**
-     * Wrapper of `output_stream`'s `write` method.
-     * @param buf
-     * @return The number of bytes written on success.
-     * @return std::nullopt on failure with the relevant Python exception and error set.
-     */
-    [[nodiscard]] auto write_to_output_stream(BufferView buf) -> std::optional<Py_ssize_t>;
-
     /**
      * Wrapper of `output_stream`'s `flush` method.
      * @return true on success.
@@ -0,0 +1,63 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "PyTimezoneUtcOffsetCache.hpp"
+
+#include <cstdint>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_py/Py_utils.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto PyTimezoneUtcOffsetCache::cache_window(clp::ir::epoch_time_ms_t timestamp) -> bool {
+    auto window_begin{timestamp / cWindowSize * cWindowSize};
+    if (window_begin > timestamp) {
+        window_begin -= cWindowSize;
+    }
+    auto const window_end{window_begin + cWindowSize - 1};
+    int32_t utc_offset_at_begin{};
+    int32_t utc_offset_at_end{};
+    if (false == get_py_utc_offset(window_begin, utc_offset_at_begin)
+        || false == get_py_utc_offset(window_end, utc_offset_at_end))
+    {
+        return false;
+    }
+
+    // Find the first timestamp with the UTC offset at the end of the window.
+    auto transition_timestamp{window_end};
+    if (utc_offset_at_begin != utc_offset_at_end) {
+        auto lower_bound{window_begin};
+        while (lower_bound + 1 < transition_timestamp) {
+            auto const mid{lower_bound + (transition_timestamp - lower_bound) / 2};
+            int32_t utc_offset{};
+            if (false == get_py_utc_offset(mid, utc_offset)) {
+                return false;
+            }
+            if (utc_offset == utc_offset_at_begin) {
+                lower_bound = mid;
+            } else {
+                transition_timestamp = mid;
+            }
+        }
+    }
+
+    m_window_begin = window_begin;
+    m_transition_timestamp = transition_timestamp;
+    m_utc_offset_before_transition = utc_offset_at_begin;
+    m_utc_offset_after_transition = utc_offset_at_end;
+    return true;
+}
+
+auto PyTimezoneUtcOffsetCache::get_py_utc_offset(
+        clp::ir::epoch_time_ms_t timestamp,
+        int32_t& utc_offset
+) const -> bool {
+    PyObjectPtr<PyObject> const py_utc_offset{py_utils_get_utc_offset(timestamp, m_py_timezone)};
+    if (nullptr == py_utc_offset) {
+        return false;
+    }
+    return parse_py_int(py_utc_offset.get(), utc_offset);
+}
+}  // namespace clp_ffi_py::ir::native
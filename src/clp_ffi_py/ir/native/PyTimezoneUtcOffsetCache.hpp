@@ -0,0 +1,91 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_PYTIMEZONEUTCOFFSETCACHE_HPP
+#define CLP_FFI_PY_IR_NATIVE_PYTIMEZONEUTCOFFSETCACHE_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <cstdint>
+#include <optional>
+
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * Class that resolves the UTC offsets of a Python tzinfo object. The UTC offsets are cached in
+ * fixed-size windows of time, so that Python is only called once per window, and cached UTC
+ * offsets can be looked up without holding the GIL. A window is assumed to contain at most one UTC
+ * offset transition, which is located by a binary search.
+ */
+class PyTimezoneUtcOffsetCache {
+public:
+    // Constants
+    static constexpr clp::ir::epoch_time_ms_t cWindowSize{15LL * 60 * 1000};
+
+    // Constructor
+    /**
+     * @param py_timezone A borrowed reference to a Python tzinfo object, or Py_None for UTC. The
+     * caller must keep it alive for the lifetime of the cache.
+     */
+    explicit PyTimezoneUtcOffsetCache(PyObject* py_timezone) : m_py_timezone{py_timezone} {}
+
+    // Methods
+    /**
+     * Gets the cached UTC offset at the given timestamp. It doesn't require the GIL.
+     * @param timestamp
+     * @return The UTC offset in seconds if the window containing the timestamp is cached.
+     * @return std::nullopt otherwise.
+     */
+    [[nodiscard]] auto get_utc_offset(clp::ir::epoch_time_ms_t timestamp) const
+            -> std::optional<int32_t> {
+        if (false == m_window_begin.has_value() || timestamp < m_window_begin.value()
+            || timestamp >= m_window_begin.value() + cWindowSize)
+        {
+            return std::nullopt;
+        }
+        return timestamp < m_transition_timestamp ? m_utc_offset_before_transition
+                                                  : m_utc_offset_after_transition;
+    }
+
+    /**
+     * Caches the UTC offsets of the window containing the given timestamp. It requires the GIL.
+     * @param timestamp
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto cache_window(clp::ir::epoch_time_ms_t timestamp) -> bool;
+
+    /**
+     * Gets the UTC offset at the given timestamp, caching its window first if necessary. It
+     * requires the GIL.
+     * @param timestamp
+     * @return The UTC offset in seconds on success.
+     * @return std::nullopt on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto resolve_utc_offset(clp::ir::epoch_time_ms_t timestamp)
+            -> std::optional<int32_t> {
+        auto utc_offset{get_utc_offset(timestamp)};
+        if (false == utc_offset.has_value() && cache_window(timestamp)) {
+            utc_offset = get_utc_offset(timestamp);
+        }
+        return utc_offset;
+    }
+
+private:
+    /**
+     * Gets the UTC offset at the given timestamp from Python.
+     * @param timestamp
+     * @param utc_offset Returns the UTC offset in seconds.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto
+    get_py_utc_offset(clp::ir::epoch_time_ms_t timestamp, int32_t& utc_offset) const -> bool;
+
+    PyObject* m_py_timezone;
+    std::optional<clp::ir::epoch_time_ms_t> m_window_begin;
+    clp::ir::epoch_time_ms_t m_transition_timestamp{0};
+    int32_t m_utc_offset_before_transition{0};
+    int32_t m_utc_offset_after_transition{0};
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_PYTIMEZONEUTCOFFSETCACHE_HPP
@@ -1,21 +1,163 @@
 #include "Query.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <clp/string_utils/string_utils.hpp>
 
 namespace clp_ffi_py::ir::native {
-auto Query::matches_wildcard_queries(std::string_view log_message) const -> bool {
+namespace {
+/**
+ * @param c
+ * @return The given character converted to lowercase.
+ */
+[[nodiscard]] auto to_lower(char c) -> char;
+
+auto to_lower(char c) -> char {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+}  // namespace
+
+auto WildcardQuery::matches(std::string_view str) const -> bool {
+    if (false == contains_longest_literal(str)) {
+        return false;
+    }
+    return matches_without_prefilter(str);
+}
+
+auto WildcardQuery::matches_without_prefilter(std::string_view str) const -> bool {
+    return clp::string_utils::wildcard_match_unsafe(str, m_wildcard_query, m_case_sensitive);
+}
+
+auto WildcardQuery::contains_longest_literal(std::string_view str) const -> bool {
+    if (m_longest_literal.empty()) {
+        return true;
+    }
+    if (m_case_sensitive) {
+        // `std::string_view::find` locates the candidates of the literal's first character using
+        // `memchr`, which is vectorized in common C libraries.
+        return std::string_view::npos != str.find(m_longest_literal);
+    }
+    auto const case_insensitive_equal = [](char c, char lowercase_literal_char) -> bool {
+        return to_lower(c) == lowercase_literal_char;
+    };
+    return false == std::ranges::search(str, m_longest_literal, case_insensitive_equal).empty();
+}
+
+auto WildcardQuery::extract_longest_literal(std::string_view wildcard_query, bool case_sensitive)
+        -> std::string {
+    std::string longest_literal;
+    std::string literal;
+    bool is_escaped{false};
+    for (auto const c : wildcard_query) {
+        if (false == is_escaped) {
+            if ('\\' == c) {
+                is_escaped = true;
+                continue;
+            }
+            if ('*' == c || '?' == c) {
+                if (literal.size() > longest_literal.size()) {
+                    std::swap(literal, longest_literal);
+                }
+                literal.clear();
+                continue;
+            }
+        }
+        is_escaped = false;
+        literal.push_back(case_sensitive ? c : to_lower(c));
+    }
+    if (literal.size() > longest_literal.size()) {
+        std::swap(literal, longest_literal);
+    }
+    return longest_literal;
+}
+
+auto Query::matches_wildcard_queries(std::string_view log_message, MatchState& state) const
+        -> bool {
     if (m_wildcard_queries.empty()) {
         return true;
     }
-    return std::ranges::any_of(m_wildcard_queries, [&](auto const& wildcard_query) {
-        return clp::string_utils::wildcard_match_unsafe(
-                log_message,
+    if (false == m_literal_automaton.has_value()) {
+        return std::ranges::any_of(m_wildcard_queries, [&](auto const& wildcard_query) {
+            return wildcard_query.matches(log_message);
+        });
+    }
+    auto& is_candidate{state.m_is_candidate_wildcard_query};
+    find_candidate_wildcard_queries(log_message, is_candidate);
+    for (size_t idx{0}; idx < m_wildcard_queries.size(); ++idx) {
+        if (is_candidate[idx] && m_wildcard_queries[idx].matches_without_prefilter(log_message)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto Query::get_matching_wildcard_query_indices(std::string_view log_message) const
+        -> std::vector<size_t> {
+    std::vector<size_t> matching_indices;
+    if (false == m_literal_automaton.has_value()) {
+        for (size_t idx{0}; idx < m_wildcard_queries.size(); ++idx) {
+            if (m_wildcard_queries[idx].matches(log_message)) {
+                matching_indices.push_back(idx);
+            }
+        }
+        return matching_indices;
+    }
+    std::vector<bool> is_candidate;
+    find_candidate_wildcard_queries(log_message, is_candidate);
+    for (size_t idx{0}; idx < m_wildcard_queries.size(); ++idx) {
+        if (is_candidate[idx] && m_wildcard_queries[idx].matches_without_prefilter(log_message)) {
+            matching_indices.push_back(idx);
+        }
+    }
+    return matching_indices;
+}
+
+auto Query::generate_id() -> size_t {
+    static std::atomic<size_t> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto Query::compile_wildcard_queries() -> void {
+    for (auto const& wildcard_query : m_wildcard_queries) {
+        m_logtype_matcher.add_wildcard_query(
                 wildcard_query.get_wildcard_query(),
                 wildcard_query.is_case_sensitive()
         );
-    });
+    }
+
+    if (m_wildcard_queries.size() < cMinNumWildcardQueriesForLiteralAutomaton) {
+        return;
+    }
+    // The automaton matches literals case-insensitively, so for case-sensitive wildcard queries, it
+    // may report literals that don't occur. This is fine since it only finds the candidates.
+    auto& literal_automaton{m_literal_automaton.emplace()};
+    for (size_t idx{0}; idx < m_wildcard_queries.size(); ++idx) {
+        auto const& literal{m_wildcard_queries[idx].get_longest_literal()};
+        if (false == literal.empty()) {
+            literal_automaton.add_literal(literal, idx);
+        }
+    }
+    literal_automaton.build();
+}
+
+auto Query::find_candidate_wildcard_queries(
+        std::string_view log_message,
+        std::vector<bool>& is_candidate
+) const -> void {
+    auto const num_wildcard_queries{m_wildcard_queries.size()};
+    is_candidate.assign(num_wildcard_queries, false);
+    m_literal_automaton->find(log_message, is_candidate);
+    for (size_t idx{0}; idx < num_wildcard_queries; ++idx) {
+        if (m_wildcard_queries[idx].get_longest_literal().empty()) {
+            is_candidate[idx] = true;
+        }
+    }
 }
 }  // namespace clp_ffi_py::ir::native
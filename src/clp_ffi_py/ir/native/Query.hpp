@@ -1,7 +1,9 @@
 #ifndef CLP_FFI_PY_IR_NATIVE_QUERY_HPP
 #define CLP_FFI_PY_IR_NATIVE_QUERY_HPP
 
+#include <cstddef>
 #include <limits>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -11,12 +13,18 @@
 #include <clp/ir/types.hpp>
 
 #include <clp_ffi_py/ExceptionFFI.hpp>
+#include <clp_ffi_py/ir/native/AhoCorasickAutomaton.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
+#include <clp_ffi_py/ir/native/LogtypeMatcher.hpp>
 
 namespace clp_ffi_py::ir::native {
 /**
  * This class defines a wildcard query, which includes a wildcard string and a boolean value to
  * indicate if the match is case-sensitive.
+ * <p>
+ * The wildcard query is compiled once on construction: its longest literal (a run of characters
+ * without any wildcard) is extracted, since any matching string must contain it. Matching first
+ * searches the string for this literal, and only runs the full wildcard matching if it's found.
  */
 class WildcardQuery {
 public:
@@ -27,15 +35,54 @@ public:
      */
     WildcardQuery(std::string wildcard_query, bool case_sensitive)
             : m_wildcard_query(std::move(wildcard_query)),
-              m_case_sensitive(case_sensitive) {}
+              m_case_sensitive(case_sensitive),
+              m_longest_literal{extract_longest_literal(m_wildcard_query, m_case_sensitive)} {}
 
     [[nodiscard]] auto get_wildcard_query() const -> std::string const& { return m_wildcard_query; }
 
     [[nodiscard]] auto is_case_sensitive() const -> bool { return m_case_sensitive; }
 
+    /**
+     * @return The longest literal of the wildcard query with escape characters removed, converted
+     * to lowercase if the match is case-insensitive. Empty if the query has no literal.
+     */
+    [[nodiscard]] auto get_longest_literal() const -> std::string const& {
+        return m_longest_literal;
+    }
+
+    /**
+     * @param str
+     * @return Whether the given string matches the wildcard query.
+     */
+    [[nodiscard]] auto matches(std::string_view str) const -> bool;
+
+    /**
+     * Matches the given string against the wildcard query without searching for the longest literal
+     * first. Used when the literal is already known to occur in the string.
+     * @param str
+     * @return Whether the given string matches the wildcard query.
+     */
+    [[nodiscard]] auto matches_without_prefilter(std::string_view str) const -> bool;
+
 private:
+    /**
+     * @param str
+     * @return Whether the given string contains the longest literal of the wildcard query.
+     */
+    [[nodiscard]] auto contains_longest_literal(std::string_view str) const -> bool;
+
+    /**
+     * @param wildcard_query
+     * @param case_sensitive
+     * @return The longest literal of the given wildcard query with escape characters removed. If
+     * the match is case-insensitive, the literal is converted to lowercase.
+     */
+    [[nodiscard]] static auto
+    extract_longest_literal(std::string_view wildcard_query, bool case_sensitive) -> std::string;
+
     std::string m_wildcard_query;
     bool m_case_sensitive;
+    std::string m_longest_literal;
 };
 
 /**
@@ -52,9 +99,46 @@ private:
  * timestamp in the IR stream exceeds the query's upper bound timestamp by a reasonable margin.
  * This margin can be specified by the user or it will default to
  * `cDefaultSearchTimeTerminationMargin`.
+ * <p>
+ * NOTE: If the query has at least `cMinNumWildcardQueriesForLiteralAutomaton` wildcard queries, the
+ * longest literals of all the wildcard queries are searched in a log message in a single pass using
+ * an Aho-Corasick automaton. Only the wildcard queries whose literals are found are then matched
+ * against the log message.
+ * <p>
+ * NOTE: A query is immutable once constructed. The caches and scratch buffers of matching are kept
+ * in a `MatchState` owned by the caller, so a query can be matched by concurrent scans (e.g., from
+ * Python threads that released the GIL), each with its own state.
  */
 class Query {
 public:
+    /**
+     * The mutable state of matching log events against one query, reused across the log events of
+     * a single scan: the cached results of logtypes, and the scratch buffer of the candidate
+     * wildcard queries. A state must only be used by one thread at a time.
+     */
+    class MatchState {
+    public:
+        /**
+         * @param query The query to match with this state.
+         */
+        explicit MatchState(Query const& query) : m_query_id{query.m_id} {}
+
+        /**
+         * @param query
+         * @return Whether this state was created for the given query.
+         */
+        [[nodiscard]] auto is_created_for(Query const& query) const -> bool {
+            return query.m_id == m_query_id;
+        }
+
+    private:
+        friend class Query;
+
+        size_t m_query_id;
+        LogtypeMatcher::MatchState m_logtype_match_state;
+        std::vector<bool> m_is_candidate_wildcard_query;
+    };
+
     static constexpr clp::ir::epoch_time_ms_t const cTimestampMin{0};
     static constexpr clp::ir::epoch_time_ms_t const cTimestampMax{
             std::numeric_limits<clp::ir::epoch_time_ms_t>::max()
@@ -62,13 +146,15 @@ public:
     static constexpr clp::ir::epoch_time_ms_t const cDefaultSearchTimeTerminationMargin{
             static_cast<clp::ir::epoch_time_ms_t>(60 * 1000)
     };
+    static constexpr size_t cMinNumWildcardQueriesForLiteralAutomaton{8};
 
     /**
      * Constructs an empty query object that will match all logs. The wildcard query list is empty
      * and the timestamp range is set to include all the valid Unix epoch timestamps.
      */
     explicit Query()
-            : m_lower_bound_ts{cTimestampMin},
+            : m_id{generate_id()},
+              m_lower_bound_ts{cTimestampMin},
               m_upper_bound_ts{cTimestampMax},
               m_search_termination_ts{cTimestampMax} {}
 
@@ -85,7 +171,8 @@ public:
             clp::ir::epoch_time_ms_t search_time_termination_margin
             = cDefaultSearchTimeTerminationMargin
     )
-            : m_lower_bound_ts{search_time_lower_bound},
+            : m_id{generate_id()},
+              m_lower_bound_ts{search_time_lower_bound},
               m_upper_bound_ts{search_time_upper_bound},
               m_search_termination_ts{
                       (cTimestampMax - search_time_termination_margin > search_time_upper_bound)
@@ -109,7 +196,8 @@ public:
           std::vector<WildcardQuery> wildcard_queries,
           clp::ir::epoch_time_ms_t search_time_termination_margin
           = cDefaultSearchTimeTerminationMargin)
-            : m_lower_bound_ts{search_time_lower_bound},
+            : m_id{generate_id()},
+              m_lower_bound_ts{search_time_lower_bound},
               m_upper_bound_ts{search_time_upper_bound},
               m_search_termination_ts{
                       (cTimestampMax - search_time_termination_margin > search_time_upper_bound)
@@ -118,6 +206,7 @@ public:
               },
               m_wildcard_queries{std::move(wildcard_queries)} {
         throw_if_ts_range_invalid();
+        compile_wildcard_queries();
     }
 
     [[nodiscard]] auto get_lower_bound_ts() const -> clp::ir::epoch_time_ms_t {
@@ -161,14 +250,50 @@ public:
     /**
      * Validates whether the input log message matches any of the wildcard queries in the query.
      * @param log_message Input log message.
+     * @param state The state of the current scan, created for this query.
      * @return true if the wildcard query list is empty or at least one wildcard query matches.
      * @return false otherwise.
      */
-    [[nodiscard]] auto matches_wildcard_queries(std::string_view log_message) const -> bool;
+    [[nodiscard]] auto
+    matches_wildcard_queries(std::string_view log_message, MatchState& state) const -> bool;
+
+    /**
+     * Validates whether the input log message matches any of the wildcard queries in the query,
+     * using a state of its own. Used to match a single log message rather than a scan.
+     * @param log_message Input log message.
+     * @return true if the wildcard query list is empty or at least one wildcard query matches.
+     * @return false otherwise.
+     */
+    [[nodiscard]] auto matches_wildcard_queries(std::string_view log_message) const -> bool {
+        MatchState state{*this};
+        return matches_wildcard_queries(log_message, state);
+    }
+
+    /**
+     * Finds all the wildcard queries that match the input log message.
+     * @param log_message Input log message.
+     * @return The indices of the matching wildcard queries in the wildcard query list, in ascending
+     * order.
+     */
+    [[nodiscard]] auto get_matching_wildcard_query_indices(std::string_view log_message) const
+            -> std::vector<size_t>;
+
+    /**
+     * Matches the wildcard queries against the logtype of an encoded log event, without decoding
+     * its variables (see `LogtypeMatcher`).
+     * @param logtype
+     * @param state The state of the current scan, created for this query, which caches the result.
+     * @return Whether the log event always matches, never matches, or needs to be decoded to match
+     * the wildcard queries.
+     */
+    [[nodiscard]] auto match_logtype(std::string_view logtype, MatchState& state) const
+            -> LogtypeMatcher::Result {
+        return m_logtype_matcher.match(logtype, state.m_logtype_match_state);
+    }
 
     /**
      * Validates whether the input log event matches the query.
-     * @param log_event Input log event.
+     * @param log_event Input log event, whose log message must be decoded.
      * @return true if the timestamp is in range, and the wildcard list is empty or has at least one
      * match.
      * @return false otherwise.
@@ -179,6 +304,30 @@ public:
     }
 
 private:
+    /**
+     * @return A new ID that's unique among all the queries constructed in the process.
+     */
+    [[nodiscard]] static auto generate_id() -> size_t;
+
+    /**
+     * Compiles the wildcard queries into the logtype matcher and, if there are enough wildcard
+     * queries, the literal automaton.
+     */
+    auto compile_wildcard_queries() -> void;
+
+    /**
+     * Finds the wildcard queries that may match the given log message, i.e., the ones whose longest
+     * literals occur in the log message, or that have no literal. Must only be called if the
+     * literal automaton is built.
+     * @param log_message
+     * @param is_candidate Returns whether each wildcard query may match, indexed by its index in
+     * the wildcard query list.
+     */
+    auto find_candidate_wildcard_queries(
+            std::string_view log_message,
+            std::vector<bool>& is_candidate
+    ) const -> void;
+
     /**
      * Throws an exception if the lower bound ts exceeds the upper bound ts.
      */
@@ -193,10 +342,14 @@ private:
         }
     }
 
+    // Identifies the query that a `MatchState` is created for.
+    size_t m_id;
     clp::ir::epoch_time_ms_t m_lower_bound_ts;
     clp::ir::epoch_time_ms_t m_upper_bound_ts;
     clp::ir::epoch_time_ms_t m_search_termination_ts;
     std::vector<WildcardQuery> m_wildcard_queries;
+    LogtypeMatcher m_logtype_matcher;
+    std::optional<AhoCorasickAutomaton> m_literal_automaton;
 };
 }  // namespace clp_ffi_py::ir::native
 
@@ -0,0 +1,187 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "ReadaheadReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <gsl/gsl>
+
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/BufferViewReader.hpp>
+#include <clp_ffi_py/ir/native/LocalFileReader.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto ReadaheadReader::create(PyObject* input, Py_ssize_t num_buffers, Py_ssize_t buffer_size)
+        -> gsl::owner<ReadaheadReader*> {
+    if (static_cast<Py_ssize_t>(cMinNumBuffers) > num_buffers) {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The number of readahead buffers must be at least %zu.",
+                cMinNumBuffers
+        );
+        return nullptr;
+    }
+    if (0 >= buffer_size) {
+        PyErr_SetString(PyExc_ValueError, "The readahead buffer size must be positive.");
+        return nullptr;
+    }
+
+    // Both source readers below never call into the Python interpreter when reading, so they can
+    // be read by the readahead thread.
+    std::unique_ptr<clp::ReaderInterface> source;
+    if (static_cast<bool>(PyObject_CheckBuffer(input))) {
+        source.reset(BufferViewReader::create(input));
+    } else if (BufferViewReader::is_supported_input(input)) {
+        source.reset(LocalFileReader::create(input));
+    } else {
+        PyErr_SetString(
+                PyExc_TypeError,
+                "Readahead requires the input to be a path or an object supporting the buffer"
+                " protocol."
+        );
+        return nullptr;
+    }
+    if (nullptr == source) {
+        return nullptr;
+    }
+
+    gsl::owner<ReadaheadReader*> reader{nullptr};
+    try {
+        reader = new ReadaheadReader{
+                std::move(source),
+                static_cast<size_t>(num_buffers),
+                static_cast<size_t>(buffer_size)
+        };
+    } catch (std::bad_alloc const&) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cOutOfMemoryError)
+        );
+        return nullptr;
+    }
+    try {
+        reader->m_readahead_thread = std::thread{&ReadaheadReader::fill_buffers, reader};
+    } catch (std::system_error const& ex) {
+        delete reader;
+        PyErr_Format(PyExc_RuntimeError, "Failed to start the readahead thread: %s", ex.what());
+        return nullptr;
+    }
+    return reader;
+}
+
+ReadaheadReader::ReadaheadReader(
+        std::unique_ptr<clp::ReaderInterface> source,
+        size_t num_buffers,
+        size_t buffer_size
+)
+        : m_source{std::move(source)},
+          m_buffers(num_buffers) {
+    for (auto& buffer : m_buffers) {
+        buffer.data.resize(buffer_size);
+    }
+}
+
+ReadaheadReader::~ReadaheadReader() {
+    if (false == m_readahead_thread.joinable()) {
+        return;
+    }
+    m_is_stop_requested.store(true, std::memory_order_release);
+    // The readahead thread only waits for the released counter to change, so bump it to wake the
+    // thread up. The counter is never used after this point.
+    m_num_released_buffers.fetch_add(1, std::memory_order_release);
+    m_num_released_buffers.notify_one();
+    m_readahead_thread.join();
+}
+
+auto ReadaheadReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read && false == m_is_last_buffer_consumed) {
+        // Only the consumer updates the released counter, so a relaxed load is sufficient.
+        auto const num_released_buffers{m_num_released_buffers.load(std::memory_order_relaxed)};
+        auto num_filled_buffers{m_num_filled_buffers.load(std::memory_order_acquire)};
+        while (num_filled_buffers == num_released_buffers) {
+            m_num_filled_buffers.wait(num_filled_buffers, std::memory_order_acquire);
+            num_filled_buffers = m_num_filled_buffers.load(std::memory_order_acquire);
+        }
+
+        auto const& buffer{m_buffers[num_released_buffers % m_buffers.size()]};
+        auto const num_bytes_to_copy{
+                std::min(buffer.size - m_current_buffer_pos, num_bytes_to_read - num_bytes_read)
+        };
+        std::copy_n(
+                buffer.data.cbegin() + static_cast<std::ptrdiff_t>(m_current_buffer_pos),
+                num_bytes_to_copy,
+                buf + num_bytes_read
+        );
+        m_current_buffer_pos += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+        if (m_current_buffer_pos < buffer.size) {
+            continue;
+        }
+
+        if (clp::ErrorCode_Success != buffer.error_code) {
+            // The readahead thread has exited after filling the last buffer, so there's no need to
+            // release it.
+            m_is_last_buffer_consumed = true;
+            m_last_error_code = buffer.error_code;
+            break;
+        }
+        m_current_buffer_pos = 0;
+        m_num_released_buffers.store(num_released_buffers + 1, std::memory_order_release);
+        m_num_released_buffers.notify_one();
+    }
+    m_pos += num_bytes_read;
+
+    if (0 == num_bytes_read && 0 != num_bytes_to_read) {
+        return m_is_last_buffer_consumed ? m_last_error_code : clp::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto ReadaheadReader::fill_buffers() -> void {
+    // Only this thread updates the filled counter.
+    size_t num_filled_buffers{0};
+    while (true) {
+        auto num_released_buffers{m_num_released_buffers.load(std::memory_order_acquire)};
+        while (num_filled_buffers - num_released_buffers == m_buffers.size()) {
+            if (m_is_stop_requested.load(std::memory_order_acquire)) {
+                return;
+            }
+            m_num_released_buffers.wait(num_released_buffers, std::memory_order_acquire);
+            num_released_buffers = m_num_released_buffers.load(std::memory_order_acquire);
+        }
+        if (m_is_stop_requested.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        auto& buffer{m_buffers[num_filled_buffers % m_buffers.size()]};
+        size_t num_bytes_read{0};
+        try {
+            buffer.error_code
+                    = m_source->try_read(buffer.data.data(), buffer.data.size(), num_bytes_read);
+        } catch (std::exception const&) {
+            buffer.error_code = clp::ErrorCode_Failure;
+        }
+        buffer.size = num_bytes_read;
+
+        ++num_filled_buffers;
+        m_num_filled_buffers.store(num_filled_buffers, std::memory_order_release);
+        m_num_filled_buffers.notify_one();
+        if (clp::ErrorCode_Success != buffer.error_code) {
+            return;
+        }
+    }
+}
+}  // namespace clp_ffi_py::ir::native
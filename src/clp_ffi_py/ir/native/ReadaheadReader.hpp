@@ -0,0 +1,144 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_READAHEADREADER_HPP
+#define CLP_FFI_PY_IR_NATIVE_READAHEADREADER_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <gsl/gsl>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class implements `clp::ReaderInterface` to read from a source reader through a native
+ * readahead thread. While the consumer decodes the data in one buffer, the readahead thread fills
+ * the next buffers from the source, so that the I/O latency of the source (e.g., page faults of a
+ * memory-mapped file, or reads from a network file system) overlaps with decoding.
+ *
+ * The buffers form a ring that is handed off between the readahead thread (the only producer) and
+ * the reader's user (the only consumer) through two monotonically increasing atomic counters: the
+ * number of buffers filled by the producer, and the number of buffers released by the consumer. A
+ * buffer is owned by the producer iff its index is in [num_filled, num_released + num_buffers),
+ * and by the consumer otherwise. Each side blocks (using `std::atomic::wait`) only when it runs out
+ * of buffers to work on.
+ *
+ * The source is either a local file, or an object supporting the buffer protocol (including
+ * memory-mapped files). The readahead thread never interacts with the Python interpreter, so the
+ * reader can be used without holding the GIL.
+ */
+class ReadaheadReader : public clp::ReaderInterface {
+public:
+    static constexpr size_t cMinNumBuffers{2};
+
+    // Factory function
+    /**
+     * Creates a reader and starts its readahead thread.
+     * @param input The path of a local file, or an object supporting the buffer protocol.
+     * @param num_buffers The number of buffers. Must be at least `cMinNumBuffers`.
+     * @param buffer_size The size of each buffer. Must be positive.
+     * @return The transferred ownership of a created object on success.
+     * @return nullptr on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] static auto
+    create(PyObject* input, Py_ssize_t num_buffers, Py_ssize_t buffer_size)
+            -> gsl::owner<ReadaheadReader*>;
+
+    // Delete copy & move constructors and assignment operators
+    ReadaheadReader(ReadaheadReader const&) = delete;
+    ReadaheadReader(ReadaheadReader&&) = delete;
+    auto operator=(ReadaheadReader const&) -> ReadaheadReader& = delete;
+    auto operator=(ReadaheadReader&&) -> ReadaheadReader& = delete;
+
+    // Destructor
+    /**
+     * Stops the readahead thread and waits for it to exit.
+     */
+    ~ReadaheadReader() override;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of bytes, blocking until the readahead thread has filled
+     * enough buffers.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_EndOfFile if there is no more data to read.
+     * @return The error code returned by the source reader if it fails.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the source.
+     * TODO: Implement this method when needed.
+     * @param pos
+     * @return clp::ErrorCode_Unsupported always.
+     */
+    [[nodiscard]] auto try_seek_from_begin([[maybe_unused]] size_t pos) -> clp::ErrorCode override {
+        return clp::ErrorCode_Unsupported;
+    }
+
+    /**
+     * @param pos Returns the position of the read head in the source.
+     * @return ErrorCode_Success always.
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode_Success;
+    }
+
+private:
+    // Types
+    struct Buffer {
+        std::vector<char> data;
+        size_t size{0};
+        // The error code returned by the source reader when filling the buffer. Any value other
+        // than ErrorCode_Success marks the last buffer.
+        clp::ErrorCode error_code{clp::ErrorCode_Success};
+    };
+
+    // Constructor
+    /**
+     * @param source The source reader, which must be safe to use without holding the GIL.
+     * @param num_buffers
+     * @param buffer_size
+     * @throw std::bad_alloc if the buffers cannot be allocated.
+     */
+    ReadaheadReader(
+            std::unique_ptr<clp::ReaderInterface> source,
+            size_t num_buffers,
+            size_t buffer_size
+    );
+
+    // Methods
+    /**
+     * The body of the readahead thread: fills free buffers from the source reader until the source
+     * is exhausted, the source fails, or the reader is being destroyed.
+     */
+    auto fill_buffers() -> void;
+
+    // Variables
+    std::unique_ptr<clp::ReaderInterface> m_source;
+    std::vector<Buffer> m_buffers;
+
+    std::atomic<size_t> m_num_filled_buffers{0};
+    std::atomic<size_t> m_num_released_buffers{0};
+    std::atomic<bool> m_is_stop_requested{false};
+
+    // Consumer states
+    size_t m_current_buffer_pos{0};
+    bool m_is_last_buffer_consumed{false};
+    clp::ErrorCode m_last_error_code{clp::ErrorCode_Success};
+    size_t m_pos{0};
+
+    std::thread m_readahead_thread;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_READAHEADREADER_HPP
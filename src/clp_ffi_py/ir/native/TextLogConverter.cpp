@@ -0,0 +1,224 @@
+#include "TextLogConverter.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/ir_stream/encoding_methods.hpp>
+#include <clp/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/type_utils.hpp>
+
+#include <clp_ffi_py/ir/native/error_messages.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto TextLogConverter::convert(clp::ReaderInterface& reader, std::ostream& output) -> size_t {
+    m_ir_buf.reserve(cOutputBufferSize * 2);
+    std::vector<char> read_buf(cReadBufferSize);
+    // The number of bytes at the beginning of `read_buf` that belong to an incomplete line.
+    size_t num_leftover_bytes{0};
+    while (true) {
+        if (num_leftover_bytes == read_buf.size()) {
+            // The line doesn't fit in the buffer, so grow the buffer.
+            read_buf.resize(read_buf.size() * 2);
+        }
+        size_t num_bytes_read{0};
+        auto const err{reader.try_read(
+                read_buf.data() + num_leftover_bytes,
+                read_buf.size() - num_leftover_bytes,
+                num_bytes_read
+        )};
+        if (clp::ErrorCode_EndOfFile == err) {
+            break;
+        }
+        if (clp::ErrorCode_Success != err) {
+            throw OperationFailed(err, __FILE__, __LINE__, "Failed to read the text log.");
+        }
+
+        std::string_view const data{read_buf.data(), num_leftover_bytes + num_bytes_read};
+        size_t line_begin_pos{0};
+        while (true) {
+            auto const line_end_pos{data.find('\n', line_begin_pos)};
+            if (std::string_view::npos == line_end_pos) {
+                break;
+            }
+            process_line(data.substr(line_begin_pos, line_end_pos + 1 - line_begin_pos));
+            line_begin_pos = line_end_pos + 1;
+        }
+        num_leftover_bytes = data.size() - line_begin_pos;
+        std::memmove(read_buf.data(), data.data() + line_begin_pos, num_leftover_bytes);
+
+        if (m_ir_buf.size() >= cOutputBufferSize) {
+            write_ir_buf(output);
+        }
+    }
+    if (0 != num_leftover_bytes) {
+        // The last line doesn't end with a line break.
+        process_line({read_buf.data(), num_leftover_bytes});
+    }
+
+    if (m_has_current_log_event) {
+        serialize_current_log_event();
+    } else if (false == m_is_preamble_serialized) {
+        serialize_preamble(
+                0,
+                m_timestamp_formats.empty() ? "" : m_timestamp_formats.front().get_format()
+        );
+    }
+    m_ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+    write_ir_buf(output);
+    output.flush();
+    if (output.fail()) {
+        throw OperationFailed(
+                clp::ErrorCode_Failure,
+                __FILE__,
+                __LINE__,
+                "Failed to write the IR stream."
+        );
+    }
+    return m_num_log_events;
+}
+
+auto TextLogConverter::parse_timestamp(
+        std::string_view line,
+        clp::ir::epoch_time_ms_t& timestamp
+) -> std::optional<std::pair<size_t, size_t>> {
+    if (m_timestamp_formats.empty()) {
+        return std::nullopt;
+    }
+    if (auto const timestamp_length{
+                m_timestamp_formats[m_last_matched_format_idx].parse(line, m_timezone, timestamp)
+        };
+        timestamp_length.has_value())
+    {
+        return std::make_pair(m_last_matched_format_idx, timestamp_length.value());
+    }
+    for (size_t format_idx{0}; format_idx < m_timestamp_formats.size(); ++format_idx) {
+        if (format_idx == m_last_matched_format_idx) {
+            continue;
+        }
+        if (auto const timestamp_length{
+                    m_timestamp_formats[format_idx].parse(line, m_timezone, timestamp)
+            };
+            timestamp_length.has_value())
+        {
+            m_last_matched_format_idx = format_idx;
+            return std::make_pair(format_idx, timestamp_length.value());
+        }
+    }
+    return std::nullopt;
+}
+
+auto TextLogConverter::process_line(std::string_view line) -> void {
+    clp::ir::epoch_time_ms_t timestamp{};
+    auto const parsed_timestamp{parse_timestamp(line, timestamp)};
+    if (false == parsed_timestamp.has_value()) {
+        if (false == m_has_current_log_event) {
+            m_current_log_message.clear();
+            m_current_timestamp = 0;
+            m_has_current_log_event = true;
+        }
+        m_current_log_message.append(line);
+        return;
+    }
+
+    if (m_has_current_log_event) {
+        serialize_current_log_event();
+    }
+    auto const [format_idx, timestamp_length]{parsed_timestamp.value()};
+    m_current_log_message.assign(line.substr(timestamp_length));
+    m_current_timestamp = timestamp;
+    m_current_format_idx = format_idx;
+    m_has_current_log_event = true;
+}
+
+auto TextLogConverter::serialize_current_log_event() -> void {
+    if (false == m_is_preamble_serialized) {
+        serialize_preamble(
+                m_current_timestamp,
+                m_timestamp_formats.empty()
+                        ? ""
+                        : m_timestamp_formats[m_current_format_idx].get_format()
+        );
+        m_prev_timestamp = m_current_timestamp;
+    }
+
+    m_logtype.clear();
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_message(
+                m_current_log_message,
+                m_logtype,
+                m_ir_buf
+        ))
+    {
+        throw OperationFailed(
+                clp::ErrorCode_Failure,
+                __FILE__,
+                __LINE__,
+                std::string{cSerializeMessageError}
+        );
+    }
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_timestamp(
+                m_current_timestamp - m_prev_timestamp,
+                m_ir_buf
+        ))
+    {
+        throw OperationFailed(
+                clp::ErrorCode_Failure,
+                __FILE__,
+                __LINE__,
+                std::string{cSerializeTimestampError}
+        );
+    }
+    m_prev_timestamp = m_current_timestamp;
+    m_has_current_log_event = false;
+    ++m_num_log_events;
+}
+
+auto TextLogConverter::serialize_preamble(
+        clp::ir::epoch_time_ms_t ref_timestamp,
+        std::string_view timestamp_format
+) -> void {
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_preamble(
+                timestamp_format,
+                {},
+                m_timezone_id,
+                ref_timestamp,
+                m_ir_buf
+        ))
+    {
+        throw OperationFailed(
+                clp::ErrorCode_Failure,
+                __FILE__,
+                __LINE__,
+                std::string{cSerializePreambleError}
+        );
+    }
+    m_is_preamble_serialized = true;
+}
+
+auto TextLogConverter::write_ir_buf(std::ostream& output) -> void {
+    output.write(
+            clp::size_checked_pointer_cast<char const>(m_ir_buf.data()),
+            static_cast<std::streamsize>(m_ir_buf.size())
+    );
+    if (output.fail()) {
+        throw OperationFailed(
+                clp::ErrorCode_Failure,
+                __FILE__,
+                __LINE__,
+                "Failed to write the IR stream."
+        );
+    }
+    m_ir_buf.clear();
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,153 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_TEXTLOGCONVERTER_HPP
+#define CLP_FFI_PY_IR_NATIVE_TEXTLOGCONVERTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/TraceableException.hpp>
+
+#include <clp_ffi_py/ir/native/TimestampFormat.hpp>
+#include <clp_ffi_py/ir/native/Timezone.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class converts a plain-text log into a four-byte encoded IR stream, including its preamble
+ * and the end-of-stream byte.
+ * The text log is split into log events by lines: a line that starts with a timestamp matching any
+ * of the given timestamp formats starts a new log event, and any other line is appended to the
+ * current log event, so that multi-line log events (e.g., stack traces) are kept together. The
+ * timestamp is removed from the log message since it's stored separately in the IR stream. Lines
+ * before the first timestamp form a log event with timestamp 0. Timestamps without a UTC offset are
+ * interpreted in the timezone recorded in the preamble.
+ * The first timestamp in the text log is used as the reference timestamp, and the format that
+ * matched it is recorded in the preamble.
+ * The conversion doesn't interact with the Python interpreter, so it can run without holding the
+ * GIL as long as the given reader doesn't require it.
+ */
+class TextLogConverter {
+public:
+    // Types
+    /**
+     * Exception thrown on conversion failures. Unlike `ExceptionFFI`, it doesn't capture any Python
+     * exception, so it can be thrown without holding the GIL.
+     */
+    class OperationFailed : public clp::TraceableException {
+    public:
+        // Constructor
+        OperationFailed(
+                clp::ErrorCode error_code,
+                char const* const filename,
+                int line_number,
+                std::string message
+        )
+                : TraceableException{error_code, filename, line_number},
+                  m_message{std::move(message)} {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return m_message.c_str();
+        }
+
+    private:
+        std::string m_message;
+    };
+
+    // Constants
+    static constexpr size_t cReadBufferSize{1024ULL * 1024};
+    static constexpr size_t cOutputBufferSize{1024ULL * 1024};
+
+    // Constructor
+    /**
+     * @param timestamp_formats The formats of the timestamps that start log events, tried in order.
+     * @param timezone_id The timezone ID recorded in the preamble.
+     * @param timezone The timezone of `timezone_id`, or nullptr to interpret timestamps without a
+     * UTC offset as UTC.
+     */
+    TextLogConverter(
+            std::vector<TimestampFormat> timestamp_formats,
+            std::string timezone_id,
+            Timezone const* timezone
+    )
+            : m_timestamp_formats{std::move(timestamp_formats)},
+              m_timezone_id{std::move(timezone_id)},
+              m_timezone{timezone} {}
+
+    // Methods
+    /**
+     * Converts the text log read from the given reader.
+     * @param reader
+     * @param output The output stream to write the serialized IR stream into.
+     * @return The number of log events converted.
+     * @throw OperationFailed if reading, serialization, or writing fails.
+     * @throw Any exception thrown by the reader.
+     */
+    [[nodiscard]] auto convert(clp::ReaderInterface& reader, std::ostream& output) -> size_t;
+
+private:
+    /**
+     * Parses the timestamp at the beginning of the given line, trying the format that matched last
+     * first, since consecutive log events usually share the same format.
+     * @param line
+     * @param timestamp Returns the parsed timestamp.
+     * @return The index of the format that matched and the length of the timestamp on success.
+     * @return std::nullopt if the line doesn't start with a timestamp.
+     */
+    [[nodiscard]] auto parse_timestamp(std::string_view line, clp::ir::epoch_time_ms_t& timestamp)
+            -> std::optional<std::pair<size_t, size_t>>;
+
+    /**
+     * Processes a line of the text log, including its line break if any.
+     * @param line
+     */
+    auto process_line(std::string_view line) -> void;
+
+    /**
+     * Serializes the current log event into the IR buffer, serializing the preamble first if it's
+     * the first log event.
+     */
+    auto serialize_current_log_event() -> void;
+
+    /**
+     * Serializes the preamble into the IR buffer.
+     * @param ref_timestamp
+     * @param timestamp_format
+     */
+    auto
+    serialize_preamble(clp::ir::epoch_time_ms_t ref_timestamp, std::string_view timestamp_format)
+            -> void;
+
+    /**
+     * Writes the IR buffer into the output stream and clears it.
+     * @param output
+     */
+    auto write_ir_buf(std::ostream& output) -> void;
+
+    // Variables
+    std::vector<TimestampFormat> m_timestamp_formats;
+    std::string m_timezone_id;
+    Timezone const* m_timezone;
+    size_t m_last_matched_format_idx{0};
+
+    std::string m_current_log_message;
+    clp::ir::epoch_time_ms_t m_current_timestamp{0};
+    size_t m_current_format_idx{0};
+    bool m_has_current_log_event{false};
+    bool m_is_preamble_serialized{false};
+    clp::ir::epoch_time_ms_t m_prev_timestamp{0};
+    size_t m_num_log_events{0};
+
+    std::string m_logtype;
+    std::vector<int8_t> m_ir_buf;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_TEXTLOGCONVERTER_HPP
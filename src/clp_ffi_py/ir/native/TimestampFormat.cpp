@@ -0,0 +1,425 @@
+#include "TimestampFormat.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_py/ir/native/Timezone.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr std::array<std::string_view, 12> cMonthNames{
+        "Jan",
+        "Feb",
+        "Mar",
+        "Apr",
+        "May",
+        "Jun",
+        "Jul",
+        "Aug",
+        "Sep",
+        "Oct",
+        "Nov",
+        "Dec"
+};
+constexpr size_t cMaxFractionWidth{9};
+constexpr size_t cMillisecondFractionWidth{3};
+constexpr int64_t cNumMillisecondsPerSecond{1000};
+constexpr int64_t cNumSecondsPerMinute{60};
+constexpr int64_t cNumMinutesPerHour{60};
+constexpr int64_t cNumHoursPerDay{24};
+constexpr int64_t cNumMillisecondsPerDay{
+        cNumHoursPerDay * cNumMinutesPerHour * cNumSecondsPerMinute * cNumMillisecondsPerSecond
+};
+
+/**
+ * Parses a fixed-width decimal integer.
+ * @param str
+ * @param pos The position of the integer in `str`, which is advanced past the integer on success.
+ * @param width The number of digits.
+ * @param value Returns the parsed integer.
+ * @return Whether the integer is parsed successfully.
+ */
+[[nodiscard]] auto
+parse_fixed_width_int(std::string_view str, size_t& pos, size_t width, int64_t& value) -> bool;
+
+/**
+ * Parses a fixed-width decimal integer and validates that it's within the given range.
+ * @param str
+ * @param pos The position of the integer in `str`, which is advanced past the integer on success.
+ * @param width The number of digits.
+ * @param min_value
+ * @param max_value
+ * @param value Returns the parsed integer.
+ * @return Whether the integer is parsed successfully and is within the range.
+ */
+[[nodiscard]] auto parse_bounded_int(
+        std::string_view str,
+        size_t& pos,
+        size_t width,
+        int64_t min_value,
+        int64_t max_value,
+        int64_t& value
+) -> bool;
+
+/**
+ * @param year
+ * @param month
+ * @return The number of days in the given month.
+ */
+[[nodiscard]] auto get_num_days_in_month(int64_t year, int64_t month) -> int64_t;
+
+/**
+ * Converts a date in the proleptic Gregorian calendar into the number of days since the Unix epoch.
+ * See http://howardhinnant.github.io/date_algorithms.html#days_from_civil.
+ * @param year
+ * @param month
+ * @param day
+ * @return The number of days since the Unix epoch.
+ */
+[[nodiscard]] auto get_num_days_since_epoch(int64_t year, int64_t month, int64_t day) -> int64_t;
+
+/**
+ * Converts a local time in the given timezone into a Unix epoch timestamp, assuming there's at most
+ * one UTC offset transition within a day of the local time:
+ * - A local time skipped by a forward transition (e.g., the start of DST) is shifted forward by the
+ *   length of the gap.
+ * - A local time repeated by a backward transition (e.g., the end of DST) resolves to its first
+ *   occurrence.
+ * @param local_time The local time as if it were a Unix epoch timestamp in UTC.
+ * @param timezone
+ * @return The Unix epoch timestamp in milliseconds.
+ */
+[[nodiscard]] auto
+convert_local_time_to_epoch(clp::ir::epoch_time_ms_t local_time, Timezone const& timezone)
+        -> clp::ir::epoch_time_ms_t;
+
+auto parse_fixed_width_int(std::string_view str, size_t& pos, size_t width, int64_t& value)
+        -> bool {
+    if (str.size() < pos + width) {
+        return false;
+    }
+    int64_t parsed_value{0};
+    for (auto const c : str.substr(pos, width)) {
+        if (false == static_cast<bool>(std::isdigit(static_cast<unsigned char>(c)))) {
+            return false;
+        }
+        parsed_value = parsed_value * 10 + (c - '0');
+    }
+    value = parsed_value;
+    pos += width;
+    return true;
+}
+
+auto parse_bounded_int(
+        std::string_view str,
+        size_t& pos,
+        size_t width,
+        int64_t min_value,
+        int64_t max_value,
+        int64_t& value
+) -> bool {
+    return parse_fixed_width_int(str, pos, width, value) && min_value <= value
+           && value <= max_value;
+}
+
+auto get_num_days_in_month(int64_t year, int64_t month) -> int64_t {
+    constexpr std::array<int64_t, 12> cNumDaysInMonth{
+            31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+    };
+    bool const is_leap_year{0 == year % 4 && (0 != year % 100 || 0 == year % 400)};
+    if (2 == month && is_leap_year) {
+        return 29;
+    }
+    return cNumDaysInMonth.at(static_cast<size_t>(month - 1));
+}
+
+auto get_num_days_since_epoch(int64_t year, int64_t month, int64_t day) -> int64_t {
+    year -= month <= 2 ? 1 : 0;
+    int64_t const era{(year >= 0 ? year : year - 399) / 400};
+    int64_t const year_of_era{year - era * 400};
+    int64_t const day_of_year{(153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1};
+    int64_t const day_of_era{
+            year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year
+    };
+    return era * 146'097 + day_of_era - 719'468;
+}
+
+auto convert_local_time_to_epoch(clp::ir::epoch_time_ms_t local_time, Timezone const& timezone)
+        -> clp::ir::epoch_time_ms_t {
+    auto const get_utc_offset = [&](clp::ir::epoch_time_ms_t timestamp) -> int64_t {
+        return static_cast<int64_t>(timezone.get_utc_offset(timestamp)) * cNumMillisecondsPerSecond;
+    };
+    // The offsets before and after any transition near the local time.
+    auto const earlier_utc_offset{get_utc_offset(local_time - cNumMillisecondsPerDay)};
+    auto const later_utc_offset{get_utc_offset(local_time + cNumMillisecondsPerDay)};
+    auto const earlier_candidate{local_time - earlier_utc_offset};
+    auto const later_candidate{local_time - later_utc_offset};
+    bool const is_earlier_candidate_valid{
+            get_utc_offset(earlier_candidate) == earlier_utc_offset
+    };
+    bool const is_later_candidate_valid{get_utc_offset(later_candidate) == later_utc_offset};
+    if (is_earlier_candidate_valid && is_later_candidate_valid) {
+        return std::min(earlier_candidate, later_candidate);
+    }
+    if (is_later_candidate_valid) {
+        return later_candidate;
+    }
+    // Either only the earlier candidate is valid, or the local time is in a gap, in which case the
+    // earlier offset shifts it forward past the gap.
+    return earlier_candidate;
+}
+}  // namespace
+
+auto TimestampFormat::create(std::string_view format) -> std::optional<TimestampFormat> {
+    std::vector<Token> tokens;
+    auto add_literal = [&](std::string_view literal) -> void {
+        if (false == tokens.empty() && TokenType::Literal == tokens.back().type) {
+            tokens.back().literal.append(literal);
+            return;
+        }
+        tokens.push_back({TokenType::Literal, 0, std::string{literal}});
+    };
+
+    bool has_specifier{false};
+    size_t idx{0};
+    while (idx < format.size()) {
+        auto const c{format[idx]};
+        if ('\'' == c) {
+            auto const quote_end_idx{format.find('\'', idx + 1)};
+            if (std::string_view::npos == quote_end_idx) {
+                return std::nullopt;
+            }
+            // Two consecutive single quotes represent a literal single quote.
+            add_literal(
+                    idx + 1 == quote_end_idx ? format.substr(idx, 1)
+                                             : format.substr(idx + 1, quote_end_idx - idx - 1)
+            );
+            idx = quote_end_idx + 1;
+            continue;
+        }
+        if (false == static_cast<bool>(std::isalpha(static_cast<unsigned char>(c)))) {
+            add_literal(format.substr(idx, 1));
+            ++idx;
+            continue;
+        }
+
+        size_t run_length{1};
+        while (idx + run_length < format.size() && c == format[idx + run_length]) {
+            ++run_length;
+        }
+        idx += run_length;
+
+        std::optional<TokenType> type;
+        size_t width{0};
+        switch (c) {
+            case 'y':
+                if (4 == run_length) {
+                    type = TokenType::Year;
+                }
+                break;
+            case 'M':
+                if (2 == run_length) {
+                    type = TokenType::Month;
+                } else if (3 == run_length) {
+                    type = TokenType::MonthName;
+                }
+                break;
+            case 'd':
+                if (2 == run_length) {
+                    type = TokenType::Day;
+                }
+                break;
+            case 'H':
+                if (2 == run_length) {
+                    type = TokenType::Hour;
+                }
+                break;
+            case 'm':
+                if (2 == run_length) {
+                    type = TokenType::Minute;
+                }
+                break;
+            case 's':
+                if (2 == run_length) {
+                    type = TokenType::Second;
+                }
+                break;
+            case 'S':
+                if (run_length <= cMaxFractionWidth) {
+                    type = TokenType::Fraction;
+                    width = run_length;
+                }
+                break;
+            case 'Z':
+                if (1 == run_length) {
+                    type = TokenType::UtcOffset;
+                }
+                break;
+            case 'X':
+                if (3 == run_length) {
+                    type = TokenType::IsoUtcOffset;
+                }
+                break;
+            default:
+                break;
+        }
+        if (false == type.has_value()) {
+            return std::nullopt;
+        }
+        tokens.push_back({type.value(), width, {}});
+        has_specifier = true;
+    }
+
+    if (false == has_specifier) {
+        return std::nullopt;
+    }
+    return TimestampFormat{std::string{format}, std::move(tokens)};
+}
+
+auto TimestampFormat::parse(
+        std::string_view str,
+        Timezone const* timezone,
+        clp::ir::epoch_time_ms_t& timestamp
+) const -> std::optional<size_t> {
+    int64_t year{1970};
+    int64_t month{1};
+    int64_t day{1};
+    int64_t hour{0};
+    int64_t minute{0};
+    int64_t second{0};
+    int64_t millisecond{0};
+    int64_t utc_offset_in_minutes{0};
+    bool has_utc_offset{false};
+
+    // Parses a UTC offset in the form of `+hhmm` or `+hh:mm`, starting from its sign.
+    auto parse_utc_offset = [&](size_t& pos, bool has_colon) -> bool {
+        if (pos >= str.size() || ('+' != str[pos] && '-' != str[pos])) {
+            return false;
+        }
+        bool const is_negative{'-' == str[pos]};
+        ++pos;
+        int64_t offset_hours{};
+        int64_t offset_minutes{};
+        if (false == parse_bounded_int(str, pos, 2, 0, 23, offset_hours)) {
+            return false;
+        }
+        if (has_colon) {
+            if (pos >= str.size() || ':' != str[pos]) {
+                return false;
+            }
+            ++pos;
+        }
+        if (false == parse_bounded_int(str, pos, 2, 0, 59, offset_minutes)) {
+            return false;
+        }
+        utc_offset_in_minutes = offset_hours * cNumMinutesPerHour + offset_minutes;
+        if (is_negative) {
+            utc_offset_in_minutes = -utc_offset_in_minutes;
+        }
+        has_utc_offset = true;
+        return true;
+    };
+
+    size_t pos{0};
+    for (auto const& token : m_tokens) {
+        bool is_parsed{false};
+        switch (token.type) {
+            case TokenType::Literal:
+                is_parsed = str.substr(pos).starts_with(token.literal);
+                pos += token.literal.size();
+                break;
+            case TokenType::Year:
+                is_parsed = parse_fixed_width_int(str, pos, 4, year);
+                break;
+            case TokenType::Month:
+                is_parsed = parse_bounded_int(str, pos, 2, 1, 12, month);
+                break;
+            case TokenType::MonthName:
+                for (size_t month_idx{0}; month_idx < cMonthNames.size(); ++month_idx) {
+                    if (str.substr(pos).starts_with(cMonthNames.at(month_idx))) {
+                        month = static_cast<int64_t>(month_idx) + 1;
+                        pos += cMonthNames.at(month_idx).size();
+                        is_parsed = true;
+                        break;
+                    }
+                }
+                break;
+            case TokenType::Day:
+                is_parsed = parse_bounded_int(str, pos, 2, 1, 31, day);
+                break;
+            case TokenType::Hour:
+                is_parsed = parse_bounded_int(str, pos, 2, 0, 23, hour);
+                break;
+            case TokenType::Minute:
+                is_parsed = parse_bounded_int(str, pos, 2, 0, 59, minute);
+                break;
+            case TokenType::Second:
+                is_parsed = parse_bounded_int(str, pos, 2, 0, 59, second);
+                break;
+            case TokenType::Fraction: {
+                int64_t fraction{};
+                is_parsed = parse_fixed_width_int(str, pos, token.width, fraction);
+                // Scale the fraction to milliseconds, truncating any sub-millisecond digits.
+                for (auto width{token.width}; width < cMillisecondFractionWidth; ++width) {
+                    fraction *= 10;
+                }
+                for (auto width{token.width}; width > cMillisecondFractionWidth; --width) {
+                    fraction /= 10;
+                }
+                millisecond = fraction;
+                break;
+            }
+            case TokenType::UtcOffset:
+                is_parsed = parse_utc_offset(pos, false);
+                break;
+            case TokenType::IsoUtcOffset:
+                if (pos < str.size() && 'Z' == str[pos]) {
+                    utc_offset_in_minutes = 0;
+                    has_utc_offset = true;
+                    ++pos;
+                    is_parsed = true;
+                } else {
+                    is_parsed = parse_utc_offset(pos, true);
+                }
+                break;
+            default:
+                break;
+        }
+        if (false == is_parsed) {
+            return std::nullopt;
+        }
+    }
+
+    if (day > get_num_days_in_month(year, month)) {
+        return std::nullopt;
+    }
+    auto const num_days_since_epoch{get_num_days_since_epoch(year, month, day)};
+    auto const num_minutes_since_epoch{
+            (num_days_since_epoch * cNumHoursPerDay + hour) * cNumMinutesPerHour + minute
+            - utc_offset_in_minutes
+    };
+    timestamp = (num_minutes_since_epoch * cNumSecondsPerMinute + second)
+                        * cNumMillisecondsPerSecond
+                + millisecond;
+    if (false == has_utc_offset && nullptr != timezone) {
+        timestamp = convert_local_time_to_epoch(timestamp, *timezone);
+    }
+    return pos;
+}
+
+auto TimestampFormat::has_utc_offset() const -> bool {
+    return std::ranges::any_of(m_tokens, [](Token const& token) -> bool {
+        return TokenType::UtcOffset == token.type || TokenType::IsoUtcOffset == token.type;
+    });
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,100 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_TIMESTAMPFORMAT_HPP
+#define CLP_FFI_PY_IR_NATIVE_TIMESTAMPFORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_py/ir/native/Timezone.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class parses timestamps of a given format at the beginning of log lines. The format uses the
+ * same specifiers as the timestamp formats stored in IR stream preambles:
+ * - `yyyy`: 4-digit year.
+ * - `MM`: 2-digit month; `MMM`: abbreviated English month name (e.g., `Jan`).
+ * - `dd`: 2-digit day of the month.
+ * - `HH`: 2-digit hour (00-23).
+ * - `mm`: 2-digit minute.
+ * - `ss`: 2-digit second.
+ * - `S` repeated 1 to 9 times: fraction of a second with the given number of digits.
+ * - `Z`: UTC offset as `+hhmm` or `-hhmm`.
+ * - `XXX`: UTC offset as `Z`, `+hh:mm`, or `-hh:mm`.
+ * - Text enclosed in single quotes, and any non-letter character, is matched literally.
+ * Timestamps without a UTC offset are interpreted in the timezone given to `parse`.
+ */
+class TimestampFormat {
+public:
+    // Factory function
+    /**
+     * @param format
+     * @return The timestamp format on success.
+     * @return std::nullopt if the format is invalid or has no specifier.
+     */
+    [[nodiscard]] static auto create(std::string_view format) -> std::optional<TimestampFormat>;
+
+    // Methods
+    [[nodiscard]] auto get_format() const -> std::string const& { return m_format; }
+
+    /**
+     * @return Whether the format has a UTC offset specifier, i.e., whether its timestamps can be
+     * parsed without a timezone.
+     */
+    [[nodiscard]] auto has_utc_offset() const -> bool;
+
+    /**
+     * Parses the timestamp at the beginning of the given string.
+     * @param str
+     * @param timezone The timezone to interpret the timestamp in if it has no UTC offset, or
+     * nullptr to interpret it as UTC.
+     * @param timestamp Returns the parsed timestamp as a Unix epoch timestamp in milliseconds.
+     * @return The length of the parsed timestamp on success.
+     * @return std::nullopt if the string doesn't start with a valid timestamp of this format.
+     */
+    [[nodiscard]] auto parse(
+            std::string_view str,
+            Timezone const* timezone,
+            clp::ir::epoch_time_ms_t& timestamp
+    ) const -> std::optional<size_t>;
+
+private:
+    // Types
+    enum class TokenType : uint8_t {
+        Literal,
+        Year,
+        Month,
+        MonthName,
+        Day,
+        Hour,
+        Minute,
+        Second,
+        Fraction,
+        UtcOffset,
+        IsoUtcOffset
+    };
+
+    struct Token {
+        TokenType type;
+        // The number of digits of a fraction.
+        size_t width;
+        std::string literal;
+    };
+
+    // Constructor
+    TimestampFormat(std::string format, std::vector<Token> tokens)
+            : m_format{std::move(format)},
+              m_tokens{std::move(tokens)} {}
+
+    // Variables
+    std::string m_format;
+    std::vector<Token> m_tokens;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_TIMESTAMPFORMAT_HPP
@@ -0,0 +1,183 @@
+#include "TimestampFormatter.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr int64_t cNumMillisecondsPerSecond{1000};
+constexpr int64_t cNumMicrosecondsPerMillisecond{1000};
+constexpr double cNumMicrosecondsPerSecond{1'000'000.0};
+constexpr int64_t cNumSecondsPerMinute{60};
+constexpr int64_t cNumSecondsPerHour{60 * cNumSecondsPerMinute};
+constexpr int64_t cNumSecondsPerDay{24 * cNumSecondsPerHour};
+// The first and the last second supported by `datetime`, i.e., 0001-01-01 00:00:00 and
+// 9999-12-31 23:59:59.
+constexpr int64_t cMinSupportedSeconds{-62'135'596'800};
+constexpr int64_t cMaxSupportedSeconds{253'402'300'799};
+
+/**
+ * Splits the given timestamp into seconds and milliseconds the same way as
+ * `datetime.fromtimestamp(timestamp / 1000)` does, so that the formatted timestamps are identical
+ * even when the division loses precision (for timestamps far from the epoch).
+ * @param timestamp
+ * @param seconds Returns the number of seconds since the Unix epoch.
+ * @param millisecond Returns the millisecond of the second.
+ */
+auto split_timestamp(clp::ir::epoch_time_ms_t timestamp, int64_t& seconds, int64_t& millisecond)
+        -> void;
+
+/**
+ * Appends the given non-negative integer as a fixed-width decimal integer padded with zeros.
+ * @param value
+ * @param width
+ * @param output
+ */
+auto append_fixed_width_int(int64_t value, size_t width, std::string& output) -> void;
+
+/**
+ * Converts the number of days since the Unix epoch into a date in the proleptic Gregorian calendar.
+ * See http://howardhinnant.github.io/date_algorithms.html#civil_from_days.
+ * @param num_days_since_epoch
+ * @param year Returns the year.
+ * @param month Returns the month.
+ * @param day Returns the day of the month.
+ */
+auto get_civil_date(int64_t num_days_since_epoch, int64_t& year, int64_t& month, int64_t& day)
+        -> void;
+
+auto split_timestamp(clp::ir::epoch_time_ms_t timestamp, int64_t& seconds, int64_t& millisecond)
+        -> void {
+    double integral_part{};
+    auto const fractional_part{std::modf(
+            static_cast<double>(timestamp) / static_cast<double>(cNumMillisecondsPerSecond),
+            &integral_part
+    )};
+    // Round half to even, as CPython does.
+    auto const scaled_fractional_part{fractional_part * cNumMicrosecondsPerSecond};
+    auto microseconds{std::round(scaled_fractional_part)};
+    if (0.5 == std::fabs(scaled_fractional_part - microseconds)) {
+        microseconds = 2.0 * std::round(scaled_fractional_part / 2.0);
+    }
+    if (microseconds >= cNumMicrosecondsPerSecond) {
+        microseconds -= cNumMicrosecondsPerSecond;
+        integral_part += 1.0;
+    } else if (microseconds < 0.0) {
+        microseconds += cNumMicrosecondsPerSecond;
+        integral_part -= 1.0;
+    }
+    seconds = static_cast<int64_t>(integral_part);
+    millisecond = static_cast<int64_t>(microseconds) / cNumMicrosecondsPerMillisecond;
+}
+
+auto append_fixed_width_int(int64_t value, size_t width, std::string& output) -> void {
+    auto const begin_pos{output.size()};
+    output.append(width, '0');
+    for (auto pos{begin_pos + width}; pos > begin_pos && 0 != value; --pos) {
+        output[pos - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+auto get_civil_date(int64_t num_days_since_epoch, int64_t& year, int64_t& month, int64_t& day)
+        -> void {
+    auto const shifted_num_days{num_days_since_epoch + 719'468};
+    int64_t const era{(shifted_num_days >= 0 ? shifted_num_days : shifted_num_days - 146'096)
+                      / 146'097};
+    int64_t const day_of_era{shifted_num_days - era * 146'097};
+    int64_t const year_of_era{
+            (day_of_era - day_of_era / 1460 + day_of_era / 36'524 - day_of_era / 146'096) / 365
+    };
+    int64_t const day_of_year{
+            day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100)
+    };
+    int64_t const shifted_month{(5 * day_of_year + 2) / 153};
+    day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+    month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+    year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+}
+}  // namespace
+
+auto TimestampFormatter::format(
+        clp::ir::epoch_time_ms_t timestamp,
+        int32_t utc_offset,
+        std::string& output
+) -> Result {
+    int64_t seconds{};
+    int64_t millisecond{};
+    split_timestamp(timestamp, seconds, millisecond);
+    if (seconds < cMinSupportedSeconds || seconds > cMaxSupportedSeconds) {
+        return Result::UtcDateOutOfRange;
+    }
+    auto const local_seconds{seconds + utc_offset};
+    if (local_seconds < cMinSupportedSeconds || local_seconds > cMaxSupportedSeconds) {
+        return Result::LocalDateOutOfRange;
+    }
+    if (false == m_cached_local_seconds.has_value()
+        || local_seconds != m_cached_local_seconds.value())
+    {
+        cache_second_prefix(local_seconds);
+    }
+    if (false == m_cached_utc_offset.has_value() || utc_offset != m_cached_utc_offset.value()) {
+        cache_utc_offset_suffix(utc_offset);
+    }
+    output.append(m_second_prefix);
+    append_fixed_width_int(millisecond, 3, output);
+    output.append(m_utc_offset_suffix);
+    return Result::Success;
+}
+
+auto TimestampFormatter::cache_second_prefix(int64_t local_seconds) -> void {
+    auto num_days_since_epoch{local_seconds / cNumSecondsPerDay};
+    auto second_of_day{local_seconds % cNumSecondsPerDay};
+    if (second_of_day < 0) {
+        --num_days_since_epoch;
+        second_of_day += cNumSecondsPerDay;
+    }
+    int64_t year{};
+    int64_t month{};
+    int64_t day{};
+    get_civil_date(num_days_since_epoch, year, month, day);
+
+    m_second_prefix.clear();
+    append_fixed_width_int(year, 4, m_second_prefix);
+    m_second_prefix.push_back('-');
+    append_fixed_width_int(month, 2, m_second_prefix);
+    m_second_prefix.push_back('-');
+    append_fixed_width_int(day, 2, m_second_prefix);
+    m_second_prefix.push_back(' ');
+    append_fixed_width_int(second_of_day / cNumSecondsPerHour, 2, m_second_prefix);
+    m_second_prefix.push_back(':');
+    append_fixed_width_int(
+            second_of_day % cNumSecondsPerHour / cNumSecondsPerMinute,
+            2,
+            m_second_prefix
+    );
+    m_second_prefix.push_back(':');
+    append_fixed_width_int(second_of_day % cNumSecondsPerMinute, 2, m_second_prefix);
+    m_second_prefix.push_back('.');
+    m_cached_local_seconds = local_seconds;
+}
+
+auto TimestampFormatter::cache_utc_offset_suffix(int32_t utc_offset) -> void {
+    m_utc_offset_suffix.clear();
+    m_utc_offset_suffix.push_back(utc_offset < 0 ? '-' : '+');
+    int64_t const abs_utc_offset{utc_offset < 0 ? -int64_t{utc_offset} : int64_t{utc_offset}};
+    append_fixed_width_int(abs_utc_offset / cNumSecondsPerHour, 2, m_utc_offset_suffix);
+    m_utc_offset_suffix.push_back(':');
+    append_fixed_width_int(
+            abs_utc_offset % cNumSecondsPerHour / cNumSecondsPerMinute,
+            2,
+            m_utc_offset_suffix
+    );
+    if (0 != abs_utc_offset % cNumSecondsPerMinute) {
+        m_utc_offset_suffix.push_back(':');
+        append_fixed_width_int(abs_utc_offset % cNumSecondsPerMinute, 2, m_utc_offset_suffix);
+    }
+    m_cached_utc_offset = utc_offset;
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,65 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_TIMESTAMPFORMATTER_HPP
+#define CLP_FFI_PY_IR_NATIVE_TIMESTAMPFORMATTER_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class formats Unix epoch timestamps in milliseconds natively, producing the same output as
+ * `clp_ffi_py.utils.get_formatted_timestamp`, i.e., the ISO 8601 format
+ * `YYYY-MM-DD HH:MM:SS.mmm+HH:MM`, where the UTC offset also includes seconds (`+HH:MM:SS`) if it
+ * isn't a whole number of minutes.
+ *
+ * Like `datetime`, only dates from year 1 to year 9999 are supported, both in UTC and in local
+ * time.
+ *
+ * The formatted date and time up to the second, and the formatted UTC offset, are cached, so that
+ * formatting consecutive timestamps within the same second only formats the milliseconds.
+ */
+class TimestampFormatter {
+public:
+    // Types
+    enum class Result : uint8_t {
+        Success,
+        UtcDateOutOfRange,
+        LocalDateOutOfRange
+    };
+
+    // Methods
+    /**
+     * Formats the given timestamp and appends it to the given output.
+     * @param timestamp
+     * @param utc_offset The UTC offset in seconds of the timezone at the given timestamp.
+     * @param output
+     * @return Result::Success on success, in which case the formatted timestamp is appended.
+     * @return Result::UtcDateOutOfRange if the date in UTC is out of the supported range.
+     * @return Result::LocalDateOutOfRange if the date in local time is out of the supported range.
+     */
+    [[nodiscard]] auto
+    format(clp::ir::epoch_time_ms_t timestamp, int32_t utc_offset, std::string& output) -> Result;
+
+private:
+    /**
+     * Caches the formatted date and time of the given local second, i.e., `YYYY-MM-DD HH:MM:SS.`.
+     * @param local_seconds The number of seconds since the Unix epoch, in local time.
+     */
+    auto cache_second_prefix(int64_t local_seconds) -> void;
+
+    /**
+     * Caches the formatted UTC offset, i.e., `+HH:MM` or `+HH:MM:SS`.
+     * @param utc_offset
+     */
+    auto cache_utc_offset_suffix(int32_t utc_offset) -> void;
+
+    std::optional<int64_t> m_cached_local_seconds;
+    std::string m_second_prefix;
+    std::optional<int32_t> m_cached_utc_offset;
+    std::string m_utc_offset_suffix;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_TIMESTAMPFORMATTER_HPP
@@ -0,0 +1,665 @@
+#include "Timezone.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr std::string_view cDefaultTimezoneDatabaseDir{"/usr/share/zoneinfo"};
+constexpr std::string_view cTzifMagic{"TZif"};
+constexpr size_t cTzifHeaderSize{44};
+constexpr size_t cTzifVersionPos{4};
+constexpr size_t cTzifCountsPos{20};
+constexpr size_t cTzifLocalTimeTypeSize{6};
+constexpr size_t cTzifV1TimeSize{4};
+constexpr size_t cTzifV2TimeSize{8};
+
+constexpr int64_t cNumMillisecondsPerSecond{1000};
+constexpr int32_t cNumSecondsPerMinute{60};
+constexpr int32_t cNumSecondsPerHour{60 * cNumSecondsPerMinute};
+constexpr int64_t cNumSecondsPerDay{24 * cNumSecondsPerHour};
+constexpr int64_t cNumDaysPerWeek{7};
+// 1970-01-01 is a Thursday, where Sunday is 0.
+constexpr int64_t cEpochWeekday{4};
+constexpr int32_t cMaxUtcOffsetHours{24};
+constexpr int32_t cMaxTransitionTimeHours{167};
+constexpr int32_t cDefaultTransitionTime{2 * cNumSecondsPerHour};
+
+/**
+ * The counts in the header of a TZif data block.
+ */
+struct TzifHeader {
+    size_t num_ut_indicators;
+    size_t num_std_indicators;
+    size_t num_leap_seconds;
+    size_t num_transitions;
+    size_t num_local_time_types;
+    size_t num_designation_chars;
+};
+
+/**
+ * Reads a big-endian two's complement integer from the given data.
+ * @tparam IntType
+ * @param data
+ * @param pos
+ * @return The integer.
+ */
+template <typename IntType>
+[[nodiscard]] auto read_big_endian_int(std::span<char const> data, size_t pos) -> IntType;
+
+/**
+ * Parses the header of a TZif data block.
+ * @param data
+ * @param pos The position of the header.
+ * @return The parsed header on success.
+ * @return std::nullopt if the header is invalid or truncated.
+ */
+[[nodiscard]] auto parse_tzif_header(std::span<char const> data, size_t pos)
+        -> std::optional<TzifHeader>;
+
+/**
+ * @param header
+ * @param time_size The size of each transition time and leap second occurrence.
+ * @return The size of the TZif data block following the given header.
+ */
+[[nodiscard]] auto get_tzif_data_block_size(TzifHeader const& header, size_t time_size) -> size_t;
+
+/**
+ * @param timezone_id
+ * @return Whether the timezone ID can be safely used as a relative path in the timezone database.
+ */
+[[nodiscard]] auto is_valid_timezone_id(std::string_view timezone_id) -> bool;
+
+/**
+ * Loads the timezone of the given ID from the system's timezone database.
+ * @param timezone_id
+ * @return The loaded timezone on success.
+ * @return std::nullopt on failure.
+ */
+[[nodiscard]] auto load_timezone(std::string const& timezone_id) -> std::optional<Timezone>;
+
+/**
+ * Parses an unsigned decimal integer of one or more digits.
+ * @param str
+ * @param pos The position of the integer in `str`, which is advanced past the integer on success.
+ * @param max_value
+ * @param value Returns the parsed integer.
+ * @return Whether the integer is parsed successfully and doesn't exceed `max_value`.
+ */
+[[nodiscard]] auto
+parse_tz_int(std::string_view str, size_t& pos, int32_t max_value, int32_t& value) -> bool;
+
+/**
+ * Parses a timezone designation in a POSIX TZ string, either as three or more letters, or quoted
+ * with `<` and `>`.
+ * @param str
+ * @param pos The position of the designation in `str`, which is advanced past it on success.
+ * @return Whether the designation is parsed successfully.
+ */
+[[nodiscard]] auto parse_tz_name(std::string_view str, size_t& pos) -> bool;
+
+/**
+ * Parses a time in a POSIX TZ string in the form of `[+|-]hh[:mm[:ss]]`.
+ * @param str
+ * @param pos The position of the time in `str`, which is advanced past the time on success.
+ * @param max_hours
+ * @param seconds Returns the parsed time in seconds.
+ * @return Whether the time is parsed successfully.
+ */
+[[nodiscard]] auto
+parse_tz_time(std::string_view str, size_t& pos, int32_t max_hours, int32_t& seconds) -> bool;
+
+/**
+ * Parses a transition rule in a POSIX TZ string in the form of `date[/time]`.
+ * @param str
+ * @param pos The position of the rule in `str`, which is advanced past the rule on success.
+ * @param rule Returns the parsed rule.
+ * @return Whether the rule is parsed successfully.
+ */
+[[nodiscard]] auto
+parse_transition_rule(std::string_view str, size_t& pos, Timezone::TransitionRule& rule) -> bool;
+
+/**
+ * @param dividend
+ * @param divisor
+ * @return The quotient rounded towards negative infinity.
+ */
+[[nodiscard]] auto floor_div(int64_t dividend, int64_t divisor) -> int64_t;
+
+/**
+ * @param year
+ * @return Whether the given year is a leap year in the proleptic Gregorian calendar.
+ */
+[[nodiscard]] auto is_leap_year(int64_t year) -> bool;
+
+/**
+ * @param year
+ * @param month
+ * @return The number of days in the given month.
+ */
+[[nodiscard]] auto get_num_days_in_month(int64_t year, int64_t month) -> int64_t;
+
+/**
+ * Converts a date in the proleptic Gregorian calendar into the number of days since the Unix epoch.
+ * See http://howardhinnant.github.io/date_algorithms.html#days_from_civil.
+ * @param year
+ * @param month
+ * @param day
+ * @return The number of days since the Unix epoch.
+ */
+[[nodiscard]] auto get_num_days_since_epoch(int64_t year, int64_t month, int64_t day) -> int64_t;
+
+/**
+ * Gets the year of the given day in the proleptic Gregorian calendar.
+ * See http://howardhinnant.github.io/date_algorithms.html#civil_from_days.
+ * @param num_days_since_epoch
+ * @return The year.
+ */
+[[nodiscard]] auto get_year(int64_t num_days_since_epoch) -> int64_t;
+
+/**
+ * @param rule
+ * @param year
+ * @return The local time of the transition specified by the rule in the given year, in seconds
+ * since the Unix epoch.
+ */
+[[nodiscard]] auto get_local_transition_time(Timezone::TransitionRule const& rule, int64_t year)
+        -> int64_t;
+
+/**
+ * @param rule
+ * @param seconds The number of seconds since the Unix epoch.
+ * @return The UTC offset specified by the POSIX TZ rule at the given time.
+ */
+[[nodiscard]] auto get_posix_tz_utc_offset(Timezone::PosixTzRule const& rule, int64_t seconds)
+        -> int32_t;
+
+template <typename IntType>
+auto read_big_endian_int(std::span<char const> data, size_t pos) -> IntType {
+    uint64_t value{0};
+    for (size_t i{0}; i < sizeof(IntType); ++i) {
+        value = (value << 8U) | static_cast<uint8_t>(data[pos + i]);
+    }
+    return static_cast<IntType>(value);
+}
+
+auto parse_tzif_header(std::span<char const> data, size_t pos) -> std::optional<TzifHeader> {
+    if (data.size() < pos + cTzifHeaderSize
+        || cTzifMagic != std::string_view{data.subspan(pos).data(), cTzifMagic.size()})
+    {
+        return std::nullopt;
+    }
+    auto read_count = [&](size_t idx) -> size_t {
+        return read_big_endian_int<uint32_t>(data, pos + cTzifCountsPos + idx * sizeof(uint32_t));
+    };
+    TzifHeader const header{
+            read_count(0),
+            read_count(1),
+            read_count(2),
+            read_count(3),
+            read_count(4),
+            read_count(5)
+    };
+    if (0 == header.num_local_time_types || 0 == header.num_designation_chars
+        || (0 != header.num_ut_indicators
+            && header.num_local_time_types != header.num_ut_indicators)
+        || (0 != header.num_std_indicators
+            && header.num_local_time_types != header.num_std_indicators))
+    {
+        return std::nullopt;
+    }
+    return header;
+}
+
+auto get_tzif_data_block_size(TzifHeader const& header, size_t time_size) -> size_t {
+    return header.num_transitions * (time_size + 1)
+           + header.num_local_time_types * cTzifLocalTimeTypeSize + header.num_designation_chars
+           + header.num_leap_seconds * (time_size + sizeof(int32_t)) + header.num_std_indicators
+           + header.num_ut_indicators;
+}
+
+auto is_valid_timezone_id(std::string_view timezone_id) -> bool {
+    if (timezone_id.empty() || '/' == timezone_id.front()) {
+        return false;
+    }
+    auto const is_valid_char = [](char c) -> bool {
+        return static_cast<bool>(std::isalnum(static_cast<unsigned char>(c))) || '/' == c
+               || '_' == c || '-' == c || '+' == c || '.' == c;
+    };
+    if (false == std::ranges::all_of(timezone_id, is_valid_char)) {
+        return false;
+    }
+    // Reject any `..` path component.
+    size_t component_begin{0};
+    while (component_begin <= timezone_id.size()) {
+        auto component_end{timezone_id.find('/', component_begin)};
+        if (std::string_view::npos == component_end) {
+            component_end = timezone_id.size();
+        }
+        if (".." == timezone_id.substr(component_begin, component_end - component_begin)) {
+            return false;
+        }
+        component_begin = component_end + 1;
+    }
+    return true;
+}
+
+auto load_timezone(std::string const& timezone_id) -> std::optional<Timezone> {
+    if (false == is_valid_timezone_id(timezone_id)) {
+        return std::nullopt;
+    }
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    auto const* tz_dir{std::getenv("TZDIR")};
+    std::string path{
+            nullptr == tz_dir || '\0' == *tz_dir ? std::string{cDefaultTimezoneDatabaseDir}
+                                                 : std::string{tz_dir}
+    };
+    path.push_back('/');
+    path.append(timezone_id);
+
+    std::error_code error_code;
+    if (false == std::filesystem::is_regular_file(path, error_code)) {
+        return std::nullopt;
+    }
+    std::ifstream tzif_file{path, std::ios::binary};
+    if (false == tzif_file.is_open()) {
+        return std::nullopt;
+    }
+    try {
+        std::vector<char> const tzif_data{
+                std::istreambuf_iterator<char>{tzif_file},
+                std::istreambuf_iterator<char>{}
+        };
+        return Timezone::parse_tzif(tzif_data);
+    } catch (std::ios_base::failure const&) {
+        return std::nullopt;
+    }
+}
+
+auto parse_tz_int(std::string_view str, size_t& pos, int32_t max_value, int32_t& value) -> bool {
+    auto const begin_pos{pos};
+    int64_t parsed_value{0};
+    for (; pos < str.size(); ++pos) {
+        auto const c{str[pos]};
+        if (false == static_cast<bool>(std::isdigit(static_cast<unsigned char>(c)))) {
+            break;
+        }
+        parsed_value = parsed_value * 10 + (c - '0');
+        if (parsed_value > max_value) {
+            return false;
+        }
+    }
+    value = static_cast<int32_t>(parsed_value);
+    return pos > begin_pos;
+}
+
+auto parse_tz_name(std::string_view str, size_t& pos) -> bool {
+    if (pos < str.size() && '<' == str[pos]) {
+        auto const quote_end_pos{str.find('>', pos + 1)};
+        if (std::string_view::npos == quote_end_pos || pos + 1 == quote_end_pos) {
+            return false;
+        }
+        pos = quote_end_pos + 1;
+        return true;
+    }
+    auto const begin_pos{pos};
+    for (; pos < str.size(); ++pos) {
+        if (false == static_cast<bool>(std::isalpha(static_cast<unsigned char>(str[pos])))) {
+            break;
+        }
+    }
+    return pos - begin_pos >= 3;
+}
+
+auto parse_tz_time(std::string_view str, size_t& pos, int32_t max_hours, int32_t& seconds)
+        -> bool {
+    bool is_negative{false};
+    if (pos < str.size() && ('+' == str[pos] || '-' == str[pos])) {
+        is_negative = '-' == str[pos];
+        ++pos;
+    }
+    int32_t hours{};
+    if (false == parse_tz_int(str, pos, max_hours, hours)) {
+        return false;
+    }
+    seconds = hours * cNumSecondsPerHour;
+    for (auto const unit : {cNumSecondsPerMinute, int32_t{1}}) {
+        if (pos >= str.size() || ':' != str[pos]) {
+            break;
+        }
+        ++pos;
+        int32_t value{};
+        if (false == parse_tz_int(str, pos, 59, value)) {
+            return false;
+        }
+        seconds += value * unit;
+    }
+    if (is_negative) {
+        seconds = -seconds;
+    }
+    return true;
+}
+
+auto parse_transition_rule(std::string_view str, size_t& pos, Timezone::TransitionRule& rule)
+        -> bool {
+    using Type = Timezone::TransitionRule::Type;
+    rule = {Type::ZeroBasedJulianDay, 0, 0, 0, cDefaultTransitionTime};
+    if (pos >= str.size()) {
+        return false;
+    }
+    if ('J' == str[pos]) {
+        ++pos;
+        rule.type = Type::JulianDay;
+        if (false == parse_tz_int(str, pos, 365, rule.day) || 0 == rule.day) {
+            return false;
+        }
+    } else if ('M' == str[pos]) {
+        ++pos;
+        rule.type = Type::MonthWeekDay;
+        if (false == parse_tz_int(str, pos, 12, rule.month) || 0 == rule.month
+            || pos >= str.size() || '.' != str[pos++]
+            || false == parse_tz_int(str, pos, 5, rule.week) || 0 == rule.week
+            || pos >= str.size() || '.' != str[pos++]
+            || false == parse_tz_int(str, pos, 6, rule.day))
+        {
+            return false;
+        }
+    } else if (false == parse_tz_int(str, pos, 365, rule.day)) {
+        return false;
+    }
+
+    if (pos < str.size() && '/' == str[pos]) {
+        ++pos;
+        return parse_tz_time(str, pos, cMaxTransitionTimeHours, rule.time);
+    }
+    return true;
+}
+
+auto floor_div(int64_t dividend, int64_t divisor) -> int64_t {
+    auto quotient{dividend / divisor};
+    if (dividend % divisor < 0) {
+        --quotient;
+    }
+    return quotient;
+}
+
+auto is_leap_year(int64_t year) -> bool {
+    return 0 == year % 4 && (0 != year % 100 || 0 == year % 400);
+}
+
+auto get_num_days_in_month(int64_t year, int64_t month) -> int64_t {
+    constexpr std::array<int64_t, 12> cNumDaysInMonth{
+            31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+    };
+    if (2 == month && is_leap_year(year)) {
+        return 29;
+    }
+    return cNumDaysInMonth.at(static_cast<size_t>(month - 1));
+}
+
+auto get_num_days_since_epoch(int64_t year, int64_t month, int64_t day) -> int64_t {
+    year -= month <= 2 ? 1 : 0;
+    int64_t const era{(year >= 0 ? year : year - 399) / 400};
+    int64_t const year_of_era{year - era * 400};
+    int64_t const day_of_year{(153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1};
+    int64_t const day_of_era{
+            year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year
+    };
+    return era * 146'097 + day_of_era - 719'468;
+}
+
+auto get_year(int64_t num_days_since_epoch) -> int64_t {
+    auto const shifted_num_days{num_days_since_epoch + 719'468};
+    int64_t const era{(shifted_num_days >= 0 ? shifted_num_days : shifted_num_days - 146'096)
+                      / 146'097};
+    int64_t const day_of_era{shifted_num_days - era * 146'097};
+    int64_t const year_of_era{
+            (day_of_era - day_of_era / 1460 + day_of_era / 36'524 - day_of_era / 146'096) / 365
+    };
+    int64_t const day_of_year{
+            day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100)
+    };
+    int64_t const shifted_month{(5 * day_of_year + 2) / 153};
+    return year_of_era + era * 400 + (shifted_month >= 10 ? 1 : 0);
+}
+
+auto get_local_transition_time(Timezone::TransitionRule const& rule, int64_t year) -> int64_t {
+    using Type = Timezone::TransitionRule::Type;
+    int64_t num_days_since_epoch{};
+    switch (rule.type) {
+        case Type::JulianDay: {
+            auto day_of_year{static_cast<int64_t>(rule.day) - 1};
+            if (is_leap_year(year) && rule.day >= 60) {
+                ++day_of_year;
+            }
+            num_days_since_epoch = get_num_days_since_epoch(year, 1, 1) + day_of_year;
+            break;
+        }
+        case Type::ZeroBasedJulianDay:
+            num_days_since_epoch = get_num_days_since_epoch(year, 1, 1) + rule.day;
+            break;
+        case Type::MonthWeekDay: {
+            auto const first_day{get_num_days_since_epoch(year, rule.month, 1)};
+            auto const first_weekday{
+                    first_day + cEpochWeekday
+                    - floor_div(first_day + cEpochWeekday, cNumDaysPerWeek) * cNumDaysPerWeek
+            };
+            auto day_of_month{
+                    (rule.day - first_weekday + cNumDaysPerWeek) % cNumDaysPerWeek
+                    + (rule.week - 1) * cNumDaysPerWeek
+            };
+            // The 5th week means the last week of the month.
+            if (day_of_month >= get_num_days_in_month(year, rule.month)) {
+                day_of_month -= cNumDaysPerWeek;
+            }
+            num_days_since_epoch = first_day + day_of_month;
+            break;
+        }
+        default:
+            break;
+    }
+    return num_days_since_epoch * cNumSecondsPerDay + rule.time;
+}
+
+auto get_posix_tz_utc_offset(Timezone::PosixTzRule const& rule, int64_t seconds) -> int32_t {
+    if (false == rule.dst_utc_offset.has_value()) {
+        return rule.std_utc_offset;
+    }
+    auto const dst_utc_offset{rule.dst_utc_offset.value()};
+    auto const year{get_year(floor_div(seconds + rule.std_utc_offset, cNumSecondsPerDay))};
+    // The start of the daylight saving time is specified in the local standard time, and the end
+    // is specified in the local daylight saving time.
+    auto const dst_start{get_local_transition_time(rule.dst_start, year) - rule.std_utc_offset};
+    auto const dst_end{get_local_transition_time(rule.dst_end, year) - dst_utc_offset};
+    bool const is_dst{
+            dst_start < dst_end ? dst_start <= seconds && seconds < dst_end
+                                : seconds < dst_end || dst_start <= seconds
+    };
+    return is_dst ? dst_utc_offset : rule.std_utc_offset;
+}
+}  // namespace
+
+auto Timezone::get(std::string const& timezone_id) -> Timezone const* {
+    // Failures are cached as well, so that the timezone database is normally read once per ID.
+    static std::shared_mutex cache_mutex;
+    static std::unordered_map<std::string, std::unique_ptr<Timezone const>> cache;
+
+    {
+        std::shared_lock const lock{cache_mutex};
+        if (auto const it{cache.find(timezone_id)}; cache.end() != it) {
+            return it->second.get();
+        }
+    }
+
+    // The timezone is loaded without holding the lock, so that concurrent lookups of cached
+    // timezones aren't blocked by file I/O. If another thread loads the same timezone meanwhile,
+    // the timezone cached first is kept.
+    std::unique_ptr<Timezone const> timezone;
+    if (auto optional_timezone{load_timezone(timezone_id)}; optional_timezone.has_value()) {
+        timezone = std::make_unique<Timezone const>(std::move(optional_timezone.value()));
+    }
+    std::unique_lock const lock{cache_mutex};
+    return cache.try_emplace(timezone_id, std::move(timezone)).first->second.get();
+}
+
+auto Timezone::parse_tzif(std::span<char const> tzif_data) -> std::optional<Timezone> {
+    auto optional_header{parse_tzif_header(tzif_data, 0)};
+    if (false == optional_header.has_value()) {
+        return std::nullopt;
+    }
+    size_t pos{cTzifHeaderSize};
+    size_t time_size{cTzifV1TimeSize};
+    if ('\0' != tzif_data[cTzifVersionPos]) {
+        // Version 2+ files have a second header and data block with 64-bit transition times,
+        // followed by a footer, after the version 1 data block.
+        pos += get_tzif_data_block_size(optional_header.value(), cTzifV1TimeSize);
+        optional_header = parse_tzif_header(tzif_data, pos);
+        if (false == optional_header.has_value()) {
+            return std::nullopt;
+        }
+        pos += cTzifHeaderSize;
+        time_size = cTzifV2TimeSize;
+    }
+    auto const& header{optional_header.value()};
+    auto const data_block_end_pos{pos + get_tzif_data_block_size(header, time_size)};
+    if (tzif_data.size() < data_block_end_pos) {
+        return std::nullopt;
+    }
+
+    auto const local_time_types_pos{pos + header.num_transitions * (time_size + 1)};
+    auto get_utc_offset_of_type = [&](size_t type_idx) -> int32_t {
+        return read_big_endian_int<int32_t>(
+                tzif_data,
+                local_time_types_pos + type_idx * cTzifLocalTimeTypeSize
+        );
+    };
+    auto const initial_utc_offset{get_utc_offset_of_type(0)};
+
+    // Only the transitions that change the UTC offset are kept. The last transition is always
+    // kept since the POSIX TZ rule takes effect from it.
+    std::vector<int64_t> transition_times;
+    std::vector<int32_t> transition_utc_offsets;
+    auto utc_offset{initial_utc_offset};
+    for (size_t i{0}; i < header.num_transitions; ++i) {
+        auto const transition_time{
+                cTzifV2TimeSize == time_size
+                        ? read_big_endian_int<int64_t>(tzif_data, pos + i * time_size)
+                        : int64_t{read_big_endian_int<int32_t>(tzif_data, pos + i * time_size)}
+        };
+        auto const type_idx{static_cast<uint8_t>(
+                tzif_data[pos + header.num_transitions * time_size + i]
+        )};
+        if (type_idx >= header.num_local_time_types
+            || (false == transition_times.empty() && transition_time <= transition_times.back()))
+        {
+            return std::nullopt;
+        }
+        auto const transition_utc_offset{get_utc_offset_of_type(type_idx)};
+        if (transition_utc_offset == utc_offset && i + 1 != header.num_transitions) {
+            continue;
+        }
+        transition_times.push_back(transition_time);
+        transition_utc_offsets.push_back(transition_utc_offset);
+        utc_offset = transition_utc_offset;
+    }
+
+    std::optional<PosixTzRule> posix_tz_rule;
+    if (cTzifV2TimeSize == time_size && data_block_end_pos < tzif_data.size()) {
+        std::string_view const footer{
+                tzif_data.subspan(data_block_end_pos).data(),
+                tzif_data.size() - data_block_end_pos
+        };
+        auto const footer_end_pos{footer.find('\n', 1)};
+        if ('\n' != footer.front() || std::string_view::npos == footer_end_pos) {
+            return std::nullopt;
+        }
+        auto const tz_str{footer.substr(1, footer_end_pos - 1)};
+        if (false == tz_str.empty()) {
+            posix_tz_rule = parse_posix_tz_rule(tz_str);
+            if (false == posix_tz_rule.has_value()) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    return Timezone{
+            std::move(transition_times),
+            std::move(transition_utc_offsets),
+            initial_utc_offset,
+            posix_tz_rule
+    };
+}
+
+auto Timezone::parse_posix_tz_rule(std::string_view tz_str) -> std::optional<PosixTzRule> {
+    PosixTzRule rule{};
+    size_t pos{0};
+    // The offsets in POSIX TZ strings are positive to the west of Greenwich.
+    int32_t offset{};
+    if (false == parse_tz_name(tz_str, pos)
+        || false == parse_tz_time(tz_str, pos, cMaxUtcOffsetHours, offset))
+    {
+        return std::nullopt;
+    }
+    rule.std_utc_offset = -offset;
+    if (tz_str.size() == pos) {
+        return rule;
+    }
+
+    if (false == parse_tz_name(tz_str, pos)) {
+        return std::nullopt;
+    }
+    rule.dst_utc_offset = rule.std_utc_offset + cNumSecondsPerHour;
+    if (pos < tz_str.size() && ',' != tz_str[pos]) {
+        if (false == parse_tz_time(tz_str, pos, cMaxUtcOffsetHours, offset)) {
+            return std::nullopt;
+        }
+        rule.dst_utc_offset = -offset;
+    }
+    // The rule of the daylight saving time must be given explicitly, since the default rule is
+    // implementation-defined.
+    if (pos >= tz_str.size() || ',' != tz_str[pos++]
+        || false == parse_transition_rule(tz_str, pos, rule.dst_start) || pos >= tz_str.size()
+        || ',' != tz_str[pos++] || false == parse_transition_rule(tz_str, pos, rule.dst_end)
+        || tz_str.size() != pos)
+    {
+        return std::nullopt;
+    }
+    return rule;
+}
+
+auto Timezone::get_utc_offset(clp::ir::epoch_time_ms_t timestamp) const -> int32_t {
+    auto const seconds{floor_div(timestamp, cNumMillisecondsPerSecond)};
+    auto const it{std::upper_bound(m_transition_times.cbegin(), m_transition_times.cend(), seconds)
+    };
+    if (m_transition_times.cend() == it && m_posix_tz_rule.has_value()) {
+        return get_posix_tz_utc_offset(m_posix_tz_rule.value(), seconds);
+    }
+    if (m_transition_times.cbegin() == it) {
+        return m_initial_utc_offset;
+    }
+    return m_transition_utc_offsets.at(
+            static_cast<size_t>(std::distance(m_transition_times.cbegin(), it) - 1)
+    );
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,122 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_TIMEZONE_HPP
+#define CLP_FFI_PY_IR_NATIVE_TIMEZONE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A class that represents a timezone loaded from the system's timezone database (TZif files, as
+ * specified by RFC 8536), reduced to a compact table of UTC offset transitions. UTC offsets after
+ * the last transition are computed from the POSIX TZ string in the footer of the TZif file.
+ *
+ * Timezones are loaded once and cached process-wide by their timezone ID. The cache is guarded by a
+ * reader-writer lock: looking up a cached timezone only takes a shared lock, and loading a new one
+ * reads the timezone database outside of the lock. The cached timezones are immutable and never
+ * released, so they can be used from any thread without holding the GIL.
+ */
+class Timezone {
+public:
+    // Types
+    /**
+     * A rule in a POSIX TZ string that specifies the date and the local time of a transition
+     * between the standard time and the daylight saving time.
+     */
+    struct TransitionRule {
+        enum class Type : uint8_t {
+            // `Jn`: The Julian day n (1 <= n <= 365), never counting February 29.
+            JulianDay,
+            // `n`: The zero-based Julian day n (0 <= n <= 365), counting February 29.
+            ZeroBasedJulianDay,
+            // `Mm.w.d`: The day d (0 <= d <= 6, Sunday first) of the week w (1 <= w <= 5, where 5
+            // means the last week) of the month m (1 <= m <= 12).
+            MonthWeekDay
+        };
+
+        Type type;
+        int32_t day;
+        int32_t week;
+        int32_t month;
+        // The local time of the transition, in seconds.
+        int32_t time;
+    };
+
+    /**
+     * The UTC offsets specified by a POSIX TZ string, such as `EST5EDT,M3.2.0,M11.1.0`.
+     */
+    struct PosixTzRule {
+        int32_t std_utc_offset;
+        std::optional<int32_t> dst_utc_offset;
+        TransitionRule dst_start;
+        TransitionRule dst_end;
+    };
+
+    // Static methods
+    /**
+     * Gets the timezone of the given ID from the process-wide cache, loading it from the system's
+     * timezone database on the first request. The database is read from the directory specified by
+     * the `TZDIR` environment variable, or from `/usr/share/zoneinfo` by default.
+     * @param timezone_id
+     * @return A pointer to the cached timezone on success.
+     * @return nullptr if the timezone can't be loaded, e.g., the timezone ID is invalid, or the
+     * timezone database isn't available on this platform.
+     */
+    [[nodiscard]] static auto get(std::string const& timezone_id) -> Timezone const*;
+
+    /**
+     * Parses the given TZif data.
+     * @param tzif_data
+     * @return The parsed timezone on success.
+     * @return std::nullopt if the data isn't valid TZif data.
+     */
+    [[nodiscard]] static auto parse_tzif(std::span<char const> tzif_data)
+            -> std::optional<Timezone>;
+
+    /**
+     * Parses the given POSIX TZ string.
+     * @param tz_str
+     * @return The parsed rule on success.
+     * @return std::nullopt if the string isn't a valid POSIX TZ string.
+     */
+    [[nodiscard]] static auto parse_posix_tz_rule(std::string_view tz_str)
+            -> std::optional<PosixTzRule>;
+
+    // Methods
+    /**
+     * @param timestamp
+     * @return The UTC offset in seconds of the timezone at the given timestamp.
+     */
+    [[nodiscard]] auto get_utc_offset(clp::ir::epoch_time_ms_t timestamp) const -> int32_t;
+
+private:
+    // Constructor
+    Timezone(
+            std::vector<int64_t> transition_times,
+            std::vector<int32_t> transition_utc_offsets,
+            int32_t initial_utc_offset,
+            std::optional<PosixTzRule> posix_tz_rule
+    )
+            : m_transition_times{std::move(transition_times)},
+              m_transition_utc_offsets{std::move(transition_utc_offsets)},
+              m_initial_utc_offset{initial_utc_offset},
+              m_posix_tz_rule{posix_tz_rule} {}
+
+    // The transition times in seconds since the Unix epoch, in ascending order.
+    std::vector<int64_t> m_transition_times;
+    // The UTC offset in effect from each transition time.
+    std::vector<int32_t> m_transition_utc_offsets;
+    // The UTC offset in effect before the first transition time.
+    int32_t m_initial_utc_offset;
+    // The rule in effect after the last transition time, if any.
+    std::optional<PosixTzRule> m_posix_tz_rule;
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_TIMEZONE_HPP
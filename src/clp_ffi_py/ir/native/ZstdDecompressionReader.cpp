@@ -0,0 +1,225 @@
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include "ZstdDecompressionReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/type_utils.hpp>
+#include <gsl/gsl>
+
+#ifdef CLP_FFI_PY_ENABLE_NATIVE_ZSTD
+    #include <zstd.h>
+#endif
+
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/BufferViewReader.hpp>
+#include <clp_ffi_py/ir/native/DeserializerBufferReader.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto ZstdDecompressionReader::create(
+        PyObject* input,
+        Py_ssize_t buf_capacity,
+        bool& is_gil_free
+) -> gsl::owner<ZstdDecompressionReader*> {
+    is_gil_free = BufferViewReader::is_supported_input(input);
+    std::unique_ptr<clp::ReaderInterface> compressed_reader;
+    if (is_gil_free) {
+        compressed_reader.reset(BufferViewReader::create(input));
+    } else {
+        compressed_reader.reset(DeserializerBufferReader::create(input, buf_capacity));
+    }
+    if (nullptr == compressed_reader) {
+        return nullptr;
+    }
+    return create(std::move(compressed_reader), false == is_gil_free);
+}
+
+auto ZstdDecompressionReader::create(
+        std::unique_ptr<clp::ReaderInterface> compressed_reader,
+        [[maybe_unused]] bool release_gil
+) -> gsl::owner<ZstdDecompressionReader*> {
+#ifndef CLP_FFI_PY_ENABLE_NATIVE_ZSTD
+    PyErr_SetString(
+            PyExc_NotImplementedError,
+            "Native zstd decompression isn't supported by this build of clp_ffi_py."
+    );
+    return nullptr;
+#else
+    std::span<int8_t const> compressed_data_view;
+    if (auto const* buffer_view_reader{dynamic_cast<BufferViewReader*>(compressed_reader.get())};
+        nullptr != buffer_view_reader)
+    {
+        compressed_data_view = buffer_view_reader->get_view();
+    }
+
+    gsl::owner<ZSTD_DStream*> dstream{ZSTD_createDStream()};
+    if (nullptr == dstream) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cOutOfMemoryError)
+        );
+        return nullptr;
+    }
+    try {
+        return new ZstdDecompressionReader{
+                std::move(compressed_reader),
+                compressed_data_view,
+                dstream,
+                release_gil
+        };
+    } catch (std::bad_alloc const&) {
+        ZSTD_freeDStream(dstream);
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                get_c_str_from_constexpr_string_view(cOutOfMemoryError)
+        );
+        return nullptr;
+    }
+#endif
+}
+
+ZstdDecompressionReader::ZstdDecompressionReader(
+        std::unique_ptr<clp::ReaderInterface> compressed_reader,
+        std::span<int8_t const> compressed_data_view,
+        gsl::owner<ZSTD_DCtx_s*> dstream,
+        bool release_gil
+)
+        : m_compressed_reader{std::move(compressed_reader)},
+          m_dstream{dstream},
+          m_release_gil{release_gil} {
+#ifdef CLP_FFI_PY_ENABLE_NATIVE_ZSTD
+    if (compressed_data_view.data() != nullptr) {
+        m_compressed_data = clp::size_checked_pointer_cast<char const>(compressed_data_view.data());
+        m_compressed_data_end_pos = compressed_data_view.size();
+        m_is_compressed_data_exhausted = true;
+    } else {
+        m_compressed_buffer.resize(ZSTD_DStreamInSize());
+    }
+    m_decompressed_buffer.resize(ZSTD_DStreamOutSize());
+#endif
+}
+
+ZstdDecompressionReader::~ZstdDecompressionReader() {
+#ifdef CLP_FFI_PY_ENABLE_NATIVE_ZSTD
+    ZSTD_freeDStream(m_dstream);
+#endif
+}
+
+auto ZstdDecompressionReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read) {
+        if (m_decompressed_buffer_begin_pos == m_decompressed_buffer_end_pos
+            && false == fill_decompressed_buffer())
+        {
+            break;
+        }
+        auto const num_bytes_to_copy{std::min(
+                m_decompressed_buffer_end_pos - m_decompressed_buffer_begin_pos,
+                num_bytes_to_read - num_bytes_read
+        )};
+        std::copy_n(
+                m_decompressed_buffer.cbegin()
+                        + static_cast<std::ptrdiff_t>(m_decompressed_buffer_begin_pos),
+                num_bytes_to_copy,
+                buf + num_bytes_read
+        );
+        m_decompressed_buffer_begin_pos += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+    }
+    m_pos += num_bytes_read;
+    if (0 == num_bytes_read && 0 != num_bytes_to_read) {
+        return clp::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto ZstdDecompressionReader::fill_decompressed_buffer() -> bool {
+#ifndef CLP_FFI_PY_ENABLE_NATIVE_ZSTD
+    return false;
+#else
+    ZSTD_outBuffer output{m_decompressed_buffer.data(), m_decompressed_buffer.size(), 0};
+    while (true) {
+        if (m_compressed_data_begin_pos == m_compressed_data_end_pos
+            && false == m_is_compressed_data_exhausted)
+        {
+            read_compressed_data();
+        }
+
+        // NOTE: Decompression is attempted even if there's no compressed data left, to flush the
+        // data buffered inside the decompression stream.
+        ZSTD_inBuffer input{
+                m_compressed_data,
+                m_compressed_data_end_pos,
+                m_compressed_data_begin_pos
+        };
+        size_t result{};
+        {
+            std::optional<PyGilReleaseGuard> gil_release_guard;
+            if (m_release_gil) {
+                gil_release_guard.emplace();
+            }
+            result = ZSTD_decompressStream(m_dstream, &output, &input);
+        }
+        m_compressed_data_begin_pos = input.pos;
+        if (static_cast<bool>(ZSTD_isError(result))) {
+            throw OperationFailed(
+                    clp::ErrorCode_Failure,
+                    __FILE__,
+                    __LINE__,
+                    std::string{"zstd decompression failed: "} + ZSTD_getErrorName(result)
+            );
+        }
+
+        if (0 != output.pos) {
+            break;
+        }
+        if (m_compressed_data_begin_pos == m_compressed_data_end_pos
+            && m_is_compressed_data_exhausted)
+        {
+            // If the compressed data ends in the middle of a frame, the decompressed stream is
+            // truncated. It's up to the consumer to detect the incomplete stream.
+            break;
+        }
+    }
+    m_decompressed_buffer_begin_pos = 0;
+    m_decompressed_buffer_end_pos = output.pos;
+    return 0 != output.pos;
+#endif
+}
+
+auto ZstdDecompressionReader::read_compressed_data() -> void {
+    size_t num_bytes_read{0};
+    auto const err{m_compressed_reader->try_read(
+            m_compressed_buffer.data(),
+            m_compressed_buffer.size(),
+            num_bytes_read
+    )};
+    if (clp::ErrorCode_Success != err && clp::ErrorCode_EndOfFile != err) {
+        throw OperationFailed(
+                err,
+                __FILE__,
+                __LINE__,
+                "Failed to read compressed data from the source reader."
+        );
+    }
+    m_compressed_data = m_compressed_buffer.data();
+    m_compressed_data_begin_pos = 0;
+    m_compressed_data_end_pos = num_bytes_read;
+    if (0 == num_bytes_read) {
+        m_is_compressed_data_exhausted = true;
+    }
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,192 @@
+#ifndef CLP_FFI_PY_IR_NATIVE_ZSTDDECOMPRESSIONREADER_HPP
+#define CLP_FFI_PY_IR_NATIVE_ZSTDDECOMPRESSIONREADER_HPP
+
+#include <wrapped_facade_headers/Python.hpp>  // Must be included before any other header files
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/TraceableException.hpp>
+#include <gsl/gsl>
+
+// Forward declaration of zstd's streaming decompression context, to avoid exposing zstd's header.
+struct ZSTD_DCtx_s;
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class implements `clp::ReaderInterface` to consume data decompressed from a zstd-compressed
+ * source reader. It decompresses the source in bulk using a streaming zstd context, and buffers the
+ * decompressed bytes so that small reads don't require any call into zstd. Both the context and the
+ * buffers are allocated once and reused until the reader is destroyed. Concatenated zstd frames are
+ * decompressed as a single stream.
+ * If the compressed data is read in place through `BufferViewReader`, it's decompressed directly
+ * from the underlying memory region without being copied.
+ * If the source reader interacts with the Python interpreter, the reader must be used with the GIL
+ * held. In this case, it can release the GIL during each bulk decompression.
+ * NOTE: This reader is only functional if the library is built with native zstd support.
+ */
+class ZstdDecompressionReader : public clp::ReaderInterface {
+public:
+    // Types
+    /**
+     * Exception thrown on decompression or source read failures. Unlike `ExceptionFFI`, it doesn't
+     * capture any Python exception, so it can be thrown without holding the GIL.
+     */
+    class OperationFailed : public clp::TraceableException {
+    public:
+        // Constructor
+        OperationFailed(
+                clp::ErrorCode error_code,
+                char const* const filename,
+                int line_number,
+                std::string message
+        )
+                : TraceableException{error_code, filename, line_number},
+                  m_message{std::move(message)} {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return m_message.c_str();
+        }
+
+    private:
+        std::string m_message;
+    };
+
+    // Factory functions
+    /**
+     * Creates a reader that decompresses the zstd-compressed data read from the given input.
+     * @param input A Python `IO[bytes]` object, a path, or an object supporting the buffer
+     * protocol.
+     * @param buf_capacity The buffer capacity used to read compressed data from an `IO[bytes]`
+     * input.
+     * @param is_gil_free Returns whether the created reader can be used without holding the GIL,
+     * i.e., whether the compressed data is read in place through `BufferViewReader`. Otherwise, the
+     * reader must be used with the GIL held, and it releases the GIL during decompression.
+     * @return The transferred ownership of a created object on success.
+     * @return nullptr on failure with the relevant Python exception and error set. If the library
+     * is built without native zstd support, `NotImplementedError` is raised.
+     */
+    [[nodiscard]] static auto create(PyObject* input, Py_ssize_t buf_capacity, bool& is_gil_free)
+            -> gsl::owner<ZstdDecompressionReader*>;
+
+    /**
+     * Creates a reader that decompresses the zstd-compressed data read from the given source
+     * reader. If the source reader is a `BufferViewReader`, the compressed data is decompressed
+     * directly from its view.
+     * @param compressed_reader
+     * @param release_gil Whether to release the GIL during decompression. Must only be set if the
+     * reader is used with the GIL held.
+     * @return The transferred ownership of a created object on success.
+     * @return nullptr on failure with the relevant Python exception and error set. If the library
+     * is built without native zstd support, `NotImplementedError` is raised.
+     */
+    [[nodiscard]] static auto
+    create(std::unique_ptr<clp::ReaderInterface> compressed_reader, bool release_gil)
+            -> gsl::owner<ZstdDecompressionReader*>;
+
+    // Delete copy & move constructors and assignment operators
+    ZstdDecompressionReader(ZstdDecompressionReader const&) = delete;
+    ZstdDecompressionReader(ZstdDecompressionReader&&) = delete;
+    auto operator=(ZstdDecompressionReader const&) -> ZstdDecompressionReader& = delete;
+    auto operator=(ZstdDecompressionReader&&) -> ZstdDecompressionReader& = delete;
+
+    // Destructor
+    ~ZstdDecompressionReader() override;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of decompressed bytes.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_EndOfFile if there is no more data to read.
+     * @throw OperationFailed if the decompression fails, or the source reader fails with an error
+     * other than ErrorCode_EndOfFile.
+     * @throw Any exception thrown by the source reader.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the decompressed data.
+     * TODO: Implement this method when needed.
+     * @param pos
+     * @return clp::ErrorCode_Unsupported always.
+     */
+    [[nodiscard]] auto try_seek_from_begin([[maybe_unused]] size_t pos) -> clp::ErrorCode override {
+        return clp::ErrorCode_Unsupported;
+    }
+
+    /**
+     * @param pos Returns the position of the read head in the decompressed data.
+     * @return ErrorCode_Success always.
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode_Success;
+    }
+
+private:
+    // Constructor
+    /**
+     * @param compressed_reader
+     * @param compressed_data_view A view of the entire compressed data if `compressed_reader` reads
+     * from a contiguous memory region, or an empty span otherwise. If given, the compressed data is
+     * decompressed directly from the view instead of being read through `compressed_reader`.
+     * @param dstream An initialized zstd decompression stream, whose ownership is transferred.
+     * @param release_gil Whether to release the GIL during decompression.
+     * @throw std::bad_alloc if the buffers cannot be allocated.
+     */
+    ZstdDecompressionReader(
+            std::unique_ptr<clp::ReaderInterface> compressed_reader,
+            std::span<int8_t const> compressed_data_view,
+            gsl::owner<ZSTD_DCtx_s*> dstream,
+            bool release_gil
+    );
+
+    // Methods
+    /**
+     * Refills the decompressed buffer by decompressing data read from the source reader, until at
+     * least one byte is decompressed or the source reader is exhausted.
+     * @return Whether any byte has been decompressed.
+     * @throw OperationFailed on failure.
+     */
+    [[nodiscard]] auto fill_decompressed_buffer() -> bool;
+
+    /**
+     * Reads the next chunk of compressed data from the source reader.
+     * @throw OperationFailed on failure.
+     */
+    auto read_compressed_data() -> void;
+
+    // Variables
+    std::unique_ptr<clp::ReaderInterface> m_compressed_reader;
+    gsl::owner<ZSTD_DCtx_s*> m_dstream;
+    bool m_release_gil;
+
+    std::vector<char> m_compressed_buffer;
+    // The compressed data to decompress next: either a chunk in `m_compressed_buffer`, or the view
+    // of the entire compressed data.
+    char const* m_compressed_data{nullptr};
+    size_t m_compressed_data_begin_pos{0};
+    size_t m_compressed_data_end_pos{0};
+    bool m_is_compressed_data_exhausted{false};
+
+    std::vector<char> m_decompressed_buffer;
+    size_t m_decompressed_buffer_begin_pos{0};
+    size_t m_decompressed_buffer_end_pos{0};
+
+    size_t m_pos{0};
+};
+}  // namespace clp_ffi_py::ir::native
+
+#endif  // CLP_FFI_PY_IR_NATIVE_ZSTDDECOMPRESSIONREADER_HPP
@@ -2,17 +2,24 @@
 
 #include "deserialization_methods.hpp"
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <map>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <clp/BufferReader.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <clp/ffi/ir_stream/encoding_methods.hpp>
 #include <clp/ffi/ir_stream/protocol_constants.hpp>
 #include <clp/ir/types.hpp>
 #include <clp/type_utils.hpp>
@@ -20,12 +27,19 @@
 
 #include <clp_ffi_py/api_decoration.hpp>
 #include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/EncodedLogMessage.hpp>
 #include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/LogtypeMatcher.hpp>
 #include <clp_ffi_py/ir/native/PyDeserializerBuffer.hpp>
 #include <clp_ffi_py/ir/native/PyLogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
 #include <clp_ffi_py/ir/native/PyQuery.hpp>
+#include <clp_ffi_py/ir/native/PyTimezoneUtcOffsetCache.hpp>
+#include <clp_ffi_py/ir/native/Query.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormatter.hpp>
+#include <clp_ffi_py/ir/native/Timezone.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
 #include <clp_ffi_py/utils.hpp>
 
 namespace clp_ffi_py::ir::native {
@@ -34,12 +48,46 @@ using clp::ffi::ir_stream::IRErrorCode;
 using clp::ffi::ir_stream::IRProtocolErrorCode;
 
 namespace {
+/**
+ * The size of the output buffer that `filter_ir_stream` accumulates before writing into the output
+ * stream.
+ */
+constexpr size_t cFilterOutputBufferSizeLimit{65'536};
+
+/**
+ * The size of the output buffer that `dump` accumulates before writing into the output.
+ */
+constexpr size_t cDumpOutputBufferSizeLimit{1024ULL * 1024};
+
+/**
+ * Requires the given type to be the encoded variable type of either the four-byte or the eight-byte
+ * IR encoding.
+ * @tparam encoded_variable_t
+ */
+template <typename encoded_variable_t>
+concept EncodedVariableTypeReq
+        = std::same_as<encoded_variable_t, clp::ir::four_byte_encoded_variable_t>
+          || std::same_as<encoded_variable_t, clp::ir::eight_byte_encoded_variable_t>;
+
+/**
+ * A log event deserialized by `deserialize_log_events`, whose log message may be left encoded.
+ */
+struct DeserializedLogEvent {
+    clp::ir::epoch_time_ms_t timestamp;
+    size_t index;
+    // The first tag of the log event.
+    encoded_tag_t tag;
+    // The encoded log event, starting right after its first tag. It's only valid until the next
+    // read into the deserializer buffer.
+    std::span<int8_t const> encoded_log_event;
+    // The decoded log message, or std::nullopt if the log message isn't decoded.
+    std::optional<std::string_view> log_message;
+};
+
 /**
  * This template defines the function signature of a termination handler required by
  * `deserialize_log_events`. Signature: (
- *         ffi::epoch_timestamp_ms timestamp,
- *         std::string_view deserialized_log_msg,
- *         size_t deserialized_log_event_idx,
+ *         DeserializedLogEvent const& log_event,
  *         PyObject*& return_value
  * ) -> bool;
  * @tparam TerminateHandler
@@ -47,10 +95,7 @@ namespace {
 template <typename TerminateHandler>
 concept TerminateHandlerSignature = requires(TerminateHandler handler) {
     {
-        handler(std::declval<clp::ir::epoch_time_ms_t>(),
-                std::declval<std::string_view>(),
-                std::declval<size_t>(),
-                std::declval<PyObject*&>())
+        handler(std::declval<DeserializedLogEvent const&>(), std::declval<PyObject*&>())
     } -> std::same_as<bool>;
 };
 
@@ -71,26 +116,231 @@ handle_incomplete_ir_error(PyDeserializerBuffer* deserializer_buffer, bool allow
         -> std::optional<PyObject*>;
 
 /**
- * Deserializes the next log event from the CLP IR buffer `deserializer_buffer` until terminate
- * handler returns true.
+ * Deserializes the next log event from the given reader into its decoded log message.
+ * @tparam encoded_variable_t The type of encoded variables in the IR stream.
+ * @param reader
+ * @param tag The first tag of the log event.
+ * @param log_message Returns the decoded log message.
+ * @param timestamp_or_timestamp_delta Returns the timestamp delta of the log event for the
+ * four-byte encoding, or its timestamp for the eight-byte encoding.
+ * @return Same as `clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event` or
+ * `clp::ffi::ir_stream::eight_byte_encoding::deserialize_log_event`.
+ */
+template <EncodedVariableTypeReq encoded_variable_t>
+[[nodiscard]] auto decode_log_event(
+        clp::ReaderInterface& reader,
+        encoded_tag_t tag,
+        std::string& log_message,
+        clp::ir::epoch_time_ms_t& timestamp_or_timestamp_delta
+) -> IRErrorCode;
+
+/**
+ * Deserializes the next log event that matches the given query from the CLP IR buffer
+ * `deserializer_buffer` until terminate handler returns true.
+ * If a query is given, each log event is first matched against the query using its timestamp and
+ * its encoded logtype. A log message is only decoded if its match against the query depends on its
+ * variables; otherwise, it's passed to `terminate_handler` encoded.
+ * @tparam encoded_variable_t The type of encoded variables in the IR stream.
  * @tparam TerminateHandler Method to determine if the deserialization should terminate, and set the
  * return value for termination.
  * @param deserializer_buffer IR deserializer buffer of the input IR stream.
+ * @param query Search query to filter log events, or nullptr to deserialize all log events.
  * @param allow_incomplete_stream A flag to indicate whether the incomplete stream error should be
  * ignored. If it is set to true, incomplete stream error should be treated as the IR stream is
  * terminated.
  * @param terminate_handler
  * @return The return value set by `terminate_handler`.
- * @return PyNone if the IR stream is terminated.
+ * @return PyNone if the IR stream is terminated, or the search time range of the query is safely
+ * exceeded.
  * @return nullptr on failure with the relevant Python exception and error set.
  */
-template <TerminateHandlerSignature TerminateHandler>
+template <EncodedVariableTypeReq encoded_variable_t, TerminateHandlerSignature TerminateHandler>
 [[nodiscard]] auto deserialize_log_events(
         PyDeserializerBuffer* deserializer_buffer,
+        Query const* query,
         bool allow_incomplete_stream,
         TerminateHandler terminate_handler
 ) -> PyObject*;
 
+/**
+ * Creates a new PyLogEvent from the given deserialized log event. If the log message isn't
+ * decoded, the PyLogEvent holds the encoded log message and decodes it on request.
+ * @tparam encoded_variable_t The type of encoded variables in the IR stream.
+ * @param log_event
+ * @param metadata
+ * @return a new reference of the created PyLogEvent.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+template <EncodedVariableTypeReq encoded_variable_t>
+[[nodiscard]] auto
+create_py_log_event(DeserializedLogEvent const& log_event, PyMetadata* metadata) -> PyObject*;
+
+/**
+ * Validates the inputs of the log event deserialization methods.
+ * @tparam encoded_variable_t The type of encoded variables expected in the IR stream.
+ * @param deserializer_buffer
+ * @param query_obj
+ * @return true if `query_obj` is either `None` or a `PyQuery`, and `deserializer_buffer` has its
+ * metadata deserialized with the expected encoding.
+ * @return false otherwise, with the relevant Python exception and error set.
+ */
+template <EncodedVariableTypeReq encoded_variable_t = clp::ir::four_byte_encoded_variable_t>
+[[nodiscard]] auto validate_log_event_deserialization_inputs(
+        PyDeserializerBuffer* deserializer_buffer,
+        PyObject* query_obj
+) -> bool;
+
+/**
+ * Deserializes all the remaining log events from the CLP IR buffer `deserializer_buffer`, and
+ * calls `match_handler` with the timestamp and the index of each log event that matches the given
+ * query, without creating any Python object for the log event. The deserialization stops at the
+ * end of the IR stream, or once the search time range of the query is safely exceeded.
+ * @tparam MatchHandler Method to handle a matched log event. Signature: (
+ *         clp::ir::epoch_time_ms_t timestamp,
+ *         size_t log_event_idx
+ * ) -> void;
+ * @param deserializer_buffer
+ * @param query_obj A `PyQuery` object, or `None` to match all log events.
+ * @param allow_incomplete_stream
+ * @param match_handler
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+template <typename MatchHandler>
+[[nodiscard]] auto scan_log_event_matches(
+        PyDeserializerBuffer* deserializer_buffer,
+        PyObject* query_obj,
+        bool allow_incomplete_stream,
+        MatchHandler match_handler
+) -> bool;
+
+/**
+ * Parses the arguments of the match scanning methods (`count_matches` and `find_match_indices`).
+ * @param args
+ * @param keywords
+ * @param deserializer_buffer Returns the deserializer buffer.
+ * @param query_obj Returns the query object.
+ * @param allow_incomplete_stream Returns whether to allow an incomplete stream.
+ * @return true if the arguments are valid and the deserializer buffer has its metadata
+ * deserialized.
+ * @return false otherwise, with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto parse_match_scan_args(
+        PyObject* args,
+        PyObject* keywords,
+        PyDeserializerBuffer*& deserializer_buffer,
+        PyObject*& query_obj,
+        bool& allow_incomplete_stream
+) -> bool;
+
+/**
+ * @tparam Integer
+ * @param values
+ * @return A new reference to a Python `array.array` containing the given values, with type code
+ * 'q' for signed values or 'Q' for unsigned values.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+template <typename Integer>
+requires std::same_as<Integer, int64_t> || std::same_as<Integer, uint64_t>
+[[nodiscard]] auto create_py_array(std::vector<Integer> const& values) -> PyObject*;
+
+/**
+ * Reads a big-endian integer from the given buffer.
+ * @tparam Integer
+ * @param ir_buf
+ * @param pos The position to read from, which is advanced past the integer on success.
+ * @param value Returns the integer read.
+ * @return Whether the buffer holds the entire integer.
+ */
+template <std::integral Integer>
+[[nodiscard]] auto
+read_big_endian_int(std::span<int8_t const> ir_buf, size_t& pos, Integer& value) -> bool;
+
+/**
+ * Skips a length-prefixed string in the given buffer.
+ * @tparam LengthType The type of the encoded length.
+ * @param ir_buf
+ * @param pos The position of the encoded length, which is advanced past the string on success.
+ * @return Whether the buffer holds the entire string.
+ */
+template <std::unsigned_integral LengthType>
+[[nodiscard]] auto skip_length_prefixed_str(std::span<int8_t const> ir_buf, size_t& pos) -> bool;
+
+/**
+ * Skips over the next four-byte encoded log event in the given buffer, only parsing its timestamp
+ * delta. The variables and the logtype are skipped using their encoded lengths without being
+ * decoded.
+ * @param ir_buf
+ * @param pos The position right after the first tag of the log event, which is advanced past the
+ * log event on success.
+ * @param tag The first tag of the log event.
+ * @param message_end_pos Returns the position right after the logtype, where the encoded timestamp
+ * delta begins.
+ * @param timestamp_delta Returns the timestamp delta of the log event.
+ * @return IRErrorCode_Success on success.
+ * @return IRErrorCode_Incomplete_IR if the buffer doesn't hold the entire log event.
+ * @return IRErrorCode_Corrupted_IR if an unexpected tag is found.
+ */
+[[nodiscard]] auto skip_four_byte_log_event(
+        std::span<int8_t const> ir_buf,
+        size_t& pos,
+        encoded_tag_t tag,
+        size_t& message_end_pos,
+        clp::ir::epoch_time_ms_t& timestamp_delta
+) -> IRErrorCode;
+
+/**
+ * Matches the given four-byte encoded log event against the wildcard queries of the given query.
+ * The variables are only decoded if the match of the logtype depends on them.
+ * @param query
+ * @param query_match_state The state of matching the query in the current scan.
+ * @param encoded_log_event The encoded log event, starting right after its first tag.
+ * @param tag The first tag of the log event.
+ * @param is_matched Returns whether the log event matches the wildcard queries.
+ * @return IRErrorCode_Success on success.
+ * @return Forwards `clp::ffi::ir_stream::deserialize_log_event`'s or `decode_log_event`'s return
+ * values on failure.
+ */
+[[nodiscard]] auto match_four_byte_log_event_wildcard_queries(
+        Query const& query,
+        Query::MatchState& query_match_state,
+        std::span<int8_t const> encoded_log_event,
+        encoded_tag_t tag,
+        bool& is_matched
+) -> IRErrorCode;
+
+/**
+ * Implements `deserialize_next_log_event` for the given encoding. See the Python doc string for the
+ * arguments and the return values.
+ * @tparam encoded_variable_t The type of encoded variables in the IR stream.
+ * @param args
+ * @param keywords
+ */
+template <EncodedVariableTypeReq encoded_variable_t>
+[[nodiscard]] auto generic_deserialize_next_log_event(PyObject* args, PyObject* keywords)
+        -> PyObject*;
+
+/**
+ * Implements `deserialize_next_log_events` for the given encoding. See the Python doc string for
+ * the arguments and the return values.
+ * @tparam encoded_variable_t The type of encoded variables in the IR stream.
+ * @param args
+ * @param keywords
+ */
+template <EncodedVariableTypeReq encoded_variable_t>
+[[nodiscard]] auto generic_deserialize_next_log_events(PyObject* args, PyObject* keywords)
+        -> PyObject*;
+
+/**
+ * Implements `dump` for the given encoding. See the Python doc string for the arguments and the
+ * return values.
+ * @tparam encoded_variable_t The type of encoded variables in the IR stream.
+ * @param args
+ * @param keywords
+ */
+template <EncodedVariableTypeReq encoded_variable_t>
+[[nodiscard]] auto generic_dump(PyObject* args, PyObject* keywords) -> PyObject*;
+
 auto
 handle_incomplete_ir_error(PyDeserializerBuffer* deserializer_buffer, bool allow_incomplete_stream)
         -> std::optional<PyObject*> {
@@ -108,18 +358,53 @@ handle_incomplete_ir_error(PyDeserializerBuffer* deserializer_buffer, bool allow
     return nullptr;
 }
 
-template <TerminateHandlerSignature TerminateHandler>
+template <EncodedVariableTypeReq encoded_variable_t>
+auto decode_log_event(
+        clp::ReaderInterface& reader,
+        encoded_tag_t tag,
+        std::string& log_message,
+        clp::ir::epoch_time_ms_t& timestamp_or_timestamp_delta
+) -> IRErrorCode {
+    if constexpr (std::is_same_v<encoded_variable_t, clp::ir::four_byte_encoded_variable_t>) {
+        return clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event(
+                reader,
+                tag,
+                log_message,
+                timestamp_or_timestamp_delta
+        );
+    } else {
+        return clp::ffi::ir_stream::eight_byte_encoding::deserialize_log_event(
+                reader,
+                tag,
+                log_message,
+                timestamp_or_timestamp_delta
+        );
+    }
+}
+
+template <EncodedVariableTypeReq encoded_variable_t, TerminateHandlerSignature TerminateHandler>
 auto deserialize_log_events(
         PyDeserializerBuffer* deserializer_buffer,
+        Query const* query,
         bool allow_incomplete_stream,
         TerminateHandler terminate_handler
 ) -> PyObject* {
     std::string deserialized_message;
-    clp::ir::epoch_time_ms_t timestamp_delta{0};
+    std::string logtype;
+    std::vector<encoded_variable_t> encoded_vars;
+    std::vector<std::string> dict_vars;
+    clp::ir::epoch_time_ms_t timestamp_or_timestamp_delta{0};
     auto timestamp{deserializer_buffer->get_ref_timestamp()};
     size_t current_log_event_idx{0};
     PyObject* return_value{nullptr};
     clp::ffi::ir_stream::encoded_tag_t tag{};
+    Query::MatchState* query_match_state{nullptr};
+    if (nullptr != query) {
+        query_match_state = deserializer_buffer->get_query_match_state(*query);
+        if (nullptr == query_match_state) {
+            return nullptr;
+        }
+    }
 
     while (true) {
         auto const unconsumed_bytes{deserializer_buffer->get_unconsumed_bytes()};
@@ -152,11 +437,14 @@ auto deserialize_log_events(
             Py_RETURN_NONE;
         }
 
-        auto const err{clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event(
+        auto const log_event_pos{ir_buffer.get_pos()};
+        auto const err{clp::ffi::ir_stream::deserialize_log_event(
                 ir_buffer,
                 tag,
-                deserialized_message,
-                timestamp_delta
+                logtype,
+                encoded_vars,
+                dict_vars,
+                timestamp_or_timestamp_delta
         )};
         if (IRErrorCode::IRErrorCode_Incomplete_IR == err) {
             if (auto const ret_val{
@@ -177,150 +465,168 @@ auto deserialize_log_events(
             return nullptr;
         }
 
-        timestamp += timestamp_delta;
+        if constexpr (std::is_same_v<encoded_variable_t, clp::ir::four_byte_encoded_variable_t>) {
+            timestamp += timestamp_or_timestamp_delta;
+        } else {
+            timestamp = timestamp_or_timestamp_delta;
+        }
         current_log_event_idx = deserializer_buffer->get_and_increment_deserialized_message_count();
         auto const num_bytes_consumed{static_cast<Py_ssize_t>(ir_buffer.get_pos())};
         deserializer_buffer->commit_read_buffer_consumption(num_bytes_consumed);
+        deserializer_buffer->set_ref_timestamp(timestamp);
 
-        if (terminate_handler(timestamp, deserialized_message, current_log_event_idx, return_value))
-        {
-            deserializer_buffer->set_ref_timestamp(timestamp);
+        // Committing the consumption doesn't invalidate the encoded bytes until the next read into
+        // the buffer.
+        DeserializedLogEvent log_event{
+                timestamp,
+                current_log_event_idx,
+                tag,
+                unconsumed_bytes.subspan(log_event_pos, ir_buffer.get_pos() - log_event_pos),
+                std::nullopt
+        };
+        if (nullptr != query) {
+            if (query->ts_safely_outside_time_range(timestamp)) {
+                Py_RETURN_NONE;
+            }
+            if (false == query->matches_time_range(timestamp)) {
+                continue;
+            }
+            auto const logtype_match_result{query->match_logtype(logtype, *query_match_state)};
+            if (LogtypeMatcher::Result::NeverMatches == logtype_match_result) {
+                continue;
+            }
+            if (LogtypeMatcher::Result::DependsOnVariables == logtype_match_result) {
+                clp::BufferReader log_event_reader{
+                        clp::size_checked_pointer_cast<char const>(
+                                log_event.encoded_log_event.data()
+                        ),
+                        log_event.encoded_log_event.size()
+                };
+                if (auto const decoding_err{decode_log_event<encoded_variable_t>(
+                            log_event_reader,
+                            tag,
+                            deserialized_message,
+                            timestamp_or_timestamp_delta
+                    )};
+                    IRErrorCode::IRErrorCode_Success != decoding_err)
+                {
+                    PyErr_Format(
+                            PyExc_RuntimeError,
+                            get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
+                            decoding_err
+                    );
+                    return nullptr;
+                }
+                if (false
+                    == query->matches_wildcard_queries(deserialized_message, *query_match_state))
+                {
+                    continue;
+                }
+                log_event.log_message = deserialized_message;
+            }
+        }
+
+        if (terminate_handler(log_event, return_value)) {
             break;
         }
     }
 
     return return_value;
 }
-}  // namespace
-
-CLP_FFI_PY_METHOD auto
-deserialize_preamble(PyObject* Py_UNUSED(self), PyObject* py_deserializer_buffer) -> PyObject* {
-    if (false
-        == static_cast<bool>(
-                PyObject_TypeCheck(py_deserializer_buffer, PyDeserializerBuffer::get_py_type())
-        ))
-    {
-        PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
-        return nullptr;
-    }
 
-    auto* deserializer_buffer{py_reinterpret_cast<PyDeserializerBuffer>(py_deserializer_buffer)};
-    bool is_four_byte_encoding{false};
-    size_t ir_buffer_cursor_pos{0};
-    while (true) {
-        auto const unconsumed_bytes{deserializer_buffer->get_unconsumed_bytes()};
-        clp::BufferReader ir_buffer{
-                clp::size_checked_pointer_cast<char const>(unconsumed_bytes.data()),
-                unconsumed_bytes.size()
-        };
-        auto const err{clp::ffi::ir_stream::get_encoding_type(ir_buffer, is_four_byte_encoding)};
-        if (IRErrorCode::IRErrorCode_Success == err) {
-            ir_buffer_cursor_pos = ir_buffer.get_pos();
-            break;
-        }
-        if (IRErrorCode::IRErrorCode_Incomplete_IR != err) {
-            PyErr_Format(
-                    PyExc_RuntimeError,
-                    get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
-                    err
-            );
-            return nullptr;
-        }
-        if (false == deserializer_buffer->try_read()) {
-            return nullptr;
-        }
+template <EncodedVariableTypeReq encoded_variable_t>
+auto create_py_log_event(DeserializedLogEvent const& log_event, PyMetadata* metadata)
+        -> PyObject* {
+    if (log_event.log_message.has_value()) {
+        return py_reinterpret_cast<PyObject>(PyLogEvent::create_new_log_event(
+                log_event.log_message.value(),
+                log_event.timestamp,
+                log_event.index,
+                metadata
+        ));
     }
-    deserializer_buffer->commit_read_buffer_consumption(static_cast<Py_ssize_t>(ir_buffer_cursor_pos
+    return py_reinterpret_cast<PyObject>(PyLogEvent::create_new_log_event(
+            EncodedLogMessage{
+                    log_event.tag,
+                    log_event.encoded_log_event,
+                    std::is_same_v<encoded_variable_t, clp::ir::four_byte_encoded_variable_t>
+            },
+            log_event.timestamp,
+            log_event.index,
+            metadata
     ));
-    if (false == is_four_byte_encoding) {
-        PyErr_SetString(PyExc_NotImplementedError, "8-byte IR encoding is not supported yet.");
-        return nullptr;
-    }
+}
 
-    clp::ffi::ir_stream::encoded_tag_t metadata_type_tag{0};
-    size_t metadata_pos{0};
-    uint16_t metadata_size{0};
-    while (true) {
-        auto const unconsumed_bytes = deserializer_buffer->get_unconsumed_bytes();
-        clp::BufferReader ir_buffer{
-                clp::size_checked_pointer_cast<char const>(unconsumed_bytes.data()),
-                unconsumed_bytes.size()
-        };
-        auto const err{clp::ffi::ir_stream::deserialize_preamble(
-                ir_buffer,
-                metadata_type_tag,
-                metadata_pos,
-                metadata_size
-        )};
-        if (IRErrorCode::IRErrorCode_Success == err) {
-            ir_buffer_cursor_pos = ir_buffer.get_pos();
-            break;
-        }
-        if (IRErrorCode ::IRErrorCode_Incomplete_IR != err) {
-            PyErr_Format(
-                    PyExc_RuntimeError,
-                    get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
-                    err
-            );
-            return nullptr;
-        }
-        if (false == deserializer_buffer->try_read()) {
-            return nullptr;
-        }
+template <EncodedVariableTypeReq encoded_variable_t>
+auto validate_log_event_deserialization_inputs(
+        PyDeserializerBuffer* deserializer_buffer,
+        PyObject* query_obj
+) -> bool {
+    if (Py_None != query_obj
+        && false == static_cast<bool>(PyObject_TypeCheck(query_obj, PyQuery::get_py_type())))
+    {
+        PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
+        return false;
     }
 
-    auto const unconsumed_bytes = deserializer_buffer->get_unconsumed_bytes();
-    auto const metadata_buffer{
-            unconsumed_bytes.subspan(metadata_pos, static_cast<size_t>(metadata_size))
-    };
-    deserializer_buffer->commit_read_buffer_consumption(static_cast<Py_ssize_t>(ir_buffer_cursor_pos
-    ));
-    PyMetadata* metadata{nullptr};
-    try {
-        // Initialization list should not be used in this case:
-        // https://github.com/nlohmann/json/discussions/4096
-        nlohmann::json const metadata_json(
-                nlohmann::json::parse(metadata_buffer.begin(), metadata_buffer.end())
+    if (false == deserializer_buffer->has_metadata()) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                "The given deserializerBuffer does not have a valid CLP IR metadata deserialized."
         );
-        std::string const version{metadata_json.at(
-                static_cast<char const*>(clp::ffi::ir_stream::cProtocol::Metadata::VersionKey)
-        )};
-        auto const error_code{clp::ffi::ir_stream::validate_protocol_version(version)};
-        if (IRProtocolErrorCode::BackwardCompatible != error_code) {
-            switch (error_code) {
-                case IRProtocolErrorCode::Supported:
-                    // This represents a key-value pair IR stream, which is not supported by these
-                    // old deserialization methods.
-                    PyErr_Format(PyExc_RuntimeError, "Version too new: %s", version.c_str());
-                    break;
-                case IRProtocolErrorCode::Unsupported:
-                    PyErr_Format(PyExc_RuntimeError, "Version unsupported: %s", version.c_str());
-                    break;
-                default:
-                    PyErr_Format(
-                            PyExc_NotImplementedError,
-                            "Unrecognized return code %d with version: %s",
-                            error_code,
-                            version.c_str()
-                    );
-                    break;
-            }
-            return nullptr;
-        }
-        metadata = PyMetadata::create_new_from_json(metadata_json, is_four_byte_encoding);
-    } catch (nlohmann::json::exception& ex) {
-        PyErr_Format(PyExc_RuntimeError, "Json Parsing Error: %s", ex.what());
-        return nullptr;
+        return false;
     }
-    if (false == deserializer_buffer->metadata_init(metadata)) {
-        return nullptr;
+    constexpr bool cIsFourByteEncoding{
+            std::is_same_v<encoded_variable_t, clp::ir::four_byte_encoded_variable_t>
+    };
+    if (cIsFourByteEncoding
+        != deserializer_buffer->get_metadata()->get_metadata()->is_using_four_byte_encoding())
+    {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                cIsFourByteEncoding
+                        ? "The IR stream of the given deserializerBuffer is not four-byte encoded."
+                        : "The IR stream of the given deserializerBuffer is not eight-byte encoded."
+        );
+        return false;
     }
-    return py_reinterpret_cast<PyObject>(metadata);
+    return true;
+}
+template <typename MatchHandler>
+auto scan_log_event_matches(
+        PyDeserializerBuffer* deserializer_buffer,
+        PyObject* query_obj,
+        bool allow_incomplete_stream,
+        MatchHandler match_handler
+) -> bool {
+    // Without a given query, an empty query is used so that no log event needs to be decoded.
+    Query const match_all_query{};
+    Query const* query{
+            Py_None == query_obj ? &match_all_query
+                                 : py_reinterpret_cast<PyQuery>(query_obj)->get_query()
+    };
+    auto terminate_handler{[&](DeserializedLogEvent const& log_event, PyObject*&) -> bool {
+        match_handler(log_event.timestamp, log_event.index);
+        return false;
+    }};
+    PyObjectPtr<PyObject> const return_value{
+            deserialize_log_events<clp::ir::four_byte_encoded_variable_t>(
+                    deserializer_buffer,
+                    query,
+                    allow_incomplete_stream,
+                    terminate_handler
+            )
+    };
+    return nullptr != return_value;
 }
 
-CLP_FFI_PY_METHOD auto
-deserialize_next_log_event(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
-        -> PyObject* {
+auto parse_match_scan_args(
+        PyObject* args,
+        PyObject* keywords,
+        PyDeserializerBuffer*& deserializer_buffer,
+        PyObject*& query_obj,
+        bool& allow_incomplete_stream
+) -> bool {
     static char keyword_deserializer_buffer[]{"deserializer_buffer"};
     static char keyword_query[]{"query"};
     static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
@@ -331,10 +637,9 @@ deserialize_next_log_event(PyObject* Py_UNUSED(self), PyObject* args, PyObject*
             nullptr
     };
 
-    PyDeserializerBuffer* deserializer_buffer{nullptr};
-    PyObject* query_obj{Py_None};
-    int allow_incomplete_stream{0};
-
+    deserializer_buffer = nullptr;
+    query_obj = Py_None;
+    int is_incomplete_stream_allowed{0};
     if (false
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
@@ -344,84 +649,1393 @@ deserialize_next_log_event(PyObject* Py_UNUSED(self), PyObject* args, PyObject*
                 PyDeserializerBuffer::get_py_type(),
                 &deserializer_buffer,
                 &query_obj,
-                &allow_incomplete_stream
+                &is_incomplete_stream_allowed
         )))
     {
-        return nullptr;
+        return false;
     }
+    allow_incomplete_stream = static_cast<bool>(is_incomplete_stream_allowed);
+    return validate_log_event_deserialization_inputs(deserializer_buffer, query_obj);
+}
 
-    bool const is_query_given{Py_None != query_obj};
-    if (is_query_given
-        && false == static_cast<bool>(PyObject_TypeCheck(query_obj, PyQuery::get_py_type())))
-    {
-        PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
+template <typename Integer>
+requires std::same_as<Integer, int64_t> || std::same_as<Integer, uint64_t>
+auto create_py_array(std::vector<Integer> const& values) -> PyObject* {
+    static_assert(sizeof(long long) == sizeof(Integer));
+    constexpr char const* cTypeCode{std::is_signed_v<Integer> ? "q" : "Q"};
+    PyObjectPtr<PyObject> const array_module{PyImport_ImportModule("array")};
+    if (nullptr == array_module) {
+        return nullptr;
+    }
+    PyObjectPtr<PyObject> py_array{
+            PyObject_CallMethod(array_module.get(), "array", "s", cTypeCode)
+    };
+    if (nullptr == py_array) {
         return nullptr;
     }
+    if (values.empty()) {
+        return py_array.release();
+    }
+    PyObjectPtr<PyObject> const py_bytes{PyBytes_FromStringAndSize(
+            clp::size_checked_pointer_cast<char const>(values.data()),
+            static_cast<Py_ssize_t>(values.size() * sizeof(Integer))
+    )};
+    if (nullptr == py_bytes) {
+        return nullptr;
+    }
+    PyObjectPtr<PyObject> const ret_val{
+            PyObject_CallMethod(py_array.get(), "frombytes", "O", py_bytes.get())
+    };
+    if (nullptr == ret_val) {
+        return nullptr;
+    }
+    return py_array.release();
+}
 
-    if (false == deserializer_buffer->has_metadata()) {
-        PyErr_SetString(
-                PyExc_RuntimeError,
-                "The given deserializerBuffer does not have a valid CLP IR metadata deserialized."
+template <std::integral Integer>
+auto read_big_endian_int(std::span<int8_t const> ir_buf, size_t& pos, Integer& value) -> bool {
+    if (ir_buf.size() - pos < sizeof(Integer)) {
+        return false;
+    }
+    std::make_unsigned_t<Integer> unsigned_value{0};
+    for (auto const byte : ir_buf.subspan(pos, sizeof(Integer))) {
+        unsigned_value = static_cast<std::make_unsigned_t<Integer>>(
+                (static_cast<uint64_t>(unsigned_value) << 8U) | static_cast<uint8_t>(byte)
         );
-        return nullptr;
     }
-    auto* metadata{deserializer_buffer->get_metadata()};
+    value = static_cast<Integer>(unsigned_value);
+    pos += sizeof(Integer);
+    return true;
+}
 
-    if (false == is_query_given) {
-        auto terminate_handler{
-                [metadata](
-                        clp::ir::epoch_time_ms_t timestamp,
-                        std::string_view log_message,
-                        size_t log_event_idx,
-                        PyObject*& return_value
-                ) -> bool {
-                    return_value = py_reinterpret_cast<PyObject>(PyLogEvent::create_new_log_event(
-                            log_message,
-                            timestamp,
-                            log_event_idx,
-                            metadata
-                    ));
-                    return true;
-                }
-        };
-        return deserialize_log_events(
+template <std::unsigned_integral LengthType>
+auto skip_length_prefixed_str(std::span<int8_t const> ir_buf, size_t& pos) -> bool {
+    LengthType length{0};
+    if (false == read_big_endian_int(ir_buf, pos, length) || ir_buf.size() - pos < length) {
+        return false;
+    }
+    pos += length;
+    return true;
+}
+
+auto skip_four_byte_log_event(
+        std::span<int8_t const> ir_buf,
+        size_t& pos,
+        encoded_tag_t tag,
+        size_t& message_end_pos,
+        clp::ir::epoch_time_ms_t& timestamp_delta
+) -> IRErrorCode {
+    namespace payload = clp::ffi::ir_stream::cProtocol::Payload;
+
+    // Skip the variables until the logtype is reached.
+    bool is_logtype_skipped{false};
+    while (false == is_logtype_skipped) {
+        bool is_complete{false};
+        switch (tag) {
+            case payload::VarFourByteEncoding: {
+                clp::ir::four_byte_encoded_variable_t encoded_var{};
+                is_complete = read_big_endian_int(ir_buf, pos, encoded_var);
+                break;
+            }
+            case payload::VarStrLenUByte:
+                is_complete = skip_length_prefixed_str<uint8_t>(ir_buf, pos);
+                break;
+            case payload::VarStrLenUShort:
+                is_complete = skip_length_prefixed_str<uint16_t>(ir_buf, pos);
+                break;
+            case payload::VarStrLenInt:
+                is_complete = skip_length_prefixed_str<uint32_t>(ir_buf, pos);
+                break;
+            case payload::LogtypeStrLenUByte:
+                is_complete = skip_length_prefixed_str<uint8_t>(ir_buf, pos);
+                is_logtype_skipped = true;
+                break;
+            case payload::LogtypeStrLenUShort:
+                is_complete = skip_length_prefixed_str<uint16_t>(ir_buf, pos);
+                is_logtype_skipped = true;
+                break;
+            case payload::LogtypeStrLenInt:
+                is_complete = skip_length_prefixed_str<uint32_t>(ir_buf, pos);
+                is_logtype_skipped = true;
+                break;
+            default:
+                return IRErrorCode::IRErrorCode_Corrupted_IR;
+        }
+        if (false == is_complete) {
+            return IRErrorCode::IRErrorCode_Incomplete_IR;
+        }
+        message_end_pos = pos;
+        if (false == read_big_endian_int(ir_buf, pos, tag)) {
+            return IRErrorCode::IRErrorCode_Incomplete_IR;
+        }
+    }
+
+    bool is_complete{false};
+    switch (tag) {
+        case payload::TimestampDeltaByte: {
+            int8_t delta{0};
+            is_complete = read_big_endian_int(ir_buf, pos, delta);
+            timestamp_delta = delta;
+            break;
+        }
+        case payload::TimestampDeltaShort: {
+            int16_t delta{0};
+            is_complete = read_big_endian_int(ir_buf, pos, delta);
+            timestamp_delta = delta;
+            break;
+        }
+        case payload::TimestampDeltaInt: {
+            int32_t delta{0};
+            is_complete = read_big_endian_int(ir_buf, pos, delta);
+            timestamp_delta = delta;
+            break;
+        }
+        case payload::TimestampDeltaLong: {
+            int64_t delta{0};
+            is_complete = read_big_endian_int(ir_buf, pos, delta);
+            timestamp_delta = delta;
+            break;
+        }
+        default:
+            return IRErrorCode::IRErrorCode_Corrupted_IR;
+    }
+    return is_complete ? IRErrorCode::IRErrorCode_Success : IRErrorCode::IRErrorCode_Incomplete_IR;
+}
+
+auto match_four_byte_log_event_wildcard_queries(
+        Query const& query,
+        Query::MatchState& query_match_state,
+        std::span<int8_t const> encoded_log_event,
+        encoded_tag_t tag,
+        bool& is_matched
+) -> IRErrorCode {
+    if (query.get_wildcard_queries().empty()) {
+        is_matched = true;
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    std::string logtype;
+    std::vector<clp::ir::four_byte_encoded_variable_t> encoded_vars;
+    std::vector<std::string> dict_vars;
+    clp::ir::epoch_time_ms_t timestamp_delta{0};
+    clp::BufferReader logtype_reader{
+            clp::size_checked_pointer_cast<char const>(encoded_log_event.data()),
+            encoded_log_event.size()
+    };
+    if (auto const err{clp::ffi::ir_stream::deserialize_log_event(
+                logtype_reader,
+                tag,
+                logtype,
+                encoded_vars,
+                dict_vars,
+                timestamp_delta
+        )};
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return err;
+    }
+    auto const logtype_match_result{query.match_logtype(logtype, query_match_state)};
+    if (LogtypeMatcher::Result::DependsOnVariables != logtype_match_result) {
+        is_matched = LogtypeMatcher::Result::AlwaysMatches == logtype_match_result;
+        return IRErrorCode::IRErrorCode_Success;
+    }
+
+    std::string log_message;
+    clp::BufferReader log_message_reader{
+            clp::size_checked_pointer_cast<char const>(encoded_log_event.data()),
+            encoded_log_event.size()
+    };
+    if (auto const err{decode_log_event<clp::ir::four_byte_encoded_variable_t>(
+                log_message_reader,
+                tag,
+                log_message,
+                timestamp_delta
+        )};
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return err;
+    }
+    is_matched = query.matches_wildcard_queries(log_message, query_match_state);
+    return IRErrorCode::IRErrorCode_Success;
+}
+
+template <EncodedVariableTypeReq encoded_variable_t>
+auto generic_deserialize_next_log_event(PyObject* args, PyObject* keywords) -> PyObject* {
+    static char keyword_deserializer_buffer[]{"deserializer_buffer"};
+    static char keyword_query[]{"query"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_deserializer_buffer),
+            static_cast<char*>(keyword_query),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            nullptr
+    };
+
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    PyObject* query_obj{Py_None};
+    int allow_incomplete_stream{0};
+
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O!|Op",
+                static_cast<char**>(keyword_table),
+                PyDeserializerBuffer::get_py_type(),
+                &deserializer_buffer,
+                &query_obj,
+                &allow_incomplete_stream
+        )))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+
+    if (false
+        == validate_log_event_deserialization_inputs<encoded_variable_t>(
                 deserializer_buffer,
-                static_cast<bool>(allow_incomplete_stream),
-                terminate_handler
+                query_obj
+        ))
+    {
+        return nullptr;
+    }
+    auto* metadata{deserializer_buffer->get_metadata()};
+    Query const* query{
+            Py_None == query_obj ? nullptr : py_reinterpret_cast<PyQuery>(query_obj)->get_query()
+    };
+
+    auto terminate_handler{
+            [metadata](DeserializedLogEvent const& log_event, PyObject*& return_value) -> bool {
+                return_value = create_py_log_event<encoded_variable_t>(log_event, metadata);
+                return true;
+            }
+    };
+    return deserialize_log_events<encoded_variable_t>(
+            deserializer_buffer,
+            query,
+            static_cast<bool>(allow_incomplete_stream),
+            terminate_handler
+    );
+}
+
+template <EncodedVariableTypeReq encoded_variable_t>
+auto generic_deserialize_next_log_events(PyObject* args, PyObject* keywords) -> PyObject* {
+    static char keyword_deserializer_buffer[]{"deserializer_buffer"};
+    static char keyword_max_events[]{"max_events"};
+    static char keyword_query[]{"query"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_deserializer_buffer),
+            static_cast<char*>(keyword_max_events),
+            static_cast<char*>(keyword_query),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            nullptr
+    };
+
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    Py_ssize_t max_events{0};
+    PyObject* query_obj{Py_None};
+    int allow_incomplete_stream{0};
+
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O!n|Op",
+                static_cast<char**>(keyword_table),
+                PyDeserializerBuffer::get_py_type(),
+                &deserializer_buffer,
+                &max_events,
+                &query_obj,
+                &allow_incomplete_stream
+        )))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+
+    if (0 >= max_events) {
+        PyErr_SetString(
+                PyExc_ValueError,
+                "The maximum number of log events must be a positive integer (> 0)."
         );
+        return nullptr;
+    }
+    if (false
+        == validate_log_event_deserialization_inputs<encoded_variable_t>(
+                deserializer_buffer,
+                query_obj
+        ))
+    {
+        return nullptr;
     }
+    auto* metadata{deserializer_buffer->get_metadata()};
+    Query const* query{
+            Py_None == query_obj ? nullptr : py_reinterpret_cast<PyQuery>(query_obj)->get_query()
+    };
 
-    auto* py_query{py_reinterpret_cast<PyQuery>(query_obj)};
-    auto const* query{py_query->get_query()};
-    auto query_terminate_handler{
-            [query, metadata](
-                    clp::ir::epoch_time_ms_t timestamp,
-                    std::string_view log_message,
-                    size_t log_event_idx,
-                    PyObject*& return_value
-            ) -> bool {
-                if (query->ts_safely_outside_time_range(timestamp)) {
-                    return_value = get_new_ref_to_py_none();
+    // The list is preallocated with the maximum size, and truncated to the number of deserialized
+    // log events afterwards.
+    PyObjectPtr<PyObject> log_events{PyList_New(max_events)};
+    if (nullptr == log_events) {
+        return nullptr;
+    }
+    Py_ssize_t num_log_events{0};
+    bool is_log_event_creation_failed{false};
+    auto batch_terminate_handler{
+            [&](DeserializedLogEvent const& deserialized_log_event, PyObject*& return_value)
+                    -> bool {
+                auto* log_event{
+                        create_py_log_event<encoded_variable_t>(deserialized_log_event, metadata)
+                };
+                if (nullptr == log_event) {
+                    is_log_event_creation_failed = true;
+                    return_value = nullptr;
                     return true;
                 }
-                if (false == query->matches_time_range(timestamp)
-                    || false == query->matches_wildcard_queries(log_message))
-                {
+                PyList_SET_ITEM(log_events.get(), num_log_events, log_event);
+                ++num_log_events;
+                if (num_log_events < max_events) {
                     return false;
                 }
-                return_value = py_reinterpret_cast<PyObject>(PyLogEvent::create_new_log_event(
-                        log_message,
-                        timestamp,
-                        log_event_idx,
-                        metadata
-                ));
+                return_value = get_new_ref_to_py_none();
                 return true;
             }
     };
-    return deserialize_log_events(
+    PyObjectPtr<PyObject> const return_value{deserialize_log_events<encoded_variable_t>(
             deserializer_buffer,
+            query,
             static_cast<bool>(allow_incomplete_stream),
-            query_terminate_handler
-    );
+            batch_terminate_handler
+    )};
+    if (nullptr == return_value) {
+        if (is_log_event_creation_failed || 0 == num_log_events) {
+            return nullptr;
+        }
+        // The bytes of the IR unit that failed to deserialize haven't been consumed, so the error
+        // will be raised again by the next call. Return the log events deserialized so far instead
+        // of discarding them.
+        PyErr_Clear();
+    }
+
+    if (num_log_events < max_events
+        && 0 != PyList_SetSlice(log_events.get(), num_log_events, max_events, nullptr))
+    {
+        return nullptr;
+    }
+    return log_events.release();
+}
+
+template <EncodedVariableTypeReq encoded_variable_t>
+auto generic_dump(PyObject* args, PyObject* keywords) -> PyObject* {
+    static char keyword_deserializer_buffer[]{"deserializer_buffer"};
+    static char keyword_output[]{"output"};
+    static char keyword_timezone[]{"timezone"};
+    static char keyword_query[]{"query"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_deserializer_buffer),
+            static_cast<char*>(keyword_output),
+            static_cast<char*>(keyword_timezone),
+            static_cast<char*>(keyword_query),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            nullptr
+    };
+
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    PyObject* output{nullptr};
+    PyObject* timezone{Py_None};
+    PyObject* query_obj{Py_None};
+    int allow_incomplete_stream{0};
+
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O!O|OOp",
+                static_cast<char**>(keyword_table),
+                PyDeserializerBuffer::get_py_type(),
+                &deserializer_buffer,
+                &output,
+                &timezone,
+                &query_obj,
+                &allow_incomplete_stream
+        )))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+    if (false
+        == validate_log_event_deserialization_inputs<encoded_variable_t>(
+                deserializer_buffer,
+                query_obj
+        ))
+    {
+        return nullptr;
+    }
+    std::optional<int> output_fd;
+    if (static_cast<bool>(PyLong_Check(output))) {
+        int fd{};
+        if (false == parse_py_int(output, fd)) {
+            return nullptr;
+        }
+        output_fd.emplace(fd);
+    }
+    // The query is matched without holding the GIL. It may be shared with other Python threads, but
+    // it's immutable, and the mutable state of matching is owned by the acquired buffer.
+    Query const* query{
+            Py_None == query_obj ? nullptr : py_reinterpret_cast<PyQuery>(query_obj)->get_query()
+    };
+    Query::MatchState* query_match_state{nullptr};
+    if (nullptr != query) {
+        query_match_state = deserializer_buffer->get_query_match_state(*query);
+        if (nullptr == query_match_state) {
+            return nullptr;
+        }
+    }
+    // Without an explicit timezone, the UTC offsets are resolved natively from the timezone of the
+    // IR stream, unless it's only available as a Python tzinfo object.
+    auto* py_metadata{deserializer_buffer->get_metadata()};
+    Timezone const* native_timezone{Py_None == timezone ? py_metadata->get_timezone() : nullptr};
+    PyObject* py_timezone{timezone};
+    if (Py_None == timezone && nullptr == native_timezone) {
+        py_timezone = py_metadata->get_py_timezone();
+        if (nullptr == py_timezone) {
+            return nullptr;
+        }
+    }
+    PyTimezoneUtcOffsetCache utc_offset_cache{py_timezone};
+    auto const get_utc_offset = [&](clp::ir::epoch_time_ms_t timestamp) -> std::optional<int32_t> {
+        if (nullptr != native_timezone) {
+            return native_timezone->get_utc_offset(timestamp);
+        }
+        return utc_offset_cache.get_utc_offset(timestamp);
+    };
+
+    TimestampFormatter timestamp_formatter;
+    std::string output_buf;
+    std::string log_message;
+    std::string logtype;
+    std::vector<encoded_variable_t> encoded_vars;
+    std::vector<std::string> dict_vars;
+    auto timestamp{deserializer_buffer->get_ref_timestamp()};
+    size_t num_log_events_written{0};
+    auto const write_output_buf = [&]() -> bool {
+        std::span<int8_t const> const buf{
+                clp::size_checked_pointer_cast<int8_t const>(output_buf.data()),
+                output_buf.size()
+        };
+        if (output_fd.has_value()) {
+            bool is_written{false};
+            {
+                PyGilReleaseGuard const gil_release_guard;
+                is_written = write_to_fd(output_fd.value(), buf);
+            }
+            if (false == is_written) {
+                PyErr_SetFromErrno(PyExc_OSError);
+                return false;
+            }
+        } else if (false == write_to_py_output_stream(output, buf)) {
+            return false;
+        }
+        output_buf.clear();
+        return true;
+    };
+
+    while (true) {
+        // Deserialize, format, and buffer the log events in the read buffer without holding the
+        // GIL. The GIL is only reacquired to read more data, to write the output buffer, or to
+        // resolve the UTC offsets of a new window of time. The read buffer can't be refilled or
+        // consumed by other Python threads meanwhile since it's acquired by this method.
+        auto const unconsumed_bytes{deserializer_buffer->get_unconsumed_bytes()};
+        size_t num_bytes_consumed{0};
+        size_t num_log_events_consumed{0};
+        auto err{IRErrorCode::IRErrorCode_Success};
+        bool is_terminated{false};
+        std::optional<clp::ir::epoch_time_ms_t> uncached_timestamp;
+        {
+            PyGilReleaseGuard const gil_release_guard;
+            clp::BufferReader ir_buffer{
+                    clp::size_checked_pointer_cast<char const>(unconsumed_bytes.data()),
+                    unconsumed_bytes.size()
+            };
+            while (output_buf.size() < cDumpOutputBufferSizeLimit) {
+                clp::ffi::ir_stream::encoded_tag_t tag{};
+                err = clp::ffi::ir_stream::deserialize_tag(ir_buffer, tag);
+                if (IRErrorCode::IRErrorCode_Success != err) {
+                    break;
+                }
+                if (clp::ffi::ir_stream::cProtocol::Eof == tag) {
+                    is_terminated = true;
+                    break;
+                }
+
+                auto const log_event_pos{ir_buffer.get_pos()};
+                clp::ir::epoch_time_ms_t timestamp_or_timestamp_delta{0};
+                err = nullptr == query ? decode_log_event<encoded_variable_t>(
+                                                 ir_buffer,
+                                                 tag,
+                                                 log_message,
+                                                 timestamp_or_timestamp_delta
+                                         )
+                                       : clp::ffi::ir_stream::deserialize_log_event(
+                                                 ir_buffer,
+                                                 tag,
+                                                 logtype,
+                                                 encoded_vars,
+                                                 dict_vars,
+                                                 timestamp_or_timestamp_delta
+                                         );
+                if (IRErrorCode::IRErrorCode_Success != err) {
+                    break;
+                }
+                auto next_timestamp{timestamp_or_timestamp_delta};
+                if constexpr (std::is_same_v<
+                                      encoded_variable_t,
+                                      clp::ir::four_byte_encoded_variable_t>)
+                {
+                    next_timestamp += timestamp;
+                }
+
+                auto const utc_offset{get_utc_offset(next_timestamp)};
+                if (nullptr == query && false == utc_offset.has_value()) {
+                    // Leave the log event unconsumed until the UTC offset is resolved.
+                    uncached_timestamp = next_timestamp;
+                    break;
+                }
+                if (nullptr != query) {
+                    if (query->ts_safely_outside_time_range(next_timestamp)) {
+                        num_bytes_consumed = ir_buffer.get_pos();
+                        ++num_log_events_consumed;
+                        timestamp = next_timestamp;
+                        is_terminated = true;
+                        break;
+                    }
+                    auto const logtype_match_result{
+                            query->matches_time_range(next_timestamp)
+                                    ? query->match_logtype(logtype, *query_match_state)
+                                    : LogtypeMatcher::Result::NeverMatches
+                    };
+                    if (LogtypeMatcher::Result::NeverMatches != logtype_match_result) {
+                        auto const encoded_log_event{unconsumed_bytes.subspan(log_event_pos)};
+                        clp::BufferReader log_event_reader{
+                                clp::size_checked_pointer_cast<char const>(
+                                        encoded_log_event.data()
+                                ),
+                                encoded_log_event.size()
+                        };
+                        err = decode_log_event<encoded_variable_t>(
+                                log_event_reader,
+                                tag,
+                                log_message,
+                                timestamp_or_timestamp_delta
+                        );
+                        if (IRErrorCode::IRErrorCode_Success != err) {
+                            break;
+                        }
+                    }
+                    bool const is_matched{
+                            LogtypeMatcher::Result::AlwaysMatches == logtype_match_result
+                            || (LogtypeMatcher::Result::DependsOnVariables == logtype_match_result
+                                && query->matches_wildcard_queries(
+                                        log_message,
+                                        *query_match_state
+                                ))
+                    };
+                    if (is_matched && false == utc_offset.has_value()) {
+                        uncached_timestamp = next_timestamp;
+                        break;
+                    }
+                    num_bytes_consumed = ir_buffer.get_pos();
+                    ++num_log_events_consumed;
+                    timestamp = next_timestamp;
+                    if (false == is_matched) {
+                        continue;
+                    }
+                } else {
+                    num_bytes_consumed = ir_buffer.get_pos();
+                    ++num_log_events_consumed;
+                    timestamp = next_timestamp;
+                }
+
+                timestamp_formatter.format(timestamp, utc_offset.value(), output_buf);
+                output_buf.append(log_message);
+                ++num_log_events_written;
+            }
+        }
+
+        deserializer_buffer->commit_read_buffer_consumption(
+                static_cast<Py_ssize_t>(num_bytes_consumed)
+        );
+        deserializer_buffer->set_ref_timestamp(timestamp);
+        for (size_t i{0}; i < num_log_events_consumed; ++i) {
+            deserializer_buffer->get_and_increment_deserialized_message_count();
+        }
+
+        if (output_buf.size() >= cDumpOutputBufferSizeLimit && false == write_output_buf()) {
+            return nullptr;
+        }
+        if (is_terminated) {
+            break;
+        }
+        if (uncached_timestamp.has_value()) {
+            if (false == utc_offset_cache.cache_window(uncached_timestamp.value())) {
+                return nullptr;
+            }
+            continue;
+        }
+        if (IRErrorCode::IRErrorCode_Success == err) {
+            // The output buffer is full.
+            continue;
+        }
+        if (IRErrorCode::IRErrorCode_Incomplete_IR != err) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
+                    err
+            );
+            return nullptr;
+        }
+        if (auto const ret_val{
+                    handle_incomplete_ir_error(deserializer_buffer, allow_incomplete_stream)
+            };
+            ret_val.has_value())
+        {
+            PyObjectPtr<PyObject> const py_none{ret_val.value()};
+            if (nullptr == py_none) {
+                return nullptr;
+            }
+            break;
+        }
+    }
+
+    if (false == write_output_buf()) {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(num_log_events_written);
+}
+}  // namespace
+
+CLP_FFI_PY_METHOD auto
+deserialize_preamble(PyObject* Py_UNUSED(self), PyObject* py_deserializer_buffer) -> PyObject* {
+    if (false
+        == static_cast<bool>(
+                PyObject_TypeCheck(py_deserializer_buffer, PyDeserializerBuffer::get_py_type())
+        ))
+    {
+        PyErr_SetString(PyExc_TypeError, get_c_str_from_constexpr_string_view(cPyTypeError));
+        return nullptr;
+    }
+
+    auto* deserializer_buffer{py_reinterpret_cast<PyDeserializerBuffer>(py_deserializer_buffer)};
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+    bool is_four_byte_encoding{false};
+    size_t ir_buffer_cursor_pos{0};
+    while (true) {
+        auto const unconsumed_bytes{deserializer_buffer->get_unconsumed_bytes()};
+        clp::BufferReader ir_buffer{
+                clp::size_checked_pointer_cast<char const>(unconsumed_bytes.data()),
+                unconsumed_bytes.size()
+        };
+        auto const err{clp::ffi::ir_stream::get_encoding_type(ir_buffer, is_four_byte_encoding)};
+        if (IRErrorCode::IRErrorCode_Success == err) {
+            ir_buffer_cursor_pos = ir_buffer.get_pos();
+            break;
+        }
+        if (IRErrorCode::IRErrorCode_Incomplete_IR != err) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
+                    err
+            );
+            return nullptr;
+        }
+        if (false == deserializer_buffer->try_read()) {
+            return nullptr;
+        }
+    }
+    deserializer_buffer->commit_read_buffer_consumption(static_cast<Py_ssize_t>(ir_buffer_cursor_pos
+    ));
+    clp::ffi::ir_stream::encoded_tag_t metadata_type_tag{0};
+    size_t metadata_pos{0};
+    uint16_t metadata_size{0};
+    while (true) {
+        auto const unconsumed_bytes = deserializer_buffer->get_unconsumed_bytes();
+        clp::BufferReader ir_buffer{
+                clp::size_checked_pointer_cast<char const>(unconsumed_bytes.data()),
+                unconsumed_bytes.size()
+        };
+        auto const err{clp::ffi::ir_stream::deserialize_preamble(
+                ir_buffer,
+                metadata_type_tag,
+                metadata_pos,
+                metadata_size
+        )};
+        if (IRErrorCode::IRErrorCode_Success == err) {
+            ir_buffer_cursor_pos = ir_buffer.get_pos();
+            break;
+        }
+        if (IRErrorCode ::IRErrorCode_Incomplete_IR != err) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
+                    err
+            );
+            return nullptr;
+        }
+        if (false == deserializer_buffer->try_read()) {
+            return nullptr;
+        }
+    }
+
+    auto const unconsumed_bytes = deserializer_buffer->get_unconsumed_bytes();
+    auto const metadata_buffer{
+            unconsumed_bytes.subspan(metadata_pos, static_cast<size_t>(metadata_size))
+    };
+    deserializer_buffer->commit_read_buffer_consumption(static_cast<Py_ssize_t>(ir_buffer_cursor_pos
+    ));
+    PyMetadata* metadata{nullptr};
+    try {
+        // Initialization list should not be used in this case:
+        // https://github.com/nlohmann/json/discussions/4096
+        nlohmann::json const metadata_json(
+                nlohmann::json::parse(metadata_buffer.begin(), metadata_buffer.end())
+        );
+        std::string const version{metadata_json.at(
+                static_cast<char const*>(clp::ffi::ir_stream::cProtocol::Metadata::VersionKey)
+        )};
+        auto const error_code{clp::ffi::ir_stream::validate_protocol_version(version)};
+        if (IRProtocolErrorCode::BackwardCompatible != error_code) {
+            switch (error_code) {
+                case IRProtocolErrorCode::Supported:
+                    // This represents a key-value pair IR stream, which is not supported by these
+                    // old deserialization methods.
+                    PyErr_Format(PyExc_RuntimeError, "Version too new: %s", version.c_str());
+                    break;
+                case IRProtocolErrorCode::Unsupported:
+                    PyErr_Format(PyExc_RuntimeError, "Version unsupported: %s", version.c_str());
+                    break;
+                default:
+                    PyErr_Format(
+                            PyExc_NotImplementedError,
+                            "Unrecognized return code %d with version: %s",
+                            error_code,
+                            version.c_str()
+                    );
+                    break;
+            }
+            return nullptr;
+        }
+        metadata = PyMetadata::create_new_from_json(metadata_json, is_four_byte_encoding);
+    } catch (nlohmann::json::exception& ex) {
+        PyErr_Format(PyExc_RuntimeError, "Json Parsing Error: %s", ex.what());
+        return nullptr;
+    }
+    if (false == deserializer_buffer->metadata_init(metadata)) {
+        return nullptr;
+    }
+    return py_reinterpret_cast<PyObject>(metadata);
+}
+
+CLP_FFI_PY_METHOD auto
+deserialize_next_log_event(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject* {
+    return generic_deserialize_next_log_event<clp::ir::four_byte_encoded_variable_t>(
+            args,
+            keywords
+    );
+}
+
+CLP_FFI_PY_METHOD auto
+deserialize_next_log_events(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject* {
+    return generic_deserialize_next_log_events<clp::ir::four_byte_encoded_variable_t>(
+            args,
+            keywords
+    );
+}
+
+CLP_FFI_PY_METHOD auto deserialize_next_eight_byte_log_event(
+        PyObject* Py_UNUSED(self),
+        PyObject* args,
+        PyObject* keywords
+) -> PyObject* {
+    return generic_deserialize_next_log_event<clp::ir::eight_byte_encoded_variable_t>(
+            args,
+            keywords
+    );
+}
+
+CLP_FFI_PY_METHOD auto deserialize_next_eight_byte_log_events(
+        PyObject* Py_UNUSED(self),
+        PyObject* args,
+        PyObject* keywords
+) -> PyObject* {
+    return generic_deserialize_next_log_events<clp::ir::eight_byte_encoded_variable_t>(
+            args,
+            keywords
+    );
+}
+
+CLP_FFI_PY_METHOD auto
+dump(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords) -> PyObject* {
+    return generic_dump<clp::ir::four_byte_encoded_variable_t>(args, keywords);
+}
+
+CLP_FFI_PY_METHOD auto
+dump_eight_byte(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords) -> PyObject* {
+    return generic_dump<clp::ir::eight_byte_encoded_variable_t>(args, keywords);
+}
+
+CLP_FFI_PY_METHOD auto
+count_matches(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords) -> PyObject* {
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    PyObject* query_obj{nullptr};
+    bool allow_incomplete_stream{false};
+    if (false
+        == parse_match_scan_args(
+                args,
+                keywords,
+                deserializer_buffer,
+                query_obj,
+                allow_incomplete_stream
+        ))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+
+    size_t num_matches{0};
+    if (false
+        == scan_log_event_matches(
+                deserializer_buffer,
+                query_obj,
+                allow_incomplete_stream,
+                [&](clp::ir::epoch_time_ms_t, size_t) -> void { ++num_matches; }
+        ))
+    {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(num_matches);
+}
+
+CLP_FFI_PY_METHOD auto
+find_match_indices(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords) -> PyObject* {
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    PyObject* query_obj{nullptr};
+    bool allow_incomplete_stream{false};
+    if (false
+        == parse_match_scan_args(
+                args,
+                keywords,
+                deserializer_buffer,
+                query_obj,
+                allow_incomplete_stream
+        ))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+
+    std::vector<uint64_t> match_indices;
+    if (false
+        == scan_log_event_matches(
+                deserializer_buffer,
+                query_obj,
+                allow_incomplete_stream,
+                [&](clp::ir::epoch_time_ms_t, size_t log_event_idx) -> void {
+                    match_indices.push_back(static_cast<uint64_t>(log_event_idx));
+                }
+        ))
+    {
+        return nullptr;
+    }
+    return create_py_array(match_indices);
+}
+
+CLP_FFI_PY_METHOD auto histogram(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject* {
+    static char keyword_deserializer_buffer[]{"deserializer_buffer"};
+    static char keyword_bucket_ms[]{"bucket_ms"};
+    static char keyword_query[]{"query"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_deserializer_buffer),
+            static_cast<char*>(keyword_bucket_ms),
+            static_cast<char*>(keyword_query),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            nullptr
+    };
+
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    clp::ir::epoch_time_ms_t bucket_ms{0};
+    PyObject* query_obj{Py_None};
+    int allow_incomplete_stream{0};
+
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O!L|Op",
+                static_cast<char**>(keyword_table),
+                PyDeserializerBuffer::get_py_type(),
+                &deserializer_buffer,
+                &bucket_ms,
+                &query_obj,
+                &allow_incomplete_stream
+        )))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+
+    if (0 >= bucket_ms) {
+        PyErr_SetString(PyExc_ValueError, "The bucket size must be a positive integer (> 0).");
+        return nullptr;
+    }
+    if (false == validate_log_event_deserialization_inputs(deserializer_buffer, query_obj)) {
+        return nullptr;
+    }
+
+    // Buckets are keyed by their index, i.e., the floor of the timestamp divided by the bucket
+    // size. Since timestamps are mostly increasing, the bucket of the previous log event is cached
+    // to skip most lookups.
+    std::map<clp::ir::epoch_time_ms_t, uint64_t> bucket_counts;
+    auto cached_bucket_it{bucket_counts.end()};
+    if (false
+        == scan_log_event_matches(
+                deserializer_buffer,
+                query_obj,
+                static_cast<bool>(allow_incomplete_stream),
+                [&](clp::ir::epoch_time_ms_t timestamp, size_t) -> void {
+                    auto bucket_idx{timestamp / bucket_ms};
+                    if (0 != timestamp % bucket_ms && timestamp < 0) {
+                        --bucket_idx;
+                    }
+                    if (bucket_counts.end() == cached_bucket_it
+                        || cached_bucket_it->first != bucket_idx)
+                    {
+                        cached_bucket_it = bucket_counts.try_emplace(bucket_idx, 0).first;
+                    }
+                    ++cached_bucket_it->second;
+                }
+        ))
+    {
+        return nullptr;
+    }
+
+    std::vector<int64_t> bucket_start_timestamps;
+    std::vector<uint64_t> counts;
+    bucket_start_timestamps.reserve(bucket_counts.size());
+    counts.reserve(bucket_counts.size());
+    for (auto const& [bucket_idx, count] : bucket_counts) {
+        bucket_start_timestamps.push_back(bucket_idx * bucket_ms);
+        counts.push_back(count);
+    }
+    PyObjectPtr<PyObject> py_bucket_start_timestamps{create_py_array(bucket_start_timestamps)};
+    if (nullptr == py_bucket_start_timestamps) {
+        return nullptr;
+    }
+    PyObjectPtr<PyObject> py_counts{create_py_array(counts)};
+    if (nullptr == py_counts) {
+        return nullptr;
+    }
+    return PyTuple_Pack(2, py_bucket_start_timestamps.get(), py_counts.get());
+}
+
+CLP_FFI_PY_METHOD auto
+scan_timestamps(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords) -> PyObject* {
+    static char keyword_deserializer_buffer[]{"deserializer_buffer"};
+    static char keyword_index_interval[]{"index_interval"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_deserializer_buffer),
+            static_cast<char*>(keyword_index_interval),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            nullptr
+    };
+
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    Py_ssize_t index_interval{0};
+    int allow_incomplete_stream{0};
+
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O!|np",
+                static_cast<char**>(keyword_table),
+                PyDeserializerBuffer::get_py_type(),
+                &deserializer_buffer,
+                &index_interval,
+                &allow_incomplete_stream
+        )))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+
+    if (0 > index_interval) {
+        PyErr_SetString(PyExc_ValueError, "The index interval must be a non-negative integer.");
+        return nullptr;
+    }
+    if (false == validate_log_event_deserialization_inputs(deserializer_buffer, Py_None)) {
+        return nullptr;
+    }
+
+    auto timestamp{deserializer_buffer->get_ref_timestamp()};
+    auto min_timestamp{std::numeric_limits<clp::ir::epoch_time_ms_t>::max()};
+    auto max_timestamp{std::numeric_limits<clp::ir::epoch_time_ms_t>::min()};
+    size_t num_log_events{0};
+    std::vector<int64_t> index_timestamps;
+    std::vector<uint64_t> index_offsets;
+    std::vector<uint64_t> index_log_event_indices;
+
+    bool is_eof_reached{false};
+    while (false == is_eof_reached) {
+        // Scan all the complete log events in the read buffer before committing the consumption,
+        // and only fall back to the deserializer buffer to read more data.
+        auto const unconsumed_bytes{deserializer_buffer->get_unconsumed_bytes()};
+        auto const stream_offset{deserializer_buffer->get_num_total_bytes_consumed()};
+        size_t pos{0};
+        size_t num_bytes_scanned{0};
+        auto err{IRErrorCode::IRErrorCode_Success};
+        while (true) {
+            encoded_tag_t tag{};
+            if (false == read_big_endian_int(unconsumed_bytes, pos, tag)) {
+                err = IRErrorCode::IRErrorCode_Incomplete_IR;
+                break;
+            }
+            if (clp::ffi::ir_stream::cProtocol::Eof == tag) {
+                is_eof_reached = true;
+                break;
+            }
+            size_t message_end_pos{0};
+            clp::ir::epoch_time_ms_t timestamp_delta{0};
+            err = skip_four_byte_log_event(
+                    unconsumed_bytes,
+                    pos,
+                    tag,
+                    message_end_pos,
+                    timestamp_delta
+            );
+            if (IRErrorCode::IRErrorCode_Success != err) {
+                break;
+            }
+
+            timestamp += timestamp_delta;
+            num_bytes_scanned = pos;
+            ++num_log_events;
+            min_timestamp = std::min(min_timestamp, timestamp);
+            max_timestamp = std::max(max_timestamp, timestamp);
+            auto const log_event_idx{
+                    deserializer_buffer->get_and_increment_deserialized_message_count()
+            };
+            if (0 != index_interval && 0 == log_event_idx % static_cast<size_t>(index_interval)) {
+                index_timestamps.push_back(timestamp);
+                index_offsets.push_back(static_cast<uint64_t>(stream_offset + pos));
+                index_log_event_indices.push_back(static_cast<uint64_t>(log_event_idx));
+            }
+        }
+        deserializer_buffer->commit_read_buffer_consumption(
+                static_cast<Py_ssize_t>(num_bytes_scanned)
+        );
+        deserializer_buffer->set_ref_timestamp(timestamp);
+        if (is_eof_reached) {
+            break;
+        }
+
+        if (IRErrorCode::IRErrorCode_Incomplete_IR != err) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
+                    err
+            );
+            return nullptr;
+        }
+        if (auto const ret_val{
+                    handle_incomplete_ir_error(deserializer_buffer, allow_incomplete_stream)
+            };
+            ret_val.has_value())
+        {
+            PyObjectPtr<PyObject> const py_none{ret_val.value()};
+            if (nullptr == py_none) {
+                return nullptr;
+            }
+            break;
+        }
+    }
+
+    PyObjectPtr<PyObject> py_min_timestamp{nullptr};
+    PyObjectPtr<PyObject> py_max_timestamp{nullptr};
+    if (0 != num_log_events) {
+        py_min_timestamp.reset(PyLong_FromLongLong(min_timestamp));
+        if (nullptr == py_min_timestamp) {
+            return nullptr;
+        }
+        py_max_timestamp.reset(PyLong_FromLongLong(max_timestamp));
+        if (nullptr == py_max_timestamp) {
+            return nullptr;
+        }
+    }
+    PyObjectPtr<PyObject> const py_num_log_events{PyLong_FromSize_t(num_log_events)};
+    if (nullptr == py_num_log_events) {
+        return nullptr;
+    }
+
+    PyObjectPtr<PyObject> py_index{nullptr};
+    if (0 != index_interval) {
+        PyObjectPtr<PyObject> py_index_timestamps{create_py_array(index_timestamps)};
+        if (nullptr == py_index_timestamps) {
+            return nullptr;
+        }
+        PyObjectPtr<PyObject> py_index_offsets{create_py_array(index_offsets)};
+        if (nullptr == py_index_offsets) {
+            return nullptr;
+        }
+        PyObjectPtr<PyObject> py_index_log_event_indices{create_py_array(index_log_event_indices)};
+        if (nullptr == py_index_log_event_indices) {
+            return nullptr;
+        }
+        py_index.reset(PyTuple_Pack(
+                3,
+                py_index_timestamps.get(),
+                py_index_offsets.get(),
+                py_index_log_event_indices.get()
+        ));
+        if (nullptr == py_index) {
+            return nullptr;
+        }
+    }
+    return PyTuple_Pack(
+            4,
+            0 == num_log_events ? Py_None : py_min_timestamp.get(),
+            0 == num_log_events ? Py_None : py_max_timestamp.get(),
+            py_num_log_events.get(),
+            0 == index_interval ? Py_None : py_index.get()
+    );
+}
+
+CLP_FFI_PY_METHOD auto
+filter_ir_stream(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords) -> PyObject* {
+    static char keyword_deserializer_buffer[]{"deserializer_buffer"};
+    static char keyword_output_stream[]{"output_stream"};
+    static char keyword_query[]{"query"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_deserializer_buffer),
+            static_cast<char*>(keyword_output_stream),
+            static_cast<char*>(keyword_query),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            nullptr
+    };
+
+    PyDeserializerBuffer* deserializer_buffer{nullptr};
+    PyObject* output_stream{nullptr};
+    PyObject* query_obj{Py_None};
+    int allow_incomplete_stream{0};
+
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O!O|Op",
+                static_cast<char**>(keyword_table),
+                PyDeserializerBuffer::get_py_type(),
+                &deserializer_buffer,
+                &output_stream,
+                &query_obj,
+                &allow_incomplete_stream
+        )))
+    {
+        return nullptr;
+    }
+    PyDeserializerBufferGuard const deserializer_buffer_guard{deserializer_buffer};
+    if (false == deserializer_buffer_guard.is_acquired()) {
+        return nullptr;
+    }
+    if (false == validate_log_event_deserialization_inputs(deserializer_buffer, query_obj)) {
+        return nullptr;
+    }
+    Query const* query{
+            Py_None == query_obj ? nullptr : py_reinterpret_cast<PyQuery>(query_obj)->get_query()
+    };
+    Query::MatchState* query_match_state{nullptr};
+    if (nullptr != query) {
+        query_match_state = deserializer_buffer->get_query_match_state(*query);
+        if (nullptr == query_match_state) {
+            return nullptr;
+        }
+    }
+
+    // The output stream starts from the current position of the input stream, so the timestamp of
+    // the last deserialized log event is used as the reference timestamp.
+    auto timestamp{deserializer_buffer->get_ref_timestamp()};
+    auto const* metadata{deserializer_buffer->get_metadata()->get_metadata()};
+    std::vector<int8_t> output_buf;
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_preamble(
+                metadata->get_timestamp_format(),
+                {},
+                metadata->get_timezone_id(),
+                timestamp,
+                output_buf
+        ))
+    {
+        PyErr_SetString(
+                PyExc_NotImplementedError,
+                get_c_str_from_constexpr_string_view(cSerializePreambleError)
+        );
+        return nullptr;
+    }
+
+    auto prev_matched_timestamp{timestamp};
+    size_t num_matched_log_events{0};
+    bool is_terminated{false};
+    while (false == is_terminated) {
+        // Filter all the complete log events in the read buffer before committing the consumption,
+        // and only fall back to the deserializer buffer to read more data.
+        auto const unconsumed_bytes{deserializer_buffer->get_unconsumed_bytes()};
+        size_t pos{0};
+        size_t num_bytes_scanned{0};
+        auto err{IRErrorCode::IRErrorCode_Success};
+        while (true) {
+            auto const log_event_begin_pos{pos};
+            encoded_tag_t tag{};
+            if (false == read_big_endian_int(unconsumed_bytes, pos, tag)) {
+                err = IRErrorCode::IRErrorCode_Incomplete_IR;
+                break;
+            }
+            if (clp::ffi::ir_stream::cProtocol::Eof == tag) {
+                is_terminated = true;
+                break;
+            }
+            size_t message_end_pos{0};
+            clp::ir::epoch_time_ms_t timestamp_delta{0};
+            err = skip_four_byte_log_event(
+                    unconsumed_bytes,
+                    pos,
+                    tag,
+                    message_end_pos,
+                    timestamp_delta
+            );
+            if (IRErrorCode::IRErrorCode_Success != err) {
+                break;
+            }
+
+            timestamp += timestamp_delta;
+            num_bytes_scanned = pos;
+            deserializer_buffer->get_and_increment_deserialized_message_count();
+            if (nullptr != query) {
+                if (query->ts_safely_outside_time_range(timestamp)) {
+                    is_terminated = true;
+                    break;
+                }
+                if (false == query->matches_time_range(timestamp)) {
+                    continue;
+                }
+                bool is_matched{false};
+                err = match_four_byte_log_event_wildcard_queries(
+                        *query,
+                        *query_match_state,
+                        unconsumed_bytes.subspan(log_event_begin_pos + 1),
+                        tag,
+                        is_matched
+                );
+                if (IRErrorCode::IRErrorCode_Success != err) {
+                    break;
+                }
+                if (false == is_matched) {
+                    continue;
+                }
+            }
+
+            // The encoded message is copied as is, and only the timestamp delta is re-serialized
+            // relative to the previous matched log event.
+            output_buf.insert(
+                    output_buf.end(),
+                    unconsumed_bytes.begin() + static_cast<std::ptrdiff_t>(log_event_begin_pos),
+                    unconsumed_bytes.begin() + static_cast<std::ptrdiff_t>(message_end_pos)
+            );
+            if (false
+                == clp::ffi::ir_stream::four_byte_encoding::serialize_timestamp(
+                        timestamp - prev_matched_timestamp,
+                        output_buf
+                ))
+            {
+                PyErr_SetString(
+                        PyExc_NotImplementedError,
+                        get_c_str_from_constexpr_string_view(cSerializeTimestampError)
+                );
+                return nullptr;
+            }
+            prev_matched_timestamp = timestamp;
+            ++num_matched_log_events;
+        }
+        deserializer_buffer->commit_read_buffer_consumption(
+                static_cast<Py_ssize_t>(num_bytes_scanned)
+        );
+        deserializer_buffer->set_ref_timestamp(timestamp);
+
+        if (output_buf.size() >= cFilterOutputBufferSizeLimit) {
+            if (false == write_to_py_output_stream(output_stream, output_buf)) {
+                return nullptr;
+            }
+            output_buf.clear();
+        }
+        if (is_terminated) {
+            break;
+        }
+
+        if (IRErrorCode::IRErrorCode_Incomplete_IR != err) {
+            PyErr_Format(
+                    PyExc_RuntimeError,
+                    get_c_str_from_constexpr_string_view(cDeserializerErrorCodeFormatStr),
+                    err
+            );
+            return nullptr;
+        }
+        if (auto const ret_val{
+                    handle_incomplete_ir_error(deserializer_buffer, allow_incomplete_stream)
+            };
+            ret_val.has_value())
+        {
+            PyObjectPtr<PyObject> const py_none{ret_val.value()};
+            if (nullptr == py_none) {
+                return nullptr;
+            }
+            break;
+        }
+    }
+
+    output_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+    if (false == write_to_py_output_stream(output_stream, output_buf)) {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(num_matched_log_events);
 }
 }  // namespace clp_ffi_py::ir::native
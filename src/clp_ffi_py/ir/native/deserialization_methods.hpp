@@ -5,14 +5,45 @@
 
 #include <clp_ffi_py/api_decoration.hpp>
 
-// Documentation for these methods is in clp/ir/native/PyDeserializer.cpp, as it also serves as the
-// documentation for Python.
+// Documentation for these methods is in clp_ffi_py/ir/native/PyFourByteDeserializer.cpp and
+// clp_ffi_py/ir/native/PyEightByteDeserializer.cpp, as it also serves as the documentation for
+// Python.
 namespace clp_ffi_py::ir::native {
 CLP_FFI_PY_METHOD auto deserialize_preamble(PyObject* self, PyObject* py_deserializer_buffer)
         -> PyObject*;
 
 CLP_FFI_PY_METHOD auto
 deserialize_next_log_event(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+deserialize_next_log_events(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+deserialize_next_eight_byte_log_event(PyObject* self, PyObject* args, PyObject* keywords)
+        -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+deserialize_next_eight_byte_log_events(PyObject* self, PyObject* args, PyObject* keywords)
+        -> PyObject*;
+
+CLP_FFI_PY_METHOD auto dump(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+dump_eight_byte(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto count_matches(PyObject* self, PyObject* args, PyObject* keywords)
+        -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+find_match_indices(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto histogram(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+scan_timestamps(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+filter_ir_stream(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
 }  // namespace clp_ffi_py::ir::native
 
 #endif  // CLP_FFI_PY_IR_NATIVE_DESERIALIZATION_METHODS
@@ -4,6 +4,12 @@
 #include <string_view>
 
 namespace clp_ffi_py::ir::native {
+constexpr std::string_view cDeserializerBufferMaxCapacityErrorFormatStr{
+        "DeserializerBuffer internal read buffer is full at its maximum capacity (%zd bytes)."
+};
+constexpr std::string_view cDeserializerBufferInUseError{
+        "DeserializerBuffer is already in use by another deserialization method."
+};
 constexpr std::string_view cDeserializerBufferOverflowError{
         "DeserializerBuffer internal read buffer overflows."
 };
@@ -16,6 +22,9 @@ constexpr std::string_view cDeserializerDeserializeNextIrUnitErrorFormatStr{
 constexpr std::string_view cDeserializerErrorCodeFormatStr{
         "IR deserialization method failed with error code: %d."
 };
+constexpr std::string_view cDeserializerInUseError{
+        "Deserializer is already in use by another call."
+};
 constexpr std::string_view cDeserializerIncompleteIRError{"The IR stream is incomplete."};
 constexpr std::string_view cKeyValuePairLogEventSerializeToStringErrorFormatStr{
         "Native `KeyValuePairLogEvent::serialize_to_json` failed: %s"
@@ -34,6 +43,13 @@ constexpr std::string_view cSerializePreambleError{
 constexpr std::string_view cSerializeTimestampError{
         "Native serializer cannot serialize the given timestamp delta"
 };
+constexpr std::string_view cTimestampLocalDateOutOfRangeErrorFormatStr{
+        "The local date of timestamp %lld is out of the range of years 1 to 9999 supported by "
+        "`datetime`."
+};
+constexpr std::string_view cTimestampOutOfRangeErrorFormatStr{
+        "Timestamp %lld is out of the range of years 1 to 9999 supported by `datetime`."
+};
 }  // namespace clp_ffi_py::ir::native
 
 #endif  // CLP_FFI_PY_IR_NATIVE_ERROR_MESSAGES
@@ -2,22 +2,190 @@
 
 #include "serialization_methods.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <clp/ffi/ir_stream/encoding_methods.hpp>
 #include <clp/ffi/ir_stream/protocol_constants.hpp>
 #include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <clp/type_utils.hpp>
 
 #include <clp_ffi_py/api_decoration.hpp>
+#include <clp_ffi_py/error_messages.hpp>
 #include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/LocalFileReader.hpp>
+#include <clp_ffi_py/ir/native/TextLogConverter.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormat.hpp>
+#include <clp_ffi_py/ir/native/Timezone.hpp>
+#include <clp_ffi_py/ir/native/ZstdDecompressionReader.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
 #include <clp_ffi_py/utils.hpp>
 
 namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * The minimum number of log events serialized by each thread when a batch is serialized in
+ * parallel, so that the cost of starting a thread is amortized. Any change to the value should
+ * also be applied to the doc string of `FourByteSerializer.serialize_messages_and_timestamps`.
+ */
+constexpr size_t cMinNumLogEventsPerThread{4096};
+
+/**
+ * Serializes the given log events using the four-byte encoding.
+ * @param timestamps
+ * @param messages
+ * @param prev_timestamp The timestamp of the log event before the given ones, used to compute the
+ * timestamp delta of the first log event.
+ * @param ir_buf Returns the serialized log events.
+ * @return std::nullopt on success.
+ * @return The error message on failure.
+ */
+[[nodiscard]] auto serialize_four_byte_log_events(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        std::span<std::string_view const> messages,
+        clp::ir::epoch_time_ms_t prev_timestamp,
+        std::vector<int8_t>& ir_buf
+) -> std::optional<std::string_view>;
+
+/**
+ * Parses the given Python sequence of timestamp format strings.
+ * @param py_timestamp_formats
+ * @param timestamp_formats Returns the parsed timestamp formats.
+ * @return Whether the timestamp formats are parsed successfully. On failure, the relevant Python
+ * exception and error are set.
+ */
+[[nodiscard]] auto parse_timestamp_formats(
+        PyObject* py_timestamp_formats,
+        std::vector<TimestampFormat>& timestamp_formats
+) -> bool;
+
+/**
+ * Opens the file at the given path for writing, truncating any existing content.
+ * @param path A Python path-like object.
+ * @param file Returns the opened file.
+ * @return Whether the file is opened successfully. On failure, the relevant Python exception and
+ * error are set.
+ */
+[[nodiscard]] auto open_output_file(PyObject* path, std::ofstream& file) -> bool;
+
+auto serialize_four_byte_log_events(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        std::span<std::string_view const> messages,
+        clp::ir::epoch_time_ms_t prev_timestamp,
+        std::vector<int8_t>& ir_buf
+) -> std::optional<std::string_view> {
+    size_t total_message_size{0};
+    for (auto const message : messages) {
+        total_message_size += message.size();
+    }
+    // To avoid the frequent expansion of ir_buf, allocate sufficient space in advance
+    ir_buf.reserve(total_message_size * 2);
+
+    std::string logtype;
+    for (size_t idx{0}; idx < messages.size(); ++idx) {
+        logtype.clear();
+        if (false
+            == clp::ffi::ir_stream::four_byte_encoding::serialize_message(
+                    messages[idx],
+                    logtype,
+                    ir_buf
+            ))
+        {
+            return cSerializeMessageError;
+        }
+        if (false
+            == clp::ffi::ir_stream::four_byte_encoding::serialize_timestamp(
+                    timestamps[idx] - prev_timestamp,
+                    ir_buf
+            ))
+        {
+            return cSerializeTimestampError;
+        }
+        prev_timestamp = timestamps[idx];
+    }
+    return std::nullopt;
+}
+
+auto parse_timestamp_formats(
+        PyObject* py_timestamp_formats,
+        std::vector<TimestampFormat>& timestamp_formats
+) -> bool {
+    PyObjectPtr<PyObject> const timestamp_formats_tuple{PySequence_Tuple(py_timestamp_formats)};
+    if (nullptr == timestamp_formats_tuple) {
+        return false;
+    }
+    auto const num_timestamp_formats{PyTuple_GET_SIZE(timestamp_formats_tuple.get())};
+    timestamp_formats.reserve(static_cast<size_t>(num_timestamp_formats));
+    for (Py_ssize_t idx{0}; idx < num_timestamp_formats; ++idx) {
+        auto* py_timestamp_format{PyTuple_GET_ITEM(timestamp_formats_tuple.get(), idx)};
+        if (false == static_cast<bool>(PyUnicode_Check(py_timestamp_format))) {
+            PyErr_Format(PyExc_TypeError, "The timestamp format at index %zd is not a str.", idx);
+            return false;
+        }
+        Py_ssize_t format_size{};
+        auto const* format_data{PyUnicode_AsUTF8AndSize(py_timestamp_format, &format_size)};
+        if (nullptr == format_data) {
+            return false;
+        }
+        auto timestamp_format{
+                TimestampFormat::create({format_data, static_cast<size_t>(format_size)})
+        };
+        if (false == timestamp_format.has_value()) {
+            PyErr_Format(PyExc_ValueError, "Invalid timestamp format: `%s`.", format_data);
+            return false;
+        }
+        timestamp_formats.emplace_back(std::move(timestamp_format.value()));
+    }
+    return true;
+}
+
+auto open_output_file(PyObject* path, std::ofstream& file) -> bool {
+    PyObjectPtr<PyObject> const fs_path{PyOS_FSPath(path)};
+    if (nullptr == fs_path) {
+        return false;
+    }
+    if (false == static_cast<bool>(PyUnicode_Check(fs_path.get()))) {
+        PyErr_SetString(PyExc_TypeError, "The path of the file to write must be a `str`.");
+        return false;
+    }
+    Py_ssize_t path_size{0};
+    auto const* path_data{PyUnicode_AsUTF8AndSize(fs_path.get(), &path_size)};
+    if (nullptr == path_data) {
+        return false;
+    }
+    std::u8string_view const utf8_path{
+            clp::size_checked_pointer_cast<char8_t const>(path_data),
+            static_cast<size_t>(path_size)
+    };
+
+    file.open(
+            std::filesystem::path{utf8_path},
+            std::ios::out | std::ios::binary | std::ios::trunc
+    );
+    if (false == file.is_open()) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, fs_path.get());
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
 CLP_FFI_PY_METHOD auto serialize_four_byte_preamble(PyObject* Py_UNUSED(self), PyObject* args)
         -> PyObject* {
     clp::ir::epoch_time_ms_t ref_timestamp{};
@@ -165,6 +333,335 @@ serialize_four_byte_timestamp_delta(PyObject* Py_UNUSED(self), PyObject* args) -
     );
 }
 
+CLP_FFI_PY_METHOD auto
+serialize_four_byte_messages_and_timestamps(PyObject* Py_UNUSED(self), PyObject* args)
+        -> PyObject* {
+    PyObject* py_timestamps{};
+    PyObject* py_messages{};
+    clp::ir::epoch_time_ms_t ref_timestamp{};
+    Py_ssize_t num_threads{1};
+    if (0
+        == PyArg_ParseTuple(
+                args,
+                "OOL|n",
+                &py_timestamps,
+                &py_messages,
+                &ref_timestamp,
+                &num_threads
+        ))
+    {
+        return nullptr;
+    }
+    if (0 > num_threads) {
+        PyErr_SetString(PyExc_ValueError, "The number of threads cannot be negative.");
+        return nullptr;
+    }
+    if (0 == num_threads) {
+        num_threads = std::max(
+                static_cast<Py_ssize_t>(std::thread::hardware_concurrency()),
+                static_cast<Py_ssize_t>(1)
+        );
+    }
+
+    // Convert the sequences into tuples so that the messages stay referenced while the GIL is
+    // released, even if the given sequences are modified by other threads.
+    PyObjectPtr<PyObject> const timestamps_tuple{PySequence_Tuple(py_timestamps)};
+    if (nullptr == timestamps_tuple) {
+        return nullptr;
+    }
+    PyObjectPtr<PyObject> const messages_tuple{PySequence_Tuple(py_messages)};
+    if (nullptr == messages_tuple) {
+        return nullptr;
+    }
+    auto const num_log_events{PyTuple_GET_SIZE(messages_tuple.get())};
+    if (PyTuple_GET_SIZE(timestamps_tuple.get()) != num_log_events) {
+        PyErr_SetString(
+                PyExc_ValueError,
+                "The number of timestamps doesn't match the number of messages."
+        );
+        return nullptr;
+    }
+
+    std::vector<clp::ir::epoch_time_ms_t> timestamps(static_cast<size_t>(num_log_events));
+    std::vector<std::string_view> messages;
+    messages.reserve(static_cast<size_t>(num_log_events));
+    for (Py_ssize_t idx{0}; idx < num_log_events; ++idx) {
+        if (false
+            == parse_py_int(
+                    PyTuple_GET_ITEM(timestamps_tuple.get(), idx),
+                    timestamps[static_cast<size_t>(idx)]
+            ))
+        {
+            return nullptr;
+        }
+        // Only `bytes` is accepted since it's immutable, so its buffer stays valid without the GIL.
+        auto* py_message{PyTuple_GET_ITEM(messages_tuple.get(), idx)};
+        if (false == static_cast<bool>(PyBytes_Check(py_message))) {
+            PyErr_Format(PyExc_TypeError, "The message at index %zd is not bytes.", idx);
+            return nullptr;
+        }
+        char* message_data{};
+        Py_ssize_t message_size{};
+        if (0 != PyBytes_AsStringAndSize(py_message, &message_data, &message_size)) {
+            return nullptr;
+        }
+        messages.emplace_back(message_data, static_cast<size_t>(message_size));
+    }
+
+    // Messages are serialized independently, and the timestamp delta of the first log event in
+    // each chunk only depends on the timestamp of the previous log event. So the chunks can be
+    // serialized in parallel, and concatenated in order into the same byte sequence as sequential
+    // serialization.
+    auto const num_chunks{std::clamp(
+            messages.size() / cMinNumLogEventsPerThread,
+            static_cast<size_t>(1),
+            static_cast<size_t>(num_threads)
+    )};
+    std::vector<std::vector<int8_t>> chunk_ir_bufs(num_chunks);
+    std::vector<std::optional<std::string_view>> chunk_errors(num_chunks);
+    {
+        PyGilReleaseGuard const gil_release_guard;
+        auto serialize_chunk = [&](size_t chunk_idx) -> void {
+            auto const begin_idx{messages.size() * chunk_idx / num_chunks};
+            auto const end_idx{messages.size() * (chunk_idx + 1) / num_chunks};
+            try {
+                chunk_errors[chunk_idx] = serialize_four_byte_log_events(
+                        std::span{timestamps}.subspan(begin_idx, end_idx - begin_idx),
+                        std::span{messages}.subspan(begin_idx, end_idx - begin_idx),
+                        0 == begin_idx ? ref_timestamp : timestamps[begin_idx - 1],
+                        chunk_ir_bufs[chunk_idx]
+                );
+            } catch (std::bad_alloc const&) {
+                chunk_errors[chunk_idx] = clp_ffi_py::cOutOfMemoryError;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_chunks - 1);
+        for (size_t chunk_idx{1}; chunk_idx < num_chunks; ++chunk_idx) {
+            try {
+                workers.emplace_back(serialize_chunk, chunk_idx);
+            } catch (std::system_error const&) {
+                // Serialize the chunk in the current thread if no more threads can be created.
+                serialize_chunk(chunk_idx);
+            }
+        }
+        serialize_chunk(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t total_size{0};
+    for (size_t chunk_idx{0}; chunk_idx < num_chunks; ++chunk_idx) {
+        if (chunk_errors[chunk_idx].has_value()) {
+            PyErr_SetString(PyExc_NotImplementedError, chunk_errors[chunk_idx].value().data());
+            return nullptr;
+        }
+        total_size += chunk_ir_bufs[chunk_idx].size();
+    }
+
+    PyObject* serialized_log_events{
+            PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(total_size))
+    };
+    if (nullptr == serialized_log_events) {
+        return nullptr;
+    }
+    auto* dst{clp::size_checked_pointer_cast<int8_t>(PyBytes_AS_STRING(serialized_log_events))};
+    for (auto const& chunk_ir_buf : chunk_ir_bufs) {
+        dst = std::ranges::copy(chunk_ir_buf, dst).out;
+    }
+    return serialized_log_events;
+}
+
+CLP_FFI_PY_METHOD auto
+serialize_four_byte_text_log(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
+        -> PyObject* {
+    static char keyword_input_path[]{"input_path"};
+    static char keyword_output_path[]{"output_path"};
+    static char keyword_timestamp_formats[]{"timestamp_formats"};
+    static char keyword_timezone[]{"timezone"};
+    static char keyword_enable_zstd_decompression[]{"enable_zstd_decompression"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_input_path),
+            static_cast<char*>(keyword_output_path),
+            static_cast<char*>(keyword_timestamp_formats),
+            static_cast<char*>(keyword_timezone),
+            static_cast<char*>(keyword_enable_zstd_decompression),
+            nullptr
+    };
+
+    PyObject* input_path{};
+    PyObject* output_path{};
+    PyObject* py_timestamp_formats{};
+    char const* input_timezone{"UTC"};
+    Py_ssize_t input_timezone_size{3};
+    int enable_zstd_decompression{0};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "OOO|s#p",
+                static_cast<char**>(keyword_table),
+                &input_path,
+                &output_path,
+                &py_timestamp_formats,
+                &input_timezone,
+                &input_timezone_size,
+                &enable_zstd_decompression
+        )))
+    {
+        return nullptr;
+    }
+
+    std::vector<TimestampFormat> timestamp_formats;
+    if (false == parse_timestamp_formats(py_timestamp_formats, timestamp_formats)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<clp::ReaderInterface> reader{LocalFileReader::create(input_path)};
+    if (nullptr == reader) {
+        return nullptr;
+    }
+    if (static_cast<bool>(enable_zstd_decompression)) {
+        // The local file reader doesn't require the GIL, so neither does the decompression reader.
+        auto* zstd_reader{ZstdDecompressionReader::create(std::move(reader), false)};
+        if (nullptr == zstd_reader) {
+            return nullptr;
+        }
+        reader.reset(zstd_reader);
+    }
+
+    std::ofstream output_file;
+    if (false == open_output_file(output_path, output_file)) {
+        return nullptr;
+    }
+
+    // Timestamps without a UTC offset are interpreted in the given timezone, which must be loaded
+    // natively unless it's UTC.
+    std::string timezone_id{input_timezone, static_cast<size_t>(input_timezone_size)};
+    auto const* timezone{Timezone::get(timezone_id)};
+    bool const is_utc_offset_always_parsed{std::ranges::all_of(
+            timestamp_formats,
+            [](TimestampFormat const& format) -> bool { return format.has_utc_offset(); }
+    )};
+    if (nullptr == timezone && "UTC" != timezone_id && false == is_utc_offset_always_parsed) {
+        PyErr_Format(
+                PyExc_ValueError,
+                "Failed to load the timezone `%s` to interpret timestamps without a UTC offset.",
+                timezone_id.c_str()
+        );
+        return nullptr;
+    }
+    TextLogConverter converter{std::move(timestamp_formats), std::move(timezone_id), timezone};
+    size_t num_log_events{0};
+    std::optional<std::string> error_message;
+    {
+        PyGilReleaseGuard const gil_release_guard;
+        try {
+            num_log_events = converter.convert(*reader, output_file);
+        } catch (std::exception const& exception) {
+            error_message = exception.what();
+        }
+    }
+    if (error_message.has_value()) {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                "Failed to convert the text log: %s",
+                error_message->c_str()
+        );
+        return nullptr;
+    }
+    return PyLong_FromSize_t(num_log_events);
+}
+
+CLP_FFI_PY_METHOD auto serialize_eight_byte_preamble(PyObject* Py_UNUSED(self), PyObject* args)
+        -> PyObject* {
+    char const* input_timestamp_format{};
+    char const* input_timezone{};
+    Py_ssize_t input_timestamp_format_size{};
+    Py_ssize_t input_timezone_size{};
+
+    if (0
+        == PyArg_ParseTuple(
+                args,
+                "s#s#",
+                &input_timestamp_format,
+                &input_timestamp_format_size,
+                &input_timezone,
+                &input_timezone_size
+        ))
+    {
+        return nullptr;
+    }
+
+    std::string_view const timestamp_format{
+            input_timestamp_format,
+            static_cast<size_t>(input_timestamp_format_size)
+    };
+    std::string_view const timezone{input_timezone, static_cast<size_t>(input_timezone_size)};
+    std::vector<int8_t> ir_buf;
+
+    if (false
+        == clp::ffi::ir_stream::eight_byte_encoding::serialize_preamble(
+                timestamp_format,
+                {},
+                timezone,
+                ir_buf
+        ))
+    {
+        PyErr_SetString(
+                PyExc_NotImplementedError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::ir::native::cSerializePreambleError
+                )
+        );
+        return nullptr;
+    }
+
+    return PyByteArray_FromStringAndSize(
+            clp::size_checked_pointer_cast<char>(ir_buf.data()),
+            static_cast<Py_ssize_t>(ir_buf.size())
+    );
+}
+
+CLP_FFI_PY_METHOD auto
+serialize_eight_byte_message_and_timestamp(PyObject* Py_UNUSED(self), PyObject* args)
+        -> PyObject* {
+    clp::ir::epoch_time_ms_t timestamp{};
+    char const* input_buffer{};
+    Py_ssize_t input_buffer_size{};
+    if (0 == PyArg_ParseTuple(args, "Ly#", &timestamp, &input_buffer, &input_buffer_size)) {
+        return nullptr;
+    }
+
+    std::string logtype;
+    std::vector<int8_t> ir_buf;
+    std::string_view const msg{input_buffer, static_cast<size_t>(input_buffer_size)};
+
+    // To avoid the frequent expansion of ir_buf, allocate sufficient space in advance
+    ir_buf.reserve(input_buffer_size * 2);
+
+    if (false
+        == clp::ffi::ir_stream::eight_byte_encoding::serialize_log_event(
+                timestamp,
+                msg,
+                logtype,
+                ir_buf
+        ))
+    {
+        PyErr_SetString(
+                PyExc_NotImplementedError,
+                get_c_str_from_constexpr_string_view(clp_ffi_py::ir::native::cSerializeMessageError)
+        );
+        return nullptr;
+    }
+
+    return PyByteArray_FromStringAndSize(
+            clp::size_checked_pointer_cast<char>(ir_buf.data()),
+            static_cast<Py_ssize_t>(ir_buf.size())
+    );
+}
+
 CLP_FFI_PY_METHOD auto serialize_end_of_ir(PyObject* Py_UNUSED(self)) -> PyObject* {
     constexpr char cEof{clp::ffi::ir_stream::cProtocol::Eof};
     return PyByteArray_FromStringAndSize(&cEof, sizeof(cEof));
@@ -5,8 +5,9 @@
 
 #include <clp_ffi_py/api_decoration.hpp>
 
-// Documentation for these methods is in clp_ffi_py/ir/native/PyFourByteSerializer.cpp, as it also
-// serves as the documentation for python.
+// Documentation for these methods is in clp_ffi_py/ir/native/PyFourByteSerializer.cpp and
+// clp_ffi_py/ir/native/PyEightByteSerializer.cpp, as it also serves as the documentation for
+// python.
 namespace clp_ffi_py::ir::native {
 CLP_FFI_PY_METHOD auto serialize_four_byte_preamble(PyObject* self, PyObject* args) -> PyObject*;
 
@@ -18,6 +19,17 @@ CLP_FFI_PY_METHOD auto serialize_four_byte_message(PyObject* self, PyObject* arg
 CLP_FFI_PY_METHOD auto serialize_four_byte_timestamp_delta(PyObject* self, PyObject* args)
         -> PyObject*;
 
+CLP_FFI_PY_METHOD auto
+serialize_four_byte_messages_and_timestamps(PyObject* self, PyObject* args) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+serialize_four_byte_text_log(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto serialize_eight_byte_preamble(PyObject* self, PyObject* args) -> PyObject*;
+
+CLP_FFI_PY_METHOD auto
+serialize_eight_byte_message_and_timestamp(PyObject* self, PyObject* args) -> PyObject*;
+
 CLP_FFI_PY_METHOD auto serialize_end_of_ir(PyObject* self) -> PyObject*;
 }  // namespace clp_ffi_py::ir::native
 
@@ -2,8 +2,11 @@
 
 #include <clp_ffi_py/ir/native/PyDeserializer.hpp>
 #include <clp_ffi_py/ir/native/PyDeserializerBuffer.hpp>
+#include <clp_ffi_py/ir/native/PyEightByteDeserializer.hpp>
+#include <clp_ffi_py/ir/native/PyEightByteSerializer.hpp>
 #include <clp_ffi_py/ir/native/PyFourByteDeserializer.hpp>
 #include <clp_ffi_py/ir/native/PyFourByteSerializer.hpp>
+#include <clp_ffi_py/ir/native/PyFourByteStreamSerializer.hpp>
 #include <clp_ffi_py/ir/native/PyKeyValuePairLogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyLogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
@@ -75,6 +78,23 @@ PyMODINIT_FUNC PyInit_native() {
         return nullptr;
     }
 
+    if (false
+        == clp_ffi_py::ir::native::PyFourByteStreamSerializer::module_level_init(new_module))
+    {
+        Py_DECREF(new_module);
+        return nullptr;
+    }
+
+    if (false == clp_ffi_py::ir::native::PyEightByteDeserializer::module_level_init(new_module)) {
+        Py_DECREF(new_module);
+        return nullptr;
+    }
+
+    if (false == clp_ffi_py::ir::native::PyEightByteSerializer::module_level_init(new_module)) {
+        Py_DECREF(new_module);
+        return nullptr;
+    }
+
     if (false == clp_ffi_py::ir::native::PyKeyValuePairLogEvent::module_level_init(new_module)) {
         Py_DECREF(new_module);
         return nullptr;
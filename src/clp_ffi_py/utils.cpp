@@ -2,34 +2,52 @@
 
 #include "utils.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <utility>
 
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
 #include <clp/TraceableException.hpp>
+#include <clp/type_utils.hpp>
 #include <outcome/single-header/outcome.hpp>
 #include <wrapped_facade_headers/msgpack.hpp>
 
 #include <clp_ffi_py/ExceptionFFI.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py {
 namespace {
 /**
- * Gets the underlying py_string byte data.
+ * Gets the underlying py_string byte data, which may contain embedded null characters.
  * @param py_string PyObject that represents a Python level string. Only Python Unicode object or an
  * instance of a Python Unicode subtype will be considered as valid input.
- * @return pointer to the byte data on success.
- * @return nullptr on failure with the relevant Python exception and error set.
+ * @return A view of the UTF-8 encoded byte data on success.
+ * @return std::nullopt on failure with the relevant Python exception and error set.
  */
-auto get_py_string_data(PyObject* py_string) -> char const* {
+auto get_py_string_data(PyObject* py_string) -> std::optional<std::string_view> {
     if (false == static_cast<bool>(PyUnicode_Check(py_string))) {
         PyErr_SetString(PyExc_TypeError, "parse_py_string receives none-string argument.");
-        return nullptr;
+        return std::nullopt;
     }
-    return PyUnicode_AsUTF8(py_string);
+    Py_ssize_t size{};
+    char const* str{PyUnicode_AsUTF8AndSize(py_string, &size)};
+    if (nullptr == str) {
+        return std::nullopt;
+    }
+    return std::string_view{str, static_cast<size_t>(size)};
 }
 }  // namespace
 
@@ -44,20 +62,20 @@ auto add_python_type(PyTypeObject* new_type, char const* type_name, PyObject* mo
 }
 
 auto parse_py_string(PyObject* py_string, std::string& out) -> bool {
-    char const* str{get_py_string_data(py_string)};
-    if (nullptr == str) {
+    auto const str{get_py_string_data(py_string)};
+    if (false == str.has_value()) {
         return false;
     }
-    out = std::string(str);
+    out = std::string{str.value()};
     return true;
 }
 
 auto parse_py_string_as_string_view(PyObject* py_string, std::string_view& view) -> bool {
-    char const* str{get_py_string_data(py_string)};
-    if (nullptr == str) {
+    auto const str{get_py_string_data(py_string)};
+    if (false == str.has_value()) {
         return false;
     }
-    view = std::string_view{str};
+    view = str.value();
     return true;
 }
 
@@ -119,6 +137,70 @@ auto construct_py_str_from_string_view(std::string_view sv) -> PyObject* {
     return PyUnicode_FromStringAndSize(sv.data(), static_cast<Py_ssize_t>(sv.size()));
 }
 
+auto write_to_py_output_stream(PyObject* output_stream, std::span<int8_t const> buf) -> bool {
+    if (buf.empty()) {
+        return true;
+    }
+
+    // `PyBUF_READ` ensures the buffer is read-only, so it should be safe to cast `char const*` to
+    // `char*`
+    PyObjectPtr<PyObject> const buf_mem_view{PyMemoryView_FromMemory(
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            const_cast<char*>(clp::size_checked_pointer_cast<char const>(buf.data())),
+            static_cast<Py_ssize_t>(buf.size()),
+            PyBUF_READ
+    )};
+    if (nullptr == buf_mem_view) {
+        return false;
+    }
+    PyObjectPtr<PyObject> const py_num_bytes_written{
+            PyObject_CallMethod(output_stream, "write", "O", buf_mem_view.get())
+    };
+    if (nullptr == py_num_bytes_written) {
+        return false;
+    }
+    Py_ssize_t num_bytes_written{};
+    if (false == parse_py_int(py_num_bytes_written.get(), num_bytes_written)) {
+        return false;
+    }
+    if (static_cast<size_t>(num_bytes_written) != buf.size()) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                "The number of bytes written to the output stream doesn't match the size of the "
+                "buffer."
+        );
+        return false;
+    }
+    return true;
+}
+
+auto write_to_fd(int fd, std::span<int8_t const> buf) -> bool {
+#if defined(_WIN32)
+    // `_write` takes the number of bytes as an `unsigned int`.
+    constexpr size_t cMaxNumBytesPerWrite{1U << 30U};
+#else
+    constexpr size_t cMaxNumBytesPerWrite{SSIZE_MAX};
+#endif
+    while (false == buf.empty()) {
+        auto const num_bytes_to_write{std::min(buf.size(), cMaxNumBytesPerWrite)};
+#if defined(_WIN32)
+        auto const num_bytes_written{
+                _write(fd, buf.data(), static_cast<unsigned int>(num_bytes_to_write))
+        };
+#else
+        auto const num_bytes_written{::write(fd, buf.data(), num_bytes_to_write)};
+#endif
+        if (num_bytes_written < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+        buf = buf.subspan(static_cast<size_t>(num_bytes_written));
+    }
+    return true;
+}
+
 auto get_new_ref_to_py_none() -> PyObject* {
     Py_INCREF(Py_None);
     return Py_None;
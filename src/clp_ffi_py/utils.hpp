@@ -103,6 +103,26 @@ auto handle_traceable_exception(clp::TraceableException& exception) noexcept ->
  */
 [[nodiscard]] auto construct_py_str_from_string_view(std::string_view sv) -> PyObject*;
 
+/**
+ * Writes the entire given buffer into the given Python output stream using its `write` method.
+ * @param output_stream
+ * @param buf
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto write_to_py_output_stream(PyObject* output_stream, std::span<int8_t const> buf)
+        -> bool;
+
+/**
+ * Writes the entire given buffer into the given file descriptor. It doesn't interact with the
+ * Python interpreter, so it can be called without holding the GIL.
+ * @param fd
+ * @param buf
+ * @return true on success.
+ * @return false on failure with `errno` set.
+ */
+[[nodiscard]] auto write_to_fd(int fd, std::span<int8_t const> buf) -> bool;
+
 /**
  * A template that always evaluates as false.
  */
@@ -1,19 +1,28 @@
 import random
+from array import array
+from collections import Counter
+from io import BytesIO
 from pathlib import Path
-from typing import List, Optional, Tuple
+from typing import Dict, List, Optional, Tuple
 
 from smart_open import open  # type: ignore
 from test_ir.test_utils import get_current_timestamp, LogGenerator, TestCLPBase
 
 from clp_ffi_py.ir import (
     DeserializerBuffer,
+    EightByteDeserializer,
+    EightByteSerializer,
     FourByteDeserializer,
     FourByteSerializer,
     LogEvent,
     Metadata,
     Query,
 )
-from clp_ffi_py.wildcard_query import WildcardQuery
+from clp_ffi_py.wildcard_query import (
+    FullStringWildcardQuery,
+    SubstringWildcardQuery,
+    WildcardQuery,
+)
 
 LOG_DIR: Path = Path("unittest-logs")
 
@@ -143,6 +152,144 @@ class TestCaseFourByteDeserializerBase(TestCLPBase):
                 log_events.append(log_event)
         return metadata, log_events
 
+    def _deserialize_log_stream_in_batches(
+        self, log_path: Path, query: Optional[Query], max_events: int
+    ) -> Tuple[Metadata, List[LogEvent]]:
+        """
+        Decodes the log stream specified by `log_path` in batches, using
+        `FourByteDeserializer.deserialize_next_log_events`.
+
+        :param log_path: The path to the log stream.
+        :param query: Optional search query.
+        :param max_events: The maximum number of log events in each batch.
+        :return: A tuple that contains the deserialized metadata and log events returned from
+            deserialization methods.
+        """
+        with open(str(log_path), "rb") as istream:
+            deserializer_buffer: DeserializerBuffer = DeserializerBuffer(istream)
+            metadata: Metadata = FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+            log_events: List[LogEvent] = []
+            while True:
+                batch: List[LogEvent] = FourByteDeserializer.deserialize_next_log_events(
+                    deserializer_buffer, max_events, query
+                )
+                self.assertLessEqual(len(batch), max_events)
+                log_events.extend(batch)
+                if len(batch) < max_events:
+                    break
+        return metadata, log_events
+
+    def _scan_log_stream_matches(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[int, List[int]]:
+        """
+        Counts and finds the indices of the log events in the log stream specified by `log_path`
+        that match the given query, using `FourByteDeserializer.count_matches` and
+        `FourByteDeserializer.find_match_indices`.
+
+        :param log_path: The path to the log stream.
+        :param query: Optional search query.
+        :return: A tuple that contains the number of matched log events and their indices.
+        """
+        num_matches: int
+        with open(str(log_path), "rb") as istream:
+            deserializer_buffer: DeserializerBuffer = DeserializerBuffer(istream)
+            FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+            num_matches = FourByteDeserializer.count_matches(deserializer_buffer, query)
+        with open(str(log_path), "rb") as istream:
+            deserializer_buffer = DeserializerBuffer(istream)
+            FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+            match_indices: array[int] = FourByteDeserializer.find_match_indices(
+                deserializer_buffer, query
+            )
+            self.assertEqual("Q", match_indices.typecode)
+        return num_matches, match_indices.tolist()
+
+    def _compute_log_stream_histogram(
+        self, log_path: Path, query: Optional[Query], bucket_ms: int
+    ) -> Dict[int, int]:
+        """
+        Counts the log events in the log stream specified by `log_path` that match the given query
+        per time bucket, using `FourByteDeserializer.histogram`.
+
+        :param log_path: The path to the log stream.
+        :param query: Optional search query.
+        :param bucket_ms: The size of each time bucket in milliseconds.
+        :return: A dictionary that maps the start timestamp of each non-empty bucket to the number
+            of matched log events in the bucket.
+        """
+        with open(str(log_path), "rb") as istream:
+            deserializer_buffer: DeserializerBuffer = DeserializerBuffer(istream)
+            FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+            bucket_start_timestamps: array[int]
+            counts: array[int]
+            bucket_start_timestamps, counts = FourByteDeserializer.histogram(
+                deserializer_buffer, bucket_ms, query
+            )
+        self.assertEqual("q", bucket_start_timestamps.typecode)
+        self.assertEqual("Q", counts.typecode)
+        self.assertEqual(sorted(bucket_start_timestamps), bucket_start_timestamps.tolist())
+        return dict(zip(bucket_start_timestamps, counts))
+
+    def _scan_log_stream_timestamps(
+        self, log_path: Path, index_interval: int
+    ) -> Tuple[Optional[int], Optional[int], int, Optional[Tuple[List[int], List[int]]]]:
+        """
+        Scans the timestamps of the log stream specified by `log_path` using
+        `FourByteDeserializer.scan_timestamps`.
+
+        :param log_path: The path to the log stream.
+        :param index_interval: The interval of the log events in the sparse index.
+        :return: A tuple that contains the minimum timestamp, the maximum timestamp, the number of
+            log events, and the timestamps and indices of the log events in the sparse index (if
+            any). The offsets in the sparse index are validated to be strictly increasing.
+        """
+        with open(str(log_path), "rb") as istream:
+            deserializer_buffer: DeserializerBuffer = DeserializerBuffer(istream)
+            FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+            min_ts, max_ts, num_log_events, index = FourByteDeserializer.scan_timestamps(
+                deserializer_buffer, index_interval
+            )
+        if index is None:
+            return min_ts, max_ts, num_log_events, None
+        timestamps, offsets, indices = index
+        self.assertEqual("q", timestamps.typecode)
+        self.assertEqual("Q", offsets.typecode)
+        self.assertEqual("Q", indices.typecode)
+        for offset, next_offset in zip(offsets, offsets[1:]):
+            self.assertLess(offset, next_offset)
+        return min_ts, max_ts, num_log_events, (timestamps.tolist(), indices.tolist())
+
+    def _filter_log_stream(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[int, List[Tuple[str, int]]]:
+        """
+        Filters the log stream specified by `log_path` into a new IR stream using
+        `FourByteDeserializer.filter_ir_stream`, and deserializes the new IR stream.
+
+        :param log_path: The path to the log stream.
+        :param query: Optional search query.
+        :return: A tuple that contains the number of log events written, and the log message and
+            timestamp of each log event deserialized from the new IR stream.
+        """
+        output_stream: BytesIO = BytesIO()
+        with open(str(log_path), "rb") as istream:
+            deserializer_buffer: DeserializerBuffer = DeserializerBuffer(istream)
+            FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+            num_written: int = FourByteDeserializer.filter_ir_stream(
+                deserializer_buffer, output_stream, query
+            )
+        output_stream.seek(0)
+        deserializer_buffer = DeserializerBuffer(output_stream)
+        FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+        filtered_log_events: List[LogEvent] = FourByteDeserializer.deserialize_next_log_events(
+            deserializer_buffer, num_written + 1
+        )
+        return num_written, [
+            (log_event.get_log_message(), log_event.get_timestamp())
+            for log_event in filtered_log_events
+        ]
+
     def _validate_deserialized_logs(
         self,
         ref_metadata: Metadata,
@@ -206,6 +353,26 @@ class TestCaseFourByteDeserializerBase(TestCLPBase):
                 log_path, num_log_events, seed
             )
 
+            index_interval: int = random.choice([0, 1, 10])
+            ref_timestamps: List[int] = [log_event.get_timestamp() for log_event in ref_log_events]
+            self.assertEqual(
+                (
+                    min(ref_timestamps),
+                    max(ref_timestamps),
+                    num_log_events,
+                    (
+                        (
+                            ref_timestamps[::index_interval],
+                            list(range(0, num_log_events, index_interval)),
+                        )
+                        if 0 != index_interval
+                        else None
+                    ),
+                ),
+                self._scan_log_stream_timestamps(log_path, index_interval),
+                f"Seed: {seed}, Index interval: {index_interval}",
+            )
+
             query: Optional[Query] = None
             if self.has_query:
                 query, ref_log_events = self._generate_random_query(ref_log_events)
@@ -224,6 +391,46 @@ class TestCaseFourByteDeserializerBase(TestCLPBase):
                 ref_metadata, ref_log_events, metadata, log_events, log_path, seed
             )
 
+            for max_events in [1, 7, num_log_events, 2 * num_log_events]:
+                metadata, log_events = self._deserialize_log_stream_in_batches(
+                    log_path, query, max_events
+                )
+                self._validate_deserialized_logs(
+                    ref_metadata, ref_log_events, metadata, log_events, log_path, seed
+                )
+
+            num_matches: int
+            match_indices: List[int]
+            num_matches, match_indices = self._scan_log_stream_matches(log_path, query)
+            self.assertEqual(len(ref_log_events), num_matches, f"Seed: {seed}")
+            self.assertEqual(
+                [log_event.get_index() for log_event in ref_log_events],
+                match_indices,
+                f"Seed: {seed}",
+            )
+
+            self.assertEqual(
+                (
+                    len(ref_log_events),
+                    [
+                        (log_event.get_log_message(), log_event.get_timestamp())
+                        for log_event in ref_log_events
+                    ],
+                ),
+                self._filter_log_stream(log_path, query),
+                f"Seed: {seed}",
+            )
+
+            bucket_ms: int = random.choice([1, 1000, 60 * 1000])
+            ref_histogram: Dict[int, int] = Counter(
+                log_event.get_timestamp() // bucket_ms * bucket_ms for log_event in ref_log_events
+            )
+            self.assertEqual(
+                ref_histogram,
+                self._compute_log_stream_histogram(log_path, query, bucket_ms),
+                f"Seed: {seed}, Bucket size: {bucket_ms}",
+            )
+
 
 class TestCaseFourByteDeserializerDecompress(TestCaseFourByteDeserializerBase):
     """
@@ -434,3 +641,185 @@ class TestCaseFourByteDeserializerTimeRangeWildcardQueryZstd(
         self.has_query = True
         self.num_test_iterations = 10
         super().setUp()
+
+
+class TestCaseFourByteDeserializerVariableWildcardQuery(TestCaseFourByteDeserializerBase):
+    """
+    Tests serialization/deserialization methods against uncompressed IR stream with wildcard queries
+    that match static text only, variables only, and both. Log events are matched against the
+    queries using their encoded logtypes before being decoded, so these queries cover the log
+    events that always match, never match, and need to be decoded to match.
+    """
+
+    wildcard_queries: List[WildcardQuery] = [
+        SubstringWildcardQuery("Final Stats: PendingReds:"),
+        SubstringWildcardQuery("final STATS", case_sensitive=False),
+        SubstringWildcardQuery("Final Stats", case_sensitive=True),
+        SubstringWildcardQuery("ScheduledMaps:1"),
+        SubstringWildcardQuery("ScheduledMaps:-?? "),
+        SubstringWildcardQuery("jvm_1427088391284_0034"),
+        SubstringWildcardQuery("Progress of TaskAttempt*is : 1"),
+        SubstringWildcardQuery("usedCapacity=*used=<memory:2"),
+        SubstringWildcardQuery("container_1427088391284_0034_01_000074: 1"),
+        SubstringWildcardQuery("Transfer took ip-172-31-17-96 at"),
+        SubstringWildcardQuery(r"Transfer\ took*KB/s"),
+        SubstringWildcardQuery(r"RESET\)*KV \?", case_sensitive=False),
+        SubstringWildcardQuery("mapred.MapTask: (RESET) equator"),
+        FullStringWildcardQuery("org.apache.hadoop.hdfs.server.namenode.*KB/s\n"),
+        FullStringWildcardQuery("org.apache.hadoop.hdfs.server.namenode.*KB/s"),
+        FullStringWildcardQuery("? org.apache.hadoop.mapred.*"),
+        SubstringWildcardQuery("No log event contains this"),
+    ]
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = False
+        self.has_query = True
+        self.num_test_iterations = 10
+        super().setUp()
+
+    # override
+    def _generate_random_query(
+        self, ref_log_events: List[LogEvent]
+    ) -> Tuple[Query, List[LogEvent]]:
+        wildcard_queries: List[WildcardQuery] = random.sample(
+            TestCaseFourByteDeserializerVariableWildcardQuery.wildcard_queries,
+            random.randint(1, 3),
+        )
+        query: Query = Query(wildcard_queries=wildcard_queries)
+        matched_log_events: List[LogEvent] = []
+        for log_event in ref_log_events:
+            if not log_event.match_query(query):
+                continue
+            matched_log_events.append(log_event)
+        return query, matched_log_events
+
+
+class TestCaseFourByteDeserializerLogtypeCacheEviction(TestCLPBase):
+    """
+    Tests searching an IR stream with more distinct logtypes than the native logtype matcher caches,
+    so that cached results are evicted and the evicted logtypes are matched again later.
+    """
+
+    # The capacity of the native logtype matcher's result cache.
+    logtype_cache_capacity: int = 4096
+
+    @staticmethod
+    def _get_word(value: int) -> str:
+        """
+        :param value:
+        :return: A word of lowercase letters uniquely representing `value`, so that it is part of
+        the logtype instead of being encoded as a variable.
+        """
+        letters: List[str] = []
+        while True:
+            value, remainder = divmod(value, 26)
+            letters.append(chr(ord("a") + remainder))
+            if 0 == value:
+                return "".join(letters)
+
+    def test_logtype_cache_eviction(self) -> None:
+        num_logtypes: int = TestCaseFourByteDeserializerLogtypeCacheEviction.logtype_cache_capacity
+        num_logtypes += num_logtypes // 4
+        timestamp: int = get_current_timestamp()
+        log_messages: List[str] = [
+            f"Event {self._get_word(idx % num_logtypes)} handled by worker {idx}\n"
+            for idx in range(2 * num_logtypes + 100)
+        ]
+        ir_stream: bytearray = FourByteSerializer.serialize_preamble(
+            timestamp, "yyyy-MM-dd HH:mm:ss.SSS", "America/Toronto"
+        )
+        for log_message in log_messages:
+            ir_stream += FourByteSerializer.serialize_message_and_timestamp_delta(
+                1, log_message.encode()
+            )
+        ir_stream += FourByteSerializer.serialize_end_of_ir()
+
+        # Includes queries whose results are decided by the logtype alone, and queries whose
+        # results depend on the variables.
+        query: Query = Query(
+            wildcard_queries=[
+                SubstringWildcardQuery("Event ab "),
+                SubstringWildcardQuery("Event *c handled by worker 1?7\n"),
+                FullStringWildcardQuery("Event ?d handled*"),
+            ]
+        )
+        expected_indices: List[int] = [
+            idx
+            for idx, log_message in enumerate(log_messages)
+            if LogEvent(log_message, timestamp + idx + 1).match_query(query)
+        ]
+        self.assertNotEqual(0, len(expected_indices))
+
+        deserializer_buffer: DeserializerBuffer = DeserializerBuffer(BytesIO(ir_stream))
+        FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+        indices: List[int] = []
+        while True:
+            log_event: Optional[LogEvent] = FourByteDeserializer.deserialize_next_log_event(
+                deserializer_buffer, query
+            )
+            if log_event is None:
+                break
+            self.assertEqual(log_messages[log_event.get_index()], log_event.get_log_message())
+            indices.append(log_event.get_index())
+        self.assertEqual(expected_indices, indices)
+
+
+class TestCaseEightByteDeserializer(TestCLPBase):
+    """
+    Class for testing clp_ffi_py.ir.EightByteDeserializer against streams serialized by
+    clp_ffi_py.ir.EightByteSerializer.
+    """
+
+    def test_serder(self) -> None:
+        timestamp_format: str = "yyyy-MM-dd HH:mm:ss.SSS"
+        timezone: str = "America/Toronto"
+        timestamp: int = get_current_timestamp()
+        log_messages: List[str] = [
+            "This is a test message: Do NOT Reply!\n",
+            f"Integer variable beyond four-byte range: {2**40 + 7}\n",
+            "Float variable: 3.1415926, dictionary variable: user_id=0x7f3a\n",
+            "Negative integer variable: -9223372036854775808\n",
+        ]
+
+        ir_stream: bytearray = EightByteSerializer.serialize_preamble(timestamp_format, timezone)
+        timestamps: List[int] = []
+        for idx, log_message in enumerate(log_messages):
+            timestamps.append(timestamp + idx * 1000)
+            ir_stream += EightByteSerializer.serialize_message_and_timestamp(
+                timestamps[-1], log_message.encode()
+            )
+        ir_stream += EightByteSerializer.serialize_end_of_ir()
+
+        deserializer_buffer: DeserializerBuffer = DeserializerBuffer(BytesIO(ir_stream))
+        metadata: Metadata = EightByteDeserializer.deserialize_preamble(deserializer_buffer)
+        self.assertFalse(metadata.is_using_four_byte_encoding())
+        self.assertEqual(metadata.get_timestamp_format(), timestamp_format)
+        self.assertEqual(metadata.get_timezone_id(), timezone)
+
+        log_event: Optional[LogEvent] = EightByteDeserializer.deserialize_next_log_event(
+            deserializer_buffer
+        )
+        assert None is not log_event
+        self.assertEqual(log_event.get_log_message(), log_messages[0])
+        self.assertEqual(log_event.get_timestamp(), timestamps[0])
+
+        log_events: List[LogEvent] = EightByteDeserializer.deserialize_next_log_events(
+            deserializer_buffer, len(log_messages)
+        )
+        self.assertEqual(len(log_events), len(log_messages) - 1)
+        for idx, log_event in enumerate(log_events, start=1):
+            self.assertEqual(log_event.get_log_message(), log_messages[idx])
+            self.assertEqual(log_event.get_timestamp(), timestamps[idx])
+            self.assertEqual(log_event.get_index(), idx)
+
+    def test_encoding_mismatch(self) -> None:
+        ir_stream: bytearray = FourByteSerializer.serialize_preamble(
+            get_current_timestamp(), "yyyy-MM-dd HH:mm:ss.SSS", "America/Toronto"
+        )
+        ir_stream += FourByteSerializer.serialize_end_of_ir()
+        deserializer_buffer: DeserializerBuffer = DeserializerBuffer(BytesIO(ir_stream))
+        metadata: Metadata = FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+        self.assertTrue(metadata.is_using_four_byte_encoding())
+        with self.assertRaises(RuntimeError):
+            EightByteDeserializer.deserialize_next_log_event(deserializer_buffer)
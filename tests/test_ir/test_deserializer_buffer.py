@@ -1,12 +1,13 @@
 import io
+import mmap
 import random
 from pathlib import Path
-from typing import Optional
+from typing import Any, List, Optional
 
 from smart_open import open  # type: ignore
 from test_ir.test_utils import TestCLPBase
 
-from clp_ffi_py.ir import DeserializerBuffer
+from clp_ffi_py.ir import DeserializerBuffer, FourByteDeserializer
 
 
 class TestCaseDeserializerBuffer(TestCLPBase):
@@ -52,12 +53,181 @@ class TestCaseDeserializerBuffer(TestCLPBase):
         buffer_capacity: int = 16384
         self.__launch_test(buffer_capacity)
 
-    def __launch_test(self, buffer_capacity: Optional[int]) -> None:
+    def test_streaming_bounded_buffer(self) -> None:
+        """
+        Tests DeserializerBuffer's functionality with a bounded buffer capacity.
+        """
+        buffer_capacity: int = 1024
+        self.__launch_test(buffer_capacity, buffer_capacity)
+        self.__launch_test(buffer_capacity, 4 * buffer_capacity)
+
+    def test_max_buffer_capacity(self) -> None:
+        """
+        Tests that DeserializerBuffer fails to buffer an IR unit larger than its maximum capacity,
+        and rejects a maximum capacity less than the initial capacity.
+        """
+        current_dir: Path = Path(__file__).resolve().parent
+        file_path: Path = (
+            current_dir
+            / TestCaseDeserializerBuffer.deserializer_buffer_test_data_dir
+            / "rand_hadoop_log.clp"
+        )
+        with open(str(file_path), "rb") as istream:
+            deserializer_buffer: DeserializerBuffer = DeserializerBuffer(
+                istream, initial_buffer_capacity=4, max_buffer_capacity=8
+            )
+            with self.assertRaises(RuntimeError):
+                FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+        with self.assertRaises(ValueError):
+            DeserializerBuffer(b"", initial_buffer_capacity=8, max_buffer_capacity=4)
+
+    def test_streaming_buffer_view(self) -> None:
+        """
+        Tests DeserializerBuffer's functionality when reading in place from a path or an object
+        supporting the buffer protocol.
+        """
+        current_dir: Path = Path(__file__).resolve().parent
+        test_data_dir: Path = (
+            current_dir / TestCaseDeserializerBuffer.deserializer_buffer_test_data_dir
+        )
+        for file_path in test_data_dir.rglob("*"):
+            if not file_path.is_file():
+                continue
+            ref_result: bytearray = bytearray(file_path.read_bytes())
+            with file_path.open("rb") as f:
+                mapped_file: mmap.mmap = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+            inputs: List[Any] = [str(file_path), file_path, bytes(ref_result), mapped_file]
+            for input_obj in inputs:
+                random_seed: int = random.randint(1, 3190)
+                deserializer_buffer: DeserializerBuffer = DeserializerBuffer(input_obj)
+                streaming_result: bytearray = deserializer_buffer._test_streaming(random_seed)
+                self.assertEqual(
+                    ref_result,
+                    streaming_result,
+                    f"Streaming result is different from the src: {file_path}. Input type:"
+                    f" {type(input_obj)}. Random seed: {random_seed}.",
+                )
+                del deserializer_buffer
+            mapped_file.close()
+
+    def test_streaming_readahead(self) -> None:
+        """
+        Tests DeserializerBuffer's functionality when reading from a path or an object supporting
+        the buffer protocol through a native readahead thread.
+        """
+        current_dir: Path = Path(__file__).resolve().parent
+        test_data_dir: Path = (
+            current_dir / TestCaseDeserializerBuffer.deserializer_buffer_test_data_dir
+        )
+        for file_path in test_data_dir.rglob("*"):
+            if not file_path.is_file():
+                continue
+            ref_result: bytearray = bytearray(file_path.read_bytes())
+            inputs: List[Any] = [str(file_path), bytes(ref_result)]
+            for input_obj in inputs:
+                for buffer_capacity, num_readahead_buffers in [(16, 2), (97, 3), (4096, 8)]:
+                    random_seed: int = random.randint(1, 3190)
+                    deserializer_buffer: DeserializerBuffer = DeserializerBuffer(
+                        input_obj,
+                        initial_buffer_capacity=buffer_capacity,
+                        num_readahead_buffers=num_readahead_buffers,
+                    )
+                    streaming_result: bytearray = deserializer_buffer._test_streaming(random_seed)
+                    self.assertEqual(
+                        ref_result,
+                        streaming_result,
+                        f"Streaming result is different from the src: {file_path}. Input type:"
+                        f" {type(input_obj)}. Buffer capacity: {buffer_capacity}. Number of"
+                        f" readahead buffers: {num_readahead_buffers}. Random seed: {random_seed}.",
+                    )
+                    del deserializer_buffer
+
+    def test_readahead_invalid_arguments(self) -> None:
+        """
+        Tests that readahead rejects invalid numbers of buffers and unsupported inputs.
+        """
+        with self.assertRaises(ValueError):
+            DeserializerBuffer(b"", num_readahead_buffers=1)
+        with self.assertRaises(ValueError):
+            DeserializerBuffer(b"", num_readahead_buffers=-2)
+        with self.assertRaises(TypeError):
+            DeserializerBuffer(io.BytesIO(b""), num_readahead_buffers=2)
+
+    def test_reentrant_access(self) -> None:
+        """
+        Tests that DeserializerBuffer can't be accessed by another deserialization method while it's
+        in use, e.g., from the input stream that it reads from.
+        """
+        current_dir: Path = Path(__file__).resolve().parent
+        file_path: Path = (
+            current_dir
+            / TestCaseDeserializerBuffer.deserializer_buffer_test_data_dir
+            / "rand_hadoop_log.clp"
+        )
+
+        test_case: TestCaseDeserializerBuffer = self
+
+        class ReentrantInputStream(io.BytesIO):
+            is_preamble_deserialized: bool = False
+            num_reentrant_calls: int = 0
+
+            def readinto(self, buffer: Any) -> int:
+                if self.is_preamble_deserialized:
+                    with test_case.assertRaises(RuntimeError):
+                        FourByteDeserializer.deserialize_next_log_event(deserializer_buffer)
+                    self.num_reentrant_calls += 1
+                return super().readinto(buffer)
+
+        input_stream: ReentrantInputStream = ReentrantInputStream(file_path.read_bytes())
+        deserializer_buffer: DeserializerBuffer = DeserializerBuffer(
+            input_stream, initial_buffer_capacity=1024
+        )
+        FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+        input_stream.is_preamble_deserialized = True
+        num_log_events: int = 0
+        while FourByteDeserializer.deserialize_next_log_event(deserializer_buffer) is not None:
+            num_log_events += 1
+        self.assertGreater(num_log_events, 0)
+        self.assertGreater(input_stream.num_reentrant_calls, 0)
+
+    def test_reentrant_dump(self) -> None:
+        """
+        Tests that DeserializerBuffer can't be accessed by another deserialization method from the
+        output stream that `dump` writes to.
+        """
+        current_dir: Path = Path(__file__).resolve().parent
+        file_path: Path = (
+            current_dir
+            / TestCaseDeserializerBuffer.deserializer_buffer_test_data_dir
+            / "rand_hadoop_log.clp"
+        )
+        deserializer_buffer: DeserializerBuffer = DeserializerBuffer(file_path)
+        FourByteDeserializer.deserialize_preamble(deserializer_buffer)
+
+        test_case: TestCaseDeserializerBuffer = self
+
+        class ReentrantOutputStream(io.BytesIO):
+            def write(self, data: Any) -> int:
+                with test_case.assertRaises(RuntimeError):
+                    FourByteDeserializer.deserialize_next_log_event(deserializer_buffer)
+                return super().write(data)
+
+        output_stream: ReentrantOutputStream = ReentrantOutputStream()
+        num_log_events: int = FourByteDeserializer.dump(deserializer_buffer, output_stream)
+        self.assertGreater(num_log_events, 0)
+        self.assertGreater(len(output_stream.getvalue()), 0)
+        self.assertIsNone(FourByteDeserializer.deserialize_next_log_event(deserializer_buffer))
+
+    def __launch_test(
+        self, buffer_capacity: Optional[int], max_buffer_capacity: Optional[int] = None
+    ) -> None:
         """
         Tests the DeserializerBuffer by streaming the files inside `test_src_dir`.
 
         :param self
         :param buffer_capacity: The buffer capacity used to initialize the deserializer buffer.
+        :param max_buffer_capacity: The maximum buffer capacity used to initialize the deserializer
+            buffer.
         """
         current_dir: Path = Path(__file__).resolve().parent
         test_data_dir: Path = (
@@ -78,7 +248,9 @@ class TestCaseDeserializerBuffer(TestCLPBase):
                             deserializer_buffer = DeserializerBuffer(istream)
                         else:
                             deserializer_buffer = DeserializerBuffer(
-                                initial_buffer_capacity=buffer_capacity, input_stream=istream
+                                initial_buffer_capacity=buffer_capacity,
+                                input_stream=istream,
+                                max_buffer_capacity=max_buffer_capacity,
                             )
                         streaming_result = deserializer_buffer._test_streaming(random_seed)
                     except Exception as e:
@@ -1,11 +1,13 @@
 import pickle
 from datetime import tzinfo
-from typing import Optional
+from typing import List, Optional
 
 import dateutil.tz
 from test_ir.test_utils import TestCLPBase
 
-from clp_ffi_py.ir import LogEvent, Metadata
+from clp_ffi_py.ir import LogEvent, Metadata, Query
+from clp_ffi_py.utils import get_formatted_timestamp
+from clp_ffi_py.wildcard_query import SubstringWildcardQuery
 
 
 class TestCaseLogEvent(TestCLPBase):
@@ -107,6 +109,97 @@ class TestCaseLogEvent(TestCLPBase):
             f"Raw message: {formatted_message}; Expected: {expected_formatted_message}",
         )
 
+    def test_formatted_timestamp(self) -> None:
+        """
+        Test that the natively formatted timestamps match the ones formatted by Python's datetime,
+        for consecutive log events within the same second and across UTC offset transitions.
+        """
+        log_message: str = " This is a test log message"
+        metadata: Metadata = Metadata(0, "yy/MM/dd HH:mm:ss", "America/New_York")
+        test_tz: Optional[tzinfo] = dateutil.tz.gettz("America/New_York")
+        assert test_tz is not None
+        # 2023-03-12 06:59:59.000 UTC is one second before the DST transition in New York.
+        dst_transition_timestamp: int = 1678604399000
+        timestamps: List[int] = [
+            dst_transition_timestamp,
+            dst_transition_timestamp + 1,
+            dst_transition_timestamp + 999,
+            dst_transition_timestamp + 1000,
+            dst_transition_timestamp + 1001,
+            0,
+            -1,
+            -86400001,
+            932724000123,
+            2005689603190,
+        ]
+        for timestamp in timestamps:
+            log_event: LogEvent = LogEvent(log_message, timestamp, 0, metadata)
+            expected_formatted_message: str = (
+                f"{get_formatted_timestamp(timestamp, test_tz)}{log_message}"
+            )
+            self.assertEqual(expected_formatted_message, log_event.get_formatted_message(test_tz))
+            self.assertEqual(expected_formatted_message, log_event.get_formatted_message())
+            self.assertEqual(
+                f"{get_formatted_timestamp(timestamp, None)}{log_message}",
+                LogEvent(log_message, timestamp).get_formatted_message(),
+            )
+
+    def test_formatted_timestamp_out_of_range(self) -> None:
+        """
+        Test that formatting timestamps whose dates are out of the range supported by Python's
+        datetime raises the same exceptions as datetime: a ValueError if the date in UTC is out of
+        range, or an OverflowError if only the date in the local time of the timezone is.
+        """
+        log_message: str = " This is a test log message"
+        metadata: Metadata = Metadata(0, "yy/MM/dd HH:mm:ss", "America/New_York")
+        # 9999-12-31 23:59:59.999 UTC and 0001-01-01 00:00:00.000 UTC.
+        max_timestamp: int = 253402300799999
+        min_timestamp: int = -62135596800000
+        self.assertEqual(
+            f"{get_formatted_timestamp(max_timestamp, None)}{log_message}",
+            LogEvent(log_message, max_timestamp).get_formatted_message(),
+        )
+        self.assertEqual(
+            f"{get_formatted_timestamp(min_timestamp, None)}{log_message}",
+            LogEvent(log_message, min_timestamp).get_formatted_message(),
+        )
+        for timestamp in [max_timestamp + 1, min_timestamp - 1000, 2**63 - 1, -(2**63)]:
+            with self.assertRaises(ValueError):
+                LogEvent(log_message, timestamp).get_formatted_message()
+            with self.assertRaises(ValueError):
+                LogEvent(log_message, timestamp, 0, metadata).get_formatted_message()
+        # The date of the minimum timestamp is out of range in the local time of New York.
+        with self.assertRaises(OverflowError):
+            LogEvent(log_message, min_timestamp, 0, metadata).get_formatted_message()
+
+    def test_cached_strings(self) -> None:
+        """
+        Test that the Python strings of the log message and the default formatted message are
+        cached, and that log messages with embedded NUL characters are preserved.
+
+        Once the Python string of the log message is cached, the native copy is released, so the
+        formatted message and query matching must read the log message from the cached string.
+        """
+        log_message: str = " This is a test log message with a \x00 in it"
+        timestamp: int = 932724000000
+        log_event = LogEvent(log_message, timestamp)
+        self.assertEqual(log_message, log_event.get_log_message())
+        self.assertIs(log_event.get_log_message(), log_event.get_log_message())
+        self.assertTrue(
+            log_event.match_query(Query(wildcard_queries=[SubstringWildcardQuery("\x00 in it")]))
+        )
+
+        expected_formatted_message: str = f"1999-07-23 10:00:00.000+00:00{log_message}"
+        self.assertEqual(expected_formatted_message, log_event.get_formatted_message())
+        self.assertIs(log_event.get_formatted_message(), log_event.get_formatted_message())
+        self.assertIs(str(log_event), str(log_event))
+
+        reconstructed_log_event: LogEvent = pickle.loads(pickle.dumps(log_event))
+        self.assertEqual(log_message, reconstructed_log_event.get_log_message())
+        self.assertEqual(
+            expected_formatted_message, reconstructed_log_event.get_formatted_message()
+        )
+
     def test_pickle(self) -> None:
         """
         Test the reconstruction of LogEvent object from pickling data.
@@ -1,10 +1,10 @@
 from datetime import tzinfo
-from typing import Optional
+from typing import List, Optional, Tuple
 
 import dateutil.tz
 from test_ir.test_utils import TestCLPBase
 
-from clp_ffi_py.ir import Metadata
+from clp_ffi_py.ir import LogEvent, Metadata
 
 
 class TestCaseMetadata(TestCLPBase):
@@ -58,3 +58,36 @@ class TestCaseMetadata(TestCLPBase):
         self.assertEqual(wrong_tz is not metadata.get_timezone(), True)
 
         self._check_metadata(metadata, ref_timestamp, timestamp_format, timezone_id)
+
+    def test_native_timezone(self) -> None:
+        """
+        Test the timestamps formatted with the timezone of the metadata across UTC offset
+        transitions, including the ones derived from the POSIX TZ rules of the timezone database.
+        """
+        timestamp_format: str = "yy/MM/dd HH:mm:ss"
+        test_cases: List[Tuple[str, int, str]] = [
+            ("America/New_York", 1678604399999, "2023-03-12 01:59:59.999-05:00"),
+            ("America/New_York", 1678604400000, "2023-03-12 03:00:00.000-04:00"),
+            ("America/New_York", 1699164000000, "2023-11-05 01:00:00.000-05:00"),
+            ("America/New_York", 4118083200000, "2100-06-30 20:00:00.000-04:00"),
+            ("Australia/Sydney", 1680364799999, "2023-04-02 02:59:59.999+11:00"),
+            ("Australia/Sydney", 1680364800000, "2023-04-02 02:00:00.000+10:00"),
+            ("Asia/Kolkata", 0, "1970-01-01 05:30:00.000+05:30"),
+            ("Pacific/Chatham", 1700000000000, "2023-11-15 11:58:20.000+13:45"),
+            ("Europe/London", 4118083200000, "2100-07-01 01:00:00.000+01:00"),
+        ]
+        for timezone_id, timestamp, expected_formatted_timestamp in test_cases:
+            metadata: Metadata = Metadata(0, timestamp_format, timezone_id)
+            log_event: LogEvent = LogEvent(" Test", timestamp, 0, metadata)
+            self.assertEqual(
+                f"{expected_formatted_timestamp} Test",
+                log_event.get_formatted_message(),
+                f"Timezone: {timezone_id}",
+            )
+
+    def test_invalid_timezone(self) -> None:
+        """
+        Test that an invalid timezone id is rejected.
+        """
+        with self.assertRaises(RuntimeError):
+            Metadata(0, "yy/MM/dd HH:mm:ss", "Invalid/Timezone_Id")
@@ -362,3 +362,60 @@ class TestCaseQuery(TestCLPBase):
         log_event = LogEvent("I'm finally matching something... QAQ", 3213)
         self.assertEqual(query.match_log_event(log_event), True, description)
         self.assertEqual(log_event.match_query(query), True, description)
+
+    def test_matching_wildcard_query_indices(self) -> None:
+        """
+        Test finding the indices of the wildcard queries that match a log event, with both a few
+        wildcard queries and enough wildcard queries to be matched by searching their literals in
+        a single pass.
+        """
+        signatures: List[str] = [
+            "connection reset by peer",
+            "OutOfMemoryError",
+            "disk quota exceeded",
+            "segfault at",
+            "timed out after * ms",
+            "checksum mismatch on block ?",
+            "permission denied",
+            "too many open files",
+        ]
+        wildcard_queries: List[WildcardQuery] = [
+            SubstringWildcardQuery(signature) for signature in signatures
+        ]
+        wildcard_queries.append(SubstringWildcardQuery("OUTOFMEMORYERROR", case_sensitive=True))
+        wildcard_queries.append(FullStringWildcardQuery("*"))
+        wildcard_queries.append(SubstringWildcardQuery("Killed?process"))
+
+        log_messages: List[str] = [
+            "java.lang.OutOfMemoryError: Java heap space",
+            "read timed out after 3000 ms: connection reset by peer",
+            "kernel: Killed process 42; too many open files",
+            "DataNode: checksum mismatch on block 7",
+            "nothing interesting here",
+        ]
+        for num_wildcard_queries in [1, 3, len(wildcard_queries)]:
+            query: Query = Query(wildcard_queries=wildcard_queries[:num_wildcard_queries])
+            for log_message in log_messages:
+                log_event: LogEvent = LogEvent(log_message, 0)
+                expected_indices: List[int] = [
+                    idx
+                    for idx, wildcard_query in enumerate(wildcard_queries[:num_wildcard_queries])
+                    if log_event.match_query(Query(wildcard_queries=[wildcard_query]))
+                ]
+                description: str = f"Log message: {log_message}, Query: {query}"
+                self.assertEqual(
+                    query.get_matching_wildcard_query_indices(log_event),
+                    expected_indices,
+                    description,
+                )
+                self.assertEqual(
+                    query.match_log_event(log_event), 0 != len(expected_indices), description
+                )
+
+        query = Query(wildcard_queries=wildcard_queries)
+        self.assertEqual(
+            query.get_matching_wildcard_query_indices(LogEvent(log_messages[2], 0)), [7, 9, 10]
+        )
+        self.assertEqual(
+            query.get_matching_wildcard_query_indices(LogEvent(log_messages[4], 0)), [9]
+        )
@@ -1,31 +1,45 @@
+import unittest
+from io import BytesIO, StringIO, TextIOWrapper
 from pathlib import Path
+from tempfile import TemporaryFile
 from typing import List, Optional, Tuple
 
+import dateutil.tz
+
 from test_ir.test_deserializer import (
     TestCaseFourByteDeserializerBase,
     TestCaseFourByteDeserializerTimeRangeQueryBase,
     TestCaseFourByteDeserializerTimeRangeWildcardQueryBase,
     TestCaseFourByteDeserializerWildcardQueryBase,
 )
-from test_ir.test_utils import TestCLPBase
+from test_ir.test_utils import is_native_zstd_decompression_supported, TestCLPBase
 
 from clp_ffi_py.ir import (
     ClpIrFileReader,
     ClpIrStreamReader,
+    FourByteSerializer,
     IncompleteStreamError,
     LogEvent,
     Metadata,
     Query,
 )
+from clp_ffi_py.wildcard_query import SubstringWildcardQuery
 
 
 def read_log_stream(
-    log_path: Path, query: Optional[Query], enable_compression: bool
+    log_path: Path,
+    query: Optional[Query],
+    enable_compression: bool,
+    enable_native_decompression: bool = False,
 ) -> Tuple[Metadata, List[LogEvent]]:
     metadata: Metadata
     log_events: List[LogEvent] = []
     with open(str(log_path), "rb") as fin:
-        reader = ClpIrStreamReader(fin, enable_compression=enable_compression)
+        reader = ClpIrStreamReader(
+            fin,
+            enable_compression=enable_compression,
+            enable_native_decompression=enable_native_decompression,
+        )
         if None is query:
             for log_event in reader:
                 log_events.append(log_event)
@@ -97,6 +111,30 @@ class TestCaseReaderDecompressZstd(TestCaseReaderBase):
         super().setUp()
 
 
+@unittest.skipUnless(
+    is_native_zstd_decompression_supported(), "Native zstd decompression isn't supported."
+)
+class TestCaseReaderDecompressNativeZstd(TestCaseReaderBase):
+    """
+    Tests stream reader against zstd compressed IR stream using native decompression.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = True
+        self.has_query = False
+        self.num_test_iterations = 10
+        super().setUp()
+
+    # override
+    def _deserialize_log_stream(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[Metadata, List[LogEvent]]:
+        return read_log_stream(
+            log_path, query, self.enable_compression, enable_native_decompression=True
+        )
+
+
 class TestCaseReaderTimeRangeQuery(TestCaseReaderTimeRangeQueryBase):
     """
     Tests stream reader against uncompressed IR stream with the query that specifies a search
@@ -181,6 +219,164 @@ class TestCaseReaderTimeRangeWildcardQueryZstd(TestCaseReaderTimeRangeWildcardQu
         super().setUp()
 
 
+class TestReaderBatching(TestCLPBase):
+    """
+    Tests that the reader returns the same log events regardless of how they are batched.
+    """
+
+    test_src: Path = Path(__file__).resolve().parent / "test_data/unstructured_ir/benchmark.clp"
+
+    def test_batch_sizes(self) -> None:
+        """
+        Tests iterating the reader with different batch sizes, and searching after a partially
+        consumed batch.
+        """
+        with ClpIrFileReader(
+            TestReaderBatching.test_src, enable_compression=False, log_event_batch_size=1
+        ) as clp_reader:
+            ref_log_events: List[str] = [str(log_event) for log_event in clp_reader]
+        self.assertNotEqual(0, len(ref_log_events))
+
+        for batch_size in [7, 256, len(ref_log_events) + 1]:
+            with ClpIrFileReader(
+                TestReaderBatching.test_src,
+                enable_compression=False,
+                log_event_batch_size=batch_size,
+            ) as clp_reader:
+                log_events: List[str] = []
+                # Read part of the first batch, and search for the rest.
+                for _ in range(3):
+                    log_event: Optional[LogEvent] = clp_reader.read_next_log_event()
+                    assert log_event is not None
+                    log_events.append(str(log_event))
+                log_events.extend(str(log_event) for log_event in clp_reader.search(Query()))
+            self.assertEqual(ref_log_events, log_events, f"Batch size: {batch_size}")
+
+
+class TestReaderLazyDecoding(TestCLPBase):
+    """
+    Tests that the log messages of the deserialized log events are decoded correctly on request.
+    """
+
+    test_src: Path = Path(__file__).resolve().parent / "test_data/unstructured_ir/benchmark.clp"
+
+    def test_lazy_decoding(self) -> None:
+        """
+        Tests accessing the log messages of the log events only after the entire stream is read, so
+        that the reader's buffer has been reused.
+        """
+        test_src: Path = TestReaderLazyDecoding.test_src
+        with ClpIrFileReader(test_src, enable_compression=False) as clp_reader:
+            string_stream: StringIO = StringIO()
+            clp_reader.dump(string_stream)
+        ref_text: str = string_stream.getvalue()
+
+        query: Query = Query(wildcard_queries=[SubstringWildcardQuery("INFO")])
+        with ClpIrFileReader(test_src, enable_compression=False) as clp_reader:
+            log_events: List[LogEvent] = list(clp_reader)
+        with ClpIrFileReader(test_src, enable_compression=False) as clp_reader:
+            matched_log_events: List[LogEvent] = list(clp_reader.search(query))
+        self.assertNotEqual(0, len(log_events))
+
+        self.assertEqual(list(range(len(log_events))), [e.get_index() for e in log_events])
+        self.assertEqual(
+            [e.get_index() for e in matched_log_events],
+            [e.get_index() for e in log_events if query.match_log_event(e)],
+        )
+        self.assertEqual(ref_text, "".join(str(log_event) for log_event in log_events))
+        self.assertEqual(
+            [e.get_log_message() for e in matched_log_events],
+            [e.get_log_message() for e in log_events if "INFO" in e.get_log_message()],
+        )
+
+
+class TestReaderDump(TestCLPBase):
+    """
+    Tests dumping log events from the reader into different types of outputs.
+    """
+
+    test_src: Path = Path(__file__).resolve().parent / "test_data/unstructured_ir/benchmark.clp"
+
+    def test_dump(self) -> None:
+        """
+        Tests that dumping the log events produces the same text as formatting each log event, for
+        different outputs, timezones, and queries.
+        """
+        timezone = dateutil.tz.gettz("America/New_York")
+        query: Query = Query(wildcard_queries=[SubstringWildcardQuery("INFO")])
+        for dump_timezone, dump_query in [(None, None), (timezone, None), (None, query)]:
+            with ClpIrFileReader(TestReaderDump.test_src, enable_compression=False) as clp_reader:
+                log_events: List[LogEvent] = (
+                    list(clp_reader)
+                    if dump_query is None
+                    else list(clp_reader.search(dump_query))
+                )
+            ref_text: str = "".join(
+                log_event.get_formatted_message(dump_timezone) for log_event in log_events
+            )
+            self.assertNotEqual(0, len(log_events))
+
+            with ClpIrFileReader(TestReaderDump.test_src, enable_compression=False) as clp_reader:
+                string_stream: StringIO = StringIO()
+                self.assertEqual(
+                    len(log_events), clp_reader.dump(string_stream, dump_timezone, dump_query)
+                )
+                self.assertEqual(ref_text, string_stream.getvalue())
+
+            with ClpIrFileReader(TestReaderDump.test_src, enable_compression=False) as clp_reader:
+                byte_stream: BytesIO = BytesIO()
+                text_stream: TextIOWrapper = TextIOWrapper(byte_stream, encoding="utf-8")
+                # Consume part of the first batch before dumping the rest.
+                first_log_event: Optional[LogEvent] = clp_reader.read_next_log_event()
+                assert first_log_event is not None
+                num_expected_log_events: int = len(log_events)
+                if dump_query is None or dump_query.match_log_event(first_log_event):
+                    text_stream.write(first_log_event.get_formatted_message(dump_timezone))
+                    num_expected_log_events -= 1
+                self.assertEqual(
+                    num_expected_log_events,
+                    clp_reader.dump(text_stream, dump_timezone, dump_query),
+                )
+                text_stream.flush()
+                self.assertEqual(ref_text, byte_stream.getvalue().decode())
+
+            with ClpIrFileReader(
+                TestReaderDump.test_src, enable_compression=False
+            ) as clp_reader, TemporaryFile() as temp_file:
+                clp_reader.dump(temp_file.fileno(), dump_timezone, dump_query)
+                temp_file.seek(0)
+                self.assertEqual(ref_text, temp_file.read().decode())
+
+    def test_dump_text_stream_in_chunks(self) -> None:
+        """
+        Tests that dumping into a text stream without an underlying UTF-8 byte stream writes the
+        text in chunks instead of all at once, including multi-byte characters split across chunks.
+        """
+        ref_timestamp: int = 1_700_000_000_000
+        ir_stream: bytearray = FourByteSerializer.serialize_preamble(ref_timestamp, "", "UTC")
+        for i in range(40_000):
+            ir_stream += FourByteSerializer.serialize_message_and_timestamp_delta(
+                1, f"Log message {i} with multi-byte characters: \u00e9\u4e2d\U0001f600\n".encode()
+            )
+        ir_stream += FourByteSerializer.serialize_end_of_ir()
+
+        with ClpIrStreamReader(BytesIO(ir_stream), enable_compression=False) as clp_reader:
+            ref_text: str = "".join(str(log_event) for log_event in clp_reader)
+
+        class RecordingStringIO(StringIO):
+            num_writes: int = 0
+
+            def write(self, text: str) -> int:
+                self.num_writes += 1
+                return super().write(text)
+
+        string_stream: RecordingStringIO = RecordingStringIO()
+        with ClpIrStreamReader(BytesIO(ir_stream), enable_compression=False) as clp_reader:
+            self.assertEqual(40_000, clp_reader.dump(string_stream))
+        self.assertEqual(ref_text, string_stream.getvalue())
+        self.assertGreater(string_stream.num_writes, 2)
+
+
 class TestIncompleteIRStream(TestCLPBase):
     """
     Tests on reading an incomplete stream.
@@ -211,6 +407,35 @@ class TestIncompleteIRStream(TestCLPBase):
         self.assertFalse(other_exception_captured, "No other exception should be set.")
         self.assertTrue(0 != log_counter, "No logs are deserialized.")
 
+    def test_incomplete_ir_stream_error_iteration(self) -> None:
+        """
+        Tests that iterating the reader over an incomplete IR file yields the log events before
+        raising the error, even if they are deserialized in the same batch.
+        """
+        log_counter: int = 0
+        with ClpIrFileReader(TestIncompleteIRStream.test_src) as clp_reader:
+            with self.assertRaises(IncompleteStreamError):
+                for _ in clp_reader:
+                    log_counter += 1
+        self.assertTrue(0 != log_counter, "No logs are deserialized.")
+
+    @unittest.skipUnless(
+        is_native_zstd_decompression_supported(), "Native zstd decompression isn't supported."
+    )
+    def test_incomplete_ir_stream_error_native_decompression(self) -> None:
+        """
+        Tests the reader against an incomplete IR file with `allow_incomplete_stream` disabled,
+        using native decompression.
+        """
+        log_counter: int = 0
+        with ClpIrFileReader(
+            TestIncompleteIRStream.test_src, enable_native_decompression=True
+        ) as clp_reader:
+            with self.assertRaises(IncompleteStreamError):
+                for _ in clp_reader.search(Query()):
+                    log_counter += 1
+        self.assertTrue(0 != log_counter, "No logs are deserialized.")
+
     def test_allow_incomplete_ir_stream_error(self) -> None:
         """
         Tests the reader against an incomplete IR file with `allow_incomplete_stream` enabled.
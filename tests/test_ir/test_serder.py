@@ -1,14 +1,88 @@
+import struct
+import threading
+from io import BytesIO
 from pathlib import Path
-from typing import Any, Dict, IO, List, Optional, Tuple
+from typing import Any, Dict, FrozenSet, Generator, IO, List, Optional, Set, Tuple, Union
 
 from smart_open import open  # type: ignore
-from test_ir.test_utils import get_current_timestamp, JsonLinesFileReader, TestCLPBase
-
-from clp_ffi_py.ir import Deserializer, IncompleteStreamError, KeyValuePairLogEvent, Serializer
+from test_ir.test_utils import (
+    get_current_timestamp,
+    is_native_zstd_decompression_supported,
+    JsonLinesFileReader,
+    TestCLPBase,
+)
+
+from clp_ffi_py.ir import (
+    Deserializer,
+    IncompleteStreamError,
+    KeyValuePairLogEvent,
+    Query,
+    Serializer,
+)
 from clp_ffi_py.utils import serialize_dict_to_msgpack
+from clp_ffi_py.wildcard_query import FullStringWildcardQuery
 
 LOG_DIR: Path = Path("unittest-logs")
 
+KeyPath = Tuple[str, ...]
+InPlaceInput = Union[Path, bytes]
+
+
+def _get_leaf_kv_pairs(
+    kv_pairs: Dict[Any, Any], parent_key_path: KeyPath = ()
+) -> Generator[Tuple[KeyPath, Any], None, None]:
+    """
+    Gets all the leaf key-value pairs in the given dictionary, where a leaf value is either a
+    non-dictionary value or an empty dictionary.
+
+    :param kv_pairs:
+    :param parent_key_path: The key path of the given dictionary.
+    :return: A generator of (key path, value) tuples.
+    """
+    for key, value in kv_pairs.items():
+        key_path: KeyPath = parent_key_path + (key,)
+        if isinstance(value, dict) and 0 != len(value):
+            yield from _get_leaf_kv_pairs(value, key_path)
+        else:
+            yield key_path, value
+
+
+def _get_expected_stats(inputs: List[Tuple[Dict[Any, Any], Dict[Any, Any]]]) -> Dict[str, Any]:
+    """
+    Computes the statistics that `Deserializer.scan_stats` is expected to return for the IR stream
+    serialized from the given inputs, except `num_encoded_bytes`.
+
+    :param inputs: A list of dictionary tuples (auto-generated, user-generated).
+    :return: The expected statistics.
+    """
+    schemas: Set[Tuple[FrozenSet[KeyPath], FrozenSet[KeyPath]]] = set()
+    key_frequencies: List[Dict[KeyPath, int]] = [{}, {}]
+    numeric_ranges: List[Dict[KeyPath, Tuple[Any, Any]]] = [{}, {}]
+    for kv_pairs_tuple in inputs:
+        key_paths: List[FrozenSet[KeyPath]] = []
+        for idx, kv_pairs in enumerate(kv_pairs_tuple):
+            leaf_kv_pairs: List[Tuple[KeyPath, Any]] = list(_get_leaf_kv_pairs(kv_pairs))
+            key_paths.append(frozenset(key_path for key_path, _ in leaf_kv_pairs))
+            for key_path, value in leaf_kv_pairs:
+                key_frequencies[idx][key_path] = key_frequencies[idx].get(key_path, 0) + 1
+                if type(value) not in (int, float) or value != value:
+                    continue
+                if key_path not in numeric_ranges[idx]:
+                    numeric_ranges[idx][key_path] = (value, value)
+                    continue
+                min_value, max_value = numeric_ranges[idx][key_path]
+                numeric_ranges[idx][key_path] = (min(min_value, value), max(max_value, value))
+        schemas.add((key_paths[0], key_paths[1]))
+
+    return {
+        "num_log_events": len(inputs),
+        "num_distinct_schemas": len(schemas),
+        "auto_gen_key_frequencies": key_frequencies[0],
+        "auto_gen_numeric_ranges": numeric_ranges[0],
+        "user_gen_key_frequencies": key_frequencies[1],
+        "user_gen_numeric_ranges": numeric_ranges[1],
+    }
+
 
 class TestCaseSerDerBase(TestCLPBase):
     """
@@ -86,6 +160,9 @@ class TestCaseSerDerBase(TestCLPBase):
         buffer_capacity: int,
         allow_incomplete_ir_stream: bool,
         expected_outputs: List[Tuple[Dict[Any, Any], Dict[Any, Any]]],
+        in_place_input: Optional[InPlaceInput] = None,
+        enable_zstd_decompression: bool = False,
+        num_readahead_buffers: int = 0,
     ) -> None:
         """
         Deserializes the input CLP key-value pair IR stream and compare the deserialized log events
@@ -96,12 +173,26 @@ class TestCaseSerDerBase(TestCLPBase):
         :param allow_incomplete_ir_stream: Whether to allow incomplete IR streams.
         :param expected_outputs: A list of dictionary tuples (auto-generated, user-generated) as the
             expected outputs.
+        :param in_place_input: If given, the deserializer reads from this input in place instead of
+            reading from `ir_stream_path` as a stream.
+        :param enable_zstd_decompression: Whether to decompress the IR stream natively. If set, the
+            input is read without being decompressed by `smart_open`.
+        :param num_readahead_buffers: The number of readahead buffers. Only valid with an in-place
+            input.
         """
-        input_stream: IO[bytes] = open(ir_stream_path, "rb")
+        input_stream: Union[IO[bytes], InPlaceInput]
+        if in_place_input is not None:
+            input_stream = in_place_input
+        elif enable_zstd_decompression:
+            input_stream = ir_stream_path.open("rb")
+        else:
+            input_stream = open(ir_stream_path, "rb")
         deserializer: Deserializer = Deserializer(
             input_stream,
             allow_incomplete_stream=allow_incomplete_ir_stream,
             buffer_capacity=buffer_capacity,
+            enable_zstd_decompression=enable_zstd_decompression,
+            num_readahead_buffers=num_readahead_buffers,
         )
         for expected_auto_gen_dict, expected_user_gen_dict in expected_outputs:
             deserialized_log_event: Optional[KeyValuePairLogEvent] = (
@@ -124,6 +215,119 @@ class TestCaseSerDerBase(TestCLPBase):
             TestCaseSerDerBase.user_defined_metadata, deserializer.get_user_defined_metadata()
         )
 
+    def _scan_stats(
+        self,
+        ir_stream_path: Path,
+        allow_incomplete_ir_stream: bool,
+        inputs: List[Tuple[Dict[Any, Any], Dict[Any, Any]]],
+        in_place_input: Optional[InPlaceInput] = None,
+        enable_zstd_decompression: bool = False,
+        num_readahead_buffers: int = 0,
+    ) -> None:
+        """
+        Scans the input CLP key-value pair IR stream using `Deserializer.scan_stats` and compares
+        the collected statistics with the statistics computed from the given inputs.
+
+        :param ir_stream_path: Path to the input file that the deserializers reads from.
+        :param allow_incomplete_ir_stream: Whether to allow incomplete IR streams.
+        :param inputs: A list of dictionary tuples (auto-generated, user-generated) that were
+            serialized into the IR stream.
+        :param in_place_input: If given, the stream is scanned from this input in place instead of
+            being read from `ir_stream_path` as a stream.
+        :param enable_zstd_decompression: Whether to decompress the IR stream natively. If set, the
+            input is read without being decompressed by `smart_open`.
+        :param num_readahead_buffers: The number of readahead buffers. Only valid with an in-place
+            input.
+        """
+        with open(ir_stream_path, "rb") as input_stream:
+            num_encoded_bytes: int = len(input_stream.read())
+
+        with (
+            ir_stream_path.open("rb") if enable_zstd_decompression else open(ir_stream_path, "rb")
+        ) as input_stream:
+            scan_input: Union[IO[bytes], InPlaceInput] = (
+                input_stream if in_place_input is None else in_place_input
+            )
+            if self.generate_incomplete_ir and not allow_incomplete_ir_stream:
+                with self.assertRaises(IncompleteStreamError):
+                    Deserializer.scan_stats(
+                        scan_input,
+                        enable_zstd_decompression=enable_zstd_decompression,
+                        num_readahead_buffers=num_readahead_buffers,
+                    )
+                return
+            stats: Dict[str, Any] = Deserializer.scan_stats(
+                scan_input,
+                allow_incomplete_stream=allow_incomplete_ir_stream,
+                enable_zstd_decompression=enable_zstd_decompression,
+                num_readahead_buffers=num_readahead_buffers,
+            )
+
+        expected_stats: Dict[str, Any] = _get_expected_stats(inputs)
+        expected_stats["num_encoded_bytes"] = num_encoded_bytes
+        self.assertEqual(expected_stats, stats)
+
+    def _filter(
+        self,
+        ir_stream_path: Path,
+        expected: List[Tuple[Dict[Any, Any], Dict[Any, Any]]],
+    ) -> None:
+        """
+        Filters the input CLP key-value pair IR stream using `Deserializer.filter_ir_stream` with
+        queries that match either all or none of the log events, and validates the filtered IR
+        streams by deserializing them.
+
+        :param ir_stream_path: Path to the input file that the deserializers reads from.
+        :param expected: A list of dictionary tuples (auto-generated, user-generated) that were
+            serialized into the IR stream.
+        """
+        match_all_query: Query = Query(wildcard_queries=[FullStringWildcardQuery("*")])
+        match_none_query: Query = Query(
+            wildcard_queries=[FullStringWildcardQuery("*clp-ffi-py-no-such-value*")]
+        )
+        for query, expected_outputs in [
+            (None, expected),
+            (match_all_query, expected),
+            (match_none_query, []),
+        ]:
+            output_stream: BytesIO = BytesIO()
+            with open(ir_stream_path, "rb") as input_stream:
+                num_written: int = Deserializer.filter_ir_stream(
+                    input_stream,
+                    output_stream,
+                    query,
+                    allow_incomplete_stream=self.generate_incomplete_ir,
+                )
+            self.assertEqual(len(expected_outputs), num_written)
+
+            output_stream.seek(0)
+            deserializer: Deserializer = Deserializer(output_stream)
+            self.assertEqual(
+                TestCaseSerDerBase.user_defined_metadata, deserializer.get_user_defined_metadata()
+            )
+            for expected_auto_gen_dict, expected_user_gen_dict in expected_outputs:
+                deserialized_log_event: Optional[KeyValuePairLogEvent] = (
+                    deserializer.deserialize_log_event()
+                )
+                assert deserialized_log_event is not None
+                self.assertEqual(
+                    (expected_auto_gen_dict, expected_user_gen_dict),
+                    deserialized_log_event.to_dict(),
+                )
+            self.assertEqual(None, deserializer.deserialize_log_event())
+
+    def _get_in_place_inputs(self, ir_stream_path: Path) -> List[InPlaceInput]:
+        """
+        :param ir_stream_path:
+        :return: A list of inputs that the deserializer reads in place: the decompressed IR stream
+            as `bytes`, and `ir_stream_path` itself if the IR stream isn't compressed.
+        """
+        with open(ir_stream_path, "rb") as input_stream:
+            in_place_inputs: List[InPlaceInput] = [input_stream.read()]
+        if not self.enable_compression:
+            in_place_inputs.append(ir_stream_path)
+        return in_place_inputs
+
     def _get_ir_stream_path(
         self,
         jsonl_path: Path,
@@ -160,6 +364,80 @@ class TestCaseSerDerBase(TestCLPBase):
                 self._deserialize(ir_stream_path, buffer_capacity, False, expected)
             if self.generate_incomplete_ir:
                 self._deserialize(ir_stream_path, 65536, True, expected)
+            self._scan_stats(ir_stream_path, False, expected)
+            if self.generate_incomplete_ir:
+                self._scan_stats(ir_stream_path, True, expected)
+            self._filter(ir_stream_path, expected)
+            for in_place_input in self._get_in_place_inputs(ir_stream_path):
+                self._deserialize(ir_stream_path, 65536, False, expected, in_place_input)
+                self._scan_stats(ir_stream_path, False, expected, in_place_input)
+                if self.generate_incomplete_ir:
+                    self._deserialize(ir_stream_path, 65536, True, expected, in_place_input)
+                    self._scan_stats(ir_stream_path, True, expected, in_place_input)
+                self._test_readahead(ir_stream_path, expected, in_place_input, False)
+            if self.enable_compression and is_native_zstd_decompression_supported():
+                self._test_native_zstd_decompression(ir_stream_path, expected)
+
+    def _test_native_zstd_decompression(
+        self,
+        ir_stream_path: Path,
+        expected: List[Tuple[Dict[Any, Any], Dict[Any, Any]]],
+    ) -> None:
+        """
+        Tests deserializing and scanning the compressed IR stream using native decompression, from
+        both a stream and a path.
+
+        :param ir_stream_path: Path to the compressed IR stream.
+        :param expected: A list of dictionary tuples (auto-generated, user-generated) that were
+            serialized into the IR stream.
+        """
+        for in_place_input in [None, ir_stream_path]:
+            for buffer_capacity in [1, 65536]:
+                self._deserialize(
+                    ir_stream_path, buffer_capacity, False, expected, in_place_input, True
+                )
+            self._scan_stats(ir_stream_path, False, expected, in_place_input, True)
+            if self.generate_incomplete_ir:
+                self._deserialize(ir_stream_path, 65536, True, expected, in_place_input, True)
+                self._scan_stats(ir_stream_path, True, expected, in_place_input, True)
+        self._test_readahead(ir_stream_path, expected, ir_stream_path, True)
+
+    def _test_readahead(
+        self,
+        ir_stream_path: Path,
+        expected: List[Tuple[Dict[Any, Any], Dict[Any, Any]]],
+        in_place_input: InPlaceInput,
+        enable_zstd_decompression: bool,
+    ) -> None:
+        """
+        Tests deserializing and scanning the IR stream read through a native readahead thread.
+
+        :param ir_stream_path: Path to the IR stream.
+        :param expected: A list of dictionary tuples (auto-generated, user-generated) that were
+            serialized into the IR stream.
+        :param in_place_input: The input to read ahead.
+        :param enable_zstd_decompression: Whether to decompress the IR stream natively.
+        """
+        for buffer_capacity, num_readahead_buffers in [(1, 2), (256, 4), (65536, 2)]:
+            self._deserialize(
+                ir_stream_path,
+                buffer_capacity,
+                False,
+                expected,
+                in_place_input,
+                enable_zstd_decompression,
+                num_readahead_buffers,
+            )
+        self._scan_stats(
+            ir_stream_path, False, expected, in_place_input, enable_zstd_decompression, 4
+        )
+        if self.generate_incomplete_ir:
+            self._deserialize(
+                ir_stream_path, 256, True, expected, in_place_input, enable_zstd_decompression, 4
+            )
+            self._scan_stats(
+                ir_stream_path, True, expected, in_place_input, enable_zstd_decompression, 4
+            )
 
 
 class TestCaseSerDerRaw(TestCaseSerDerBase):
@@ -208,3 +486,124 @@ class TestCaseSerDerIncompleteZstd(TestCaseSerDerBase):
         self.enable_compression = True
         self.generate_incomplete_ir = True
         super().setUp()
+
+
+class _UnclosableBytesIO(BytesIO):
+    """
+    A `BytesIO` that stays readable after the serializer writing into it closes it.
+    """
+
+    # override
+    def close(self) -> None:
+        pass
+
+
+class TestCaseFilterUtcOffsetChange(TestCLPBase):
+    """
+    Tests that `Deserializer.filter_ir_stream` carries UTC offset changes over to the filtered IR
+    stream.
+    """
+
+    def test_filter_utc_offset_change(self) -> None:
+        """
+        Filters an IR stream that changes its UTC offset between two log events, and checks that the
+        UTC offset change is written before the matched log event that follows it.
+        """
+        # A UTC offset change IR unit: its tag followed by the UTC offset in seconds as a big-endian
+        # 64-bit integer.
+        utc_offset_change: bytes = b"\x3f" + struct.pack(">q", -5 * 60 * 60)
+        user_gen_dicts: List[Dict[Any, Any]] = [{"message": "before"}, {"message": "after"}]
+
+        ir_stream: _UnclosableBytesIO = _UnclosableBytesIO()
+        serializer: Serializer = Serializer(ir_stream)
+        serializer.serialize_log_event_from_msgpack_map(
+            serialize_dict_to_msgpack({}), serialize_dict_to_msgpack(user_gen_dicts[0])
+        )
+        serializer.flush()
+        utc_offset_change_pos: int = len(ir_stream.getvalue())
+        serializer.serialize_log_event_from_msgpack_map(
+            serialize_dict_to_msgpack({}), serialize_dict_to_msgpack(user_gen_dicts[1])
+        )
+        serializer.close()
+        serialized_bytes: bytes = ir_stream.getvalue()
+        input_bytes: bytes = (
+            serialized_bytes[:utc_offset_change_pos]
+            + utc_offset_change
+            + serialized_bytes[utc_offset_change_pos:]
+        )
+
+        match_before_query: Query = Query(wildcard_queries=[FullStringWildcardQuery("*before*")])
+        match_after_query: Query = Query(wildcard_queries=[FullStringWildcardQuery("*after*")])
+        for query, expected_user_gen_dicts, is_utc_offset_change_expected in [
+            (None, user_gen_dicts, True),
+            (match_before_query, user_gen_dicts[:1], False),
+            (match_after_query, user_gen_dicts[1:], True),
+        ]:
+            output_stream: BytesIO = BytesIO()
+            num_written: int = Deserializer.filter_ir_stream(
+                BytesIO(input_bytes), output_stream, query
+            )
+            self.assertEqual(len(expected_user_gen_dicts), num_written)
+
+            output_bytes: bytes = output_stream.getvalue()
+            self.assertEqual(is_utc_offset_change_expected, utc_offset_change in output_bytes)
+            deserializer: Deserializer = Deserializer(BytesIO(output_bytes))
+            for expected_user_gen_dict in expected_user_gen_dicts:
+                deserialized_log_event: Optional[KeyValuePairLogEvent] = (
+                    deserializer.deserialize_log_event()
+                )
+                assert deserialized_log_event is not None
+                self.assertEqual(({}, expected_user_gen_dict), deserialized_log_event.to_dict())
+            self.assertEqual(None, deserializer.deserialize_log_event())
+
+
+class TestCaseConcurrentDeserialization(TestCLPBase):
+    """
+    Tests deserializing log events from one `Deserializer` in multiple threads.
+    """
+
+    def test_concurrent_deserialization(self) -> None:
+        """
+        Iterates one `Deserializer` that reads its input in place from two threads, and checks that
+        every log event is deserialized exactly once. A call made while the other thread is
+        deserializing must raise `RuntimeError` instead of accessing the same deserializer.
+        """
+        num_log_events: int = 20000
+        user_gen_dicts: List[Dict[Any, Any]] = [
+            {"id": i, "message": f"Log message {i}"} for i in range(num_log_events)
+        ]
+        ir_stream: _UnclosableBytesIO = _UnclosableBytesIO()
+        with Serializer(ir_stream) as serializer:
+            for user_gen_dict in user_gen_dicts:
+                serializer.serialize_log_event_from_msgpack_map(
+                    serialize_dict_to_msgpack({}), serialize_dict_to_msgpack(user_gen_dict)
+                )
+
+        deserializer: Deserializer = Deserializer(ir_stream.getvalue())
+        deserialized_ids: List[List[int]] = [[], []]
+
+        def iterate(thread_idx: int) -> None:
+            while True:
+                try:
+                    log_event: Optional[KeyValuePairLogEvent] = (
+                        deserializer.deserialize_log_event()
+                    )
+                except RuntimeError:
+                    continue
+                if log_event is None:
+                    return
+                deserialized_ids[thread_idx].append(log_event.to_dict()[1]["id"])
+
+        threads: List[threading.Thread] = [
+            threading.Thread(target=iterate, args=(thread_idx,)) for thread_idx in range(2)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for ids in deserialized_ids:
+            self.assertEqual(sorted(ids), ids)
+        self.assertEqual(
+            list(range(num_log_events)), sorted(deserialized_ids[0] + deserialized_ids[1])
+        )
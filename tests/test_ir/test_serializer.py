@@ -1,10 +1,17 @@
 from io import BytesIO
 from pathlib import Path
-from typing import List, Optional
+from tempfile import TemporaryDirectory
+from typing import List, Optional, Tuple
 
 from test_ir.test_utils import JsonLinesFileReader, TestCLPBase
 
-from clp_ffi_py.ir import FourByteSerializer, Serializer
+from clp_ffi_py.ir import (
+    ClpIrFileReader,
+    FourByteSerializer,
+    FourByteStreamSerializer,
+    LogEvent,
+    Serializer,
+)
 from clp_ffi_py.utils import serialize_dict_to_msgpack
 
 
@@ -44,6 +51,186 @@ class TestCaseFourByteSerializer(TestCLPBase):
         )
         self.assertEqual(serialized_message_and_ts_delta, serialized_message + serialized_ts_delta)
 
+    def test_batch_serialization_consistency(self) -> None:
+        """
+        This test checks if the result of serialize_messages_and_timestamps is consistent with
+        the concatenated results of serialize_message_and_timestamp_delta.
+        """
+        ref_timestamp: int = 1_700_000_000_000
+        timestamps: List[int] = [ref_timestamp + 5, ref_timestamp - 20, ref_timestamp + 70_000]
+        messages: List[bytes] = [
+            b"This is a test message: Do NOT Reply!",
+            b"Variables: 1234, 5.678, and id_42",
+            b"",
+        ]
+        expected: bytearray = bytearray()
+        prev_timestamp: int = ref_timestamp
+        for timestamp, message in zip(timestamps, messages):
+            expected += FourByteSerializer.serialize_message_and_timestamp_delta(
+                timestamp - prev_timestamp, message
+            )
+            prev_timestamp = timestamp
+        self.assertEqual(
+            bytes(expected),
+            FourByteSerializer.serialize_messages_and_timestamps(
+                timestamps, messages, ref_timestamp
+            ),
+        )
+        self.assertEqual(b"", FourByteSerializer.serialize_messages_and_timestamps([], [], 0))
+
+        # Large enough to be split across threads
+        num_log_events: int = 20000
+        timestamps = [ref_timestamp + (idx * 37) % 1000 for idx in range(num_log_events)]
+        messages = [
+            f"Log event {idx}: value={idx * 0.5} user=u{idx}".encode()
+            for idx in range(num_log_events)
+        ]
+        sequentially_serialized: bytes = FourByteSerializer.serialize_messages_and_timestamps(
+            timestamps, messages, ref_timestamp
+        )
+        for num_threads in [0, 2, 3, 8]:
+            self.assertEqual(
+                sequentially_serialized,
+                FourByteSerializer.serialize_messages_and_timestamps(
+                    timestamps, messages, ref_timestamp, num_threads
+                ),
+            )
+
+        with self.assertRaises(ValueError):
+            FourByteSerializer.serialize_messages_and_timestamps(timestamps, messages[1:], 0)
+        with self.assertRaises(ValueError):
+            FourByteSerializer.serialize_messages_and_timestamps(timestamps, messages, 0, -1)
+        with self.assertRaises(TypeError):
+            FourByteSerializer.serialize_messages_and_timestamps(
+                [ref_timestamp], ["str"], 0  # type: ignore
+            )
+
+
+    def test_text_log_serialization(self) -> None:
+        """
+        This test converts a plain-text log with multi-line log messages and multiple timestamp
+        formats, and checks the log events read back from the converted IR stream. Timestamps
+        without a UTC offset are interpreted in the given timezone, including across a DST
+        transition.
+        """
+        text_log: str = (
+            "Starting up\n"
+            "2023-11-14 22:13:20,000 INFO Log message 1\n"
+            "2023-11-14 22:13:20.123 ERROR Exception with id=42\n"
+            "\tat Foo.bar(Foo.java:10)\n"
+            "2023-11-14T22:13:21.5+01:00 WARN Log message 3\n"
+            "2023-07-01 12:00:00,000 INFO Log message in DST\n"
+            "2023-11-14 22:13:22,250 INFO Log message without a line break"
+        )
+        timestamp_formats: List[str] = [
+            "yyyy-MM-dd HH:mm:ss,SSS",
+            "yyyy-MM-dd HH:mm:ss.SSS",
+            "yyyy-MM-dd'T'HH:mm:ss.SXXX",
+        ]
+        # America/Toronto is UTC-05:00 in November and UTC-04:00 in July.
+        expected_log_events: List[Tuple[int, str]] = [
+            (0, "Starting up\n"),
+            (1_700_018_000_000, " INFO Log message 1\n"),
+            (1_700_018_000_123, " ERROR Exception with id=42\n\tat Foo.bar(Foo.java:10)\n"),
+            (1_699_996_401_500, " WARN Log message 3\n"),
+            (1_688_227_200_000, " INFO Log message in DST\n"),
+            (1_700_018_002_250, " INFO Log message without a line break"),
+        ]
+        with TemporaryDirectory() as temp_dir:
+            input_path: Path = Path(temp_dir) / "input.log"
+            output_path: Path = Path(temp_dir) / "output.clp"
+            input_path.write_text(text_log)
+            num_log_events: int = FourByteSerializer.serialize_text_log(
+                input_path, output_path, timestamp_formats, "America/Toronto"
+            )
+            self.assertEqual(len(expected_log_events), num_log_events)
+
+            with ClpIrFileReader(output_path, enable_compression=False) as reader:
+                log_events: List[LogEvent] = list(reader)
+                metadata = reader.get_metadata()
+                self.assertEqual(0, metadata.get_ref_timestamp())
+                self.assertEqual("America/Toronto", metadata.get_timezone_id())
+            self.assertEqual(
+                expected_log_events,
+                [(event.get_timestamp(), event.get_log_message()) for event in log_events],
+            )
+
+            with self.assertRaises(ValueError):
+                FourByteSerializer.serialize_text_log(input_path, output_path, ["yyyy-QQ"])
+            with self.assertRaises(ValueError):
+                FourByteSerializer.serialize_text_log(
+                    input_path, output_path, timestamp_formats, "Invalid/Timezone"
+                )
+            with self.assertRaises(OSError):
+                FourByteSerializer.serialize_text_log(
+                    Path(temp_dir) / "nonexistent.log", output_path, timestamp_formats
+                )
+
+
+class TestCaseFourByteStreamSerializer(TestCLPBase):
+    """
+    Class for testing clp_ffi_py.ir.FourByteStreamSerializer.
+    """
+
+    def test_consistency_with_four_byte_serializer(self) -> None:
+        """
+        This test checks if the serialized IR stream is consistent with the one serialized using
+        FourByteSerializer's static methods.
+        """
+        ref_timestamp: int = 1_700_000_000_000
+        timestamp_format: str = "yyyy-MM-dd HH:mm:ss.SSS"
+        timezone: str = "America/Toronto"
+        log_events: List[Tuple[int, str]] = [
+            (ref_timestamp + 12, "This is a test message: Do NOT Reply!\n"),
+            (ref_timestamp + 3, "Out-of-order timestamp with variables: 1234 and 5.678\n"),
+            (ref_timestamp + 100_000, "Large timestamp delta with a dictionary variable: id_42\n"),
+        ]
+
+        expected: bytearray = FourByteSerializer.serialize_preamble(
+            ref_timestamp, timestamp_format, timezone
+        )
+        prev_timestamp: int = ref_timestamp
+        for timestamp, log_message in log_events:
+            expected += FourByteSerializer.serialize_message_and_timestamp_delta(
+                timestamp - prev_timestamp, log_message.encode()
+            )
+            prev_timestamp = timestamp
+
+        # A zero buffer size limit writes every log event to the output stream immediately, while
+        # the default one buffers all of them until `flush`.
+        for buffer_size_limit in [0, 65536]:
+            byte_buffer: BytesIO = BytesIO()
+            serializer: FourByteStreamSerializer = FourByteStreamSerializer(
+                byte_buffer,
+                ref_timestamp,
+                timestamp_format,
+                timezone,
+                buffer_size_limit=buffer_size_limit,
+            )
+            num_bytes_serialized: int = serializer.get_num_bytes_serialized()
+            for timestamp, log_message in log_events:
+                num_bytes_serialized += serializer.serialize_log_event(
+                    timestamp, log_message.encode()
+                )
+            self.assertEqual(num_bytes_serialized, serializer.get_num_bytes_serialized())
+            serializer.flush()
+            self.assertEqual(expected, byte_buffer.getvalue())
+            serializer.close()
+            self.assertEqual(
+                len(expected) + 1,
+                serializer.get_num_bytes_serialized(),
+                "End-of-stream byte is missing",
+            )
+            with self.assertRaises(IOError):
+                serializer.serialize_log_event(ref_timestamp, b"Serializer is closed")
+
+    def test_not_closed(self) -> None:
+        serializer: Optional[FourByteStreamSerializer] = FourByteStreamSerializer(
+            BytesIO(), 0, "", ""
+        )
+        with self.assertWarns(ResourceWarning) as _:
+            serializer = None  # noqa
+
 
 class TestCaseSerializer(TestCLPBase):
     """
@@ -173,6 +360,28 @@ class TestCaseSerializer(TestCLPBase):
         with self.assertRaises(TypeError):
             _ = Serializer(byte_buffer, user_defined_metadata=[1, "str"])  # type: ignore
 
+    def test_encoding(self) -> None:
+        four_byte_magic_number: bytes = bytes([0xFD, 0x2F, 0xB5, 0x29])
+        eight_byte_magic_number: bytes = bytes([0xFD, 0x2F, 0xB5, 0x30])
+        byte_buffer: BytesIO
+
+        byte_buffer = BytesIO()
+        with Serializer(byte_buffer) as _:
+            pass
+        self.assertTrue(byte_buffer.getvalue().startswith(four_byte_magic_number))
+
+        byte_buffer = BytesIO()
+        with Serializer(byte_buffer, encoding="eight_byte") as serializer:
+            msgpack_byte_sequence: bytes = serialize_dict_to_msgpack({"count": 2**40})
+            serializer.serialize_log_event_from_msgpack_map(
+                auto_gen_msgpack_map=serialize_dict_to_msgpack({}),
+                user_gen_msgpack_map=msgpack_byte_sequence,
+            )
+        self.assertTrue(byte_buffer.getvalue().startswith(eight_byte_magic_number))
+
+        with self.assertRaises(ValueError):
+            _ = Serializer(BytesIO(), encoding="two_byte")
+
     def __get_test_files(self) -> List[Path]:
         test_files: List[Path] = []
         for file_path in TestCaseSerializer.test_data_dir.rglob("*"):
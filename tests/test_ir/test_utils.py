@@ -1,3 +1,4 @@
+import io
 import json
 import random
 import time
@@ -17,6 +18,7 @@ from zstandard import (
 )
 
 from clp_ffi_py.ir import (
+    DeserializerBuffer,
     LogEvent,
     Metadata,
     Query,
@@ -68,6 +70,17 @@ def _zstd_compressions_handler(
 register_compressor(".zst", _zstd_compressions_handler)
 
 
+def is_native_zstd_decompression_supported() -> bool:
+    """
+    :return: Whether the native library is built with zstd decompression support.
+    """
+    try:
+        DeserializerBuffer(io.BytesIO(), enable_zstd_decompression=True)
+    except NotImplementedError:
+        return False
+    return True
+
+
 def get_current_timestamp() -> int:
     """
     :return: the current Unix epoch time in milliseconds.